@@ -5,6 +5,10 @@ import android.util.Log;
 
 import com.google.android.accessibility.selecttospeak.SelectToSpeakService;
 
+import org.json.JSONArray;
+import org.json.JSONException;
+import org.json.JSONObject;
+
 import java.io.File;
 import java.io.FileOutputStream;
 import java.io.OutputStreamWriter;
@@ -25,6 +29,19 @@ public class AppToolsHost {
         return service.takeScreenshotSync();
     }
 
+    /** Raw JPEG bytes for the zero-copy ArrayBuffer path; null on failure. */
+    public static byte[] nativeTakeScreenshotJpeg() {
+        SelectToSpeakService service = SelectToSpeakService.getInstance();
+        if (service == null) return null;
+        return service.takeScreenshotJpegSync();
+    }
+
+    public static String nativeScreenshotError() {
+        SelectToSpeakService service = SelectToSpeakService.getInstance();
+        if (service == null) return "ERROR: accessibility service not running";
+        return service.getLastScreenshotError();
+    }
+
     public static String nativeGetScreen() {
         SelectToSpeakService service = SelectToSpeakService.getInstance();
         if (service == null) return "(accessibility service not running)";
@@ -136,4 +153,95 @@ public class AppToolsHost {
         if (service == null) return "Accessibility service not running";
         return service.listApps();
     }
+
+    /** Cap on a single in-batch sleep so a bad script can't stall the exec thread. */
+    private static final long BATCH_SLEEP_MAX_MS = 5000;
+
+    /**
+     * Execute a JSON array of actions in one JNI crossing and return a JSON
+     * array of per-action results. Each action object carries an "action"
+     * name plus the same fields the single-call tools take, e.g.
+     * {"action":"click","text":"OK"}, {"action":"click","x":100,"y":200},
+     * {"action":"scroll","direction":"down"}, {"action":"sleep","ms":500}.
+     * Execution stops at the first failed action — later entries in a
+     * sequence usually depend on the earlier ones landing.
+     */
+    public static String nativeBatchActions(String actionsJson) {
+        SelectToSpeakService service = SelectToSpeakService.getInstance();
+        if (service == null) return "[{\"error\":\"accessibility service not running\"}]";
+        JSONArray results = new JSONArray();
+        try {
+            JSONArray actions = new JSONArray(actionsJson);
+            for (int i = 0; i < actions.length(); i++) {
+                JSONObject action = actions.getJSONObject(i);
+                String name = action.getString("action");
+                JSONObject res = new JSONObject();
+                res.put("action", name);
+                boolean ok;
+                switch (name) {
+                    case "click":
+                        ok = dispatchClick(service, action, false);
+                        break;
+                    case "long_click":
+                        ok = dispatchClick(service, action, true);
+                        break;
+                    case "scroll":
+                        ok = service.scrollScreen(action.getString("direction"));
+                        break;
+                    case "type_text":
+                        ok = service.inputText(action.getString("text"));
+                        break;
+                    case "sleep":
+                        Thread.sleep(Math.min(action.getLong("ms"), BATCH_SLEEP_MAX_MS));
+                        ok = true;
+                        break;
+                    case "press_home":
+                        ok = service.globalAction(android.accessibilityservice.AccessibilityService.GLOBAL_ACTION_HOME);
+                        break;
+                    case "press_back":
+                        ok = service.globalAction(android.accessibilityservice.AccessibilityService.GLOBAL_ACTION_BACK);
+                        break;
+                    case "press_recents":
+                        ok = service.globalAction(android.accessibilityservice.AccessibilityService.GLOBAL_ACTION_RECENTS);
+                        break;
+                    case "show_notifications":
+                        ok = service.globalAction(android.accessibilityservice.AccessibilityService.GLOBAL_ACTION_NOTIFICATIONS);
+                        break;
+                    default:
+                        res.put("error", "unknown action: " + name);
+                        results.put(res);
+                        return results.toString();
+                }
+                res.put("ok", ok);
+                results.put(res);
+                if (!ok) break;
+            }
+        } catch (JSONException | InterruptedException e) {
+            try {
+                JSONObject err = new JSONObject();
+                err.put("error", String.valueOf(e.getMessage()));
+                results.put(err);
+            } catch (JSONException ignored) {}
+        }
+        return results.toString();
+    }
+
+    /** Same target resolution as the single-call click/long_click: text, desc, or coords. */
+    private static boolean dispatchClick(SelectToSpeakService service, JSONObject action, boolean isLong)
+            throws JSONException {
+        if (action.has("text")) {
+            String text = action.getString("text");
+            return isLong ? service.longClickByText(text) : service.clickByText(text);
+        }
+        if (action.has("desc")) {
+            String desc = action.getString("desc");
+            return isLong ? service.longClickByDesc(desc) : service.clickByDesc(desc);
+        }
+        if (action.has("x") && action.has("y")) {
+            int x = action.getInt("x");
+            int y = action.getInt("y");
+            return isLong ? service.longClickByCoordinates(x, y) : service.clickByCoordinates(x, y);
+        }
+        return false;
+    }
 }
@@ -221,7 +221,15 @@ public class DeviceConnection {
         connected = false;
         releaseWifiLock();
         if (hermesInitialized) {
-            try { HermesRuntime.nativeDestroyRuntime(agentType); } catch (Exception ignored) {}
+            // Destroy on the runtime's pinned thread so teardown cannot race
+            // an in-flight evaluation.
+            try {
+                HermesRuntime.onRuntimeThread(agentType, () -> {
+                    HermesRuntime.nativeDestroyRuntime(agentType);
+                    return null;
+                });
+            } catch (Exception ignored) {}
+            HermesRuntime.markRuntimeDestroyed(agentType);
             hermesInitialized = false;
             cachedPromptInfo = null;
         }
@@ -322,7 +330,7 @@ public class DeviceConnection {
             JSONArray executionLog = null;
             try {
                 initHermesRuntime();
-                String rawResult = HermesRuntime.nativeEvaluateJS(
+                String rawResult = HermesRuntime.execJs(
                         agentType,
                         "JSON.stringify(executeCodeForServer(" + escapeJsString(code) + "))",
                         "exec_js"
@@ -331,9 +339,10 @@ public class DeviceConnection {
                 if (rawResult != null && (rawResult.contains("Runtime not created")
                         || (rawResult.contains("executeCodeForServer") && rawResult.contains("doesn't exist")))) {
                     Log.w(TAG, "[" + agentType + "] Runtime issue, reinitializing: " + rawResult);
+                    HermesRuntime.markRuntimeDestroyed(agentType);
                     hermesInitialized = false;
                     initHermesRuntime();
-                    rawResult = HermesRuntime.nativeEvaluateJS(
+                    rawResult = HermesRuntime.execJs(
                             agentType,
                             "JSON.stringify(executeCodeForServer(" + escapeJsString(code) + "))",
                             "exec_js"
@@ -377,39 +386,30 @@ public class DeviceConnection {
     private void initHermesRuntime() {
         if (hermesInitialized) return;
 
-        HermesRuntime.nativeCreateRuntime(agentType);
-
-        // Load the appropriate JS bundle
-        String assetName = "app".equals(agentType) ? "agent-standalone.js" : "browser-standalone.js";
-
         Context loadContext;
         if ("app".equals(agentType)) {
             com.google.android.accessibility.selecttospeak.SelectToSpeakService service =
                     com.google.android.accessibility.selecttospeak.SelectToSpeakService.getInstance();
             if (service == null) {
-                Log.e(TAG, "[" + agentType + "] A11y service not available, destroying bare runtime");
-                HermesRuntime.nativeDestroyRuntime(agentType);
+                Log.e(TAG, "[" + agentType + "] A11y service not available");
                 throw new RuntimeException("Accessibility service is not enabled. Please enable it in Android Settings > Accessibility > Select to Speak.");
             }
             loadContext = service;
         } else {
             if (appContext == null) {
-                HermesRuntime.nativeDestroyRuntime(agentType);
                 throw new RuntimeException("Application context not available");
             }
             loadContext = appContext;
         }
-        String bundleJs = HermesRuntime.loadAsset(loadContext, assetName);
-        if (bundleJs == null) {
-            Log.e(TAG, "[" + agentType + "] Failed to load " + assetName + ", destroying bare runtime");
-            HermesRuntime.nativeDestroyRuntime(agentType);
-            throw new RuntimeException("Failed to load JS bundle: " + assetName);
+        // No-op when the runtime was pre-warmed at service bind; otherwise
+        // creates the runtime and evaluates the bundle on this thread.
+        if (!HermesRuntime.ensureRuntimeWarm(agentType, loadContext)) {
+            throw new RuntimeException("Failed to load JS bundle for agent type: " + agentType);
         }
-        HermesRuntime.nativeEvaluateJS(agentType, bundleJs, assetName);
 
         // Read __DEVICE_PROMPT__ (set by prompt.ts / browser-prompt.ts)
         try {
-            String result = HermesRuntime.nativeEvaluateJS(
+            String result = HermesRuntime.execJs(
                     agentType,
                     "JSON.stringify(__DEVICE_PROMPT__)",
                     "get-prompt-info"
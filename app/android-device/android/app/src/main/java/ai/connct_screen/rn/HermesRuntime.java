@@ -17,10 +17,16 @@ import java.io.OutputStream;
 import java.io.OutputStreamWriter;
 import java.net.HttpURLConnection;
 import java.net.URL;
+import java.util.ArrayList;
 import java.util.Iterator;
+import java.util.List;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 import java.util.concurrent.atomic.AtomicBoolean;
 
+import org.json.JSONArray;
 import org.json.JSONObject;
 
 /**
@@ -43,8 +49,157 @@ public class HermesRuntime {
     // --- Native methods (implemented in hermes_runtime.cpp) ---
     static native void nativeCreateRuntime(String agentType);
     static native String nativeEvaluateJS(String agentType, String code, String sourceURL);
+    /** Evaluate a bundle asset in place (mmap'd from the APK; .hbc assets skip
+     *  parse+compile entirely). Returns false if the asset is missing or fails. */
+    static native boolean nativeEvaluateAsset(String agentType, android.content.res.AssetManager assets, String assetName);
     static native void nativeDestroyRuntime(String agentType);
 
+    // --- Profiling (Hermes sampling profiler + heap stats) ---
+    /** Start sampling JS stacks across all runtimes (cheap until stopped). */
+    public static native void nativeStartSamplingProfiler();
+    /** Stop sampling and write the trace to outPath; false on dump failure. */
+    public static native boolean nativeStopSamplingProfiler(String outPath);
+    /**
+     * Heap counters for one runtime as JSON (allocated/used bytes, GC
+     * counts). Touches the runtime — use getHeapInfo(), which hops to the
+     * runtime's pinned thread, unless already on it.
+     */
+    public static native String nativeGetHeapInfo(String agentType);
+
+    /**
+     * Stop the profiler and dump the trace into the app files dir, named
+     * hermes-profile-&lt;millis&gt;.cpuprofile (Chrome DevTools loads it).
+     * Pull with: adb shell "run-as ai.connct_screen.rn cat files/&lt;name&gt;".
+     * Returns the absolute path, or null if the dump failed.
+     */
+    public static String stopProfilerAndDump(Context ctx) {
+        File out = new File(ctx.getFilesDir(),
+                "hermes-profile-" + System.currentTimeMillis() + ".cpuprofile");
+        if (!nativeStopSamplingProfiler(out.getAbsolutePath())) return null;
+        return out.getAbsolutePath();
+    }
+
+    // --- Per-runtime execution threads ---
+
+    // One dedicated worker per agent type. A runtime is created, warmed and
+    // evaluated on its pinned thread for its whole life, so N agent types run
+    // truly in parallel while Hermes never sees two threads on one runtime.
+    // The thread's JNIEnv stays attached across tasks — getEnv() in the C++
+    // host functions reuses it instead of re-attaching.
+    private static final java.util.concurrent.ConcurrentHashMap<String, ExecutorService>
+            sRuntimeThreads = new java.util.concurrent.ConcurrentHashMap<>();
+
+    private static ExecutorService runtimeThread(String agentType) {
+        return sRuntimeThreads.computeIfAbsent(agentType, type ->
+                Executors.newSingleThreadExecutor(r -> new Thread(r, "hermes-" + type)));
+    }
+
+    /**
+     * Run work on the agent type's pinned runtime thread and wait for the
+     * result. Must not be called from that thread itself (it would deadlock
+     * waiting on its own queue).
+     */
+    public static <T> T onRuntimeThread(String agentType, java.util.concurrent.Callable<T> work)
+            throws Exception {
+        try {
+            return runtimeThread(agentType).submit(work).get();
+        } catch (java.util.concurrent.ExecutionException e) {
+            Throwable cause = e.getCause();
+            if (cause instanceof Exception) throw (Exception) cause;
+            throw e;
+        }
+    }
+
+    /** Evaluate JS on the agent type's pinned runtime thread. */
+    public static String execJs(String agentType, String code, String sourceURL) throws Exception {
+        return onRuntimeThread(agentType, () -> nativeEvaluateJS(agentType, code, sourceURL));
+    }
+
+    /** Heap counters via nativeGetHeapInfo, on the runtime's pinned thread. */
+    public static String getHeapInfo(String agentType) {
+        try {
+            return onRuntimeThread(agentType, () -> nativeGetHeapInfo(agentType));
+        } catch (Exception e) {
+            return "{\"error\":\"" + e.getMessage().replace("\"", "\\\"") + "\"}";
+        }
+    }
+
+    // --- Runtime pre-warming ---
+
+    /** Agent types whose runtime exists with the bundle already evaluated. */
+    private static final java.util.Set<String> sWarmRuntimes =
+            java.util.Collections.synchronizedSet(new java.util.HashSet<String>());
+
+    /**
+     * Create the runtime for this agent type and evaluate its bundle, unless
+     * both already happened. Everything up to (but not including) task
+     * execution — a later exec_js is dispatch-only. Returns false if the
+     * bundle could not be loaded (the bare runtime is destroyed). Hops to the
+     * runtime's pinned thread; concurrent warms of different types proceed in
+     * parallel, same-type warms serialize on that thread's queue.
+     */
+    public static boolean ensureRuntimeWarm(String agentType, Context loadContext) {
+        if (sWarmRuntimes.contains(agentType)) return true;
+        try {
+            return onRuntimeThread(agentType, () -> warmOnThread(agentType, loadContext));
+        } catch (Exception e) {
+            Log.e(TAG, "[" + agentType + "] Warm-up failed", e);
+            return false;
+        }
+    }
+
+    /** Body of ensureRuntimeWarm; runs on the pinned runtime thread. */
+    private static boolean warmOnThread(String agentType, Context loadContext) {
+        if (sWarmRuntimes.contains(agentType)) return true;
+
+        nativeCreateRuntime(agentType);
+        String assetName = "app".equals(agentType) ? "agent-standalone.js" : "browser-standalone.js";
+        // Prefer precompiled bytecode: Hermes executes the mmap'd .hbc straight
+        // from the APK, skipping the parse+compile that dominates cold dispatch.
+        String hbcName = assetName.replace(".js", ".hbc");
+        boolean loaded = nativeEvaluateAsset(agentType, loadContext.getAssets(), hbcName);
+        if (!loaded) {
+            Log.i(TAG, "[" + agentType + "] " + hbcName + " unavailable, compiling " + assetName);
+            String bundleJs = loadAsset(loadContext, assetName);
+            if (bundleJs == null) {
+                Log.e(TAG, "[" + agentType + "] Failed to load " + assetName + ", destroying bare runtime");
+                nativeDestroyRuntime(agentType);
+                return false;
+            }
+            nativeEvaluateJS(agentType, bundleJs, assetName);
+        }
+        sWarmRuntimes.add(agentType);
+        return true;
+    }
+
+    /** Forget a runtime's warm state (call alongside nativeDestroyRuntime). */
+    public static void markRuntimeDestroyed(String agentType) {
+        sWarmRuntimes.remove(agentType);
+    }
+
+    /**
+     * Pre-warm runtimes for the known agent types. Called at service bind so
+     * the first task of each type pays dispatch only, not construction + tool
+     * registration + bundle evaluation. Each type warms on its own pinned
+     * runtime thread, so the warms overlap.
+     */
+    public static void prewarmRuntimes(Context context) {
+        final Context app = context.getApplicationContext();
+        for (String type : new String[]{ "app", "browser" }) {
+            runtimeThread(type).execute(() -> {
+                try {
+                    long t0 = android.os.SystemClock.elapsedRealtime();
+                    if (warmOnThread(type, app)) {
+                        Log.i(TAG, "[" + type + "] Runtime pre-warmed in "
+                                + (android.os.SystemClock.elapsedRealtime() - t0) + "ms");
+                    }
+                } catch (Exception e) {
+                    Log.w(TAG, "[" + type + "] Pre-warm failed", e);
+                }
+            });
+        }
+    }
+
     // --- Shared callbacks invoked from C++ via JNI ---
 
     public static void nativeSleepMs(long ms) {
@@ -103,12 +258,55 @@ public class HermesRuntime {
             if (code < 200 || code >= 300) {
                 Log.e(TAG, "[httpPost] HTTP " + code + ": " + sb.toString().substring(0, Math.min(200, sb.length())));
             }
+            // No disconnect() here: reading to EOF and closing the stream
+            // returns the socket to HttpURLConnection's keep-alive pool, so
+            // repeated calls to the same host skip TCP+TLS setup.
             return sb.toString();
         } catch (Exception e) {
             Log.e(TAG, "[httpPost] failed", e);
-            return "{\"error\":\"" + e.getMessage().replace("\"", "\\\"") + "\"}";
-        } finally {
+            // A failed exchange leaves the socket in an unknown state —
+            // kill it rather than hand it back to the keep-alive pool.
             if (conn != null) conn.disconnect();
+            return "{\"error\":\"" + e.getMessage().replace("\"", "\\\"") + "\"}";
+        }
+    }
+
+    // Shared pool for nativeHttpPostBatch. Four workers: HttpURLConnection
+    // keeps at most five idle sockets per host (http.maxConnections), so a
+    // wider pool would stop reusing warm connections anyway.
+    private static final ExecutorService sHttpPool = Executors.newFixedThreadPool(4, r -> {
+        Thread t = new Thread(r, "HttpBatch");
+        t.setDaemon(true);
+        return t;
+    });
+
+    /**
+     * Fan several POSTs out to sHttpPool and block until all complete.
+     * requestsJson is a JSON array of {"url", "headers", "body"} objects;
+     * returns a JSON array of response bodies in request order. A failed
+     * request yields the same {"error":...} shape as nativeHttpPost without
+     * aborting its siblings.
+     */
+    public static String nativeHttpPostBatch(String requestsJson) {
+        try {
+            JSONArray requests = new JSONArray(requestsJson);
+            List<Future<String>> futures = new ArrayList<>(requests.length());
+            for (int i = 0; i < requests.length(); i++) {
+                JSONObject req = requests.getJSONObject(i);
+                final String url = req.getString("url");
+                final String headers = req.has("headers")
+                        ? req.getJSONObject("headers").toString() : "{}";
+                final String body = req.optString("body", "");
+                futures.add(sHttpPool.submit(() -> nativeHttpPost(url, headers, body)));
+            }
+            JSONArray responses = new JSONArray();
+            for (Future<String> f : futures) {
+                responses.put(f.get());
+            }
+            return responses.toString();
+        } catch (Exception e) {
+            Log.e(TAG, "[httpPostBatch] failed", e);
+            return "{\"error\":\"" + e.getMessage().replace("\"", "\\\"") + "\"}";
         }
     }
 
@@ -154,14 +352,19 @@ public class HermesRuntime {
     static native boolean nativeTtsLoadModel(String modelDir);
     static native short[] nativeTtsGenerate(String tokenIds, String speaker, String language);
     static native void nativeTtsGenerateStream(String tokenIds, String speaker, String language,
-                                                int chunkSize, TtsStreamCallback callback);
+                                                int chunkSize, boolean directSink,
+                                                TtsStreamCallback callback);
     static native boolean nativeTtsIsLoaded();
     static native void nativeTtsFree();
     static native int nativeTtsVerifyIncremental(String tokenIds, String speaker, String language);
 
     /** Callback interface for streaming TTS audio delivery. */
     public interface TtsStreamCallback {
-        /** Called with each chunk of PCM int16 samples at 24kHz mono. */
+        /**
+         * Called with each chunk of PCM int16 samples at 24kHz mono.
+         * Not called in direct-sink mode, where native code plays the
+         * float PCM through AAudio and only lifecycle events cross JNI.
+         */
         void onAudioChunk(short[] samples, int numSamples);
         /** Called when generation completes successfully. */
         void onComplete(int totalSamples, long elapsedMs);
@@ -249,41 +452,28 @@ public class HermesRuntime {
             String tokenIds = sBpeTokenizer.tokenizeForTts(text);
             Log.i(TAG, "[speak] Tokenized: " + tokenIds.length() + " chars");
 
-            // 4. Stream generate + play via AudioTrack MODE_STREAM
+            // 4. Stream generate. Preferred path: native AAudio sink — PCM
+            // never crosses JNI and onComplete fires after playback drains.
+            // The AudioTrack below is created lazily only when the native
+            // sink is unavailable (API < 26) and chunks arrive via
+            // onAudioChunk.
             nativeUpdateStatus("Generating speech...");
             final int sampleRate = 24000;
-            int bufSize = AudioTrack.getMinBufferSize(sampleRate,
-                    AudioFormat.CHANNEL_OUT_MONO,
-                    AudioFormat.ENCODING_PCM_16BIT);
-            /* Large buffer (4s) so track.write() doesn't block the inference thread.
-             * Each streaming chunk is ~9600 samples (19,200 bytes / 400ms).
-             * With 4s buffer, ~10 chunks can queue without blocking. */
-            bufSize = Math.max(bufSize, sampleRate * 2 * 4); /* 4 seconds */
-
-            final AudioTrack track = new AudioTrack.Builder()
-                    .setAudioAttributes(new AudioAttributes.Builder()
-                            .setUsage(AudioAttributes.USAGE_ASSISTANT)
-                            .setContentType(AudioAttributes.CONTENT_TYPE_SPEECH)
-                            .build())
-                    .setAudioFormat(new AudioFormat.Builder()
-                            .setSampleRate(sampleRate)
-                            .setChannelMask(AudioFormat.CHANNEL_OUT_MONO)
-                            .setEncoding(AudioFormat.ENCODING_PCM_16BIT)
-                            .build())
-                    .setBufferSizeInBytes(bufSize)
-                    .setTransferMode(AudioTrack.MODE_STREAM)
-                    .build();
-
-            track.play();
-            nativeUpdateStatus("Speaking...");
-
+            final AudioTrack[] trackHolder = {null};
             final int[] totalSamples = {0};
             final CountDownLatch doneLatch = new CountDownLatch(1);
             final AtomicBoolean genSuccess = new AtomicBoolean(false);
 
-            nativeTtsGenerateStream(tokenIds, speaker, language, 5, new TtsStreamCallback() {
+            nativeUpdateStatus("Speaking...");
+            nativeTtsGenerateStream(tokenIds, speaker, language, 5, true, new TtsStreamCallback() {
                 @Override
                 public void onAudioChunk(short[] samples, int numSamples) {
+                    AudioTrack track = trackHolder[0];
+                    if (track == null) {
+                        track = buildFallbackTrack(sampleRate);
+                        trackHolder[0] = track;
+                        track.play();
+                    }
                     track.write(samples, 0, numSamples);
                     totalSamples[0] += numSamples;
                 }
@@ -304,20 +494,23 @@ public class HermesRuntime {
 
             doneLatch.await();
 
-            // Wait for AudioTrack to finish playing all buffered audio.
-            // With the large buffer, generation may finish well before playback.
-            if (totalSamples[0] > 0) {
-                int played = track.getPlaybackHeadPosition();
-                int remaining = totalSamples[0] - played;
-                if (remaining > 0) {
-                    long waitMs = (long)(remaining * 1000.0 / sampleRate) + 200;
-                    Thread.sleep(waitMs);
+            // Fallback AudioTrack drain: with the large buffer, generation
+            // may finish well before playback. The native sink path drains
+            // before onComplete, so trackHolder stays null there.
+            AudioTrack track = trackHolder[0];
+            if (track != null) {
+                if (totalSamples[0] > 0) {
+                    int played = track.getPlaybackHeadPosition();
+                    int remaining = totalSamples[0] - played;
+                    if (remaining > 0) {
+                        long waitMs = (long)(remaining * 1000.0 / sampleRate) + 200;
+                        Thread.sleep(waitMs);
+                    }
                 }
+                track.stop();
+                track.release();
             }
 
-            track.stop();
-            track.release();
-
             return genSuccess.get() ? "true" : "false";
         } catch (Exception e) {
             Log.e(TAG, "[speak] failed", e);
@@ -325,6 +518,31 @@ public class HermesRuntime {
         }
     }
 
+    /** MODE_STREAM AudioTrack for the pre-AAudio playback path. */
+    private static AudioTrack buildFallbackTrack(int sampleRate) {
+        int bufSize = AudioTrack.getMinBufferSize(sampleRate,
+                AudioFormat.CHANNEL_OUT_MONO,
+                AudioFormat.ENCODING_PCM_16BIT);
+        /* Large buffer (4s) so track.write() doesn't block the inference thread.
+         * Each streaming chunk is ~9600 samples (19,200 bytes / 400ms).
+         * With 4s buffer, ~10 chunks can queue without blocking. */
+        bufSize = Math.max(bufSize, sampleRate * 2 * 4); /* 4 seconds */
+
+        return new AudioTrack.Builder()
+                .setAudioAttributes(new AudioAttributes.Builder()
+                        .setUsage(AudioAttributes.USAGE_ASSISTANT)
+                        .setContentType(AudioAttributes.CONTENT_TYPE_SPEECH)
+                        .build())
+                .setAudioFormat(new AudioFormat.Builder()
+                        .setSampleRate(sampleRate)
+                        .setChannelMask(AudioFormat.CHANNEL_OUT_MONO)
+                        .setEncoding(AudioFormat.ENCODING_PCM_16BIT)
+                        .build())
+                .setBufferSizeInBytes(bufSize)
+                .setTransferMode(AudioTrack.MODE_STREAM)
+                .build();
+    }
+
     public static String loadAsset(Context context, String filename) {
         try {
             InputStream is = context.getAssets().open(filename);
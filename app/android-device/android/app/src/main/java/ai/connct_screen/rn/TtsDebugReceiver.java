@@ -332,7 +332,9 @@ public class TtsDebugReceiver extends BroadcastReceiver {
                 Log.i(TAG, "speak_stream: generating (speaker=" + speaker
                         + ", language=" + language + ", chunk_size=" + chunkSize + ")...");
 
-                HermesRuntime.nativeTtsGenerateStream(tokenIds, speaker, language, chunkSize,
+                // Java chunk path (directSink=false): the per-chunk callback is
+                // what produces the TTFA/chunk timing instrumentation below.
+                HermesRuntime.nativeTtsGenerateStream(tokenIds, speaker, language, chunkSize, false,
                         new HermesRuntime.TtsStreamCallback() {
                     @Override
                     public void onAudioChunk(short[] samples, int numSamples) {
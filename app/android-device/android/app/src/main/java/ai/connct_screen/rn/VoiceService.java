@@ -29,9 +29,12 @@ public class VoiceService extends Service {
     private static final int NOTIFICATION_ID = 1001;
 
     private static final int SAMPLE_RATE = 16000;
+    // Preferred capture rate: most devices run the mic at 48kHz natively, so
+    // recording at 48kHz keeps AudioFlinger's resampler out of the path; the
+    // JNI push path converts to 16kHz in C (NEON polyphase FIR).
+    private static final int RECORD_RATE = 48000;
     private static final int CHANNEL_CONFIG = AudioFormat.CHANNEL_IN_MONO;
     private static final int AUDIO_FORMAT = AudioFormat.ENCODING_PCM_16BIT;
-    private static final int CHUNK_SAMPLES = 1600; // 100ms at 16kHz
     private static final long SILENCE_TIMEOUT_MS = 2000;
 
     // Native methods (implemented in qwen_asr_jni.cpp)
@@ -39,17 +42,24 @@ public class VoiceService extends Service {
     public static native void nativeSetCacheDir(String cacheDir);
     public static native boolean nativeLoadModel(String modelDir, int nThreads);
     public static native boolean nativeStartAsr();
+    public static native void nativeSetAudioInputRate(int sampleRate);
     public static native void nativePushAudio(short[] samples, int length);
+    public static native java.nio.ByteBuffer nativeCreateAudioRing(int chunkBytes);
+    public static native void nativeCommitAudio(int bytes);
     public static native void nativeStopAsr();
     public static native void nativeResetAsr();
     public static native void nativeFreeModel();
     public static native void nativeTestWav(String wavPath);
     public static native void nativeTestWavStream(String wavPath);
+    public static native String nativeGetPerfReport();
 
     private static VoiceService sInstance;
     private AudioRecord audioRecord;
     private Thread recordingThread;
     private volatile boolean isRecording;
+    // Native-allocated staging buffer shared with the JNI audio ring;
+    // AudioRecord writes into it directly, so no short[] crosses JNI.
+    private java.nio.ByteBuffer audioRing;
 
     // Text accumulation (accessed on main thread only)
     private final StringBuilder textBuffer = new StringBuilder();
@@ -148,27 +158,47 @@ public class VoiceService extends Service {
         mainHandler.postDelayed(silenceRunnable, SILENCE_TIMEOUT_MS);
     }
 
-    private void startRecording() {
-        if (isRecording) return;
-
-        int bufferSize = AudioRecord.getMinBufferSize(SAMPLE_RATE, CHANNEL_CONFIG, AUDIO_FORMAT);
-        bufferSize = Math.max(bufferSize, CHUNK_SAMPLES * 2); // at least one chunk
+    private boolean initAudioRecord(int rate, int chunkSamples) {
+        int bufferSize = AudioRecord.getMinBufferSize(rate, CHANNEL_CONFIG, AUDIO_FORMAT);
+        if (bufferSize <= 0) return false;
+        bufferSize = Math.max(bufferSize, chunkSamples * 2); // at least one chunk
 
         try {
             audioRecord = new AudioRecord(
                     MediaRecorder.AudioSource.MIC,
-                    SAMPLE_RATE, CHANNEL_CONFIG, AUDIO_FORMAT, bufferSize);
+                    rate, CHANNEL_CONFIG, AUDIO_FORMAT, bufferSize);
         } catch (SecurityException e) {
             Log.e(TAG, "No RECORD_AUDIO permission", e);
-            return;
+            return false;
         }
 
         if (audioRecord.getState() != AudioRecord.STATE_INITIALIZED) {
-            Log.e(TAG, "AudioRecord failed to initialize");
             audioRecord.release();
             audioRecord = null;
-            return;
+            return false;
+        }
+        return true;
+    }
+
+    private void startRecording() {
+        if (isRecording) return;
+
+        // Capture at the native rate when possible; the C side resamples.
+        int rate = RECORD_RATE;
+        if (!initAudioRecord(rate, rate / 10)) {
+            rate = SAMPLE_RATE;
+            if (!initAudioRecord(rate, rate / 10)) {
+                Log.e(TAG, "AudioRecord failed to initialize");
+                return;
+            }
         }
+        final int chunkSamples = rate / 10; // 100ms chunks
+        nativeSetAudioInputRate(rate);
+
+        // Zero-copy path: AudioRecord reads into the native staging buffer
+        // and nativeCommitAudio publishes it lock-free. Must exist before
+        // nativeStartAsr so the native pump thread starts with it.
+        audioRing = nativeCreateAudioRing(chunkSamples * 2);
 
         // Start native ASR
         if (!nativeStartAsr()) {
@@ -182,17 +212,29 @@ public class VoiceService extends Service {
         audioRecord.startRecording();
 
         recordingThread = new Thread(() -> {
-            short[] buffer = new short[CHUNK_SAMPLES];
-            while (isRecording) {
-                int read = audioRecord.read(buffer, 0, CHUNK_SAMPLES);
-                if (read > 0) {
-                    nativePushAudio(buffer, read);
+            if (audioRing != null) {
+                final int chunkBytes = chunkSamples * 2;
+                while (isRecording) {
+                    audioRing.clear();
+                    int read = audioRecord.read(audioRing, chunkBytes);
+                    if (read > 0) {
+                        nativeCommitAudio(read);
+                    }
+                }
+            } else {
+                // Fallback: ring allocation failed, push via jshortArray
+                short[] buffer = new short[chunkSamples];
+                while (isRecording) {
+                    int read = audioRecord.read(buffer, 0, chunkSamples);
+                    if (read > 0) {
+                        nativePushAudio(buffer, read);
+                    }
                 }
             }
         }, "AudioRecordThread");
         recordingThread.start();
 
-        Log.i(TAG, "Recording started");
+        Log.i(TAG, "Recording started at " + rate + " Hz");
     }
 
     private void stopRecording() {
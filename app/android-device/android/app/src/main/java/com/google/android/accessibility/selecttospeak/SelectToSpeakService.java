@@ -94,6 +94,10 @@ public class SelectToSpeakService extends AccessibilityService {
         WifiManager wm = (WifiManager) getApplicationContext().getSystemService(Context.WIFI_SERVICE);
         wifiLock = wm.createWifiLock(WifiManager.WIFI_MODE_FULL_HIGH_PERF, "RNAgent:ws");
         wifiLock.acquire();
+        // Pre-warm Hermes runtimes off the critical path: the first exec_js of
+        // each agent type then pays dispatch only, not runtime construction +
+        // tool registration + bundle evaluation.
+        ai.connct_screen.rn.HermesRuntime.prewarmRuntimes(getApplicationContext());
         Log.d(TAG, "SelectToSpeakService connected, WiFi lock acquired");
         Log.d(AGENT_TAG, "SelectToSpeakService connected - agent ready");
     }
@@ -116,13 +120,28 @@ public class SelectToSpeakService extends AccessibilityService {
 
     // ========== Screenshot ==========
 
-    public String takeScreenshotSync() {
+    /** Error message from the most recent failed takeScreenshotJpegSync() call. */
+    private volatile String lastScreenshotError = "ERROR: no screenshot taken";
+
+    public String getLastScreenshotError() {
+        return lastScreenshotError;
+    }
+
+    /**
+     * Capture the screen as scaled JPEG bytes (720px wide, q=80).
+     * Returns null on failure; see getLastScreenshotError(). The raw bytes
+     * are handed to JS as an ArrayBuffer — Base64 is applied lazily when
+     * the LLM payload is built, not per capture.
+     */
+    public byte[] takeScreenshotJpegSync() {
         if (Build.VERSION.SDK_INT < Build.VERSION_CODES.R) {
-            return "ERROR: takeScreenshot requires API 30+";
+            lastScreenshotError = "ERROR: takeScreenshot requires API 30+";
+            return null;
         }
 
         final CountDownLatch latch = new CountDownLatch(1);
-        final String[] resultHolder = { null };
+        final byte[][] resultHolder = { null };
+        final String[] errorHolder = { null };
 
         takeScreenshot(Display.DEFAULT_DISPLAY,
                 getMainExecutor(),
@@ -135,7 +154,7 @@ public class SelectToSpeakService extends AccessibilityService {
                                     screenshot.getColorSpace());
                             hwBuffer.close();
                             if (hwBitmap == null) {
-                                resultHolder[0] = "ERROR: wrapHardwareBuffer returned null";
+                                errorHolder[0] = "ERROR: wrapHardwareBuffer returned null";
                                 latch.countDown();
                                 return;
                             }
@@ -153,32 +172,46 @@ public class SelectToSpeakService extends AccessibilityService {
                             scaled.compress(Bitmap.CompressFormat.JPEG, 80, baos);
                             scaled.recycle();
 
-                            resultHolder[0] = Base64.encodeToString(baos.toByteArray(), Base64.NO_WRAP);
-                            Log.d(AGENT_TAG, "[SCREENSHOT] captured, base64 length=" + resultHolder[0].length());
+                            resultHolder[0] = baos.toByteArray();
+                            Log.d(AGENT_TAG, "[SCREENSHOT] captured, jpeg bytes=" + resultHolder[0].length);
                         } catch (Exception e) {
-                            resultHolder[0] = "ERROR: " + e.getMessage();
+                            errorHolder[0] = "ERROR: " + e.getMessage();
                         }
                         latch.countDown();
                     }
 
                     @Override
                     public void onFailure(int errorCode) {
-                        resultHolder[0] = "ERROR: takeScreenshot failed, code=" + errorCode;
+                        errorHolder[0] = "ERROR: takeScreenshot failed, code=" + errorCode;
                         latch.countDown();
                     }
                 });
 
         try {
             boolean ok = latch.await(10, java.util.concurrent.TimeUnit.SECONDS);
-            if (!ok) return "ERROR: takeScreenshot timed out (10s)";
+            if (!ok) {
+                lastScreenshotError = "ERROR: takeScreenshot timed out (10s)";
+                return null;
+            }
         } catch (InterruptedException e) {
             Thread.currentThread().interrupt();
-            return "ERROR: takeScreenshot interrupted";
+            lastScreenshotError = "ERROR: takeScreenshot interrupted";
+            return null;
         }
 
+        if (resultHolder[0] == null) {
+            lastScreenshotError = errorHolder[0] != null ? errorHolder[0] : "ERROR: screenshot failed";
+            return null;
+        }
         return resultHolder[0];
     }
 
+    public String takeScreenshotSync() {
+        byte[] jpeg = takeScreenshotJpegSync();
+        if (jpeg == null) return lastScreenshotError;
+        return Base64.encodeToString(jpeg, Base64.NO_WRAP);
+    }
+
     // ========== Delegated methods (maintain API for AppToolsHost) ==========
 
     public String getAccessibilityTree() {
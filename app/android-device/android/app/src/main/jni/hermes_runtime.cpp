@@ -12,6 +12,16 @@
 #include "tools_app.h"
 #include "tools_browser.h"
 
+#include <android/asset_manager.h>
+#include <android/asset_manager_jni.h>
+#include <jsi/instrumentation.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 using namespace facebook::jsi;
 using namespace facebook::hermes;
 
@@ -22,6 +32,9 @@ using namespace facebook::hermes;
 JavaVM* g_jvm = nullptr;
 CommonJniCache g_common_cache = {};
 std::unordered_map<std::string, RuntimeEntry> g_runtimes;
+// Guards g_runtimes map operations: the pre-warm thread creates runtimes
+// while per-connection exec threads look theirs up.
+std::mutex g_runtimes_mu;
 
 // ---------------------------------------------------------------------------
 // Helpers
@@ -43,10 +56,238 @@ std::string jstringToStd(JNIEnv* env, jstring js) {
     return result;
 }
 
+// Per-thread transcode buffer. Host calls run on a handful of long-lived
+// exec threads, so the capacity converges on the largest payload seen
+// (typically the LLM response body) and the GetStringUTFChars malloc/free
+// pair disappears from the per-call cost.
+static std::string& scratchBuf() {
+    static thread_local std::string buf;
+    return buf;
+}
+
+const std::string& jstringToScratch(JNIEnv* env, jstring js) {
+    std::string& buf = scratchBuf();
+    buf.clear();
+    if (!js) return buf;
+    jsize utf16Len = env->GetStringLength(js);
+    jsize utf8Len = env->GetStringUTFLength(js);
+    buf.resize((size_t)utf8Len + 1);  // some VMs NUL-terminate the region copy
+    env->GetStringUTFRegion(js, 0, utf16Len, &buf[0]);
+    buf.resize((size_t)utf8Len);
+    return buf;
+}
+
+String jstringToJsi(JNIEnv* env, Runtime& rt, jstring js) {
+    const std::string& buf = jstringToScratch(env, js);
+    return String::createFromUtf8(
+        rt, reinterpret_cast<const uint8_t*>(buf.data()), buf.size());
+}
+
+// ---------------------------------------------------------------------------
+// JSON → JSI builder
+// ---------------------------------------------------------------------------
+// Builds jsi::Object/Array results directly from a JSON byte buffer, so tools
+// that produce structured data hand JS a ready object instead of a string the
+// script must JSON.parse — one UTF-8 scan in native code, no intermediate JS
+// string allocation.
+
+namespace {
+
+struct JsonCursor {
+    const char* p;
+    const char* end;
+
+    void skipWs() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    }
+    bool consume(char c) {
+        if (p < end && *p == c) { ++p; return true; }
+        return false;
+    }
+    bool match(const char* lit, size_t n) {
+        if ((size_t)(end - p) < n || memcmp(p, lit, n) != 0) return false;
+        p += n;
+        return true;
+    }
+};
+
+bool parseJsonValue(Runtime& rt, JsonCursor& c, Value& out);
+
+// Decode a JSON string literal (opening quote already consumed) into buf.
+bool parseJsonStringBody(JsonCursor& c, std::string& buf) {
+    buf.clear();
+    while (c.p < c.end) {
+        char ch = *c.p++;
+        if (ch == '"') return true;
+        if (ch != '\\') { buf += ch; continue; }
+        if (c.p >= c.end) return false;
+        char esc = *c.p++;
+        switch (esc) {
+            case '"': buf += '"'; break;
+            case '\\': buf += '\\'; break;
+            case '/': buf += '/'; break;
+            case 'b': buf += '\b'; break;
+            case 'f': buf += '\f'; break;
+            case 'n': buf += '\n'; break;
+            case 'r': buf += '\r'; break;
+            case 't': buf += '\t'; break;
+            case 'u': {
+                if (c.end - c.p < 4) return false;
+                unsigned cp = 0;
+                for (int i = 0; i < 4; i++) {
+                    char h = *c.p++;
+                    cp <<= 4;
+                    if (h >= '0' && h <= '9') cp |= (unsigned)(h - '0');
+                    else if (h >= 'a' && h <= 'f') cp |= (unsigned)(h - 'a' + 10);
+                    else if (h >= 'A' && h <= 'F') cp |= (unsigned)(h - 'A' + 10);
+                    else return false;
+                }
+                // Surrogate pair → single code point
+                if (cp >= 0xD800 && cp <= 0xDBFF && c.end - c.p >= 6 &&
+                    c.p[0] == '\\' && c.p[1] == 'u') {
+                    unsigned lo = 0;
+                    bool ok = true;
+                    for (int i = 2; i < 6; i++) {
+                        char h = c.p[i];
+                        lo <<= 4;
+                        if (h >= '0' && h <= '9') lo |= (unsigned)(h - '0');
+                        else if (h >= 'a' && h <= 'f') lo |= (unsigned)(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') lo |= (unsigned)(h - 'A' + 10);
+                        else { ok = false; break; }
+                    }
+                    if (ok && lo >= 0xDC00 && lo <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                        c.p += 6;
+                    }
+                }
+                // UTF-8 encode
+                if (cp < 0x80) {
+                    buf += (char)cp;
+                } else if (cp < 0x800) {
+                    buf += (char)(0xC0 | (cp >> 6));
+                    buf += (char)(0x80 | (cp & 0x3F));
+                } else if (cp < 0x10000) {
+                    buf += (char)(0xE0 | (cp >> 12));
+                    buf += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    buf += (char)(0x80 | (cp & 0x3F));
+                } else {
+                    buf += (char)(0xF0 | (cp >> 18));
+                    buf += (char)(0x80 | ((cp >> 12) & 0x3F));
+                    buf += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    buf += (char)(0x80 | (cp & 0x3F));
+                }
+                break;
+            }
+            default: return false;
+        }
+    }
+    return false;  // unterminated
+}
+
+bool parseJsonValue(Runtime& rt, JsonCursor& c, Value& out) {
+    c.skipWs();
+    if (c.p >= c.end) return false;
+    char ch = *c.p;
+
+    if (ch == '{') {
+        ++c.p;
+        Object obj(rt);
+        c.skipWs();
+        if (c.consume('}')) { out = Value(rt, obj); return true; }
+        std::string key;
+        for (;;) {
+            c.skipWs();
+            if (!c.consume('"') || !parseJsonStringBody(c, key)) return false;
+            c.skipWs();
+            if (!c.consume(':')) return false;
+            Value v;
+            if (!parseJsonValue(rt, c, v)) return false;
+            obj.setProperty(rt, key.c_str(), v);
+            c.skipWs();
+            if (c.consume(',')) continue;
+            if (c.consume('}')) break;
+            return false;
+        }
+        out = Value(rt, obj);
+        return true;
+    }
+
+    if (ch == '[') {
+        ++c.p;
+        // Two-pass sizing would need a second scan; grow via a JS-side push
+        // equivalent instead: collect into a vector, then one sized Array.
+        std::vector<Value> items;
+        c.skipWs();
+        if (!c.consume(']')) {
+            for (;;) {
+                Value v;
+                if (!parseJsonValue(rt, c, v)) return false;
+                items.emplace_back(std::move(v));
+                c.skipWs();
+                if (c.consume(',')) continue;
+                if (c.consume(']')) break;
+                return false;
+            }
+        }
+        Array arr(rt, items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            arr.setValueAtIndex(rt, i, items[i]);
+        }
+        out = Value(rt, arr);
+        return true;
+    }
+
+    if (ch == '"') {
+        ++c.p;
+        std::string s;
+        if (!parseJsonStringBody(c, s)) return false;
+        out = Value(rt, String::createFromUtf8(
+            rt, reinterpret_cast<const uint8_t*>(s.data()), s.size()));
+        return true;
+    }
+
+    if (c.match("true", 4))  { out = Value(true);  return true; }
+    if (c.match("false", 5)) { out = Value(false); return true; }
+    if (c.match("null", 4))  { out = Value::null(); return true; }
+
+    // Number: strtod accepts a superset of JSON numbers, which is fine here —
+    // the input comes from our own Java/C++ serializers, not untrusted text.
+    char* numEnd = nullptr;
+    double num = strtod(c.p, &numEnd);
+    if (numEnd == c.p || numEnd > c.end) return false;
+    c.p = numEnd;
+    out = Value(num);
+    return true;
+}
+
+}  // namespace
+
+Value jsonToJsi(Runtime& rt, const char* data, size_t size) {
+    JsonCursor c{data, data + size};
+    Value out;
+    if (!parseJsonValue(rt, c, out)) {
+        // Malformed input: hand JS the raw string so nothing is lost.
+        return Value(rt, String::createFromUtf8(
+            rt, reinterpret_cast<const uint8_t*>(data), size));
+    }
+    c.skipWs();
+    if (c.p != c.end) {
+        return Value(rt, String::createFromUtf8(
+            rt, reinterpret_cast<const uint8_t*>(data), size));
+    }
+    return out;
+}
+
+Value jstringJsonToJsi(JNIEnv* env, Runtime& rt, jstring js) {
+    const std::string& buf = jstringToScratch(env, js);
+    return jsonToJsi(rt, buf.data(), buf.size());
+}
+
 static void resolveCommonJniCache(JNIEnv* env) {
     jclass cls = env->FindClass("ai/connct_screen/rn/HermesRuntime");
     g_common_cache.clazz        = (jclass)env->NewGlobalRef(cls);
     g_common_cache.httpPost     = env->GetStaticMethodID(cls, "nativeHttpPost",     "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;");
+    g_common_cache.httpPostBatch = env->GetStaticMethodID(cls, "nativeHttpPostBatch", "(Ljava/lang/String;)Ljava/lang/String;");
     g_common_cache.appendLog    = env->GetStaticMethodID(cls, "nativeAppendLog",    "(Ljava/lang/String;)V");
     g_common_cache.updateStatus = env->GetStaticMethodID(cls, "nativeUpdateStatus", "(Ljava/lang/String;)V");
     g_common_cache.askUser      = env->GetStaticMethodID(cls, "nativeAskUser",      "(Ljava/lang/String;)Ljava/lang/String;");
@@ -56,6 +297,88 @@ static void resolveCommonJniCache(JNIEnv* env) {
     env->DeleteLocalRef(cls);
 }
 
+// ---------------------------------------------------------------------------
+// Asset bundle loading
+// ---------------------------------------------------------------------------
+
+// jsi::Buffer over an mmap'd region of the APK. Hermes executes precompiled
+// bytecode (.hbc) in place, so pages are faulted in on demand and shared
+// across runtimes — no copy, no parse+compile. The shared_ptr handed to
+// evaluateJavaScript keeps the mapping alive as long as Hermes needs it.
+class MmapBuffer : public Buffer {
+public:
+    MmapBuffer(void* map, size_t mapSize, size_t dataOffset, size_t dataSize)
+        : map_(map), mapSize_(mapSize), dataOffset_(dataOffset), dataSize_(dataSize) {}
+    ~MmapBuffer() override { munmap(map_, mapSize_); }
+    size_t size() const override { return dataSize_; }
+    const uint8_t* data() const override {
+        return static_cast<const uint8_t*>(map_) + dataOffset_;
+    }
+private:
+    void* map_;
+    size_t mapSize_;
+    size_t dataOffset_;
+    size_t dataSize_;
+};
+
+// Open an asset and wrap it in a jsi::Buffer. Uncompressed assets (the .hbc
+// bundles are excluded from compression in build.gradle) are mmap'd straight
+// from the APK; compressed ones fall back to a one-time copy.
+static std::shared_ptr<const Buffer> bufferFromAsset(AAssetManager* am, const char* name) {
+    AAsset* asset = AAssetManager_open(am, name, AASSET_MODE_RANDOM);
+    if (!asset) return nullptr;
+
+    off64_t start = 0, length = 0;
+    int fd = AAsset_openFileDescriptor64(asset, &start, &length);
+    if (fd >= 0) {
+        size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        off64_t mapStart = start - (start % pageSize);
+        size_t delta = (size_t)(start - mapStart);
+        size_t mapSize = (size_t)length + delta;
+        void* map = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, mapStart);
+        close(fd);
+        if (map != MAP_FAILED) {
+            AAsset_close(asset);
+            return std::make_shared<MmapBuffer>(map, mapSize, delta, (size_t)length);
+        }
+        LOGE("mmap failed for asset %s, falling back to copy", name);
+    }
+
+    // Compressed asset (or mmap failure): copy the contents
+    const void* data = AAsset_getBuffer(asset);
+    if (!data) {
+        AAsset_close(asset);
+        return nullptr;
+    }
+    auto buffer = std::make_shared<StringBuffer>(
+        std::string(static_cast<const char*>(data), (size_t)AAsset_getLength64(asset)));
+    AAsset_close(asset);
+    return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Instrumentation helpers
+// ---------------------------------------------------------------------------
+
+// Heap counters from jsi::Instrumentation as a flat JSON object, e.g.
+// {"hermes_allocatedBytes":...,"hermes_heapSize":...}. Cheap enough to call
+// per agent step.
+static std::string heapInfoJson(Runtime& rt) {
+    auto info = rt.instrumentation().getHeapInfo(/* includeExpensive */ false);
+    std::string json = "{";
+    bool first = true;
+    for (const auto& kv : info) {
+        if (!first) json += ",";
+        first = false;
+        json += "\"";
+        json += kv.first;
+        json += "\":";
+        json += std::to_string(kv.second);
+    }
+    json += "}";
+    return json;
+}
+
 // ---------------------------------------------------------------------------
 // Common host functions (shared by all agent types)
 // ---------------------------------------------------------------------------
@@ -75,12 +398,34 @@ void registerCommonTools(Runtime& rt) {
                 jstring jbody = env->NewStringUTF(body.c_str());
                 jstring result = (jstring)env->CallStaticObjectMethod(
                     g_common_cache.clazz, g_common_cache.httpPost, jurl, jheaders, jbody);
-                std::string str = jstringToStd(env, result);
+                // Response bodies run to hundreds of KB — go straight from
+                // the jstring into the JS heap via the scratch buffer.
+                String str = jstringToJsi(env, rt, result);
                 env->DeleteLocalRef(jurl);
                 env->DeleteLocalRef(jheaders);
                 env->DeleteLocalRef(jbody);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
+            }));
+
+    // http_post_batch(requestsJson) -> string (JSON array of response bodies)
+    // requestsJson is a JSON array of {url, headers, body}. The Java side
+    // fans the requests out to a shared thread pool and joins, so independent
+    // round-trips (main LLM + embeddings, racing providers) overlap while JS
+    // keeps its synchronous one-call semantics.
+    rt.global().setProperty(rt, "http_post_batch",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "http_post_batch"), 1,
+            [](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
+                if (count < 1) return String::createFromUtf8(rt, "{\"error\":\"need requests json\"}");
+                JNIEnv* env = getEnv();
+                std::string requests = args[0].asString(rt).utf8(rt);
+                jstring jrequests = env->NewStringUTF(requests.c_str());
+                jstring result = (jstring)env->CallStaticObjectMethod(
+                    g_common_cache.clazz, g_common_cache.httpPostBatch, jrequests);
+                String str = jstringToJsi(env, rt, result);
+                env->DeleteLocalRef(jrequests);
+                if (result) env->DeleteLocalRef(result);
+                return str;
             }));
 
     // log(msg) -> undefined
@@ -130,10 +475,10 @@ void registerCommonTools(Runtime& rt) {
                 std::string question = args[0].asString(rt).utf8(rt);
                 jstring jquestion = env->NewStringUTF(question.c_str());
                 jstring result = (jstring)env->CallStaticObjectMethod(g_common_cache.clazz, g_common_cache.askUser, jquestion);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 env->DeleteLocalRef(jquestion);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // hide_overlay() -> undefined
@@ -145,6 +490,49 @@ void registerCommonTools(Runtime& rt) {
                 return Value::undefined();
             }));
 
+    // base64_encode(arrayBuffer) -> string
+    // Companion to the ArrayBuffer byte paths (e.g. take_screenshot_jpeg):
+    // lets JS defer Base64 until the bytes actually go into an LLM payload.
+    rt.global().setProperty(rt, "base64_encode",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "base64_encode"), 1,
+            [](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
+                if (count < 1 || !args[0].isObject() ||
+                    !args[0].asObject(rt).isArrayBuffer(rt)) {
+                    return String::createFromUtf8(rt, "");
+                }
+                auto buf = args[0].asObject(rt).getArrayBuffer(rt);
+                const uint8_t* data = buf.data(rt);
+                size_t n = buf.size(rt);
+                static const char tbl[] =
+                    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+                std::string out;
+                out.reserve(((n + 2) / 3) * 4);
+                for (size_t i = 0; i < n; i += 3) {
+                    uint32_t v = (uint32_t)data[i] << 16;
+                    if (i + 1 < n) v |= (uint32_t)data[i + 1] << 8;
+                    if (i + 2 < n) v |= (uint32_t)data[i + 2];
+                    out += tbl[(v >> 18) & 63];
+                    out += tbl[(v >> 12) & 63];
+                    out += (i + 1 < n) ? tbl[(v >> 6) & 63] : '=';
+                    out += (i + 2 < n) ? tbl[v & 63] : '=';
+                }
+                return String::createFromUtf8(rt, out);
+            }));
+
+    // get_heap_info() -> object of heap counters
+    // Lets the agent loop log GC pressure per step without a debugger. Built
+    // as a JSI object directly — no JSON round-trip for a native map.
+    rt.global().setProperty(rt, "get_heap_info",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "get_heap_info"), 0,
+            [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
+                auto info = rt.instrumentation().getHeapInfo(/* includeExpensive */ false);
+                Object obj(rt);
+                for (const auto& kv : info) {
+                    obj.setProperty(rt, kv.first.c_str(), (double)kv.second);
+                }
+                return Value(rt, obj);
+            }));
+
     // speak(text, speaker?, language?) -> bool
     rt.global().setProperty(rt, "speak",
         Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "speak"), 3,
@@ -165,7 +553,7 @@ void registerCommonTools(Runtime& rt) {
                 }
                 jstring result = (jstring)env->CallStaticObjectMethod(
                     g_common_cache.clazz, g_common_cache.speak, jtext, jspeaker, jlanguage);
-                std::string str = jstringToStd(env, result);
+                const std::string& str = jstringToScratch(env, result);
                 env->DeleteLocalRef(jtext);
                 if (jspeaker) env->DeleteLocalRef(jspeaker);
                 if (jlanguage) env->DeleteLocalRef(jlanguage);
@@ -201,13 +589,21 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeCreateRuntime(JNIEnv* env, jclass,
     }
 
     // Destroy existing runtime for this agent type if any
-    auto it = g_runtimes.find(agentType);
-    if (it != g_runtimes.end()) {
-        LOGI("Destroying existing runtime for agent type: %s", agentType.c_str());
-        g_runtimes.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(g_runtimes_mu);
+        auto it = g_runtimes.find(agentType);
+        if (it != g_runtimes.end()) {
+            LOGI("Destroying existing runtime for agent type: %s", agentType.c_str());
+            g_runtimes.erase(it);
+        }
     }
 
-    auto runtime = makeHermesRuntime();
+    // Sample profiling must be opted into at construction for the runtime to
+    // register with Hermes' global sampling profiler; the overhead is only
+    // paid while nativeStartSamplingProfiler is active.
+    auto runtime = makeHermesRuntime(::hermes::vm::RuntimeConfig::Builder()
+                                         .withEnableSampleProfiling(true)
+                                         .build());
     Runtime& rt = *runtime;
 
     // Register common tools
@@ -223,7 +619,10 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeCreateRuntime(JNIEnv* env, jclass,
     RuntimeEntry entry;
     entry.runtime = std::move(runtime);
     entry.agentType = agentType;
-    g_runtimes[agentType] = std::move(entry);
+    {
+        std::lock_guard<std::mutex> lock(g_runtimes_mu);
+        g_runtimes[agentType] = std::move(entry);
+    }
 
     LOGI("Hermes runtime created for agent type: %s", agentType.c_str());
 }
@@ -231,12 +630,17 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeCreateRuntime(JNIEnv* env, jclass,
 JNIEXPORT jstring JNICALL
 Java_ai_connct_1screen_rn_HermesRuntime_nativeEvaluateJS(JNIEnv* env, jclass, jstring jAgentType, jstring jsCode, jstring sourceURL) {
     std::string agentType = jstringToStd(env, jAgentType);
-    auto it = g_runtimes.find(agentType);
-    if (it == g_runtimes.end() || !it->second.runtime) {
+    RuntimeEntry* entry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_runtimes_mu);
+        auto it = g_runtimes.find(agentType);
+        if (it != g_runtimes.end()) entry = &it->second;
+    }
+    if (!entry) {
         return env->NewStringUTF("{\"error\":\"Runtime not created\"}");
     }
 
-    auto& runtime = it->second.runtime;
+    auto* runtime = entry->runtime.get();
     std::string code = jstringToStd(env, jsCode);
     std::string url = jstringToStd(env, sourceURL);
 
@@ -257,12 +661,15 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeEvaluateJS(JNIEnv* env, jclass, js
         } else if (result.isNull()) {
             return env->NewStringUTF("null");
         } else {
-            // For objects, try JSON.stringify
+            // For objects, try JSON.stringify (resolved once per runtime)
             try {
-                auto json = runtime->global()
-                    .getPropertyAsObject(*runtime, "JSON")
-                    .getPropertyAsFunction(*runtime, "stringify")
-                    .call(*runtime, result);
+                if (!entry->jsonStringify) {
+                    entry->jsonStringify = std::make_shared<Function>(
+                        runtime->global()
+                            .getPropertyAsObject(*runtime, "JSON")
+                            .getPropertyAsFunction(*runtime, "stringify"));
+                }
+                auto json = entry->jsonStringify->call(*runtime, result);
                 if (json.isString()) {
                     std::string str = json.asString(*runtime).utf8(*runtime);
                     return env->NewStringUTF(str.c_str());
@@ -281,10 +688,89 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeEvaluateJS(JNIEnv* env, jclass, js
     }
 }
 
+JNIEXPORT jboolean JNICALL
+Java_ai_connct_1screen_rn_HermesRuntime_nativeEvaluateAsset(JNIEnv* env, jclass, jstring jAgentType, jobject jAssetManager, jstring jAssetName) {
+    std::string agentType = jstringToStd(env, jAgentType);
+    std::string assetName = jstringToStd(env, jAssetName);
+
+    HermesRuntime* runtime = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_runtimes_mu);
+        auto it = g_runtimes.find(agentType);
+        if (it != g_runtimes.end()) runtime = it->second.runtime.get();
+    }
+    if (!runtime) {
+        LOGE("nativeEvaluateAsset: runtime not created for %s", agentType.c_str());
+        return JNI_FALSE;
+    }
+
+    AAssetManager* am = AAssetManager_fromJava(env, jAssetManager);
+    auto buffer = am ? bufferFromAsset(am, assetName.c_str()) : nullptr;
+    if (!buffer) {
+        // Missing asset is expected when the bundle wasn't precompiled;
+        // the caller falls back to the .js source.
+        LOGI("Asset %s not available", assetName.c_str());
+        return JNI_FALSE;
+    }
+
+    try {
+        runtime->evaluateJavaScript(buffer, assetName);
+        LOGI("Evaluated %s (%zu bytes) for agent type: %s",
+             assetName.c_str(), buffer->size(), agentType.c_str());
+        return JNI_TRUE;
+    } catch (const JSError& e) {
+        LOGE("[JS Error] evaluating %s: %s", assetName.c_str(), e.what());
+        return JNI_FALSE;
+    } catch (const std::exception& e) {
+        LOGE("[Native Error] evaluating %s: %s", assetName.c_str(), e.what());
+        return JNI_FALSE;
+    }
+}
+
+// Global sampling profiler: samples JS stacks across all runtimes created
+// with sample profiling enabled. Start/stop around a slow agent loop, then
+// pull the trace (Chrome DevTools "Performance" loads it) via run-as.
+JNIEXPORT void JNICALL
+Java_ai_connct_1screen_rn_HermesRuntime_nativeStartSamplingProfiler(JNIEnv*, jclass) {
+    HermesRuntime::enableSamplingProfiler();
+    LOGI("Sampling profiler started");
+}
+
+JNIEXPORT jboolean JNICALL
+Java_ai_connct_1screen_rn_HermesRuntime_nativeStopSamplingProfiler(JNIEnv* env, jclass, jstring jOutPath) {
+    std::string outPath = jstringToStd(env, jOutPath);
+    HermesRuntime::disableSamplingProfiler();
+    try {
+        HermesRuntime::dumpSampledTraceToFile(outPath);
+    } catch (const std::exception& e) {
+        LOGE("Failed to dump sampled trace: %s", e.what());
+        return JNI_FALSE;
+    }
+    LOGI("Sampled trace written to %s", outPath.c_str());
+    return JNI_TRUE;
+}
+
+JNIEXPORT jstring JNICALL
+Java_ai_connct_1screen_rn_HermesRuntime_nativeGetHeapInfo(JNIEnv* env, jclass, jstring jAgentType) {
+    std::string agentType = jstringToStd(env, jAgentType);
+    HermesRuntime* runtime = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_runtimes_mu);
+        auto it = g_runtimes.find(agentType);
+        if (it != g_runtimes.end()) runtime = it->second.runtime.get();
+    }
+    if (!runtime) {
+        return env->NewStringUTF("{\"error\":\"Runtime not created\"}");
+    }
+    std::string json = heapInfoJson(*runtime);
+    return env->NewStringUTF(json.c_str());
+}
+
 JNIEXPORT void JNICALL
 Java_ai_connct_1screen_rn_HermesRuntime_nativeDestroyRuntime(JNIEnv* env, jclass, jstring jAgentType) {
     std::string agentType = jstringToStd(env, jAgentType);
     LOGI("Destroying Hermes runtime for agent type: %s", agentType.c_str());
+    std::lock_guard<std::mutex> lock(g_runtimes_mu);
     g_runtimes.erase(agentType);
 }
 
@@ -14,6 +14,7 @@
 #include <jsi/jsi.h>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #define LOG_TAG "HermesRuntime"
@@ -24,6 +25,7 @@
 struct CommonJniCache {
     jclass clazz;          // HermesRuntime.java
     jmethodID httpPost;
+    jmethodID httpPostBatch;
     jmethodID appendLog;
     jmethodID updateStatus;
     jmethodID askUser;
@@ -36,12 +38,16 @@ struct CommonJniCache {
 struct RuntimeEntry {
     std::unique_ptr<facebook::hermes::HermesRuntime> runtime;
     std::string agentType;
+    // JSON.stringify, resolved once per runtime instead of two property
+    // lookups per eval. Declared after `runtime` so it is released first.
+    std::shared_ptr<facebook::jsi::Function> jsonStringify;
 };
 
 // Global state — defined in hermes_runtime.cpp
 extern JavaVM* g_jvm;
 extern CommonJniCache g_common_cache;
 extern std::unordered_map<std::string, RuntimeEntry> g_runtimes;
+extern std::mutex g_runtimes_mu;  // guards g_runtimes (pre-warm thread vs exec threads)
 
 // Get JNIEnv for the current thread, attaching if necessary.
 JNIEnv* getEnv();
@@ -49,5 +55,23 @@ JNIEnv* getEnv();
 // Convert jstring → std::string (handles null).
 std::string jstringToStd(JNIEnv* env, jstring js);
 
+// Convert jstring → a per-thread scratch buffer (handles null). Avoids the
+// per-call GetStringUTFChars allocation; the reference is valid until the
+// next call on the same thread, so copy it if it must live longer.
+const std::string& jstringToScratch(JNIEnv* env, jstring js);
+
+// Convert jstring → JSI string via the scratch buffer, skipping the
+// intermediate std::string. Preferred for large payloads (LLM response
+// bodies, tree dumps) where the extra heap copy is measurable.
+facebook::jsi::String jstringToJsi(JNIEnv* env, facebook::jsi::Runtime& rt, jstring js);
+
+// Parse a JSON buffer straight into jsi::Object/Array/primitive values —
+// one native scan, no intermediate JS string and no JSON.parse in Hermes.
+// Malformed input falls back to returning the raw text as a JSI string.
+facebook::jsi::Value jsonToJsi(facebook::jsi::Runtime& rt, const char* data, size_t size);
+
+// jstring carrying JSON → structured JSI value, via the scratch buffer.
+facebook::jsi::Value jstringJsonToJsi(JNIEnv* env, facebook::jsi::Runtime& rt, jstring js);
+
 // Register the common host functions (http_post, log, sleep, update_status, ask_user, hide_overlay).
 void registerCommonTools(facebook::jsi::Runtime& rt);
@@ -0,0 +1,209 @@
+/*
+ * gen_dsp_tables.c - host-side generator for qwen_asr_dsp_tables.h
+ *
+ * Emits the fixed DSP tables used by qwen_asr_audio.c: the periodic Hann
+ * window, the radix-2 FFT bit-reversal and twiddle tables, and the Slaney
+ * mel filterbank. Every input is a compile-time constant (16 kHz, 400-tap
+ * window, 512-point FFT, 128 mel bins), so the tables live in .rodata
+ * instead of being rebuilt on first use. Not part of the build; rerun by
+ * hand if a constant ever changes:
+ *
+ *   cc -O2 -o gen_dsp_tables gen_dsp_tables.c -lm
+ *   ./gen_dsp_tables > qwen_asr_dsp_tables.h
+ *
+ * The mel filterbank is emitted sparse: each triangle filter only touches
+ * a short contiguous run of FFT bins, so storing (start, len, values) per
+ * filter keeps the table small and lets the apply loop skip the zeros.
+ * The generator builds the dense [128, 257] matrix with the exact float
+ * arithmetic the runtime used to run, then cross-checks the sparse form
+ * against it before printing. Floats are printed with %.9g, which
+ * round-trips IEEE single precision exactly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SAMPLE_RATE  16000
+#define N_MEL        128
+#define WIN_LENGTH   400
+#define N_FFT        512
+#define N_FREQ       (N_FFT / 2 + 1)    /* 257 bins */
+
+/* Twiddle table size for an N-point radix-2 FFT: 1+2+...+N/2 = N-1
+ * complex values, concatenated per stage. */
+#define FFT_TWIDDLE_COUNT (N_FFT - 1)
+
+static float hertz_to_mel(float freq) {
+    const float min_log_hertz = 1000.0f;
+    const float min_log_mel = 15.0f;
+    const float logstep = 27.0f / logf(6.4f);
+    float mels = 3.0f * freq / 200.0f;
+    if (freq >= min_log_hertz) mels = min_log_mel + logf(freq / min_log_hertz) * logstep;
+    return mels;
+}
+
+static float mel_to_hertz(float mels) {
+    const float min_log_hertz = 1000.0f;
+    const float min_log_mel = 15.0f;
+    const float logstep = logf(6.4f) / 27.0f;
+    float freq = 200.0f * mels / 3.0f;
+    if (mels >= min_log_mel) freq = min_log_hertz * expf(logstep * (mels - min_log_mel));
+    return freq;
+}
+
+/* Dense Slaney-style filterbank, verbatim from the old build_mel_filters. */
+static void build_mel_filters(float *filters) {
+    float fft_freqs[N_FREQ];
+    for (int i = 0; i < N_FREQ; i++)
+        fft_freqs[i] = (float)i * ((float)SAMPLE_RATE / 2.0f) / (float)(N_FREQ - 1);
+
+    float mel_min = hertz_to_mel(0.0f);
+    float mel_max = hertz_to_mel((float)SAMPLE_RATE / 2.0f);
+
+    float filter_freqs[N_MEL + 2];
+    float filter_diff[N_MEL + 1];
+    for (int i = 0; i < N_MEL + 2; i++) {
+        float mel = mel_min + (mel_max - mel_min) * (float)i / (float)(N_MEL + 1);
+        filter_freqs[i] = mel_to_hertz(mel);
+    }
+    for (int i = 0; i < N_MEL + 1; i++) {
+        filter_diff[i] = filter_freqs[i + 1] - filter_freqs[i];
+        if (filter_diff[i] == 0.0f) filter_diff[i] = 1e-6f;
+    }
+
+    for (int m = 0; m < N_MEL; m++) {
+        float enorm = 2.0f / (filter_freqs[m + 2] - filter_freqs[m]);
+        for (int f = 0; f < N_FREQ; f++) {
+            float down = (fft_freqs[f] - filter_freqs[m]) / filter_diff[m];
+            float up = (filter_freqs[m + 2] - fft_freqs[f]) / filter_diff[m + 1];
+            float val = fminf(down, up);
+            if (val < 0.0f) val = 0.0f;
+            filters[(size_t)m * N_FREQ + f] = val * enorm;
+        }
+    }
+}
+
+static void print_f32(const char *name, const float *vals, int n) {
+    printf("static const float %s[%d] = {\n", name, n);
+    for (int i = 0; i < n; i++) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.9g", vals[i]);
+        /* %.9g drops the point for integral values; "0f" is not valid C */
+        printf("%s%s%sf%s", (i % 6 == 0) ? "    " : " ", buf,
+               (strpbrk(buf, ".e") == NULL) ? ".0" : "",
+               (i + 1 < n) ? "," : "");
+        if (i % 6 == 5 || i + 1 == n) printf("\n");
+    }
+    printf("};\n\n");
+}
+
+static void print_u16(const char *name, const int *vals, int n) {
+    printf("static const uint16_t %s[%d] = {\n", name, n);
+    for (int i = 0; i < n; i++) {
+        printf("%s%d%s", (i % 12 == 0) ? "    " : " ",
+               vals[i], (i + 1 < n) ? "," : "");
+        if (i % 12 == 11 || i + 1 == n) printf("\n");
+    }
+    printf("};\n\n");
+}
+
+int main(void) {
+    /* Periodic Hann window */
+    float window[WIN_LENGTH];
+    for (int i = 0; i < WIN_LENGTH; i++)
+        window[i] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * (float)i / (float)WIN_LENGTH));
+
+    /* FFT bit-reversal permutation and per-stage twiddles */
+    int brev[N_FFT];
+    for (int i = 0, j = 0; i < N_FFT; i++) {
+        brev[i] = j;
+        int bit = N_FFT >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+    }
+    float tw_re[FFT_TWIDDLE_COUNT], tw_im[FFT_TWIDDLE_COUNT];
+    int off = 0;
+    for (int len = 2; len <= N_FFT; len <<= 1) {
+        int half = len / 2;
+        for (int j = 0; j < half; j++) {
+            float angle = -2.0f * (float)M_PI * (float)j / (float)len;
+            tw_re[off + j] = cosf(angle);
+            tw_im[off + j] = sinf(angle);
+        }
+        off += half;
+    }
+
+    /* Mel filterbank: dense, then the contiguous non-zero run per filter */
+    float *dense = (float *)calloc((size_t)N_MEL * N_FREQ, sizeof(float));
+    if (!dense) return 1;
+    build_mel_filters(dense);
+
+    int start[N_MEL], len[N_MEL], voff[N_MEL];
+    float *vals = (float *)malloc((size_t)N_MEL * N_FREQ * sizeof(float));
+    if (!vals) return 1;
+    int nnz = 0;
+    for (int m = 0; m < N_MEL; m++) {
+        const float *row = dense + (size_t)m * N_FREQ;
+        int lo = 0, hi = -1;
+        for (int f = 0; f < N_FREQ; f++) {
+            if (row[f] != 0.0f) {
+                if (hi < 0) lo = f;
+                hi = f;
+            }
+        }
+        start[m] = (hi < 0) ? 0 : lo;
+        len[m] = (hi < 0) ? 0 : hi - lo + 1;
+        voff[m] = nnz;
+        for (int f = 0; f < len[m]; f++)
+            vals[nnz++] = row[start[m] + f];
+    }
+
+    /* Cross-check: sparse form must reproduce the dense row exactly */
+    for (int m = 0; m < N_MEL; m++) {
+        for (int f = 0; f < N_FREQ; f++) {
+            float d = dense[(size_t)m * N_FREQ + f];
+            float s = (f >= start[m] && f < start[m] + len[m])
+                          ? vals[voff[m] + (f - start[m])] : 0.0f;
+            if (d != s) {
+                fprintf(stderr, "sparse mismatch at [%d,%d]\n", m, f);
+                return 1;
+            }
+        }
+    }
+
+    printf("/*\n"
+           " * qwen_asr_dsp_tables.h - generated by gen_dsp_tables.c, do not edit\n"
+           " *\n"
+           " * Fixed DSP tables for qwen_asr_audio.c (16 kHz, %d-tap periodic Hann\n"
+           " * window, %d-point radix-2 FFT, %d Slaney mel filters). The mel\n"
+           " * filterbank is sparse: filter m covers FFT power bins\n"
+           " * [qwen_dsp_mel_start[m], qwen_dsp_mel_start[m] + qwen_dsp_mel_len[m])\n"
+           " * with weights at qwen_dsp_mel_vals + qwen_dsp_mel_off[m].\n"
+           " */\n\n"
+           "#ifndef QWEN_ASR_DSP_TABLES_H\n"
+           "#define QWEN_ASR_DSP_TABLES_H\n\n"
+           "#include <stdint.h>\n\n"
+           "#define QWEN_DSP_MEL_NNZ %d\n\n",
+           WIN_LENGTH, N_FFT, N_MEL, nnz);
+
+    print_f32("qwen_dsp_hann_window", window, WIN_LENGTH);
+    print_u16("qwen_dsp_fft_brev", brev, N_FFT);
+    print_f32("qwen_dsp_fft_tw_re", tw_re, FFT_TWIDDLE_COUNT);
+    print_f32("qwen_dsp_fft_tw_im", tw_im, FFT_TWIDDLE_COUNT);
+    print_u16("qwen_dsp_mel_start", start, N_MEL);
+    print_u16("qwen_dsp_mel_len", len, N_MEL);
+    print_u16("qwen_dsp_mel_off", voff, N_MEL);
+    print_f32("qwen_dsp_mel_vals", vals, nnz);
+
+    printf("#endif /* QWEN_ASR_DSP_TABLES_H */\n");
+
+    free(dense);
+    free(vals);
+    return 0;
+}
@@ -24,8 +24,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-/* Global verbose flag */
-int qwen_verbose = 0;
+/* Global verbose flag lives in the shared pool (qwen-kernels/qwen_pool.c) */
 int qwen_monitor = 0;
 
 /* Global cache directory for .qcache files */
@@ -43,11 +42,28 @@ static const char *get_cache_dir(const qwen_ctx_t *ctx) {
     return g_cache_dir[0] ? g_cache_dir : ctx->model_dir;
 }
 
+/* Global KV cache format selector, captured per-context at qwen_load time */
+static int g_kv_cache_int8 = 0;
+
+void qwen_set_kv_cache_int8(int enable) {
+    g_kv_cache_int8 = enable ? 1 : 0;
+}
+
 void qwen_set_token_callback(qwen_ctx_t *ctx, qwen_token_cb cb, void *userdata) {
     ctx->token_cb = cb;
     ctx->token_cb_userdata = userdata;
 }
 
+void qwen_set_draft_ctx(qwen_ctx_t *ctx, qwen_ctx_t *draft, int n_draft) {
+    if (draft && draft->config.vocab_size != ctx->config.vocab_size) {
+        fprintf(stderr, "qwen_set_draft_ctx: vocab mismatch (%d vs %d), ignoring draft\n",
+                draft->config.vocab_size, ctx->config.vocab_size);
+        draft = NULL;
+    }
+    ctx->draft_ctx = draft;
+    ctx->spec_n_draft = (n_draft > 0) ? n_draft : 4;
+}
+
 static void reset_prompt_cache(qwen_ctx_t *ctx) {
     free(ctx->prompt_tokens);
     ctx->prompt_tokens = NULL;
@@ -58,6 +74,12 @@ static void reset_prompt_cache(qwen_ctx_t *ctx) {
     ctx->n_force_prompt_tokens = 0;
 
     ctx->prompt_tokens_ready = 0;
+
+    /* Prefix KV snapshot is derived from the prompt tokens; the draft
+     * context mirrors the same prompt, so drop its snapshot too. */
+    qwen_decoder_drop_prefix(ctx);
+    if (ctx->draft_ctx)
+        qwen_decoder_drop_prefix(ctx->draft_ctx);
 }
 
 /* ========================================================================
@@ -68,6 +90,8 @@ extern int qwen_encoder_load(qwen_encoder_t *enc, multi_safetensors_t *ms,
                               const qwen_config_t *cfg);
 extern int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
                               const qwen_config_t *cfg);
+extern int qwen_decoder_build_argmax_index(qwen_decoder_t *dec,
+                                            const qwen_config_t *cfg);
 
 /* ========================================================================
  * Config Detection
@@ -142,18 +166,32 @@ static int detect_config(qwen_ctx_t *ctx) {
  * Cache is saved alongside safetensors in model_dir.
  * Invalidated when safetensors total file size changes.
  *
- * Cache format:
- *   header (asr_qcache_header_t)
+ * Cache format (v2):
+ *   header (asr_qcache_header_t), then each tensor page-aligned in order:
  *   for each encoder layer:
  *     wq_q8 | wk_q8 | wv_q8 | wo_q8 | fc1_q8 | fc2_q8
  *   encoder: conv_out_q8 | proj1_q8 | proj2_q8
  *   for each decoder layer:
  *     wq_q4k | wk_q4k | wv_q4k | wo_q4k | gate_up_q4k | down_q4k
- *   decoder: tok_embeddings_q4k
+ *   decoder: tok_embeddings_q4k | argmax_centroids | argmax_radii
+ *
+ * v2 page-aligns every tensor so load is a single mmap with pointer
+ * fixups: weights stay file-backed (no malloc+memcpy, no RSS doubling)
+ * and the kernel can drop clean weight pages under memory pressure.
+ * v3 appends the hierarchical argmax index over tok_embeddings_q4k.
+ * v4 stores the per-layer decoder Q4_K weights in the 4-row interleaved
+ * block_q4_kx4 layout (tok_embeddings_q4k stays row-major for the argmax
+ * scan). Tensor byte sizes are unchanged; the version bump forces old
+ * row-major caches to re-quantize.
  * ======================================================================== */
 
 #define ASR_QCACHE_MAGIC   0x31435141  /* "AQC1" */
-#define ASR_QCACHE_VERSION 1
+#define ASR_QCACHE_VERSION 4
+#define ASR_QCACHE_ALIGN   4096
+
+static size_t qcache_align(size_t off) {
+    return (off + ASR_QCACHE_ALIGN - 1) & ~(size_t)(ASR_QCACHE_ALIGN - 1);
+}
 
 typedef struct {
     uint32_t magic;
@@ -181,7 +219,10 @@ typedef struct {
     uint32_t dec_down_q4k_bytes;
     /* Decoder one-time Q4_K sizes */
     uint32_t dec_tok_emb_q4k_bytes;
-    uint32_t reserved[3];
+    /* Hierarchical argmax index (0 groups = no index) */
+    uint32_t argmax_n_groups;
+    uint32_t argmax_group_size;
+    uint32_t reserved[1];
 } asr_qcache_header_t;
 
 static uint64_t get_safetensors_size(const char *model_dir) {
@@ -204,6 +245,11 @@ static uint64_t get_safetensors_size(const char *model_dir) {
 static int save_asr_qcache(qwen_ctx_t *ctx) {
     const qwen_config_t *cfg = &ctx->config;
     char path[1024];
+
+    /* Weights already come from a mapped cache file; rewriting it would
+     * truncate our own mapping. */
+    if (ctx->qcache_map) return 0;
+
     snprintf(path, sizeof(path), "%s/model.qcache", get_cache_dir(ctx));
 
     /* Compute per-layer sizes */
@@ -263,6 +309,8 @@ static int save_asr_qcache(qwen_ctx_t *ctx) {
     hdr.dec_gate_up_q4k_bytes = dec_gate_up_q4k_bytes;
     hdr.dec_down_q4k_bytes = dec_down_q4k_bytes;
     hdr.dec_tok_emb_q4k_bytes = dec_tok_emb_q4k_bytes;
+    hdr.argmax_n_groups = (uint32_t)ctx->decoder.argmax_n_groups;
+    hdr.argmax_group_size = (uint32_t)ctx->decoder.argmax_group_size;
 
     FILE *f = fopen(path, "wb");
     if (!f) {
@@ -273,9 +321,20 @@ static int save_asr_qcache(qwen_ctx_t *ctx) {
 
     fwrite(&hdr, sizeof(hdr), 1, f);
 
+    /* Pad to the next page boundary so every tensor is page-aligned */
+    static const uint8_t zero_page[ASR_QCACHE_ALIGN] = {0};
+    #define PAD_TO_PAGE() do { \
+        size_t pos = (size_t)ftell(f); \
+        size_t pad = qcache_align(pos) - pos; \
+        if (pad > 0) fwrite(zero_page, 1, pad, f); \
+    } while(0)
+
+    PAD_TO_PAGE();
+
     #define WRITE_OR_ZERO(ptr, nbytes) do { \
         if (ptr) fwrite(ptr, 1, nbytes, f); \
         else { void *z = calloc(1, nbytes); fwrite(z, 1, nbytes, f); free(z); } \
+        PAD_TO_PAGE(); \
     } while(0)
 
     /* Write encoder layers */
@@ -308,7 +367,17 @@ static int save_asr_qcache(qwen_ctx_t *ctx) {
     /* Write decoder token embeddings Q4_K */
     WRITE_OR_ZERO(ctx->decoder.tok_embeddings_q4k, dec_tok_emb_q4k_bytes);
 
+    /* Write hierarchical argmax index */
+    if (hdr.argmax_n_groups > 0) {
+        uint32_t centroid_bytes =
+            (uint32_t)((size_t)hdr.argmax_n_groups * hidden * sizeof(float));
+        uint32_t radii_bytes = (uint32_t)(hdr.argmax_n_groups * sizeof(float));
+        WRITE_OR_ZERO(ctx->decoder.argmax_centroids, centroid_bytes);
+        WRITE_OR_ZERO(ctx->decoder.argmax_radii, radii_bytes);
+    }
+
     #undef WRITE_OR_ZERO
+    #undef PAD_TO_PAGE
 
     fclose(f);
     if (qwen_verbose >= 1)
@@ -356,71 +425,87 @@ static int load_asr_qcache(qwen_ctx_t *ctx) {
         return -1;
     }
 
-    /* Validate total file size */
-    size_t enc_per_layer = (size_t)hdr->enc_wq_q8_bytes + hdr->enc_wk_q8_bytes +
-                            hdr->enc_wv_q8_bytes + hdr->enc_wo_q8_bytes +
-                            hdr->enc_fc1_q8_bytes + hdr->enc_fc2_q8_bytes;
-    size_t dec_per_layer = (size_t)hdr->dec_wq_q4k_bytes + hdr->dec_wk_q4k_bytes +
-                            hdr->dec_wv_q4k_bytes + hdr->dec_wo_q4k_bytes +
-                            hdr->dec_gate_up_q4k_bytes + hdr->dec_down_q4k_bytes;
-    size_t expected_size = sizeof(asr_qcache_header_t) +
+    /* Validate total file size (every tensor occupies a page-aligned slot) */
+    size_t enc_per_layer = qcache_align(hdr->enc_wq_q8_bytes) + qcache_align(hdr->enc_wk_q8_bytes) +
+                            qcache_align(hdr->enc_wv_q8_bytes) + qcache_align(hdr->enc_wo_q8_bytes) +
+                            qcache_align(hdr->enc_fc1_q8_bytes) + qcache_align(hdr->enc_fc2_q8_bytes);
+    size_t dec_per_layer = qcache_align(hdr->dec_wq_q4k_bytes) + qcache_align(hdr->dec_wk_q4k_bytes) +
+                            qcache_align(hdr->dec_wv_q4k_bytes) + qcache_align(hdr->dec_wo_q4k_bytes) +
+                            qcache_align(hdr->dec_gate_up_q4k_bytes) + qcache_align(hdr->dec_down_q4k_bytes);
+    size_t argmax_centroid_bytes = (size_t)hdr->argmax_n_groups * cfg->dec_hidden * sizeof(float);
+    size_t argmax_radii_bytes = (size_t)hdr->argmax_n_groups * sizeof(float);
+    size_t expected_size = qcache_align(sizeof(asr_qcache_header_t)) +
                            enc_per_layer * hdr->n_enc_layers +
-                           (size_t)hdr->enc_conv_out_q8_bytes +
-                           hdr->enc_proj1_q8_bytes + hdr->enc_proj2_q8_bytes +
+                           qcache_align(hdr->enc_conv_out_q8_bytes) +
+                           qcache_align(hdr->enc_proj1_q8_bytes) +
+                           qcache_align(hdr->enc_proj2_q8_bytes) +
                            dec_per_layer * hdr->n_dec_layers +
-                           hdr->dec_tok_emb_q4k_bytes;
+                           qcache_align(hdr->dec_tok_emb_q4k_bytes) +
+                           qcache_align(argmax_centroid_bytes) +
+                           qcache_align(argmax_radii_bytes);
     if (file_size < expected_size) {
         munmap(mapped, file_size);
         return -1;
     }
 
-    /* Copy weights from mmap into malloc'd buffers */
-    const uint8_t *ptr = (const uint8_t *)mapped + sizeof(asr_qcache_header_t);
+    /* Fix up weight pointers directly into the mapping: weights stay
+     * file-backed for the lifetime of the context (no copies). */
+    const uint8_t *ptr = (const uint8_t *)mapped + qcache_align(sizeof(asr_qcache_header_t));
 
-    #define CACHE_COPY(dst, type, n_bytes) do { \
+    #define CACHE_PTR(dst, type, n_bytes) do { \
         if ((n_bytes) > 0) { \
-            dst = (type)malloc(n_bytes); \
-            if (dst) memcpy(dst, ptr, n_bytes); \
-            ptr += (n_bytes); \
+            dst = (type)ptr; \
+            ptr += qcache_align(n_bytes); \
         } \
     } while(0)
 
-    /* Read encoder layers */
+    /* Encoder layers */
     for (int i = 0; i < cfg->enc_layers; i++) {
         qwen_enc_layer_t *l = &ctx->encoder.layers[i];
-        CACHE_COPY(l->wq_weight_q8, block_q8_0 *, hdr->enc_wq_q8_bytes);
-        CACHE_COPY(l->wk_weight_q8, block_q8_0 *, hdr->enc_wk_q8_bytes);
-        CACHE_COPY(l->wv_weight_q8, block_q8_0 *, hdr->enc_wv_q8_bytes);
-        CACHE_COPY(l->wo_weight_q8, block_q8_0 *, hdr->enc_wo_q8_bytes);
-        CACHE_COPY(l->fc1_weight_q8, block_q8_0 *, hdr->enc_fc1_q8_bytes);
-        CACHE_COPY(l->fc2_weight_q8, block_q8_0 *, hdr->enc_fc2_q8_bytes);
+        CACHE_PTR(l->wq_weight_q8, block_q8_0 *, hdr->enc_wq_q8_bytes);
+        CACHE_PTR(l->wk_weight_q8, block_q8_0 *, hdr->enc_wk_q8_bytes);
+        CACHE_PTR(l->wv_weight_q8, block_q8_0 *, hdr->enc_wv_q8_bytes);
+        CACHE_PTR(l->wo_weight_q8, block_q8_0 *, hdr->enc_wo_q8_bytes);
+        CACHE_PTR(l->fc1_weight_q8, block_q8_0 *, hdr->enc_fc1_q8_bytes);
+        CACHE_PTR(l->fc2_weight_q8, block_q8_0 *, hdr->enc_fc2_q8_bytes);
     }
 
-    /* Read encoder one-time weights */
-    CACHE_COPY(ctx->encoder.conv_out_weight_q8, block_q8_0 *, hdr->enc_conv_out_q8_bytes);
-    CACHE_COPY(ctx->encoder.proj1_weight_q8, block_q8_0 *, hdr->enc_proj1_q8_bytes);
-    CACHE_COPY(ctx->encoder.proj2_weight_q8, block_q8_0 *, hdr->enc_proj2_q8_bytes);
+    /* Encoder one-time weights */
+    CACHE_PTR(ctx->encoder.conv_out_weight_q8, block_q8_0 *, hdr->enc_conv_out_q8_bytes);
+    CACHE_PTR(ctx->encoder.proj1_weight_q8, block_q8_0 *, hdr->enc_proj1_q8_bytes);
+    CACHE_PTR(ctx->encoder.proj2_weight_q8, block_q8_0 *, hdr->enc_proj2_q8_bytes);
 
-    /* Read decoder layers */
+    /* Decoder layers */
     for (int i = 0; i < cfg->dec_layers; i++) {
         qwen_dec_layer_t *l = &ctx->decoder.layers[i];
-        CACHE_COPY(l->wq_weight_q4k, block_q4_k *, hdr->dec_wq_q4k_bytes);
-        CACHE_COPY(l->wk_weight_q4k, block_q4_k *, hdr->dec_wk_q4k_bytes);
-        CACHE_COPY(l->wv_weight_q4k, block_q4_k *, hdr->dec_wv_q4k_bytes);
-        CACHE_COPY(l->wo_weight_q4k, block_q4_k *, hdr->dec_wo_q4k_bytes);
-        CACHE_COPY(l->gate_up_fused_q4k, block_q4_k *, hdr->dec_gate_up_q4k_bytes);
-        CACHE_COPY(l->down_weight_q4k, block_q4_k *, hdr->dec_down_q4k_bytes);
+        CACHE_PTR(l->wq_weight_q4k, block_q4_kx4 *, hdr->dec_wq_q4k_bytes);
+        CACHE_PTR(l->wk_weight_q4k, block_q4_kx4 *, hdr->dec_wk_q4k_bytes);
+        CACHE_PTR(l->wv_weight_q4k, block_q4_kx4 *, hdr->dec_wv_q4k_bytes);
+        CACHE_PTR(l->wo_weight_q4k, block_q4_kx4 *, hdr->dec_wo_q4k_bytes);
+        CACHE_PTR(l->gate_up_fused_q4k, block_q4_kx4 *, hdr->dec_gate_up_q4k_bytes);
+        CACHE_PTR(l->down_weight_q4k, block_q4_kx4 *, hdr->dec_down_q4k_bytes);
     }
 
-    /* Read decoder token embeddings */
-    CACHE_COPY(ctx->decoder.tok_embeddings_q4k, block_q4_k *, hdr->dec_tok_emb_q4k_bytes);
+    /* Decoder token embeddings */
+    CACHE_PTR(ctx->decoder.tok_embeddings_q4k, block_q4_k *, hdr->dec_tok_emb_q4k_bytes);
+
+    /* Hierarchical argmax index */
+    if (hdr->argmax_n_groups > 0) {
+        CACHE_PTR(ctx->decoder.argmax_centroids, float *, argmax_centroid_bytes);
+        CACHE_PTR(ctx->decoder.argmax_radii, float *, argmax_radii_bytes);
+        ctx->decoder.argmax_n_groups = (int)hdr->argmax_n_groups;
+        ctx->decoder.argmax_group_size = (int)hdr->argmax_group_size;
+    }
 
-    #undef CACHE_COPY
+    #undef CACHE_PTR
 
-    munmap(mapped, file_size);
+    /* Keep the mapping alive; qwen_free() unmaps it instead of freeing the
+     * individual weight buffers. */
+    ctx->qcache_map = mapped;
+    ctx->qcache_map_size = file_size;
 
     if (qwen_verbose >= 1)
-        fprintf(stderr, "Loaded quantized cache from %s\n", path);
+        fprintf(stderr, "Loaded quantized cache from %s (mmap)\n", path);
     return 0;
 }
 
@@ -448,6 +533,11 @@ qwen_ctx_t *qwen_load(const char *model_dir) {
     /* Detect model configuration */
     detect_config(ctx);
 
+    /* KV cache format is fixed per context at load time */
+    ctx->kv_cache_int8 = g_kv_cache_int8;
+    if (qwen_verbose >= 1 && ctx->kv_cache_int8)
+        fprintf(stderr, "Decoder KV cache: INT8 (per-head scales)\n");
+
     /* Try loading quantized weight cache */
     int cache_ok = load_asr_qcache(ctx);
     if (cache_ok == 0 && qwen_verbose >= 1) {
@@ -470,8 +560,10 @@ qwen_ctx_t *qwen_load(const char *model_dir) {
         return NULL;
     }
 
-    /* Save cache if it wasn't loaded (first-time quantization) */
+    /* Build the argmax index and save the cache if it wasn't loaded
+     * (first-time quantization) */
     if (cache_ok != 0) {
+        qwen_decoder_build_argmax_index(&ctx->decoder, &ctx->config);
         save_asr_qcache(ctx);
     }
 
@@ -491,6 +583,36 @@ qwen_ctx_t *qwen_load(const char *model_dir) {
     return ctx;
 }
 
+qwen_ctx_t *qwen_session_new(qwen_ctx_t *base) {
+    if (!base) return NULL;
+    qwen_ctx_t *s = (qwen_ctx_t *)calloc(1, sizeof(qwen_ctx_t));
+    if (!s) return NULL;
+
+    /* Share immutable weights by struct copy; everything mutable (KV cache,
+     * scratch buffers, RoPE caches, prompt caches) starts empty and is
+     * allocated lazily, exactly as after qwen_load(). */
+    s->config = base->config;
+    s->encoder = base->encoder;
+    s->decoder = base->decoder;
+    memcpy(s->model_dir, base->model_dir, sizeof(s->model_dir));
+    s->is_session = 1;
+    /* safetensors stays NULL: the base context owns the mmap */
+
+    /* Inherit tunables (not callbacks, prompt strings or the draft ctx) */
+    s->kv_cache_int8 = base->kv_cache_int8;
+    s->segment_sec = base->segment_sec;
+    s->search_sec = base->search_sec;
+    s->stream_chunk_sec = base->stream_chunk_sec;
+    s->stream_rollback = base->stream_rollback;
+    s->stream_unfixed_chunks = base->stream_unfixed_chunks;
+    s->stream_max_new_tokens = base->stream_max_new_tokens;
+    s->past_text_conditioning = base->past_text_conditioning;
+    s->skip_silence = base->skip_silence;
+    s->spec_n_draft = base->spec_n_draft;
+
+    return s;
+}
+
 /* ========================================================================
  * Free
  * ======================================================================== */
@@ -499,47 +621,73 @@ void qwen_free(qwen_ctx_t *ctx) {
     if (!ctx) return;
 
     #define FREE0(p) do { free(p); (p) = NULL; } while (0)
+    /* Quantized weights point into the qcache mapping when it is present
+     * (v2 cache); only free them when they were malloc'd. */
+    int q_owned = (ctx->qcache_map == NULL);
+    #define FREEQ(p) do { if (q_owned) free(p); (p) = NULL; } while (0)
+
+    /* Sessions (qwen_session_new) borrow their weights from a base context;
+     * only free weights when this context owns them. */
+    if (ctx->is_session) goto free_mutable_state;
 
     /* Encoder conv stem */
     FREE0(ctx->encoder.conv1_weight); FREE0(ctx->encoder.conv1_bias);
     FREE0(ctx->encoder.conv2_weight); FREE0(ctx->encoder.conv2_bias);
     FREE0(ctx->encoder.conv3_weight); FREE0(ctx->encoder.conv3_bias);
-    FREE0(ctx->encoder.conv_out_weight_q8);
+    FREEQ(ctx->encoder.conv_out_weight_q8);
 
-    /* Encoder layers (weights are Q8_0, all allocated) */
+    /* Encoder layers (weights are Q8_0) */
     for (int i = 0; i < ctx->config.enc_layers; i++) {
         qwen_enc_layer_t *l = &ctx->encoder.layers[i];
-        FREE0(l->wq_weight_q8); FREE0(l->wq_bias);
-        FREE0(l->wk_weight_q8); FREE0(l->wk_bias);
-        FREE0(l->wv_weight_q8); FREE0(l->wv_bias);
-        FREE0(l->wo_weight_q8); FREE0(l->wo_bias);
+        FREEQ(l->wq_weight_q8); FREE0(l->wq_bias);
+        FREEQ(l->wk_weight_q8); FREE0(l->wk_bias);
+        FREEQ(l->wv_weight_q8); FREE0(l->wv_bias);
+        FREEQ(l->wo_weight_q8); FREE0(l->wo_bias);
         FREE0(l->attn_norm_weight); FREE0(l->attn_norm_bias);
-        FREE0(l->fc1_weight_q8); FREE0(l->fc1_bias);
-        FREE0(l->fc2_weight_q8); FREE0(l->fc2_bias);
+        FREEQ(l->fc1_weight_q8); FREE0(l->fc1_bias);
+        FREEQ(l->fc2_weight_q8); FREE0(l->fc2_bias);
         FREE0(l->ffn_norm_weight); FREE0(l->ffn_norm_bias);
     }
     FREE0(ctx->encoder.ln_post_weight); FREE0(ctx->encoder.ln_post_bias);
-    FREE0(ctx->encoder.proj1_weight_q8); FREE0(ctx->encoder.proj1_bias);
-    FREE0(ctx->encoder.proj2_weight_q8); FREE0(ctx->encoder.proj2_bias);
+    FREEQ(ctx->encoder.proj1_weight_q8); FREE0(ctx->encoder.proj1_bias);
+    FREEQ(ctx->encoder.proj2_weight_q8); FREE0(ctx->encoder.proj2_bias);
 
-    /* Decoder layers (Q4_K weights are all malloc'd, must be freed) */
+    /* Decoder layers (Q4_K weights) */
     for (int i = 0; i < ctx->config.dec_layers; i++) {
         qwen_dec_layer_t *l = &ctx->decoder.layers[i];
-        FREE0(l->wq_weight_q4k); FREE0(l->wk_weight_q4k);
-        FREE0(l->wv_weight_q4k); FREE0(l->wo_weight_q4k);
+        FREEQ(l->wq_weight_q4k); FREEQ(l->wk_weight_q4k);
+        FREEQ(l->wv_weight_q4k); FREEQ(l->wo_weight_q4k);
         FREE0(l->q_norm_weight); FREE0(l->k_norm_weight);
         FREE0(l->input_norm); FREE0(l->post_attn_norm);
-        FREE0(l->down_weight_q4k);
-        FREE0(l->gate_up_fused_q4k);
+        FREEQ(l->down_weight_q4k);
+        FREEQ(l->gate_up_fused_q4k);
     }
     FREE0(ctx->decoder.norm);
-    FREE0(ctx->decoder.tok_embeddings_q4k);
+    FREEQ(ctx->decoder.tok_embeddings_q4k);
+    FREEQ(ctx->decoder.argmax_centroids);
+    FREEQ(ctx->decoder.argmax_radii);
+
+    if (ctx->qcache_map) {
+        munmap(ctx->qcache_map, ctx->qcache_map_size);
+        ctx->qcache_map = NULL;
+        ctx->qcache_map_size = 0;
+    }
 
+    #undef FREEQ
     #undef FREE0
 
+    /* GEMM workspace (process-global, freed with the weight owner) */
+    qwen_gemm_workspace_free();
+
+free_mutable_state:
     /* KV cache */
     free(ctx->kv_cache_k);
     free(ctx->kv_cache_v);
+    free(ctx->kv_cache_k_q8);
+    free(ctx->kv_cache_v_q8);
+    free(ctx->kv_cache_k_scale);
+    free(ctx->kv_cache_v_scale);
+    qwen_decoder_drop_prefix(ctx);
 
     /* Persistent decoder buffers */
     free(ctx->dec_x); free(ctx->dec_x_norm);
@@ -554,13 +702,21 @@ void qwen_free(qwen_ctx_t *ctx) {
     free(ctx->pref_attn_out); free(ctx->pref_proj_out); free(ctx->pref_ffn_out);
     free(ctx->pref_gate); free(ctx->pref_gate_up);
 
+    /* Persistent encoder transformer buffers */
+    free(ctx->enc_x_norm);
+    free(ctx->enc_q); free(ctx->enc_k); free(ctx->enc_v);
+    free(ctx->enc_attn_out); free(ctx->enc_proj_out);
+    free(ctx->enc_ffn_mid); free(ctx->enc_ffn_out);
+    free(ctx->enc_proj_mid);
+    free(ctx->enc_k_f16); free(ctx->enc_v_f16);
+
+    /* Encoder PE cache */
+    free(ctx->enc_pe_cache);
+
     /* Decoder RoPE caches */
     free(ctx->rope_cache_cos); free(ctx->rope_cache_sin);
     free(ctx->rope_inv_freq);
 
-    /* GEMM workspace */
-    qwen_gemm_workspace_free();
-
     /* Prompt/language options */
     free(ctx->prompt);
     free(ctx->force_language);
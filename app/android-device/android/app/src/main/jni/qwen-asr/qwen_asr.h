@@ -130,11 +130,12 @@ typedef struct {
  * ======================================================================== */
 
 typedef struct {
-    /* Self-attention (NO biases in decoder) - quantized to Q4_K */
-    block_q4_k *wq_weight_q4k;  /* [n_heads*head_dim, hidden/QK_K] Q4_K blocks */
-    block_q4_k *wk_weight_q4k;  /* [n_kv_heads*head_dim, hidden/QK_K] Q4_K blocks */
-    block_q4_k *wv_weight_q4k;  /* [n_kv_heads*head_dim, hidden/QK_K] Q4_K blocks */
-    block_q4_k *wo_weight_q4k;  /* [hidden, n_heads*head_dim/QK_K] Q4_K blocks */
+    /* Self-attention (NO biases in decoder) - quantized to Q4_K and
+     * repacked into the 4-row interleaved x4 layout for the SDOT kernels */
+    block_q4_kx4 *wq_weight_q4k;  /* [n_heads*head_dim/4, hidden/QK_K] x4 tiles */
+    block_q4_kx4 *wk_weight_q4k;  /* [n_kv_heads*head_dim/4, hidden/QK_K] x4 tiles */
+    block_q4_kx4 *wv_weight_q4k;  /* [n_kv_heads*head_dim/4, hidden/QK_K] x4 tiles */
+    block_q4_kx4 *wo_weight_q4k;  /* [hidden/4, n_heads*head_dim/QK_K] x4 tiles */
 
     /* Per-head Q/K RMSNorm */
     float *q_norm_weight;      /* [head_dim] = [128] */
@@ -144,11 +145,11 @@ typedef struct {
     float *input_norm;         /* [hidden] */
     float *post_attn_norm;     /* [hidden] */
 
-    /* SwiGLU MLP (NO biases) - quantized to Q4_K */
-    block_q4_k *down_weight_q4k; /* [hidden, intermediate/QK_K] Q4_K blocks */
+    /* SwiGLU MLP (NO biases) - quantized to Q4_K, x4 interleaved */
+    block_q4_kx4 *down_weight_q4k; /* [hidden/4, intermediate/QK_K] x4 tiles */
 
-    /* Fused gate+up weight [2*intermediate, hidden/QK_K] Q4_K blocks */
-    block_q4_k *gate_up_fused_q4k;
+    /* Fused gate+up weight [2*intermediate/4, hidden/QK_K] x4 tiles */
+    block_q4_kx4 *gate_up_fused_q4k;
 } qwen_dec_layer_t;
 
 typedef struct {
@@ -161,6 +162,14 @@ typedef struct {
 
     /* Final RMSNorm */
     float *norm;               /* [hidden] */
+
+    /* Hierarchical argmax index over tok_embeddings_q4k: per-group centroid
+     * and radius for branch-and-bound lm_head argmax (built at qcache time,
+     * groups of consecutive token ids). NULL = full vocab scan. */
+    float *argmax_centroids;   /* [argmax_n_groups, hidden] */
+    float *argmax_radii;       /* [argmax_n_groups] */
+    int argmax_n_groups;
+    int argmax_group_size;
 } qwen_decoder_t;
 
 /* ========================================================================
@@ -175,20 +184,57 @@ typedef void (*qwen_token_cb)(const char *piece, void *userdata);
  * Main Context
  * ======================================================================== */
 
-typedef struct {
+typedef struct qwen_ctx_s {
     qwen_config_t config;
     qwen_encoder_t encoder;
     qwen_decoder_t decoder;
 
     /* Model files (kept open for mmap) */
     void *safetensors;         /* multi_safetensors_t* */
+    void *qcache_map;          /* mmap'd model.qcache; quantized weights point
+                                * into it when set (v2 cache), else malloc'd */
+    size_t qcache_map_size;
     char model_dir[512];
+    int is_session;            /* 1 = weights borrowed from a base context
+                                * (qwen_session_new); qwen_free skips them */
 
     /* KV cache for decoder (FP16 for bandwidth savings) */
     uint16_t *kv_cache_k;     /* [layers, max_seq, kv_heads * head_dim] as FP16 */
     uint16_t *kv_cache_v;
     int kv_cache_len;
     int kv_cache_max;
+    int kv_pos_offset;        /* RoPE position = cache index + offset; grows by n
+                               * on each qwen_decoder_evict_kv(n), reset when the
+                               * cache restarts from position 0 */
+
+    /* Logit gap (best minus runner-up) of the most recent greedy argmax in
+     * qwen_decoder_forward / _forward_batch. Raw logit units: the runner-up
+     * carries e^-margin of the winner's probability mass. Streaming uses it
+     * to fix confident tail tokens without waiting out the full rollback. */
+    float last_logit_margin;
+
+    /* Optional INT8 KV cache (per-head scales, halves cache bandwidth).
+     * Enabled via qwen_set_kv_cache_int8() before qwen_load().
+     * When active, kv_cache_k/kv_cache_v above stay NULL. */
+    int kv_cache_int8;        /* 1 = INT8 cache active for this context */
+    int8_t *kv_cache_k_q8;    /* [layers, max_seq, kv_heads * head_dim] as int8 */
+    int8_t *kv_cache_v_q8;
+    float *kv_cache_k_scale;  /* [layers, max_seq, kv_heads] per-head scales */
+    float *kv_cache_v_scale;
+
+    /* Prompt-prefix KV snapshot. The prefix (PREFIX_HEAD + prompt +
+     * PREFIX_TAIL) is identical for every utterance in a session, so its KV
+     * entries are copied out after the first prefill and restored by memcpy
+     * on later calls instead of re-prefilling those tokens. Buffers match
+     * the active cache format, laid out [layers, prefix_kv_len, ...].
+     * Invalidated when the prompt changes (reset_prompt_cache). */
+    uint16_t *prefix_kv_k;
+    uint16_t *prefix_kv_v;
+    int8_t *prefix_kv_k_q8;
+    int8_t *prefix_kv_v_q8;
+    float *prefix_kv_k_scale;
+    float *prefix_kv_v_scale;
+    int prefix_kv_len;        /* snapshotted positions (0 = no snapshot) */
 
     /* Persistent decoder buffers (single-token generation) */
     float *dec_x, *dec_x_norm, *dec_q, *dec_k, *dec_v;
@@ -202,6 +248,20 @@ typedef struct {
     float *pref_gate, *pref_gate_up;
     int pref_seq_cap;
 
+    /* Persistent encoder transformer buffers (streaming re-runs the
+     * transformer on the partial tail window every chunk) */
+    float *enc_x_norm, *enc_q, *enc_k, *enc_v;
+    float *enc_attn_out, *enc_proj_out, *enc_ffn_mid, *enc_ffn_out;
+    float *enc_proj_mid;
+    uint16_t *enc_k_f16, *enc_v_f16;  /* FP16 K/V for encoder attention */
+    int enc_tok_cap;
+
+    /* Cached sinusoidal PE for the encoder stem (per-chunk positions
+     * always start at 0, so one table grown monotonically covers every
+     * chunk) */
+    float *enc_pe_cache;                      /* [pos, enc_d_model] */
+    int enc_pe_cache_cap;                     /* cached positions */
+
     /* Cached RoPE tables for decoder positions */
     float *rope_cache_cos, *rope_cache_sin;   /* [pos, head_dim] */
     float *rope_inv_freq;                     /* [head_dim / 2] */
@@ -218,13 +278,22 @@ typedef struct {
 
     /* Streaming settings */
     float stream_chunk_sec;        /* chunk interval in seconds (default 2.0) */
-    int stream_rollback;           /* tokens to roll back per chunk (default 5) */
+    int stream_rollback;           /* max tokens to roll back per chunk (default 5);
+                                    * the confidence gate shrinks the actual tail
+                                    * when it was decoded with high logit margins */
     int stream_unfixed_chunks;     /* cold-start chunks without prefix (default 2) */
     int stream_max_new_tokens;     /* max generated tokens per streaming step (default 32) */
     int past_text_conditioning;    /* 1=enable past text conditioning in -S/--stream (default: off).
                                     * In segmented mode, this also enables boundary cleanup/post-processing. */
     int skip_silence;              /* 1=drop long silent spans before transcription */
 
+    /* Speculative decoding (optional, batch transcription).
+     * draft_ctx is a second context loaded with the 0.6B model; it drafts
+     * spec_n_draft tokens per step which the main model verifies in one
+     * batched prefill pass. Greedy decoding makes verification exact. */
+    struct qwen_ctx_s *draft_ctx;  /* set via qwen_set_draft_ctx(), not owned */
+    int spec_n_draft;              /* tokens drafted per verify step */
+
     /* Optional prompt/language controls */
     char *prompt;                  /* system prompt text (UTF-8) */
     char *force_language;          /* normalized language name, or NULL */
@@ -240,12 +309,17 @@ typedef struct {
     double perf_audio_ms;          /* input audio duration in milliseconds */
     double perf_encode_ms;         /* mel + encoder time in milliseconds */
     double perf_decode_ms;         /* decoder prefill + decode time in milliseconds */
+    int perf_spec_drafted;         /* draft tokens proposed (speculative mode) */
+    int perf_spec_accepted;        /* draft tokens verified and accepted */
 } qwen_ctx_t;
 
 /* ========================================================================
  * Live Audio (incremental stdin streaming)
  * ======================================================================== */
 
+#define QWEN_LIVE_VAD_WIN 160           /* 10 ms at 16 kHz */
+#define QWEN_LIVE_VAD_LOOKBACK_WINS 3   /* speech edge pad, as compact_silence */
+
 typedef struct {
     /* Written by reader thread under mutex */
     float *samples;
@@ -256,6 +330,34 @@ typedef struct {
     pthread_mutex_t mutex;
     pthread_cond_t cond;
     pthread_t thread;
+
+    /* Online VAD gate (qwen_live_audio_set_vad): drops long silent spans
+     * before they enter the buffer. State below is owned by the pushing
+     * thread; the sample counters are read by the consumer under mutex. */
+    int vad_enabled;
+    float vad_smooth_rms;       /* EMA of 10 ms window RMS */
+    float vad_noise_floor;      /* slow EMA of silent-window RMS */
+    int vad_silence_windows;    /* consecutive silent windows seen */
+    float vad_carry[QWEN_LIVE_VAD_WIN];            /* partial window */
+    int vad_carry_len;
+    float vad_lookback[QWEN_LIVE_VAD_LOOKBACK_WINS * QWEN_LIVE_VAD_WIN];
+    int vad_lookback_len;       /* dropped tail, flushed on voice onset */
+    int64_t vad_in_samples;     /* total samples seen by the gate */
+    int64_t vad_dropped_samples;/* samples gated out */
+
+    /* Input-rate polyphase resampler (qwen_live_audio_set_input_rate):
+     * converts native-rate mic PCM to 16 kHz ahead of the VAD gate, so
+     * pushes can carry 48/44.1 kHz AudioRecord buffers directly. State
+     * is owned by the pushing thread, like the VAD gate above. */
+    int rs_in_rate;             /* input rate (0 or 16000 = passthrough) */
+    int rs_up;                  /* L: upsample factor / number of phases */
+    int rs_down;                /* M: decimation step */
+    int rs_taps;                /* FIR taps per phase */
+    float *rs_coeffs;           /* [L, rs_taps] per-phase taps, time-reversed */
+    float *rs_hist;             /* last rs_taps - 1 input samples */
+    int rs_hist_len;
+    int64_t rs_in_total;        /* input samples received */
+    int64_t rs_out_total;       /* output samples produced */
 } qwen_live_audio_t;
 
 /* ========================================================================
@@ -266,19 +368,48 @@ typedef struct {
  * If not set, defaults to model_dir. */
 void qwen_set_cache_dir(const char *dir);
 
+/* Select INT8 decoder KV cache for contexts created by subsequent
+ * qwen_load() calls (default: off = FP16). Halves KV cache memory and
+ * attention bandwidth at a small accuracy cost; intended for A/B testing
+ * on long streaming sessions. */
+void qwen_set_kv_cache_int8(int enable);
+
 /* Load model from directory */
 qwen_ctx_t *qwen_load(const char *model_dir);
 
 /* Free all resources */
 void qwen_free(qwen_ctx_t *ctx);
 
+/* Create a lightweight session sharing the (immutable) weights of 'base'.
+ * A session owns only its KV cache, scratch buffers and prompt/perf state,
+ * so N sessions cost a few MB each instead of a full model copy. Free with
+ * qwen_free(); all sessions must be freed before their base context. */
+qwen_ctx_t *qwen_session_new(qwen_ctx_t *base);
+
 /* Set a callback to receive each decoded token as it's generated.
  * Set cb=NULL to disable. The callback is invoked during transcription. */
 void qwen_set_token_callback(qwen_ctx_t *ctx, qwen_token_cb cb, void *userdata);
 
+/* Attach a draft model for speculative decoding (batch transcription only).
+ * 'draft' should be a context loaded with the 0.6B model; it must share the
+ * same tokenizer vocabulary as ctx. n_draft is the number of tokens drafted
+ * per verify step (<=0 selects the default of 4). Pass draft=NULL to detach.
+ * The draft context is not owned and must outlive ctx's transcription calls. */
+void qwen_set_draft_ctx(qwen_ctx_t *ctx, qwen_ctx_t *draft, int n_draft);
+
 /* Transcribe from raw audio samples (mono float32, 16kHz) */
 char *qwen_transcribe_audio(qwen_ctx_t *ctx, const float *samples, int n_samples);
 
+/* Transcribe n independent clips over sessions sharing one weight set
+ * (qwen_session_new). Decode steps are interleaved so each Q4_K weight
+ * pass amortizes across all still-active clips. Each clip is transcribed
+ * as a single segment (intended for short utterances). out_texts[i]
+ * receives a malloc'd string or NULL on per-clip failure.
+ * Returns 0 on success, -1 if the batch could not be set up. */
+int qwen_transcribe_audio_batch(qwen_ctx_t **sessions, int n,
+                                const float **samples, const int *n_samples,
+                                char **out_texts);
+
 /* Live streaming transcription from an incrementally-filled audio source.
  * The streaming loop waits for new data instead of terminating at EOF.
  * Tokens are emitted via the token callback as they become "fixed". */
@@ -310,14 +441,47 @@ int qwen_encoder_stem_tokens(int chunk_w);
 /* Decoder prefill (multiple tokens) */
 void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_len);
 
+/* Decoder prefill that also returns the greedy token at every position
+ * (speculative-decode verify pass). out_tokens: [seq_len]. Returns 0 on
+ * success, -1 on allocation failure. */
+int qwen_decoder_prefill_argmax(qwen_ctx_t *ctx, const float *input_embeds,
+                                int seq_len, int *out_tokens);
+
+/* Snapshot the first n positions of the decoder KV cache (the prompt
+ * prefix) so later utterances can skip re-prefilling them. Requires
+ * kv_cache_len >= n. Returns 0 on success, -1 on failure (no snapshot). */
+int qwen_decoder_snapshot_prefix(qwen_ctx_t *ctx, int n);
+
+/* Restore a prefix snapshot taken with the same length n. Sets
+ * kv_cache_len = n and returns n; returns 0 (and leaves the cache
+ * untouched) when no matching snapshot exists. */
+int qwen_decoder_restore_prefix(qwen_ctx_t *ctx, int n);
+
+/* Drop the prefix snapshot (prompt changed or context is being freed). */
+void qwen_decoder_drop_prefix(qwen_ctx_t *ctx);
+
+/* Evict cache positions [start, start + n) in place, keeping the KV of the
+ * surviving positions valid: their stored RoPE rotations are untouched and
+ * kv_pos_offset advances by n so later tokens keep counting from the
+ * pre-eviction position numbering. Streaming uses this to drop the oldest
+ * encoder window's span without re-prefilling everything behind it. */
+void qwen_decoder_evict_kv(qwen_ctx_t *ctx, int start, int n);
+
 /* Decoder forward (single token, uses KV cache, returns greedy token) */
 int qwen_decoder_forward(qwen_ctx_t *ctx, const float *input_embed);
 
+/* Advance n weight-sharing sessions by one token each in a single batched
+ * pass. input_embeds: [n, dec_hidden]. out_tokens: [n] greedy tokens.
+ * Returns 0 on success, -1 on allocation failure. */
+int qwen_decoder_forward_batch(qwen_ctx_t **sess, int n,
+                               const float *input_embeds, int *out_tokens);
+
 /* Global verbose flag */
 extern int qwen_verbose;
 
 /* Monitor mode: show inline Unicode symbols on stderr for streaming diagnostics.
- * Symbols: ▶ encoder  · prefill  ▪ decode  ▸ slow decode  ⟳ window eviction */
+ * Symbols: ▶ encoder  · prefill  ▪ decode  ▸ slow decode  ⟳ window eviction
+ * (machine-readable equivalent: the JSONL/ATrace mode in qwen_asr_trace.h) */
 extern int qwen_monitor;
 
 #endif /* QWEN_ASR_H */
@@ -12,13 +12,19 @@
  */
 
 #include "qwen_asr_audio.h"
+#include "qwen_asr_dsp_tables.h"
 #include "qwen_asr_kernels.h"
+#include "qwen_asr_perf.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <limits.h>
 
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -229,75 +235,23 @@ float *qwen_read_pcm_stdin(int *out_n_samples) {
     return samples;
 }
 
-/* ========================================================================
- * Mel Filter Bank (Slaney-style)
- * ======================================================================== */
-
-static float hertz_to_mel(float freq) {
-    const float min_log_hertz = 1000.0f;
-    const float min_log_mel = 15.0f;
-    const float logstep = 27.0f / logf(6.4f);
-    float mels = 3.0f * freq / 200.0f;
-    if (freq >= min_log_hertz) mels = min_log_mel + logf(freq / min_log_hertz) * logstep;
-    return mels;
-}
-
-static float mel_to_hertz(float mels) {
-    const float min_log_hertz = 1000.0f;
-    const float min_log_mel = 15.0f;
-    const float logstep = logf(6.4f) / 27.0f;
-    float freq = 200.0f * mels / 3.0f;
-    if (mels >= min_log_mel) freq = min_log_hertz * expf(logstep * (mels - min_log_mel));
-    return freq;
-}
-
-static float *build_mel_filters(void) {
-    float *filters = (float *)calloc((size_t)N_MEL * N_FREQ, sizeof(float));
-    if (!filters) return NULL;
-
-    float fft_freqs[N_FREQ];
-    for (int i = 0; i < N_FREQ; i++)
-        fft_freqs[i] = (float)i * ((float)SAMPLE_RATE / 2.0f) / (float)(N_FREQ - 1);
-
-    float mel_min = hertz_to_mel(0.0f);
-    float mel_max = hertz_to_mel((float)SAMPLE_RATE / 2.0f);
-
-    float filter_freqs[N_MEL + 2];
-    float filter_diff[N_MEL + 1];
-    for (int i = 0; i < N_MEL + 2; i++) {
-        float mel = mel_min + (mel_max - mel_min) * (float)i / (float)(N_MEL + 1);
-        filter_freqs[i] = mel_to_hertz(mel);
-    }
-    for (int i = 0; i < N_MEL + 1; i++) {
-        filter_diff[i] = filter_freqs[i + 1] - filter_freqs[i];
-        if (filter_diff[i] == 0.0f) filter_diff[i] = 1e-6f;
-    }
-
-    for (int m = 0; m < N_MEL; m++) {
-        float enorm = 2.0f / (filter_freqs[m + 2] - filter_freqs[m]);
-        for (int f = 0; f < N_FREQ; f++) {
-            float down = (fft_freqs[f] - filter_freqs[m]) / filter_diff[m];
-            float up = (filter_freqs[m + 2] - fft_freqs[f]) / filter_diff[m + 1];
-            float val = fminf(down, up);
-            if (val < 0.0f) val = 0.0f;
-            filters[(size_t)m * N_FREQ + f] = val * enorm;
-        }
-    }
-    return filters;
-}
-
 /* ========================================================================
  * Mel Spectrogram (dynamic max, returns [128, n_frames])
+ *
+ * The Hann window, FFT bit-reversal/twiddle tables, and the Slaney mel
+ * filterbank are all fixed by the constants above, so they live in .rodata
+ * (qwen_asr_dsp_tables.h, emitted by gen_dsp_tables.c) instead of being
+ * rebuilt at runtime. The filterbank is stored sparse: each triangle only
+ * touches a short contiguous run of FFT bins.
  * ======================================================================== */
 
-/* Radix-2 Cooley-Tukey FFT (in-place, decimation-in-time).
- * N must be a power of 2. re[] and im[] are length N. */
-static void fft_radix2(float *re, float *im, int N) {
-    /* Bit-reversal permutation */
-    for (int i = 1, j = 0; i < N; i++) {
-        int bit = N >> 1;
-        for (; j & bit; bit >>= 1) j ^= bit;
-        j ^= bit;
+/* Radix-2 Cooley-Tukey FFT (in-place, decimation-in-time) with precomputed
+ * tables. N must be a power of 2; the butterfly inner loop is NEON
+ * vectorized once the stage half-width reaches 4. */
+static void fft_radix2(float *re, float *im, int N, const uint16_t *brev,
+                       const float *tw_re, const float *tw_im) {
+    for (int i = 0; i < N; i++) {
+        int j = brev[i];
         if (i < j) {
             float t;
             t = re[i]; re[i] = re[j]; re[j] = t;
@@ -305,31 +259,78 @@ static void fft_radix2(float *re, float *im, int N) {
         }
     }
 
-    /* Butterfly stages */
+    const float *twr = tw_re;
+    const float *twi = tw_im;
     for (int len = 2; len <= N; len <<= 1) {
-        float angle = -2.0f * (float)M_PI / (float)len;
-        float wR = cosf(angle), wI = sinf(angle);
+        int half = len / 2;
         for (int i = 0; i < N; i += len) {
-            float tR = 1.0f, tI = 0.0f;
-            for (int j = 0; j < len / 2; j++) {
+            int j = 0;
+#ifdef __ARM_NEON
+            for (; j + 4 <= half; j += 4) {
+                float32x4_t tR = vld1q_f32(twr + j);
+                float32x4_t tI = vld1q_f32(twi + j);
+                float32x4_t uR = vld1q_f32(re + i + j);
+                float32x4_t uI = vld1q_f32(im + i + j);
+                float32x4_t aR = vld1q_f32(re + i + j + half);
+                float32x4_t aI = vld1q_f32(im + i + j + half);
+                float32x4_t vR = vfmaq_f32(vnegq_f32(vmulq_f32(aI, tI)), aR, tR);
+                float32x4_t vI = vfmaq_f32(vmulq_f32(aI, tR), aR, tI);
+                vst1q_f32(re + i + j, vaddq_f32(uR, vR));
+                vst1q_f32(im + i + j, vaddq_f32(uI, vI));
+                vst1q_f32(re + i + j + half, vsubq_f32(uR, vR));
+                vst1q_f32(im + i + j + half, vsubq_f32(uI, vI));
+            }
+#endif
+            for (; j < half; j++) {
+                float tR = twr[j], tI = twi[j];
                 float uR = re[i + j], uI = im[i + j];
-                float vR = re[i + j + len/2] * tR - im[i + j + len/2] * tI;
-                float vI = re[i + j + len/2] * tI + im[i + j + len/2] * tR;
+                float vR = re[i + j + half] * tR - im[i + j + half] * tI;
+                float vI = re[i + j + half] * tI + im[i + j + half] * tR;
                 re[i + j] = uR + vR;
                 im[i + j] = uI + vI;
-                re[i + j + len/2] = uR - vR;
-                im[i + j + len/2] = uI - vI;
-                float newT = tR * wR - tI * wI;
-                tI = tR * wI + tI * wR;
-                tR = newT;
+                re[i + j + half] = uR - vR;
+                im[i + j + half] = uI - vI;
             }
         }
+        twr += half;
+        twi += half;
+    }
+}
+
+/* Compute one log-mel column: window the frame at padded[start], FFT,
+ * power spectrum, filterbank, log10. Writes N_MEL values to out. */
+static void mel_frame(const float *padded, int start, float *out) {
+    float fft_re[N_FFT];
+    float fft_im[N_FFT];
+    float power[N_FREQ];
+
+    /* Window and zero-pad to N_FFT */
+    for (int i = 0; i < WIN_LENGTH; i++)
+        fft_re[i] = padded[start + i] * qwen_dsp_hann_window[i];
+    for (int i = WIN_LENGTH; i < N_FFT; i++)
+        fft_re[i] = 0.0f;
+    memset(fft_im, 0, N_FFT * sizeof(float));
+
+    fft_radix2(fft_re, fft_im, N_FFT, qwen_dsp_fft_brev,
+               qwen_dsp_fft_tw_re, qwen_dsp_fft_tw_im);
+
+    /* Power spectrum (first N_FREQ = N_FFT/2+1 bins) */
+    for (int k = 0; k < N_FREQ; k++)
+        power[k] = fft_re[k] * fft_re[k] + fft_im[k] * fft_im[k];
+
+    for (int m = 0; m < N_MEL; m++) {
+        const float *filt = qwen_dsp_mel_vals + qwen_dsp_mel_off[m];
+        const float *pw = power + qwen_dsp_mel_start[m];
+        float sum = 0.0f;
+        for (int k = 0; k < qwen_dsp_mel_len[m]; k++) sum += filt[k] * pw[k];
+        if (sum < 1e-10f) sum = 1e-10f;
+        out[m] = log10f(sum);
     }
 }
 
 float *qwen_mel_spectrogram(const float *samples, int n_samples, int *out_frames,
                             float *preset_global_max) {
-    int n_freqs = N_FREQ;
+    uint64_t perf_t0 = qwen_perf_tic();
     int pad_len = WIN_LENGTH / 2; /* center=True padding (reflect), based on window size */
 
     /* Reflect-pad the signal */
@@ -353,49 +354,18 @@ float *qwen_mel_spectrogram(const float *samples, int n_samples, int *out_frames
         return NULL;
     }
 
-    float *mel_filters = build_mel_filters();
-    if (!mel_filters) { free(padded); return NULL; }
-
-    /* Periodic Hann window */
-    float window[WIN_LENGTH];
-    for (int i = 0; i < WIN_LENGTH; i++)
-        window[i] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * (float)i / (float)WIN_LENGTH));
-
     /* First pass: compute mel values and find global max.
      * Store as [n_frames, N_MEL] temporarily for convenient max search. */
     float *mel_tmp = (float *)calloc(n_frames * N_MEL, sizeof(float));
-    float fft_re[N_FFT];
-    float fft_im[N_FFT];
-    float power[N_FREQ];
     int use_preset_max = (preset_global_max && *preset_global_max > -1e20f);
     float global_max = use_preset_max ? *preset_global_max : -1e30f;
 
     for (int t = 0; t < n_frames; t++) {
-        int start = t * HOP_LENGTH;
-
-        /* Window and zero-pad to N_FFT */
-        for (int i = 0; i < WIN_LENGTH; i++)
-            fft_re[i] = padded[start + i] * window[i];
-        for (int i = WIN_LENGTH; i < N_FFT; i++)
-            fft_re[i] = 0.0f;
-        memset(fft_im, 0, N_FFT * sizeof(float));
-
-        /* In-place radix-2 FFT */
-        fft_radix2(fft_re, fft_im, N_FFT);
-
-        /* Power spectrum (first N_FREQ = N_FFT/2+1 bins) */
-        for (int k = 0; k < n_freqs; k++) {
-            power[k] = fft_re[k] * fft_re[k] + fft_im[k] * fft_im[k];
-        }
-
-        for (int m = 0; m < N_MEL; m++) {
-            float sum = 0.0f;
-            const float *filt = mel_filters + (size_t)m * n_freqs;
-            for (int k = 0; k < n_freqs; k++) sum += filt[k] * power[k];
-            if (sum < 1e-10f) sum = 1e-10f;
-            float val = log10f(sum);
-            mel_tmp[t * N_MEL + m] = val;
-            if (!use_preset_max && val > global_max) global_max = val;
+        float *row = mel_tmp + (size_t)t * N_MEL;
+        mel_frame(padded, t * HOP_LENGTH, row);
+        if (!use_preset_max) {
+            for (int m = 0; m < N_MEL; m++)
+                if (row[m] > global_max) global_max = row[m];
         }
     }
 
@@ -419,9 +389,116 @@ float *qwen_mel_spectrogram(const float *samples, int n_samples, int *out_frames
 
     free(mel_tmp);
     free(padded);
-    free(mel_filters);
 
     *out_frames = n_frames;
+    qwen_perf_toc(QWEN_PERF_MEL, perf_t0);
+    return mel;
+}
+
+/* ========================================================================
+ * Streaming Mel: frame cache for growing spans
+ * ======================================================================== */
+
+struct qwen_mel_stream_s {
+    float *rows;                    /* cached un-normalized frames, [cap, N_MEL] */
+    int rows_cap;
+    int n_stable;                   /* cached frames that needed no right pad */
+    int n_samples_prev;
+};
+
+qwen_mel_stream_t *qwen_mel_stream_create(void) {
+    return (qwen_mel_stream_t *)calloc(1, sizeof(qwen_mel_stream_t));
+}
+
+void qwen_mel_stream_reset(qwen_mel_stream_t *ms) {
+    if (!ms) return;
+    ms->n_stable = 0;
+    ms->n_samples_prev = 0;
+}
+
+void qwen_mel_stream_free(qwen_mel_stream_t *ms) {
+    if (!ms) return;
+    free(ms->rows);
+    free(ms);
+}
+
+float *qwen_mel_stream_process(qwen_mel_stream_t *ms, const float *samples, int n_samples,
+                               int *out_frames, float *preset_global_max) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    int pad_len = WIN_LENGTH / 2;
+    int padded_len = n_samples + 2 * pad_len;
+    int n_frames = (padded_len - WIN_LENGTH) / HOP_LENGTH; /* total - 1 (drop last) */
+    if (n_frames <= 0) {
+        fprintf(stderr, "qwen_mel_stream_process: audio too short (%d samples)\n", n_samples);
+        return NULL;
+    }
+
+    /* The cache assumes the span only grows in place; a shorter span means
+     * the caller moved to a new position without resetting. */
+    if (n_samples < ms->n_samples_prev) qwen_mel_stream_reset(ms);
+
+    if (n_frames > ms->rows_cap) {
+        int new_cap = ms->rows_cap > 0 ? ms->rows_cap : 256;
+        while (new_cap < n_frames) new_cap *= 2;
+        float *tmp = (float *)realloc(ms->rows, (size_t)new_cap * N_MEL * sizeof(float));
+        if (!tmp) return NULL;
+        ms->rows = tmp;
+        ms->rows_cap = new_cap;
+    }
+
+    /* Reflect-pad the full span (cheap next to the FFT work we skip) */
+    float *padded = (float *)malloc((size_t)padded_len * sizeof(float));
+    if (!padded) return NULL;
+    for (int i = 0; i < pad_len; i++) {
+        int src = pad_len - i;
+        padded[i] = (src < n_samples) ? samples[src] : 0.0f;
+    }
+    memcpy(padded + pad_len, samples, (size_t)n_samples * sizeof(float));
+    for (int i = 0; i < pad_len; i++) {
+        int src = n_samples - 2 - i;
+        padded[pad_len + n_samples + i] = (src >= 0) ? samples[src] : 0.0f;
+    }
+
+    /* Frame t covers span samples [t*HOP - pad, t*HOP + pad); it is final
+     * once the right edge needs no reflect padding. Cached final frames are
+     * reused; only the unstable tail and the newly arrived frames run the
+     * FFT. */
+    for (int t = ms->n_stable; t < n_frames; t++) {
+        mel_frame(padded, t * HOP_LENGTH, ms->rows + (size_t)t * N_MEL);
+    }
+    int n_stable = (n_samples >= pad_len) ? (n_samples - pad_len) / HOP_LENGTH + 1 : 0;
+    if (n_stable > n_frames) n_stable = n_frames;
+    ms->n_stable = n_stable;
+    ms->n_samples_prev = n_samples;
+    free(padded);
+
+    int use_preset_max = (preset_global_max && *preset_global_max > -1e20f);
+    float global_max = use_preset_max ? *preset_global_max : -1e30f;
+    if (!use_preset_max) {
+        for (int t = 0; t < n_frames; t++) {
+            const float *row = ms->rows + (size_t)t * N_MEL;
+            for (int m = 0; m < N_MEL; m++)
+                if (row[m] > global_max) global_max = row[m];
+        }
+        if (preset_global_max) *preset_global_max = global_max;
+    }
+
+    /* Clamp + normalize into the [N_MEL, n_frames] layout of
+     * qwen_mel_spectrogram. */
+    float *mel = (float *)malloc((size_t)N_MEL * n_frames * sizeof(float));
+    if (!mel) return NULL;
+    float min_val = global_max - 8.0f;
+    for (int t = 0; t < n_frames; t++) {
+        const float *row = ms->rows + (size_t)t * N_MEL;
+        for (int m = 0; m < N_MEL; m++) {
+            float val = row[m];
+            if (val < min_val) val = min_val;
+            mel[(size_t)m * n_frames + t] = (val + 4.0f) / 4.0f;
+        }
+    }
+
+    *out_frames = n_frames;
+    qwen_perf_toc(QWEN_PERF_MEL, perf_t0);
     return mel;
 }
 
@@ -431,31 +508,290 @@ float *qwen_mel_spectrogram(const float *samples, int n_samples, int *out_frames
 
 #include <pthread.h>
 
-/* Append n_new float samples to la->samples under mutex + signal condvar. */
-void qwen_live_audio_push(qwen_live_audio_t *la, const float *data, int n_new) {
-    if (!la || !data || n_new <= 0) return;
-
-    pthread_mutex_lock(&la->mutex);
+/* Grow la->samples and append. Caller must hold la->mutex. */
+static int live_audio_append_locked(qwen_live_audio_t *la, const float *data, int n_new) {
     int64_t need = la->n_samples + (int64_t)n_new;
     if (need > la->capacity) {
         int64_t new_cap = la->capacity > 0 ? la->capacity : 32000;
         while (new_cap < need) new_cap *= 2;
-        if ((uint64_t)new_cap > (uint64_t)(SIZE_MAX / sizeof(float))) {
-            pthread_mutex_unlock(&la->mutex);
-            return;
-        }
+        if ((uint64_t)new_cap > (uint64_t)(SIZE_MAX / sizeof(float)))
+            return -1;
         float *tmp = (float *)realloc(la->samples, (size_t)new_cap * sizeof(float));
-        if (!tmp) {
-            pthread_mutex_unlock(&la->mutex);
-            return;
-        }
+        if (!tmp)
+            return -1;
         la->samples = tmp;
         la->capacity = new_cap;
     }
     memcpy(la->samples + (size_t)la->n_samples, data, (size_t)n_new * sizeof(float));
     la->n_samples += n_new;
+    return 0;
+}
+
+/* Online VAD gate: process complete 10 ms windows from in[] and write the
+ * windows that pass the gate to out[] (sized n_in + WIN + lookback).
+ * Mirrors compact_silence: smoothed RMS against an adaptive noise floor,
+ * the first 600 ms of each silent span passes (natural pauses), and a
+ * short lookback of dropped audio is flushed on voice onset so speech
+ * edges aren't clipped. Runs on the pushing thread; no lock needed. */
+static int live_vad_filter(qwen_live_audio_t *la, const float *in, int n_in, float *out) {
+    const float base_thresh = 0.002f;   /* ~ -54 dBFS, as compact_silence */
+    const float max_thresh = 0.025f;
+    const float smooth_alpha = 0.2f;
+    const float floor_alpha = 0.05f;    /* slow noise-floor tracking */
+    const int pass_windows = 60;        /* keep first 600 ms of silence */
+
+    int n_out = 0;
+    int consumed = 0;
+
+    while (consumed < n_in || la->vad_carry_len == QWEN_LIVE_VAD_WIN) {
+        /* Fill the carry window */
+        int take = QWEN_LIVE_VAD_WIN - la->vad_carry_len;
+        if (take > n_in - consumed) take = n_in - consumed;
+        if (take > 0) {
+            memcpy(la->vad_carry + la->vad_carry_len, in + consumed,
+                   (size_t)take * sizeof(float));
+            la->vad_carry_len += take;
+            consumed += take;
+        }
+        if (la->vad_carry_len < QWEN_LIVE_VAD_WIN) break;
+
+        float energy = 0.0f;
+        for (int i = 0; i < QWEN_LIVE_VAD_WIN; i++)
+            energy += la->vad_carry[i] * la->vad_carry[i];
+        float rms = sqrtf(energy / (float)QWEN_LIVE_VAD_WIN);
+
+        if (la->vad_in_samples == 0)
+            la->vad_smooth_rms = rms;
+        la->vad_smooth_rms = (1.0f - smooth_alpha) * la->vad_smooth_rms +
+                             smooth_alpha * rms;
+        la->vad_in_samples += QWEN_LIVE_VAD_WIN;
+
+        float thresh = la->vad_noise_floor * 1.8f;
+        if (thresh < base_thresh) thresh = base_thresh;
+        if (thresh > max_thresh) thresh = max_thresh;
+        int voiced = la->vad_smooth_rms > thresh;
+
+        if (!voiced) {
+            if (la->vad_noise_floor <= 0.0f)
+                la->vad_noise_floor = la->vad_smooth_rms;
+            else
+                la->vad_noise_floor = (1.0f - floor_alpha) * la->vad_noise_floor +
+                                      floor_alpha * la->vad_smooth_rms;
+        }
+
+        if (voiced) {
+            /* Speech edge pad: flush the recently dropped tail first */
+            if (la->vad_lookback_len > 0) {
+                memcpy(out + n_out, la->vad_lookback,
+                       (size_t)la->vad_lookback_len * sizeof(float));
+                n_out += la->vad_lookback_len;
+                la->vad_dropped_samples -= la->vad_lookback_len;
+                la->vad_lookback_len = 0;
+            }
+            la->vad_silence_windows = 0;
+            memcpy(out + n_out, la->vad_carry,
+                   QWEN_LIVE_VAD_WIN * sizeof(float));
+            n_out += QWEN_LIVE_VAD_WIN;
+        } else {
+            la->vad_silence_windows++;
+            if (la->vad_silence_windows <= pass_windows) {
+                memcpy(out + n_out, la->vad_carry,
+                       QWEN_LIVE_VAD_WIN * sizeof(float));
+                n_out += QWEN_LIVE_VAD_WIN;
+            } else {
+                /* Drop, keeping the tail for the voice-onset flush */
+                const int lb_cap = QWEN_LIVE_VAD_LOOKBACK_WINS * QWEN_LIVE_VAD_WIN;
+                if (la->vad_lookback_len == lb_cap) {
+                    memmove(la->vad_lookback,
+                            la->vad_lookback + QWEN_LIVE_VAD_WIN,
+                            (size_t)(lb_cap - QWEN_LIVE_VAD_WIN) * sizeof(float));
+                    la->vad_lookback_len -= QWEN_LIVE_VAD_WIN;
+                }
+                memcpy(la->vad_lookback + la->vad_lookback_len, la->vad_carry,
+                       QWEN_LIVE_VAD_WIN * sizeof(float));
+                la->vad_lookback_len += QWEN_LIVE_VAD_WIN;
+                la->vad_dropped_samples += QWEN_LIVE_VAD_WIN;
+            }
+        }
+        la->vad_carry_len = 0;
+    }
+    return n_out;
+}
+
+/* ---- Input-rate polyphase resampler ----
+ * Rational L/M resampling (48k: 1/3, 44.1k: 160/441) with a Kaiser-windowed
+ * sinc prototype designed at the upsampled rate. Phase p of output n uses
+ * taps h[kL + p]; taps are stored time-reversed per phase so the inner loop
+ * is a contiguous forward dot over the input history. */
+
+/* I0 (modified Bessel, first kind, order 0) — power series, fast for beta <= 10 */
+static double live_rs_bessel_i0(double x) {
+    double sum = 1.0, term = 1.0, xx = x * x;
+    for (int k = 1; k <= 20; k++) {
+        term *= xx / (4.0 * (double)k * (double)k);
+        sum += term;
+    }
+    return sum;
+}
+
+static inline float live_rs_dot(const float *a, const float *b, int n) {
+#ifdef __ARM_NEON
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = vfmaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    float sum = vaddvq_f32(acc);
+    for (; i < n; i++) sum += a[i] * b[i];
+    return sum;
+#else
+    float sum = 0.0f;
+    for (int i = 0; i < n; i++) sum += a[i] * b[i];
+    return sum;
+#endif
+}
+
+int qwen_live_audio_set_input_rate(qwen_live_audio_t *la, int sample_rate) {
+    if (!la) return -1;
+
+    free(la->rs_coeffs); la->rs_coeffs = NULL;
+    free(la->rs_hist);   la->rs_hist = NULL;
+    la->rs_in_rate = 0;
+    la->rs_up = la->rs_down = la->rs_taps = 0;
+    la->rs_hist_len = 0;
+    la->rs_in_total = la->rs_out_total = 0;
+
+    if (sample_rate == 0 || sample_rate == SAMPLE_RATE) return 0;
+
+    int L, M, taps;
+    if (sample_rate == 48000)      { L = 1;   M = 3;   taps = 64; }
+    else if (sample_rate == 44100) { L = 160; M = 441; taps = 32; }
+    else return -1;
+
+    const double KAISER_BETA = 6.0;
+    int proto_len = taps * L;
+    double center = (double)(proto_len - 1) / 2.0;
+    /* Cutoff just under the output Nyquist (in the upsampled domain) so the
+     * transition band stays inside it: content above ~7.3 kHz is attenuated
+     * rather than aliased, which is the right trade for speech. */
+    double cutoff = 0.91 / (double)(L > M ? L : M);
+    double inv_i0_beta = 1.0 / live_rs_bessel_i0(KAISER_BETA);
+
+    la->rs_coeffs = (float *)malloc((size_t)L * taps * sizeof(float));
+    la->rs_hist = (float *)malloc((size_t)(taps - 1) * sizeof(float));
+    if (!la->rs_coeffs || !la->rs_hist) {
+        free(la->rs_coeffs); la->rs_coeffs = NULL;
+        free(la->rs_hist);   la->rs_hist = NULL;
+        return -1;
+    }
+
+    for (int p = 0; p < L; p++) {
+        for (int k = 0; k < taps; k++) {
+            int n = k * L + p;
+            double d = ((double)n - center) * cutoff;
+            double s = (fabs(d) < 1e-9) ? 1.0 : sin(M_PI * d) / (M_PI * d);
+            double npos = ((double)n - center) / center;
+            double w = (npos <= -1.0 || npos >= 1.0)
+                           ? 0.0
+                           : live_rs_bessel_i0(KAISER_BETA * sqrt(1.0 - npos * npos)) *
+                                 inv_i0_beta;
+            /* Gain L preserves amplitude through the zero-stuffed upsample;
+             * time-reversed storage makes the dot a forward scan. */
+            la->rs_coeffs[(size_t)p * taps + (taps - 1 - k)] =
+                (float)(s * w * cutoff * (double)L);
+        }
+    }
+
+    la->rs_in_rate = sample_rate;
+    la->rs_up = L;
+    la->rs_down = M;
+    la->rs_taps = taps;
+    return 0;
+}
+
+/* Resample a pushed chunk. out must hold n_in * L / M + 2 samples.
+ * Runs on the pushing thread; history carries the FIR tail across pushes. */
+static int live_resample(qwen_live_audio_t *la, const float *in, int n_in, float *out) {
+    int T = la->rs_taps, L = la->rs_up, M = la->rs_down;
+    int nbuf = la->rs_hist_len + n_in;
+
+    float *buf = (float *)malloc((size_t)nbuf * sizeof(float));
+    if (!buf) return 0;
+    memcpy(buf, la->rs_hist, (size_t)la->rs_hist_len * sizeof(float));
+    memcpy(buf + la->rs_hist_len, in, (size_t)n_in * sizeof(float));
+
+    int64_t base = la->rs_in_total - la->rs_hist_len;  /* global index of buf[0] */
+    la->rs_in_total += n_in;
+    int64_t end = la->rs_in_total;
+
+    int n_out = 0;
+    int64_t no = la->rs_out_total;
+    for (;;) {
+        int64_t up = no * M;            /* position in the upsampled domain */
+        int64_t m = up / L;             /* newest input sample under the FIR */
+        int phase = (int)(up % L);
+        if (m >= end) break;
+
+        const float *tap = la->rs_coeffs + (size_t)phase * T;
+        int64_t w0 = m - T + 1;         /* oldest input sample under the FIR */
+        if (w0 < base) {
+            /* Stream start: window extends before the first sample */
+            int skip = (int)(base - w0);
+            out[n_out++] = live_rs_dot(tap + skip, buf, T - skip);
+        } else {
+            out[n_out++] = live_rs_dot(tap, buf + (size_t)(w0 - base), T);
+        }
+        no++;
+    }
+    la->rs_out_total = no;
+
+    int keep = T - 1;
+    if (keep > nbuf) keep = nbuf;
+    memcpy(la->rs_hist, buf + nbuf - keep, (size_t)keep * sizeof(float));
+    la->rs_hist_len = keep;
+    free(buf);
+    return n_out;
+}
+
+/* Append n_new float samples to la->samples under mutex + signal condvar. */
+void qwen_live_audio_push(qwen_live_audio_t *la, const float *data, int n_new) {
+    if (!la || !data || n_new <= 0) return;
+
+    float *resampled = NULL;
+    if (la->rs_in_rate) {
+        size_t cap = (size_t)n_new * la->rs_up / la->rs_down + 2;
+        resampled = (float *)malloc(cap * sizeof(float));
+        if (resampled) {
+            n_new = live_resample(la, data, n_new, resampled);
+            if (n_new <= 0) {
+                free(resampled);
+                return;
+            }
+            data = resampled;
+        }
+    }
+
+    float *filtered = NULL;
+    if (la->vad_enabled) {
+        size_t cap = (size_t)n_new + QWEN_LIVE_VAD_WIN +
+                     QWEN_LIVE_VAD_LOOKBACK_WINS * QWEN_LIVE_VAD_WIN;
+        filtered = (float *)malloc(cap * sizeof(float));
+        if (filtered) {
+            n_new = live_vad_filter(la, data, n_new, filtered);
+            if (n_new <= 0) {
+                free(filtered);
+                free(resampled);
+                return;
+            }
+            data = filtered;
+        }
+    }
+
+    pthread_mutex_lock(&la->mutex);
+    live_audio_append_locked(la, data, n_new);
     pthread_cond_signal(&la->cond);
     pthread_mutex_unlock(&la->mutex);
+    free(filtered);
+    free(resampled);
 }
 
 /* Convert a chunk of s16le bytes to float samples and append. */
@@ -490,10 +826,28 @@ qwen_live_audio_t *qwen_live_audio_create(void) {
     return la;
 }
 
+/* Enable/disable the online VAD gate (resets gate state). */
+void qwen_live_audio_set_vad(qwen_live_audio_t *la, int enable) {
+    if (!la) return;
+    la->vad_enabled = enable ? 1 : 0;
+    la->vad_smooth_rms = 0.0f;
+    la->vad_noise_floor = 0.0f;
+    la->vad_silence_windows = 0;
+    la->vad_carry_len = 0;
+    la->vad_lookback_len = 0;
+    la->vad_in_samples = 0;
+    la->vad_dropped_samples = 0;
+}
+
 /* Signal end-of-stream. */
 void qwen_live_audio_signal_eof(qwen_live_audio_t *la) {
     if (!la) return;
     pthread_mutex_lock(&la->mutex);
+    /* Flush the VAD partial window so trailing speech isn't lost */
+    if (la->vad_enabled && la->vad_carry_len > 0) {
+        live_audio_append_locked(la, la->vad_carry, la->vad_carry_len);
+        la->vad_carry_len = 0;
+    }
     la->eof = 1;
     pthread_cond_signal(&la->cond);
     pthread_mutex_unlock(&la->mutex);
@@ -507,6 +861,11 @@ void qwen_live_audio_reset(qwen_live_audio_t *la) {
     la->sample_offset = 0;
     la->eof = 0;
     pthread_mutex_unlock(&la->mutex);
+    /* Restart the resampler stream (pushing thread must be idle, as with
+     * the VAD gate) */
+    la->rs_hist_len = 0;
+    la->rs_in_total = 0;
+    la->rs_out_total = 0;
 }
 
 typedef struct {
@@ -672,6 +1031,8 @@ void qwen_live_audio_free(qwen_live_audio_t *la) {
     }
     pthread_mutex_destroy(&la->mutex);
     pthread_cond_destroy(&la->cond);
+    free(la->rs_coeffs);
+    free(la->rs_hist);
     free(la->samples);
     free(la);
 }
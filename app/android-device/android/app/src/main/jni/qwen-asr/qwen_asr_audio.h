@@ -34,6 +34,27 @@ float *qwen_read_pcm_stdin(int *out_n_samples);
 float *qwen_mel_spectrogram(const float *samples, int n_samples, int *out_frames,
                             float *preset_global_max);
 
+/* Streaming mel state: persistent Hann window, mel filterbank, FFT twiddle
+ * and bit-reversal tables, plus a cache of finished frames. For a span that
+ * grows in place (the streaming encoder's partial window), only frames not
+ * yet computed — and the tail frames that previously depended on right-edge
+ * reflect padding — run the FFT; everything else is reused. */
+typedef struct qwen_mel_stream_s qwen_mel_stream_t;
+
+qwen_mel_stream_t *qwen_mel_stream_create(void);
+
+/* Invalidate cached frames. Call whenever the span's start sample moves
+ * (window rollover, stream reset). */
+void qwen_mel_stream_reset(qwen_mel_stream_t *ms);
+
+void qwen_mel_stream_free(qwen_mel_stream_t *ms);
+
+/* Same contract and output layout as qwen_mel_spectrogram, but samples must
+ * be the current prefix-stable span for this state (reset first otherwise).
+ * Returns [128, n_frames] (caller must free). */
+float *qwen_mel_stream_process(qwen_mel_stream_t *ms, const float *samples, int n_samples,
+                               int *out_frames, float *preset_global_max);
+
 /* Start a reader thread that incrementally fills a live audio buffer from stdin.
  * Detects WAV vs raw s16le. For WAV, requires 16kHz sample rate.
  * Returns NULL on error. Caller must call qwen_live_audio_free() when done. */
@@ -51,6 +72,20 @@ void qwen_live_audio_push(qwen_live_audio_t *la, const float *samples, int n_sam
  * Converts to float32 internally. Thread-safe. */
 void qwen_live_audio_push_s16(qwen_live_audio_t *la, const int16_t *samples, int n_samples);
 
+/* Declare the sample rate of subsequently pushed audio. 16000 (or 0)
+ * disables resampling; 48000 and 44100 enable a NEON polyphase FIR
+ * resampler that converts to 16kHz inside the push path, ahead of the
+ * VAD gate. Returns 0 on success, -1 on unsupported rates (resampling
+ * stays off). Must be called from the pushing thread or before pushing
+ * starts. */
+int qwen_live_audio_set_input_rate(qwen_live_audio_t *la, int sample_rate);
+
+/* Enable/disable the online VAD gate. When enabled, pushes run an energy
+ * gate (the streaming analog of compact_silence) that drops silent spans
+ * beyond a short pass-through, so silence never reaches the encoder.
+ * Must be toggled from the pushing thread or before pushing starts. */
+void qwen_live_audio_set_vad(qwen_live_audio_t *la, int enable);
+
 /* Signal end-of-stream. The inference loop will finish processing remaining data. */
 void qwen_live_audio_signal_eof(qwen_live_audio_t *la);
 
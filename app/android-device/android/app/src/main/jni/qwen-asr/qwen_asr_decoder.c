@@ -12,6 +12,7 @@
 
 #include "qwen_asr.h"
 #include "qwen_asr_kernels.h"
+#include "qwen_asr_perf.h"
 #include "qwen_asr_safetensors.h"
 #include "qwen_asr_quant.h"
 #include <stdio.h>
@@ -64,7 +65,7 @@ static block_q8_0 *load_bf16_as_q8(multi_safetensors_t *ms, const char *name) {
     return q8;
 }
 
-static block_q4_k *load_bf16_as_q4k(multi_safetensors_t *ms, const char *name) {
+static block_q4_kx4 *load_bf16_as_q4k_x4(multi_safetensors_t *ms, const char *name) {
     safetensors_file_t *sf = NULL;
     const safetensor_t *t = multi_safetensors_find(ms, name, &sf);
     if (!t) {
@@ -78,9 +79,14 @@ static block_q4_k *load_bf16_as_q4k(multi_safetensors_t *ms, const char *name) {
     int rows = t->shape[0];
     int cols = (t->ndim >= 2) ? t->shape[1] : 1;
 
+    /* Quantize row-major, then repack into the 4-row interleaved layout
+     * the decoder matvec/GEMM kernels consume */
     block_q4_k *q4k = NULL;
     quantize_bf16_to_q4k(bf16, rows, cols, &q4k);
-    return q4k;
+    if (!q4k) return NULL;
+    block_q4_kx4 *x4 = qwen_q4k_repack_x4(q4k, rows, cols);
+    free(q4k);
+    return x4;
 }
 
 int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
@@ -99,19 +105,19 @@ int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
         /* Attention weights (bf16 -> Q4_K, no bias) - skip if qcache loaded */
         if (!l->wq_weight_q4k) {
             snprintf(name, sizeof(name), "thinker.model.layers.%d.self_attn.q_proj.weight", i);
-            l->wq_weight_q4k = load_bf16_as_q4k(ms, name);
+            l->wq_weight_q4k = load_bf16_as_q4k_x4(ms, name);
         }
         if (!l->wk_weight_q4k) {
             snprintf(name, sizeof(name), "thinker.model.layers.%d.self_attn.k_proj.weight", i);
-            l->wk_weight_q4k = load_bf16_as_q4k(ms, name);
+            l->wk_weight_q4k = load_bf16_as_q4k_x4(ms, name);
         }
         if (!l->wv_weight_q4k) {
             snprintf(name, sizeof(name), "thinker.model.layers.%d.self_attn.v_proj.weight", i);
-            l->wv_weight_q4k = load_bf16_as_q4k(ms, name);
+            l->wv_weight_q4k = load_bf16_as_q4k_x4(ms, name);
         }
         if (!l->wo_weight_q4k) {
             snprintf(name, sizeof(name), "thinker.model.layers.%d.self_attn.o_proj.weight", i);
-            l->wo_weight_q4k = load_bf16_as_q4k(ms, name);
+            l->wo_weight_q4k = load_bf16_as_q4k_x4(ms, name);
         }
 
         /* Per-head Q/K RMSNorm weights (from safetensors, not cached) */
@@ -129,7 +135,7 @@ int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
         /* SwiGLU MLP down_proj (bf16 -> Q4_K, no bias) */
         if (!l->down_weight_q4k) {
             snprintf(name, sizeof(name), "thinker.model.layers.%d.mlp.down_proj.weight", i);
-            l->down_weight_q4k = load_bf16_as_q4k(ms, name);
+            l->down_weight_q4k = load_bf16_as_q4k_x4(ms, name);
         }
 
         if (!l->wq_weight_q4k || !l->wk_weight_q4k ||
@@ -168,9 +174,14 @@ int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
                        hidden * sizeof(uint16_t));
             }
 
-            /* Quantize fused BF16 -> Q4_K */
-            quantize_bf16_to_q4k(fused_bf16, 2 * inter, hidden, &l->gate_up_fused_q4k);
+            /* Quantize fused BF16 -> Q4_K, then repack to x4 tiles */
+            block_q4_k *fused_q4k = NULL;
+            quantize_bf16_to_q4k(fused_bf16, 2 * inter, hidden, &fused_q4k);
             free(fused_bf16);
+            if (fused_q4k) {
+                l->gate_up_fused_q4k = qwen_q4k_repack_x4(fused_q4k, 2 * inter, hidden);
+                free(fused_q4k);
+            }
 
             if (!l->gate_up_fused_q4k) {
                 fprintf(stderr, "decoder: failed to quantize gate_up for layer %d\n", i);
@@ -202,17 +213,102 @@ int qwen_decoder_load(qwen_decoder_t *dec, multi_safetensors_t *ms,
     return 0;
 }
 
+/* ========================================================================
+ * Hierarchical Argmax Index
+ *
+ * Coarse index over tok_embeddings_q4k for branch-and-bound lm_head
+ * argmax: groups of consecutive token ids (BPE ids are roughly frequency
+ * ordered, so groups are frequency partitions), each described by the
+ * centroid of its dequantized rows and the max row distance to it. Built
+ * once after quantization and persisted in the qcache.
+ * ======================================================================== */
+
+#define ARGMAX_GROUP_SIZE 256
+
+int qwen_decoder_build_argmax_index(qwen_decoder_t *dec, const qwen_config_t *cfg) {
+    int dim = cfg->dec_hidden;
+    int vocab = cfg->vocab_size;
+    int blocks_per_row = dim / QK_K;
+    if (!dec->tok_embeddings_q4k || dec->argmax_centroids) return -1;
+
+    int n_groups = (vocab + ARGMAX_GROUP_SIZE - 1) / ARGMAX_GROUP_SIZE;
+    float *centroids = (float *)calloc((size_t)n_groups * dim, sizeof(float));
+    float *radii = (float *)calloc((size_t)n_groups, sizeof(float));
+    float *row = (float *)malloc((size_t)dim * sizeof(float));
+    if (!centroids || !radii || !row) {
+        free(centroids); free(radii); free(row);
+        return -1;
+    }
+
+    /* Pass 1: group means over dequantized rows */
+    for (int r = 0; r < vocab; r++) {
+        dequantize_q4k_to_f32(dec->tok_embeddings_q4k + (size_t)r * blocks_per_row,
+                              row, dim);
+        float *c = centroids + (size_t)(r / ARGMAX_GROUP_SIZE) * dim;
+        for (int i = 0; i < dim; i++) c[i] += row[i];
+    }
+    for (int g = 0; g < n_groups; g++) {
+        int start = g * ARGMAX_GROUP_SIZE;
+        int count = vocab - start < ARGMAX_GROUP_SIZE ? vocab - start : ARGMAX_GROUP_SIZE;
+        float inv = 1.0f / (float)count;
+        float *c = centroids + (size_t)g * dim;
+        for (int i = 0; i < dim; i++) c[i] *= inv;
+    }
+
+    /* Pass 2: group radius = max ‖row - centroid‖ */
+    for (int r = 0; r < vocab; r++) {
+        dequantize_q4k_to_f32(dec->tok_embeddings_q4k + (size_t)r * blocks_per_row,
+                              row, dim);
+        int g = r / ARGMAX_GROUP_SIZE;
+        const float *c = centroids + (size_t)g * dim;
+        float d2 = 0.0f;
+        for (int i = 0; i < dim; i++) {
+            float d = row[i] - c[i];
+            d2 += d * d;
+        }
+        if (d2 > radii[g]) radii[g] = d2;
+    }
+    for (int g = 0; g < n_groups; g++) radii[g] = sqrtf(radii[g]);
+    free(row);
+
+    dec->argmax_centroids = centroids;
+    dec->argmax_radii = radii;
+    dec->argmax_n_groups = n_groups;
+    dec->argmax_group_size = ARGMAX_GROUP_SIZE;
+
+    if (qwen_verbose >= 1)
+        fprintf(stderr, "decoder: built argmax index (%d groups of %d, %.1f MB)\n",
+                n_groups, ARGMAX_GROUP_SIZE,
+                (double)n_groups * (dim + 1) * sizeof(float) / (1024.0 * 1024.0));
+    return 0;
+}
+
 /* ========================================================================
  * KV Cache Management
  * ======================================================================== */
 
 static int kv_cache_init(qwen_ctx_t *ctx, int max_seq) {
     int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
-    size_t cache_size = (size_t)ctx->config.dec_layers * max_seq * kv_dim * sizeof(uint16_t);
-    ctx->kv_cache_k = (uint16_t *)calloc(1, cache_size);
-    ctx->kv_cache_v = (uint16_t *)calloc(1, cache_size);
+    int layers = ctx->config.dec_layers;
     ctx->kv_cache_len = 0;
     ctx->kv_cache_max = max_seq;
+    ctx->kv_pos_offset = 0;
+
+    if (ctx->kv_cache_int8) {
+        size_t cache_size = (size_t)layers * max_seq * kv_dim;
+        size_t scale_size = (size_t)layers * max_seq * ctx->config.dec_kv_heads * sizeof(float);
+        ctx->kv_cache_k_q8 = (int8_t *)calloc(1, cache_size);
+        ctx->kv_cache_v_q8 = (int8_t *)calloc(1, cache_size);
+        ctx->kv_cache_k_scale = (float *)calloc(1, scale_size);
+        ctx->kv_cache_v_scale = (float *)calloc(1, scale_size);
+        if (!ctx->kv_cache_k_q8 || !ctx->kv_cache_v_q8 ||
+            !ctx->kv_cache_k_scale || !ctx->kv_cache_v_scale) return -1;
+        return 0;
+    }
+
+    size_t cache_size = (size_t)layers * max_seq * kv_dim * sizeof(uint16_t);
+    ctx->kv_cache_k = (uint16_t *)calloc(1, cache_size);
+    ctx->kv_cache_v = (uint16_t *)calloc(1, cache_size);
     if (!ctx->kv_cache_k || !ctx->kv_cache_v) return -1;
     return 0;
 }
@@ -221,19 +317,57 @@ static int kv_cache_grow(qwen_ctx_t *ctx, int required) {
     if (required <= ctx->kv_cache_max) return 0;
 
     int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    int kv_heads = ctx->config.dec_kv_heads;
+    int layers = ctx->config.dec_layers;
     int new_max = ctx->kv_cache_max;
     while (new_max < required) new_max *= 2;
 
+    if (ctx->kv_cache_int8) {
+        size_t new_stride = (size_t)new_max * kv_dim;
+        size_t old_stride = (size_t)ctx->kv_cache_max * kv_dim;
+        size_t new_sstride = (size_t)new_max * kv_heads;
+        size_t old_sstride = (size_t)ctx->kv_cache_max * kv_heads;
+
+        int8_t *new_k = (int8_t *)calloc(1, (size_t)layers * new_stride);
+        int8_t *new_v = (int8_t *)calloc(1, (size_t)layers * new_stride);
+        float *new_ks = (float *)calloc(1, (size_t)layers * new_sstride * sizeof(float));
+        float *new_vs = (float *)calloc(1, (size_t)layers * new_sstride * sizeof(float));
+        if (!new_k || !new_v || !new_ks || !new_vs) {
+            free(new_k); free(new_v); free(new_ks); free(new_vs);
+            return -1;
+        }
+
+        size_t copy = (size_t)ctx->kv_cache_len * kv_dim;
+        size_t scopy = (size_t)ctx->kv_cache_len * kv_heads * sizeof(float);
+        for (int l = 0; l < layers; l++) {
+            memcpy(new_k + l * new_stride, ctx->kv_cache_k_q8 + l * old_stride, copy);
+            memcpy(new_v + l * new_stride, ctx->kv_cache_v_q8 + l * old_stride, copy);
+            memcpy(new_ks + l * new_sstride, ctx->kv_cache_k_scale + l * old_sstride, scopy);
+            memcpy(new_vs + l * new_sstride, ctx->kv_cache_v_scale + l * old_sstride, scopy);
+        }
+
+        free(ctx->kv_cache_k_q8);
+        free(ctx->kv_cache_v_q8);
+        free(ctx->kv_cache_k_scale);
+        free(ctx->kv_cache_v_scale);
+        ctx->kv_cache_k_q8 = new_k;
+        ctx->kv_cache_v_q8 = new_v;
+        ctx->kv_cache_k_scale = new_ks;
+        ctx->kv_cache_v_scale = new_vs;
+        ctx->kv_cache_max = new_max;
+        return 0;
+    }
+
     size_t new_stride = (size_t)new_max * kv_dim;
     size_t old_stride = (size_t)ctx->kv_cache_max * kv_dim;
-    size_t total = (size_t)ctx->config.dec_layers * new_stride * sizeof(uint16_t);
+    size_t total = (size_t)layers * new_stride * sizeof(uint16_t);
 
     uint16_t *new_k = (uint16_t *)calloc(1, total);
     uint16_t *new_v = (uint16_t *)calloc(1, total);
     if (!new_k || !new_v) { free(new_k); free(new_v); return -1; }
 
     size_t copy = (size_t)ctx->kv_cache_len * kv_dim * sizeof(uint16_t);
-    for (int l = 0; l < ctx->config.dec_layers; l++) {
+    for (int l = 0; l < layers; l++) {
         memcpy(new_k + l * new_stride, ctx->kv_cache_k + l * old_stride, copy);
         memcpy(new_v + l * new_stride, ctx->kv_cache_v + l * old_stride, copy);
     }
@@ -256,6 +390,207 @@ static uint16_t *kv_cache_v_at(qwen_ctx_t *ctx, int layer, int pos) {
     return ctx->kv_cache_v + ((size_t)layer * ctx->kv_cache_max + pos) * kv_dim;
 }
 
+/* INT8 cache accessors (valid only when ctx->kv_cache_int8) */
+static int8_t *kv_cache_k_q8_at(qwen_ctx_t *ctx, int layer, int pos) {
+    int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    return ctx->kv_cache_k_q8 + ((size_t)layer * ctx->kv_cache_max + pos) * kv_dim;
+}
+
+static int8_t *kv_cache_v_q8_at(qwen_ctx_t *ctx, int layer, int pos) {
+    int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    return ctx->kv_cache_v_q8 + ((size_t)layer * ctx->kv_cache_max + pos) * kv_dim;
+}
+
+static float *kv_cache_k_scale_at(qwen_ctx_t *ctx, int layer, int pos) {
+    int kv_heads = ctx->config.dec_kv_heads;
+    return ctx->kv_cache_k_scale + ((size_t)layer * ctx->kv_cache_max + pos) * kv_heads;
+}
+
+static float *kv_cache_v_scale_at(qwen_ctx_t *ctx, int layer, int pos) {
+    int kv_heads = ctx->config.dec_kv_heads;
+    return ctx->kv_cache_v_scale + ((size_t)layer * ctx->kv_cache_max + pos) * kv_heads;
+}
+
+/* Store one token's K/V into the cache at (layer, pos) in the active format. */
+static void kv_cache_store(qwen_ctx_t *ctx, int layer, int pos,
+                           const float *k, const float *v) {
+    int kv_heads = ctx->config.dec_kv_heads;
+    int head_dim = ctx->config.dec_head_dim;
+    int kv_dim = kv_heads * head_dim;
+
+    if (ctx->kv_cache_int8) {
+        qwen_f32_to_q8_per_head(kv_cache_k_q8_at(ctx, layer, pos),
+                                 kv_cache_k_scale_at(ctx, layer, pos),
+                                 k, kv_heads, head_dim);
+        qwen_f32_to_q8_per_head(kv_cache_v_q8_at(ctx, layer, pos),
+                                 kv_cache_v_scale_at(ctx, layer, pos),
+                                 v, kv_heads, head_dim);
+    } else {
+        qwen_f32_to_f16(kv_cache_k_at(ctx, layer, pos), k, kv_dim);
+        qwen_f32_to_f16(kv_cache_v_at(ctx, layer, pos), v, kv_dim);
+    }
+}
+
+/* ---- Prompt-prefix KV snapshot ----
+ * One fixed prompt per session means the KV entries for the prompt prefix
+ * are identical across utterances (causal attention, absolute RoPE
+ * positions starting at 0). Snapshot them once, then seed each utterance's
+ * cache with a memcpy instead of a 28-layer prefill of the prefix. */
+
+void qwen_decoder_drop_prefix(qwen_ctx_t *ctx) {
+    free(ctx->prefix_kv_k);       ctx->prefix_kv_k = NULL;
+    free(ctx->prefix_kv_v);       ctx->prefix_kv_v = NULL;
+    free(ctx->prefix_kv_k_q8);    ctx->prefix_kv_k_q8 = NULL;
+    free(ctx->prefix_kv_v_q8);    ctx->prefix_kv_v_q8 = NULL;
+    free(ctx->prefix_kv_k_scale); ctx->prefix_kv_k_scale = NULL;
+    free(ctx->prefix_kv_v_scale); ctx->prefix_kv_v_scale = NULL;
+    ctx->prefix_kv_len = 0;
+}
+
+int qwen_decoder_snapshot_prefix(qwen_ctx_t *ctx, int n) {
+    int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    int kv_heads = ctx->config.dec_kv_heads;
+    int layers = ctx->config.dec_layers;
+
+    if (n <= 0 || n > ctx->kv_cache_len) return -1;
+    qwen_decoder_drop_prefix(ctx);
+
+    if (ctx->kv_cache_int8) {
+        size_t row = (size_t)n * kv_dim;
+        size_t srow = (size_t)n * kv_heads;
+        ctx->prefix_kv_k_q8 = (int8_t *)malloc((size_t)layers * row);
+        ctx->prefix_kv_v_q8 = (int8_t *)malloc((size_t)layers * row);
+        ctx->prefix_kv_k_scale = (float *)malloc((size_t)layers * srow * sizeof(float));
+        ctx->prefix_kv_v_scale = (float *)malloc((size_t)layers * srow * sizeof(float));
+        if (!ctx->prefix_kv_k_q8 || !ctx->prefix_kv_v_q8 ||
+            !ctx->prefix_kv_k_scale || !ctx->prefix_kv_v_scale) {
+            qwen_decoder_drop_prefix(ctx);
+            return -1;
+        }
+        for (int l = 0; l < layers; l++) {
+            memcpy(ctx->prefix_kv_k_q8 + l * row, kv_cache_k_q8_at(ctx, l, 0), row);
+            memcpy(ctx->prefix_kv_v_q8 + l * row, kv_cache_v_q8_at(ctx, l, 0), row);
+            memcpy(ctx->prefix_kv_k_scale + l * srow,
+                   kv_cache_k_scale_at(ctx, l, 0), srow * sizeof(float));
+            memcpy(ctx->prefix_kv_v_scale + l * srow,
+                   kv_cache_v_scale_at(ctx, l, 0), srow * sizeof(float));
+        }
+    } else {
+        size_t row = (size_t)n * kv_dim;
+        ctx->prefix_kv_k = (uint16_t *)malloc((size_t)layers * row * sizeof(uint16_t));
+        ctx->prefix_kv_v = (uint16_t *)malloc((size_t)layers * row * sizeof(uint16_t));
+        if (!ctx->prefix_kv_k || !ctx->prefix_kv_v) {
+            qwen_decoder_drop_prefix(ctx);
+            return -1;
+        }
+        for (int l = 0; l < layers; l++) {
+            memcpy(ctx->prefix_kv_k + l * row, kv_cache_k_at(ctx, l, 0),
+                   row * sizeof(uint16_t));
+            memcpy(ctx->prefix_kv_v + l * row, kv_cache_v_at(ctx, l, 0),
+                   row * sizeof(uint16_t));
+        }
+    }
+    ctx->prefix_kv_len = n;
+    return 0;
+}
+
+int qwen_decoder_restore_prefix(qwen_ctx_t *ctx, int n) {
+    int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    int kv_heads = ctx->config.dec_kv_heads;
+    int layers = ctx->config.dec_layers;
+
+    if (n <= 0 || ctx->prefix_kv_len != n) return 0;
+    /* A snapshot implies a prior prefill, so the cache normally exists;
+     * if it was torn down in between, fall back to a full prefill. */
+    if (!ctx->kv_cache_k && !ctx->kv_cache_k_q8) return 0;
+    if (ctx->kv_cache_max < n) return 0;
+
+    if (ctx->kv_cache_int8) {
+        size_t row = (size_t)n * kv_dim;
+        size_t srow = (size_t)n * kv_heads;
+        for (int l = 0; l < layers; l++) {
+            memcpy(kv_cache_k_q8_at(ctx, l, 0), ctx->prefix_kv_k_q8 + l * row, row);
+            memcpy(kv_cache_v_q8_at(ctx, l, 0), ctx->prefix_kv_v_q8 + l * row, row);
+            memcpy(kv_cache_k_scale_at(ctx, l, 0),
+                   ctx->prefix_kv_k_scale + l * srow, srow * sizeof(float));
+            memcpy(kv_cache_v_scale_at(ctx, l, 0),
+                   ctx->prefix_kv_v_scale + l * srow, srow * sizeof(float));
+        }
+    } else {
+        size_t row = (size_t)n * kv_dim;
+        for (int l = 0; l < layers; l++) {
+            memcpy(kv_cache_k_at(ctx, l, 0), ctx->prefix_kv_k + l * row,
+                   row * sizeof(uint16_t));
+            memcpy(kv_cache_v_at(ctx, l, 0), ctx->prefix_kv_v + l * row,
+                   row * sizeof(uint16_t));
+        }
+    }
+    ctx->kv_cache_len = n;
+    ctx->kv_pos_offset = 0;
+    return n;
+}
+
+/* Evict cache positions [start, start + n): close the gap with a per-layer
+ * memmove and advance kv_pos_offset so surviving entries keep the RoPE
+ * rotations they were stored with. Relative distances among the survivors
+ * (and to the prefix before the gap) are unchanged; only the gap itself
+ * widens the apparent distance across it, which is the same information
+ * loss the eviction already implies. */
+void qwen_decoder_evict_kv(qwen_ctx_t *ctx, int start, int n) {
+    int kv_dim = ctx->config.dec_kv_heads * ctx->config.dec_head_dim;
+    int kv_heads = ctx->config.dec_kv_heads;
+    int layers = ctx->config.dec_layers;
+
+    if (n <= 0 || start < 0 || start + n > ctx->kv_cache_len) return;
+
+    int tail = ctx->kv_cache_len - start - n;
+    if (ctx->kv_cache_int8) {
+        for (int l = 0; l < layers; l++) {
+            memmove(kv_cache_k_q8_at(ctx, l, start), kv_cache_k_q8_at(ctx, l, start + n),
+                    (size_t)tail * kv_dim);
+            memmove(kv_cache_v_q8_at(ctx, l, start), kv_cache_v_q8_at(ctx, l, start + n),
+                    (size_t)tail * kv_dim);
+            memmove(kv_cache_k_scale_at(ctx, l, start), kv_cache_k_scale_at(ctx, l, start + n),
+                    (size_t)tail * kv_heads * sizeof(float));
+            memmove(kv_cache_v_scale_at(ctx, l, start), kv_cache_v_scale_at(ctx, l, start + n),
+                    (size_t)tail * kv_heads * sizeof(float));
+        }
+    } else if (ctx->kv_cache_k) {
+        for (int l = 0; l < layers; l++) {
+            memmove(kv_cache_k_at(ctx, l, start), kv_cache_k_at(ctx, l, start + n),
+                    (size_t)tail * kv_dim * sizeof(uint16_t));
+            memmove(kv_cache_v_at(ctx, l, start), kv_cache_v_at(ctx, l, start + n),
+                    (size_t)tail * kv_dim * sizeof(uint16_t));
+        }
+    } else {
+        return;
+    }
+    ctx->kv_cache_len -= n;
+    ctx->kv_pos_offset += n;
+}
+
+/* Run causal attention against the cache in the active format. */
+static void kv_cache_attention(qwen_ctx_t *ctx, int layer, float *attn_out,
+                               const float *q, int seq_q, int seq_k,
+                               float scale, int q_offset) {
+    const qwen_config_t *cfg = &ctx->config;
+    if (ctx->kv_cache_int8) {
+        qwen_causal_attention_q8(attn_out, q,
+                                  kv_cache_k_q8_at(ctx, layer, 0),
+                                  kv_cache_k_scale_at(ctx, layer, 0),
+                                  kv_cache_v_q8_at(ctx, layer, 0),
+                                  kv_cache_v_scale_at(ctx, layer, 0),
+                                  seq_q, seq_k, cfg->dec_heads, cfg->dec_kv_heads,
+                                  cfg->dec_head_dim, scale, q_offset);
+    } else {
+        qwen_causal_attention(attn_out, q,
+                               kv_cache_k_at(ctx, layer, 0),
+                               kv_cache_v_at(ctx, layer, 0),
+                               seq_q, seq_k, cfg->dec_heads, cfg->dec_kv_heads,
+                               cfg->dec_head_dim, scale, q_offset);
+    }
+}
+
 static int ensure_prefill_buffers(qwen_ctx_t *ctx, int seq_len) {
     const qwen_config_t *cfg = &ctx->config;
     int dim = cfg->dec_hidden;
@@ -346,7 +681,10 @@ static int ensure_rope_cache(qwen_ctx_t *ctx, int required_pos, int head_dim, fl
  * Decoder Prefill (Multiple Tokens)
  * ======================================================================== */
 
-void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_len) {
+/* Shared prefill body. When out_tokens is non-NULL, also computes the
+ * greedy token at every position (used for speculative-decode verify). */
+static int decoder_prefill_impl(qwen_ctx_t *ctx, const float *input_embeds,
+                                int seq_len, int *out_tokens) {
     qwen_decoder_t *dec = &ctx->decoder;
     const qwen_config_t *cfg = &ctx->config;
     int dim = cfg->dec_hidden;
@@ -360,13 +698,13 @@ void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_le
     int kv_dim = n_kv_heads * head_dim;
 
     /* Ensure KV cache */
-    if (!ctx->kv_cache_k) {
-        if (kv_cache_init(ctx, seq_len + 1024) != 0) return;
+    if (!ctx->kv_cache_k && !ctx->kv_cache_k_q8) {
+        if (kv_cache_init(ctx, seq_len + 1024) != 0) return -1;
     } else if (ctx->kv_cache_len + seq_len > ctx->kv_cache_max) {
-        if (kv_cache_grow(ctx, ctx->kv_cache_len + seq_len + 1024) != 0) return;
+        if (kv_cache_grow(ctx, ctx->kv_cache_len + seq_len + 1024) != 0) return -1;
     }
 
-    if (ensure_prefill_buffers(ctx, seq_len) != 0) return;
+    if (ensure_prefill_buffers(ctx, seq_len) != 0) return -1;
 
     float *x = ctx->pref_x;
     float *x_norm = ctx->pref_x_norm;
@@ -382,22 +720,24 @@ void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_le
     memcpy(x, input_embeds, (size_t)seq_len * dim * sizeof(float));
 
     int start_pos = ctx->kv_cache_len;
-    if (ensure_rope_cache(ctx, start_pos + seq_len, head_dim, theta) != 0) return;
-    const float *rope_cos = ctx->rope_cache_cos + (size_t)start_pos * head_dim;
-    const float *rope_sin = ctx->rope_cache_sin + (size_t)start_pos * head_dim;
+    int rope_pos = start_pos + ctx->kv_pos_offset;
+    if (ensure_rope_cache(ctx, rope_pos + seq_len, head_dim, theta) != 0) return -1;
+    const float *rope_cos = ctx->rope_cache_cos + (size_t)rope_pos * head_dim;
+    const float *rope_sin = ctx->rope_cache_sin + (size_t)rope_pos * head_dim;
 
     float scale = 1.0f / sqrtf((float)head_dim);
 
     for (int layer = 0; layer < cfg->dec_layers; layer++) {
         qwen_dec_layer_t *l = &dec->layers[layer];
+        qwen_perf_set_layer(layer);
 
         /* Input RMSNorm */
         qwen_rms_norm(x_norm, x, l->input_norm, seq_len, dim, eps);
 
         /* QKV projections (no bias, Q4_K) */
-        qwen_linear_nobias_q4k(q, x_norm, l->wq_weight_q4k, seq_len, dim, q_dim);
-        qwen_linear_nobias_q4k(k, x_norm, l->wk_weight_q4k, seq_len, dim, kv_dim);
-        qwen_linear_nobias_q4k(v, x_norm, l->wv_weight_q4k, seq_len, dim, kv_dim);
+        qwen_linear_nobias_q4k_x4(q, x_norm, l->wq_weight_q4k, seq_len, dim, q_dim);
+        qwen_linear_nobias_q4k_x4(k, x_norm, l->wk_weight_q4k, seq_len, dim, kv_dim);
+        qwen_linear_nobias_q4k_x4(v, x_norm, l->wv_weight_q4k, seq_len, dim, kv_dim);
 
         /* Per-head Q/K RMSNorm */
         qwen_rms_norm_per_head(q, l->q_norm_weight, seq_len, n_heads, head_dim, eps);
@@ -407,24 +747,19 @@ void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_le
         qwen_apply_rope_neox(q, rope_cos, rope_sin, seq_len, n_heads, head_dim);
         qwen_apply_rope_neox(k, rope_cos, rope_sin, seq_len, n_kv_heads, head_dim);
 
-        /* Store K, V in cache (convert FP32 → FP16) */
+        /* Store K, V in cache (FP16 or per-head INT8) */
         for (int s = 0; s < seq_len; s++) {
-            qwen_f32_to_f16(kv_cache_k_at(ctx, layer, start_pos + s),
-                            k + s * kv_dim, kv_dim);
-            qwen_f32_to_f16(kv_cache_v_at(ctx, layer, start_pos + s),
-                            v + s * kv_dim, kv_dim);
+            kv_cache_store(ctx, layer, start_pos + s,
+                           k + s * kv_dim, v + s * kv_dim);
         }
 
-        /* Causal attention (K/V are FP16 in cache) */
+        /* Causal attention over the cached K/V */
         int total_seq = start_pos + seq_len;
-        uint16_t *full_k = kv_cache_k_at(ctx, layer, 0);
-        uint16_t *full_v = kv_cache_v_at(ctx, layer, 0);
-        qwen_causal_attention(attn_out, q, full_k, full_v,
-                               seq_len, total_seq, n_heads, n_kv_heads,
-                               head_dim, scale, start_pos);
+        kv_cache_attention(ctx, layer, attn_out, q, seq_len, total_seq,
+                           scale, start_pos);
 
         /* Output projection + residual (Q4_K) */
-        qwen_linear_nobias_q4k(proj_out, attn_out, l->wo_weight_q4k,
+        qwen_linear_nobias_q4k_x4(proj_out, attn_out, l->wo_weight_q4k,
                                 seq_len, q_dim, dim);
         qwen_add_inplace(x, proj_out, seq_len * dim);
 
@@ -432,17 +767,40 @@ void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_le
         qwen_rms_norm(x_norm, x, l->post_attn_norm, seq_len, dim, eps);
 
         /* SwiGLU MLP (Q4_K) */
-        qwen_linear_nobias_q4k(gate_up, x_norm, l->gate_up_fused_q4k,
+        qwen_linear_nobias_q4k_x4(gate_up, x_norm, l->gate_up_fused_q4k,
                                 seq_len, dim, 2 * intermediate);
         qwen_swiglu_multiply(gate, gate_up, seq_len, intermediate);
-        qwen_linear_nobias_q4k(ffn_out, gate, l->down_weight_q4k,
+        qwen_linear_nobias_q4k_x4(ffn_out, gate, l->down_weight_q4k,
                                 seq_len, intermediate, dim);
 
         qwen_add_inplace(x, ffn_out, seq_len * dim);
 
     }
+    qwen_perf_set_layer(-1);
 
     ctx->kv_cache_len = start_pos + seq_len;
+
+    if (out_tokens) {
+        /* Final norm + greedy argmax at every prefill position */
+        qwen_rms_norm(x_norm, x, dec->norm, seq_len, dim, eps);
+        for (int s = 0; s < seq_len; s++) {
+            out_tokens[s] = qwen_argmax_matvec_q4k_hier(
+                x_norm + (size_t)s * dim, dec->tok_embeddings_q4k,
+                dim, cfg->vocab_size,
+                dec->argmax_centroids, dec->argmax_radii,
+                dec->argmax_n_groups, dec->argmax_group_size, NULL);
+        }
+    }
+    return 0;
+}
+
+void qwen_decoder_prefill(qwen_ctx_t *ctx, const float *input_embeds, int seq_len) {
+    decoder_prefill_impl(ctx, input_embeds, seq_len, NULL);
+}
+
+int qwen_decoder_prefill_argmax(qwen_ctx_t *ctx, const float *input_embeds,
+                                int seq_len, int *out_tokens) {
+    return decoder_prefill_impl(ctx, input_embeds, seq_len, out_tokens);
 }
 
 /* ========================================================================
@@ -504,19 +862,21 @@ int qwen_decoder_forward(qwen_ctx_t *ctx, const float *input_embed) {
         if (kv_cache_grow(ctx, pos + 1024) != 0) return QWEN_TOKEN_IM_END;
     }
 
-    if (ensure_rope_cache(ctx, pos + 1, head_dim, theta) != 0) {
+    int rope_pos = pos + ctx->kv_pos_offset;
+    if (ensure_rope_cache(ctx, rope_pos + 1, head_dim, theta) != 0) {
         return QWEN_TOKEN_IM_END;
     }
-    const float *rope_cos = ctx->rope_cache_cos + (size_t)pos * head_dim;
-    const float *rope_sin = ctx->rope_cache_sin + (size_t)pos * head_dim;
+    const float *rope_cos = ctx->rope_cache_cos + (size_t)rope_pos * head_dim;
+    const float *rope_sin = ctx->rope_cache_sin + (size_t)rope_pos * head_dim;
 
     float scale = 1.0f / sqrtf((float)head_dim);
 
     for (int layer = 0; layer < cfg->dec_layers; layer++) {
         qwen_dec_layer_t *l = &dec->layers[layer];
+        qwen_perf_set_layer(layer);
 
         qwen_rms_norm(x_norm, x, l->input_norm, 1, dim, eps);
-        qwen_linear_nobias_q4k_qkv(q, k, v, x_norm,
+        qwen_linear_nobias_q4k_qkv_x4(q, k, v, x_norm,
                                      l->wq_weight_q4k,
                                      l->wk_weight_q4k,
                                      l->wv_weight_q4k,
@@ -530,33 +890,159 @@ int qwen_decoder_forward(qwen_ctx_t *ctx, const float *input_embed) {
         qwen_apply_rope_neox(q, rope_cos, rope_sin, 1, n_heads, head_dim);
         qwen_apply_rope_neox(k, rope_cos, rope_sin, 1, n_kv_heads, head_dim);
 
-        qwen_f32_to_f16(kv_cache_k_at(ctx, layer, pos), k, kv_dim);
-        qwen_f32_to_f16(kv_cache_v_at(ctx, layer, pos), v, kv_dim);
+        kv_cache_store(ctx, layer, pos, k, v);
 
         int total_seq = pos + 1;
-        uint16_t *full_k = kv_cache_k_at(ctx, layer, 0);
-        uint16_t *full_v = kv_cache_v_at(ctx, layer, 0);
-
-        qwen_causal_attention(attn_out, q, full_k, full_v,
-                               1, total_seq, n_heads, n_kv_heads,
-                               head_dim, scale, pos);
+        kv_cache_attention(ctx, layer, attn_out, q, 1, total_seq, scale, pos);
 
-        qwen_linear_nobias_q4k(proj_out, attn_out, l->wo_weight_q4k, 1, q_dim, dim);
+        qwen_linear_nobias_q4k_x4(proj_out, attn_out, l->wo_weight_q4k, 1, q_dim, dim);
         qwen_add_inplace(x, proj_out, dim);
 
         qwen_rms_norm(x_norm, x, l->post_attn_norm, 1, dim, eps);
 
         /* Fused gate+up matvec (Q4_K) */
-        qwen_linear_nobias_q4k(gate_buf, x_norm, l->gate_up_fused_q4k,
+        qwen_linear_nobias_q4k_x4(gate_buf, x_norm, l->gate_up_fused_q4k,
                                 1, dim, 2 * intermediate);
         qwen_swiglu_multiply(gate_buf, gate_buf, 1, intermediate);
-        qwen_linear_nobias_q4k(ffn_out, gate_buf, l->down_weight_q4k, 1, intermediate, dim);
+        qwen_linear_nobias_q4k_x4(ffn_out, gate_buf, l->down_weight_q4k, 1, intermediate, dim);
         qwen_add_inplace(x, ffn_out, dim);
     }
+    qwen_perf_set_layer(-1);
 
     ctx->kv_cache_len = pos + 1;
 
     /* Final norm + streaming argmax (no logits buffer needed, Q4_K) */
     qwen_rms_norm(x, x, dec->norm, 1, dim, eps);
-    return qwen_argmax_matvec_q4k(x, dec->tok_embeddings_q4k, dim, cfg->vocab_size);
+    return qwen_argmax_matvec_q4k_hier(x, dec->tok_embeddings_q4k,
+                                       dim, cfg->vocab_size,
+                                       dec->argmax_centroids, dec->argmax_radii,
+                                       dec->argmax_n_groups, dec->argmax_group_size,
+                                       &ctx->last_logit_margin);
+}
+
+/* ========================================================================
+ * Batched Decoder Forward (one token per weight-sharing session)
+ * ======================================================================== */
+
+int qwen_decoder_forward_batch(qwen_ctx_t **sess, int n,
+                               const float *input_embeds, int *out_tokens) {
+    if (n <= 0) return 0;
+    if (n == 1) {
+        out_tokens[0] = qwen_decoder_forward(sess[0], input_embeds);
+        return 0;
+    }
+
+    /* All sessions share sess[0]'s weights and config (qwen_session_new);
+     * its prefill buffers provide the [n, dim] scratch. */
+    qwen_ctx_t *ctx = sess[0];
+    qwen_decoder_t *dec = &ctx->decoder;
+    const qwen_config_t *cfg = &ctx->config;
+    int dim = cfg->dec_hidden;
+    int n_heads = cfg->dec_heads;
+    int n_kv_heads = cfg->dec_kv_heads;
+    int head_dim = cfg->dec_head_dim;
+    int intermediate = cfg->dec_intermediate;
+    float eps = cfg->dec_rms_norm_eps;
+    float theta = cfg->dec_rope_theta;
+    int q_dim = n_heads * head_dim;
+    int kv_dim = n_kv_heads * head_dim;
+
+    if (ensure_prefill_buffers(ctx, n) != 0) return -1;
+
+    /* Per-session KV cache and RoPE rows (positions differ per session) */
+    float *batch_cos = (float *)malloc(2 * (size_t)n * head_dim * sizeof(float));
+    if (!batch_cos) return -1;
+    float *batch_sin = batch_cos + (size_t)n * head_dim;
+    for (int i = 0; i < n; i++) {
+        qwen_ctx_t *s = sess[i];
+        int pos = s->kv_cache_len;
+        if (!s->kv_cache_k && !s->kv_cache_k_q8) {
+            if (kv_cache_init(s, pos + 1024) != 0) { free(batch_cos); return -1; }
+        } else if (pos >= s->kv_cache_max) {
+            if (kv_cache_grow(s, pos + 1024) != 0) { free(batch_cos); return -1; }
+        }
+        int rope_pos = pos + s->kv_pos_offset;
+        if (ensure_rope_cache(s, rope_pos + 1, head_dim, theta) != 0) {
+            free(batch_cos);
+            return -1;
+        }
+        memcpy(batch_cos + (size_t)i * head_dim,
+               s->rope_cache_cos + (size_t)rope_pos * head_dim,
+               head_dim * sizeof(float));
+        memcpy(batch_sin + (size_t)i * head_dim,
+               s->rope_cache_sin + (size_t)rope_pos * head_dim,
+               head_dim * sizeof(float));
+    }
+
+    float *x = ctx->pref_x;
+    float *x_norm = ctx->pref_x_norm;
+    float *q = ctx->pref_q;
+    float *k = ctx->pref_k;
+    float *v = ctx->pref_v;
+    float *attn_out = ctx->pref_attn_out;
+    float *proj_out = ctx->pref_proj_out;
+    float *ffn_out = ctx->pref_ffn_out;
+    float *gate = ctx->pref_gate;
+    float *gate_up = ctx->pref_gate_up;
+
+    memcpy(x, input_embeds, (size_t)n * dim * sizeof(float));
+
+    float scale = 1.0f / sqrtf((float)head_dim);
+
+    for (int layer = 0; layer < cfg->dec_layers; layer++) {
+        qwen_dec_layer_t *l = &dec->layers[layer];
+        qwen_perf_set_layer(layer);
+
+        /* Row-wise ops and projections run batched over all sessions */
+        qwen_rms_norm(x_norm, x, l->input_norm, n, dim, eps);
+        qwen_linear_nobias_q4k_x4(q, x_norm, l->wq_weight_q4k, n, dim, q_dim);
+        qwen_linear_nobias_q4k_x4(k, x_norm, l->wk_weight_q4k, n, dim, kv_dim);
+        qwen_linear_nobias_q4k_x4(v, x_norm, l->wv_weight_q4k, n, dim, kv_dim);
+
+        qwen_rms_norm_per_head(q, l->q_norm_weight, n, n_heads, head_dim, eps);
+        qwen_rms_norm_per_head(k, l->k_norm_weight, n, n_kv_heads, head_dim, eps);
+
+        qwen_apply_rope_neox(q, batch_cos, batch_sin, n, n_heads, head_dim);
+        qwen_apply_rope_neox(k, batch_cos, batch_sin, n, n_kv_heads, head_dim);
+
+        /* KV update and attention stay per-session (separate caches) */
+        for (int i = 0; i < n; i++) {
+            qwen_ctx_t *s = sess[i];
+            int pos = s->kv_cache_len;
+            kv_cache_store(s, layer, pos, k + (size_t)i * kv_dim,
+                           v + (size_t)i * kv_dim);
+            kv_cache_attention(s, layer, attn_out + (size_t)i * q_dim,
+                               q + (size_t)i * q_dim, 1, pos + 1, scale, pos);
+        }
+
+        qwen_linear_nobias_q4k_x4(proj_out, attn_out, l->wo_weight_q4k, n, q_dim, dim);
+        qwen_add_inplace(x, proj_out, n * dim);
+
+        qwen_rms_norm(x_norm, x, l->post_attn_norm, n, dim, eps);
+
+        qwen_linear_nobias_q4k_x4(gate_up, x_norm, l->gate_up_fused_q4k,
+                                n, dim, 2 * intermediate);
+        qwen_swiglu_multiply(gate, gate_up, n, intermediate);
+        qwen_linear_nobias_q4k_x4(ffn_out, gate, l->down_weight_q4k,
+                                n, intermediate, dim);
+        qwen_add_inplace(x, ffn_out, n * dim);
+    }
+    qwen_perf_set_layer(-1);
+
+    for (int i = 0; i < n; i++)
+        sess[i]->kv_cache_len += 1;
+
+    /* Final norm + greedy argmax per session */
+    qwen_rms_norm(x_norm, x, dec->norm, n, dim, eps);
+    for (int i = 0; i < n; i++) {
+        out_tokens[i] = qwen_argmax_matvec_q4k_hier(
+            x_norm + (size_t)i * dim, dec->tok_embeddings_q4k,
+            dim, cfg->vocab_size,
+            dec->argmax_centroids, dec->argmax_radii,
+            dec->argmax_n_groups, dec->argmax_group_size,
+            &sess[i]->last_logit_margin);
+    }
+
+    free(batch_cos);
+    return 0;
 }
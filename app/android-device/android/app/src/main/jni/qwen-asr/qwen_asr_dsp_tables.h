@@ -0,0 +1,441 @@
+/*
+ * qwen_asr_dsp_tables.h - generated by gen_dsp_tables.c, do not edit
+ *
+ * Fixed DSP tables for qwen_asr_audio.c (16 kHz, 400-tap periodic Hann
+ * window, 512-point radix-2 FFT, 128 Slaney mel filters). The mel
+ * filterbank is sparse: filter m covers FFT power bins
+ * [qwen_dsp_mel_start[m], qwen_dsp_mel_start[m] + qwen_dsp_mel_len[m])
+ * with weights at qwen_dsp_mel_vals + qwen_dsp_mel_off[m].
+ */
+
+#ifndef QWEN_ASR_DSP_TABLES_H
+#define QWEN_ASR_DSP_TABLES_H
+
+#include <stdint.h>
+
+#define QWEN_DSP_MEL_NNZ 504
+
+static const float qwen_dsp_hann_window[400] = {
+    0.0f, 6.16908073e-05f, 0.000246733427f, 0.000555068254f, 0.000986635685f, 0.00154134631f,
+    0.00221902132f, 0.0030195117f, 0.00394263864f, 0.00498816371f, 0.0061558187f, 0.00744533539f,
+    0.00885638595f, 0.0103885829f, 0.0120416284f, 0.0138150454f, 0.0157084167f, 0.0177212954f,
+    0.0198531449f, 0.0221034884f, 0.02447173f, 0.0269573331f, 0.0295596123f, 0.0322779715f,
+    0.0351117551f, 0.0380602479f, 0.0411227047f, 0.0442983806f, 0.0475864708f, 0.0509862006f,
+    0.0544967353f, 0.0581171811f, 0.0618466735f, 0.0656842589f, 0.0696289837f, 0.073679924f,
+    0.0778360367f, 0.0820963085f, 0.0864597261f, 0.0909251571f, 0.0954914987f, 0.100157678f,
+    0.104922503f, 0.109784812f, 0.114743382f, 0.119797021f, 0.124944478f, 0.130184472f,
+    0.13551569f, 0.140936881f, 0.146446615f, 0.152043641f, 0.157726467f, 0.163493723f,
+    0.169344097f, 0.175275981f, 0.181288034f, 0.187378675f, 0.193546474f, 0.199789882f,
+    0.206107378f, 0.212497383f, 0.218958318f, 0.225488603f, 0.232086629f, 0.238750696f,
+    0.245479316f, 0.252270639f, 0.259123206f, 0.26603508f, 0.27300477f, 0.2800304f,
+    0.287110329f, 0.294242799f, 0.301426053f, 0.308658302f, 0.315937728f, 0.323262572f,
+    0.330631047f, 0.338041306f, 0.345491529f, 0.352979839f, 0.360504448f, 0.368063509f,
+    0.375655085f, 0.383277297f, 0.390928417f, 0.39860639f, 0.406309366f, 0.414035439f,
+    0.421782821f, 0.429549426f, 0.437333375f, 0.445132852f, 0.452945918f, 0.460770518f,
+    0.468604743f, 0.476446778f, 0.484294683f, 0.492146373f, 0.5f, 0.507853687f,
+    0.515705466f, 0.523553252f, 0.531395316f, 0.539229572f, 0.547054112f, 0.554867208f,
+    0.562666655f, 0.570450604f, 0.578217208f, 0.58596462f, 0.593690693f, 0.60139364f,
+    0.609071612f, 0.616722763f, 0.624344945f, 0.63193655f, 0.639495552f, 0.647020221f,
+    0.654508531f, 0.661958754f, 0.669368982f, 0.676737428f, 0.684062302f, 0.691341758f,
+    0.698574007f, 0.705757141f, 0.712889671f, 0.71996963f, 0.72699523f, 0.73396498f,
+    0.740876913f, 0.747729421f, 0.754520655f, 0.761249304f, 0.767913461f, 0.774511337f,
+    0.781041622f, 0.787502706f, 0.793892741f, 0.800210118f, 0.806453466f, 0.812621415f,
+    0.818711996f, 0.824724019f, 0.830655932f, 0.836506367f, 0.842273593f, 0.847956419f,
+    0.853553414f, 0.859063148f, 0.86448431f, 0.869815588f, 0.875055552f, 0.880203009f,
+    0.885256648f, 0.890215218f, 0.895077527f, 0.899842381f, 0.904508531f, 0.909074903f,
+    0.913540304f, 0.917903662f, 0.922163963f, 0.926320076f, 0.930371046f, 0.934315801f,
+    0.938153386f, 0.941882849f, 0.945503235f, 0.94901377f, 0.952413559f, 0.955701709f,
+    0.958877325f, 0.961939812f, 0.964888275f, 0.967721999f, 0.970440388f, 0.973042667f,
+    0.9755283f, 0.977896571f, 0.980146885f, 0.982278705f, 0.984291553f, 0.986184955f,
+    0.987958372f, 0.989611387f, 0.991143644f, 0.992554665f, 0.993844151f, 0.995011806f,
+    0.996057391f, 0.996980488f, 0.997780979f, 0.998458683f, 0.999013364f, 0.999444962f,
+    0.999753237f, 0.999938309f, 1.0f, 0.999938309f, 0.999753237f, 0.999444962f,
+    0.999013364f, 0.998458683f, 0.997780979f, 0.996980429f, 0.996057332f, 0.995011806f,
+    0.993844151f, 0.992554665f, 0.991143644f, 0.989611387f, 0.987958372f, 0.986184955f,
+    0.984291553f, 0.982278705f, 0.980146885f, 0.977896512f, 0.97552824f, 0.973042727f,
+    0.970440388f, 0.967721939f, 0.964888215f, 0.961939752f, 0.958877325f, 0.95570159f,
+    0.952413559f, 0.94901377f, 0.945503235f, 0.94188273f, 0.938153327f, 0.934315741f,
+    0.930370986f, 0.926320076f, 0.922163963f, 0.917903662f, 0.913540184f, 0.909074903f,
+    0.904508471f, 0.899842262f, 0.895077467f, 0.890215158f, 0.885256588f, 0.880202949f,
+    0.875055552f, 0.869815588f, 0.864484251f, 0.859063089f, 0.853553295f, 0.8479563f,
+    0.842273474f, 0.836506248f, 0.830655932f, 0.824723959f, 0.818711877f, 0.812621236f,
+    0.806453466f, 0.800209999f, 0.793892741f, 0.787502527f, 0.781041622f, 0.774511337f,
+    0.767913282f, 0.761249185f, 0.754520595f, 0.747729421f, 0.740876913f, 0.733964801f,
+    0.726995111f, 0.719969451f, 0.712889493f, 0.705757022f, 0.698574007f, 0.691341758f,
+    0.684062362f, 0.676737249f, 0.669368804f, 0.661958575f, 0.654508352f, 0.647020221f,
+    0.639495611f, 0.63193655f, 0.624345005f, 0.616722465f, 0.609071434f, 0.601393461f,
+    0.593690693f, 0.585964561f, 0.578217268f, 0.570450664f, 0.562666655f, 0.55486691f,
+    0.547053933f, 0.539229572f, 0.531395257f, 0.523553252f, 0.515705407f, 0.507853627f,
+    0.5f, 0.492146343f, 0.484294593f, 0.476446748f, 0.468604714f, 0.460770428f,
+    0.452945828f, 0.445132822f, 0.437333345f, 0.429549336f, 0.421782732f, 0.41403541f,
+    0.406309307f, 0.3986063f, 0.390928328f, 0.383277267f, 0.375654995f, 0.36806342f,
+    0.360504389f, 0.352979779f, 0.345491439f, 0.338041216f, 0.330630958f, 0.323262513f,
+    0.315937638f, 0.308658183f, 0.301426172f, 0.294242948f, 0.287110269f, 0.28003031f,
+    0.273004651f, 0.26603502f, 0.259123087f, 0.252270579f, 0.245479196f, 0.238750607f,
+    0.232086509f, 0.225488484f, 0.218958199f, 0.212497264f, 0.206107467f, 0.199789971f,
+    0.193546563f, 0.187378734f, 0.181287885f, 0.175275862f, 0.169343948f, 0.163493633f,
+    0.157726318f, 0.152043492f, 0.146446496f, 0.140936732f, 0.135515571f, 0.130184501f,
+    0.124944508f, 0.119797051f, 0.114743412f, 0.109784842f, 0.104922533f, 0.100157708f,
+    0.0954913795f, 0.0909250379f, 0.0864596069f, 0.0820962191f, 0.0778359175f, 0.0736798048f,
+    0.0696288645f, 0.0656842589f, 0.0618466735f, 0.0581171811f, 0.0544967353f, 0.0509862006f,
+    0.0475864708f, 0.0442983508f, 0.0411226749f, 0.0380602181f, 0.0351116657f, 0.0322778821f,
+    0.0295595229f, 0.0269572437f, 0.0244716704f, 0.0221034884f, 0.0198531449f, 0.0177212954f,
+    0.0157084167f, 0.0138150454f, 0.0120415986f, 0.0103885829f, 0.00885635614f, 0.00744533539f,
+    0.0061558187f, 0.00498816371f, 0.00394260883f, 0.0030194819f, 0.00221899152f, 0.00154134631f,
+    0.000986635685f, 0.000555068254f, 0.000246703625f, 6.16908073e-05f
+};
+
+static const uint16_t qwen_dsp_fft_brev[512] = {
+    0, 256, 128, 384, 64, 320, 192, 448, 32, 288, 160, 416,
+    96, 352, 224, 480, 16, 272, 144, 400, 80, 336, 208, 464,
+    48, 304, 176, 432, 112, 368, 240, 496, 8, 264, 136, 392,
+    72, 328, 200, 456, 40, 296, 168, 424, 104, 360, 232, 488,
+    24, 280, 152, 408, 88, 344, 216, 472, 56, 312, 184, 440,
+    120, 376, 248, 504, 4, 260, 132, 388, 68, 324, 196, 452,
+    36, 292, 164, 420, 100, 356, 228, 484, 20, 276, 148, 404,
+    84, 340, 212, 468, 52, 308, 180, 436, 116, 372, 244, 500,
+    12, 268, 140, 396, 76, 332, 204, 460, 44, 300, 172, 428,
+    108, 364, 236, 492, 28, 284, 156, 412, 92, 348, 220, 476,
+    60, 316, 188, 444, 124, 380, 252, 508, 2, 258, 130, 386,
+    66, 322, 194, 450, 34, 290, 162, 418, 98, 354, 226, 482,
+    18, 274, 146, 402, 82, 338, 210, 466, 50, 306, 178, 434,
+    114, 370, 242, 498, 10, 266, 138, 394, 74, 330, 202, 458,
+    42, 298, 170, 426, 106, 362, 234, 490, 26, 282, 154, 410,
+    90, 346, 218, 474, 58, 314, 186, 442, 122, 378, 250, 506,
+    6, 262, 134, 390, 70, 326, 198, 454, 38, 294, 166, 422,
+    102, 358, 230, 486, 22, 278, 150, 406, 86, 342, 214, 470,
+    54, 310, 182, 438, 118, 374, 246, 502, 14, 270, 142, 398,
+    78, 334, 206, 462, 46, 302, 174, 430, 110, 366, 238, 494,
+    30, 286, 158, 414, 94, 350, 222, 478, 62, 318, 190, 446,
+    126, 382, 254, 510, 1, 257, 129, 385, 65, 321, 193, 449,
+    33, 289, 161, 417, 97, 353, 225, 481, 17, 273, 145, 401,
+    81, 337, 209, 465, 49, 305, 177, 433, 113, 369, 241, 497,
+    9, 265, 137, 393, 73, 329, 201, 457, 41, 297, 169, 425,
+    105, 361, 233, 489, 25, 281, 153, 409, 89, 345, 217, 473,
+    57, 313, 185, 441, 121, 377, 249, 505, 5, 261, 133, 389,
+    69, 325, 197, 453, 37, 293, 165, 421, 101, 357, 229, 485,
+    21, 277, 149, 405, 85, 341, 213, 469, 53, 309, 181, 437,
+    117, 373, 245, 501, 13, 269, 141, 397, 77, 333, 205, 461,
+    45, 301, 173, 429, 109, 365, 237, 493, 29, 285, 157, 413,
+    93, 349, 221, 477, 61, 317, 189, 445, 125, 381, 253, 509,
+    3, 259, 131, 387, 67, 323, 195, 451, 35, 291, 163, 419,
+    99, 355, 227, 483, 19, 275, 147, 403, 83, 339, 211, 467,
+    51, 307, 179, 435, 115, 371, 243, 499, 11, 267, 139, 395,
+    75, 331, 203, 459, 43, 299, 171, 427, 107, 363, 235, 491,
+    27, 283, 155, 411, 91, 347, 219, 475, 59, 315, 187, 443,
+    123, 379, 251, 507, 7, 263, 135, 391, 71, 327, 199, 455,
+    39, 295, 167, 423, 103, 359, 231, 487, 23, 279, 151, 407,
+    87, 343, 215, 471, 55, 311, 183, 439, 119, 375, 247, 503,
+    15, 271, 143, 399, 79, 335, 207, 463, 47, 303, 175, 431,
+    111, 367, 239, 495, 31, 287, 159, 415, 95, 351, 223, 479,
+    63, 319, 191, 447, 127, 383, 255, 511
+};
+
+static const float qwen_dsp_fft_tw_re[511] = {
+    1.0f, 1.0f, -4.37113883e-08f, 1.0f, 0.707106769f, -4.37113883e-08f,
+    -0.707106769f, 1.0f, 0.923879504f, 0.707106769f, 0.382683426f, -4.37113883e-08f,
+    -0.382683516f, -0.707106769f, -0.923879623f, 1.0f, 0.980785251f, 0.923879504f,
+    0.831469595f, 0.707106769f, 0.555570185f, 0.382683426f, 0.195090234f, -4.37113883e-08f,
+    -0.195090324f, -0.382683516f, -0.555570364f, -0.707106769f, -0.831469655f, -0.923879623f,
+    -0.98078531f, 1.0f, 0.99518472f, 0.980785251f, 0.956940353f, 0.923879504f,
+    0.881921232f, 0.831469595f, 0.773010433f, 0.707106769f, 0.634393275f, 0.555570185f,
+    0.471396655f, 0.382683426f, 0.290284634f, 0.195090234f, 0.0980171338f, -4.37113883e-08f,
+    -0.0980172232f, -0.195090324f, -0.290284723f, -0.382683516f, -0.471396834f, -0.555570364f,
+    -0.634393275f, -0.707106769f, -0.773010492f, -0.831469655f, -0.881921351f, -0.923879623f,
+    -0.956940353f, -0.98078531f, -0.99518472f, 1.0f, 0.99879545f, 0.99518472f,
+    0.989176512f, 0.980785251f, 0.970031261f, 0.956940353f, 0.941544056f, 0.923879504f,
+    0.903989315f, 0.881921232f, 0.857728601f, 0.831469595f, 0.803207517f, 0.773010433f,
+    0.740951121f, 0.707106769f, 0.671558917f, 0.634393275f, 0.59569931f, 0.555570185f,
+    0.514102697f, 0.471396655f, 0.427555114f, 0.382683426f, 0.336889833f, 0.290284634f,
+    0.242980123f, 0.195090234f, 0.146730497f, 0.0980171338f, 0.04906765f, -4.37113883e-08f,
+    -0.0490677394f, -0.0980172232f, -0.146730572f, -0.195090324f, -0.242980197f, -0.290284723f,
+    -0.336889923f, -0.382683516f, -0.427555084f, -0.471396834f, -0.514102757f, -0.555570364f,
+    -0.59569937f, -0.634393275f, -0.671559036f, -0.707106769f, -0.74095124f, -0.773010492f,
+    -0.803207636f, -0.831469655f, -0.857728601f, -0.881921351f, -0.903989315f, -0.923879623f,
+    -0.941544116f, -0.956940353f, -0.970031261f, -0.98078531f, -0.989176512f, -0.99518472f,
+    -0.99879545f, 1.0f, 0.999698818f, 0.99879545f, 0.997290432f, 0.99518472f,
+    0.992479563f, 0.989176512f, 0.985277653f, 0.980785251f, 0.975702107f, 0.970031261f,
+    0.963776052f, 0.956940353f, 0.949528158f, 0.941544056f, 0.932992816f, 0.923879504f,
+    0.914209723f, 0.903989315f, 0.893224299f, 0.881921232f, 0.870086968f, 0.857728601f,
+    0.84485358f, 0.831469595f, 0.817584813f, 0.803207517f, 0.78834641f, 0.773010433f,
+    0.757208824f, 0.740951121f, 0.724247098f, 0.707106769f, 0.689540505f, 0.671558917f,
+    0.653172791f, 0.634393275f, 0.615231574f, 0.59569931f, 0.575808167f, 0.555570185f,
+    0.534997642f, 0.514102697f, 0.492898166f, 0.471396655f, 0.449611306f, 0.427555114f,
+    0.405241281f, 0.382683426f, 0.359894961f, 0.336889833f, 0.313681662f, 0.290284634f,
+    0.266712755f, 0.242980123f, 0.219101235f, 0.195090234f, 0.170961857f, 0.146730497f,
+    0.122410625f, 0.0980171338f, 0.0735644922f, 0.04906765f, 0.0245411359f, -4.37113883e-08f,
+    -0.0245412234f, -0.0490677394f, -0.0735645741f, -0.0980172232f, -0.122410707f, -0.146730572f,
+    -0.170961946f, -0.195090324f, -0.21910131f, -0.242980197f, -0.266712844f, -0.290284723f,
+    -0.313681722f, -0.336889923f, -0.359895051f, -0.382683516f, -0.40524134f, -0.427555084f,
+    -0.449611366f, -0.471396834f, -0.492898166f, -0.514102757f, -0.534997702f, -0.555570364f,
+    -0.575808167f, -0.59569937f, -0.615231693f, -0.634393275f, -0.653172851f, -0.671559036f,
+    -0.689540684f, -0.707106769f, -0.724247158f, -0.74095124f, -0.757208824f, -0.773010492f,
+    -0.788346469f, -0.803207636f, -0.817584813f, -0.831469655f, -0.84485364f, -0.857728601f,
+    -0.870087028f, -0.881921351f, -0.893224299f, -0.903989315f, -0.914209783f, -0.923879623f,
+    -0.932992816f, -0.941544116f, -0.949528217f, -0.956940353f, -0.963776052f, -0.970031261f,
+    -0.975702167f, -0.98078531f, -0.985277653f, -0.989176512f, -0.992479503f, -0.99518472f,
+    -0.997290492f, -0.99879545f, -0.999698818f, 1.0f, 0.999924719f, 0.999698818f,
+    0.999322355f, 0.99879545f, 0.998118103f, 0.997290432f, 0.996312618f, 0.99518472f,
+    0.993906975f, 0.992479563f, 0.990902662f, 0.989176512f, 0.987301409f, 0.985277653f,
+    0.983105481f, 0.980785251f, 0.97831738f, 0.975702107f, 0.972939968f, 0.970031261f,
+    0.966976464f, 0.963776052f, 0.960430503f, 0.956940353f, 0.953306019f, 0.949528158f,
+    0.945607305f, 0.941544056f, 0.937339008f, 0.932992816f, 0.928506076f, 0.923879504f,
+    0.919113874f, 0.914209723f, 0.909167945f, 0.903989315f, 0.898674488f, 0.893224299f,
+    0.887639642f, 0.881921232f, 0.876070082f, 0.870086968f, 0.863972843f, 0.857728601f,
+    0.851355195f, 0.84485358f, 0.838224709f, 0.831469595f, 0.824589312f, 0.817584813f,
+    0.81045717f, 0.803207517f, 0.795836926f, 0.78834641f, 0.780737221f, 0.773010433f,
+    0.765167236f, 0.757208824f, 0.749136388f, 0.740951121f, 0.732654274f, 0.724247098f,
+    0.715730786f, 0.707106769f, 0.698376238f, 0.689540505f, 0.680601001f, 0.671558917f,
+    0.662415743f, 0.653172791f, 0.643831551f, 0.634393275f, 0.624859452f, 0.615231574f,
+    0.60551101f, 0.59569931f, 0.585797846f, 0.575808167f, 0.565731823f, 0.555570185f,
+    0.545324981f, 0.534997642f, 0.524589658f, 0.514102697f, 0.50353843f, 0.492898166f,
+    0.482183725f, 0.471396655f, 0.460538715f, 0.449611306f, 0.438616186f, 0.427555114f,
+    0.416429549f, 0.405241281f, 0.393991947f, 0.382683426f, 0.371317148f, 0.359894961f,
+    0.348418683f, 0.336889833f, 0.32531023f, 0.313681662f, 0.302005947f, 0.290284634f,
+    0.27851963f, 0.266712755f, 0.254865646f, 0.242980123f, 0.231058136f, 0.219101235f,
+    0.207111329f, 0.195090234f, 0.183039889f, 0.170961857f, 0.158858076f, 0.146730497f,
+    0.134580687f, 0.122410625f, 0.110222116f, 0.0980171338f, 0.0857972726f, 0.0735644922f,
+    0.0613207482f, 0.04906765f, 0.0368071645f, 0.0245411359f, 0.0122715291f, -4.37113883e-08f,
+    -0.0122716166f, -0.0245412234f, -0.0368072502f, -0.0490677394f, -0.0613208339f, -0.0735645741f,
+    -0.085797362f, -0.0980172232f, -0.110222206f, -0.122410707f, -0.134580776f, -0.146730572f,
+    -0.158858165f, -0.170961946f, -0.183039978f, -0.195090324f, -0.207111418f, -0.21910131f,
+    -0.23105821f, -0.242980197f, -0.254865706f, -0.266712844f, -0.27851969f, -0.290284723f,
+    -0.302006036f, -0.313681722f, -0.32531032f, -0.336889923f, -0.348418772f, -0.359895051f,
+    -0.371317238f, -0.382683516f, -0.393992037f, -0.40524134f, -0.41642952f, -0.427555084f,
+    -0.438616246f, -0.449611366f, -0.460538775f, -0.471396834f, -0.482183903f, -0.492898166f,
+    -0.50353837f, -0.514102757f, -0.524589717f, -0.534997702f, -0.5453251f, -0.555570364f,
+    -0.565731764f, -0.575808167f, -0.585797906f, -0.59569937f, -0.605511129f, -0.615231693f,
+    -0.624859631f, -0.634393275f, -0.643831551f, -0.653172851f, -0.662415862f, -0.671559036f,
+    -0.68060112f, -0.689540684f, -0.698376238f, -0.707106769f, -0.715730846f, -0.724247158f,
+    -0.732654333f, -0.74095124f, -0.749136508f, -0.757208824f, -0.765167296f, -0.773010492f,
+    -0.780737281f, -0.788346469f, -0.795836985f, -0.803207636f, -0.81045717f, -0.817584813f,
+    -0.824589312f, -0.831469655f, -0.838224769f, -0.84485364f, -0.851355314f, -0.857728601f,
+    -0.863972843f, -0.870087028f, -0.876070142f, -0.881921351f, -0.887639701f, -0.893224299f,
+    -0.898674488f, -0.903989315f, -0.909168005f, -0.914209783f, -0.919113874f, -0.923879623f,
+    -0.928506076f, -0.932992816f, -0.937339008f, -0.941544116f, -0.945607364f, -0.949528217f,
+    -0.953306079f, -0.956940353f, -0.960430503f, -0.963776052f, -0.966976464f, -0.970031261f,
+    -0.972939968f, -0.975702167f, -0.97831738f, -0.98078531f, -0.983105481f, -0.985277653f,
+    -0.987301409f, -0.989176512f, -0.990902662f, -0.992479503f, -0.993906975f, -0.99518472f,
+    -0.996312618f, -0.997290492f, -0.998118103f, -0.99879545f, -0.999322355f, -0.999698818f,
+    -0.999924719f
+};
+
+static const float qwen_dsp_fft_tw_im[511] = {
+    -0.0f, -0.0f, -1.0f, -0.0f, -0.707106769f, -1.0f,
+    -0.707106769f, -0.0f, -0.382683456f, -0.707106769f, -0.923879504f, -1.0f,
+    -0.923879504f, -0.707106769f, -0.382683277f, -0.0f, -0.195090324f, -0.382683456f,
+    -0.555570245f, -0.707106769f, -0.831469655f, -0.923879504f, -0.98078531f, -1.0f,
+    -0.980785251f, -0.923879504f, -0.831469536f, -0.707106769f, -0.555570185f, -0.382683277f,
+    -0.195090309f, -0.0f, -0.0980171412f, -0.195090324f, -0.290284693f, -0.382683456f,
+    -0.471396744f, -0.555570245f, -0.634393334f, -0.707106769f, -0.773010433f, -0.831469655f,
+    -0.881921291f, -0.923879504f, -0.956940353f, -0.98078531f, -0.99518472f, -1.0f,
+    -0.99518472f, -0.980785251f, -0.956940293f, -0.923879504f, -0.881921232f, -0.831469536f,
+    -0.773010492f, -0.707106769f, -0.634393275f, -0.555570185f, -0.471396625f, -0.382683277f,
+    -0.290284723f, -0.195090309f, -0.0980170965f, -0.0f, -0.0490676761f, -0.0980171412f,
+    -0.146730468f, -0.195090324f, -0.242980197f, -0.290284693f, -0.336889863f, -0.382683456f,
+    -0.427555084f, -0.471396744f, -0.514102757f, -0.555570245f, -0.59569931f, -0.634393334f,
+    -0.671558976f, -0.707106769f, -0.74095118f, -0.773010433f, -0.803207517f, -0.831469655f,
+    -0.85772866f, -0.881921291f, -0.903989315f, -0.923879504f, -0.941544056f, -0.956940353f,
+    -0.970031261f, -0.98078531f, -0.989176512f, -0.99518472f, -0.99879545f, -1.0f,
+    -0.99879545f, -0.99518472f, -0.989176512f, -0.980785251f, -0.970031261f, -0.956940293f,
+    -0.941544056f, -0.923879504f, -0.903989315f, -0.881921232f, -0.857728601f, -0.831469536f,
+    -0.803207517f, -0.773010492f, -0.740951061f, -0.707106769f, -0.671558857f, -0.634393275f,
+    -0.595699131f, -0.555570185f, -0.514102757f, -0.471396625f, -0.427555054f, -0.382683277f,
+    -0.336889803f, -0.290284723f, -0.242980078f, -0.195090309f, -0.146730334f, -0.0980170965f,
+    -0.0490674861f, -0.0f, -0.024541229f, -0.0490676761f, -0.0735645667f, -0.0980171412f,
+    -0.122410677f, -0.146730468f, -0.170961902f, -0.195090324f, -0.219101235f, -0.242980197f,
+    -0.266712785f, -0.290284693f, -0.313681751f, -0.336889863f, -0.359895051f, -0.382683456f,
+    -0.40524134f, -0.427555084f, -0.449611336f, -0.471396744f, -0.492898226f, -0.514102757f,
+    -0.534997582f, -0.555570245f, -0.575808227f, -0.59569931f, -0.615231633f, -0.634393334f,
+    -0.653172851f, -0.671558976f, -0.689540565f, -0.707106769f, -0.724247098f, -0.74095118f,
+    -0.757208884f, -0.773010433f, -0.78834641f, -0.803207517f, -0.817584813f, -0.831469655f,
+    -0.84485358f, -0.85772866f, -0.870086968f, -0.881921291f, -0.893224299f, -0.903989315f,
+    -0.914209783f, -0.923879504f, -0.932992816f, -0.941544056f, -0.949528217f, -0.956940353f,
+    -0.963776052f, -0.970031261f, -0.975702107f, -0.98078531f, -0.985277653f, -0.989176512f,
+    -0.992479563f, -0.99518472f, -0.997290432f, -0.99879545f, -0.999698818f, -1.0f,
+    -0.999698818f, -0.99879545f, -0.997290432f, -0.99518472f, -0.992479503f, -0.989176512f,
+    -0.985277653f, -0.980785251f, -0.975702107f, -0.970031261f, -0.963776052f, -0.956940293f,
+    -0.949528158f, -0.941544056f, -0.932992816f, -0.923879504f, -0.914209723f, -0.903989315f,
+    -0.893224299f, -0.881921232f, -0.870087028f, -0.857728601f, -0.84485352f, -0.831469536f,
+    -0.817584813f, -0.803207517f, -0.78834635f, -0.773010492f, -0.757208824f, -0.740951061f,
+    -0.724246979f, -0.707106769f, -0.689540505f, -0.671558857f, -0.653172851f, -0.634393275f,
+    -0.615231514f, -0.595699131f, -0.575808167f, -0.555570185f, -0.534997463f, -0.514102757f,
+    -0.492898136f, -0.471396625f, -0.449611366f, -0.427555054f, -0.405241221f, -0.382683277f,
+    -0.359895051f, -0.336889803f, -0.313681602f, -0.290284723f, -0.266712725f, -0.242980078f,
+    -0.219101071f, -0.195090309f, -0.170961812f, -0.146730334f, -0.1224107f, -0.0980170965f,
+    -0.0735644475f, -0.0490674861f, -0.0245412104f, -0.0f, -0.0122715384f, -0.024541229f,
+    -0.0368072242f, -0.0490676761f, -0.0613207407f, -0.0735645667f, -0.0857973173f, -0.0980171412f,
+    -0.110222206f, -0.122410677f, -0.134580716f, -0.146730468f, -0.15885815f, -0.170961902f,
+    -0.183039889f, -0.195090324f, -0.207111388f, -0.219101235f, -0.231058121f, -0.242980197f,
+    -0.254865676f, -0.266712785f, -0.27851969f, -0.290284693f, -0.302005947f, -0.313681751f,
+    -0.32531032f, -0.336889863f, -0.348418683f, -0.359895051f, -0.371317208f, -0.382683456f,
+    -0.393992066f, -0.40524134f, -0.416429579f, -0.427555084f, -0.438616246f, -0.449611336f,
+    -0.460538715f, -0.471396744f, -0.482183754f, -0.492898226f, -0.50353837f, -0.514102757f,
+    -0.524589717f, -0.534997582f, -0.545324981f, -0.555570245f, -0.565731823f, -0.575808227f,
+    -0.585797906f, -0.59569931f, -0.60551101f, -0.615231633f, -0.624859512f, -0.634393334f,
+    -0.643831551f, -0.653172851f, -0.662415802f, -0.671558976f, -0.680601001f, -0.689540565f,
+    -0.698376298f, -0.707106769f, -0.715730846f, -0.724247098f, -0.732654274f, -0.74095118f,
+    -0.749136388f, -0.757208884f, -0.765167296f, -0.773010433f, -0.780737281f, -0.78834641f,
+    -0.795836926f, -0.803207517f, -0.81045717f, -0.817584813f, -0.824589312f, -0.831469655f,
+    -0.838224709f, -0.84485358f, -0.851355195f, -0.85772866f, -0.863972843f, -0.870086968f,
+    -0.876070142f, -0.881921291f, -0.887639642f, -0.893224299f, -0.898674488f, -0.903989315f,
+    -0.909168005f, -0.914209783f, -0.919113874f, -0.923879504f, -0.928506076f, -0.932992816f,
+    -0.937339008f, -0.941544056f, -0.945607364f, -0.949528217f, -0.953306019f, -0.956940353f,
+    -0.960430562f, -0.963776052f, -0.966976464f, -0.970031261f, -0.972939968f, -0.975702107f,
+    -0.97831738f, -0.98078531f, -0.983105481f, -0.985277653f, -0.987301409f, -0.989176512f,
+    -0.990902662f, -0.992479563f, -0.993906975f, -0.99518472f, -0.996312618f, -0.997290432f,
+    -0.998118103f, -0.99879545f, -0.999322414f, -0.999698818f, -0.999924719f, -1.0f,
+    -0.999924719f, -0.999698818f, -0.999322355f, -0.99879545f, -0.998118103f, -0.997290432f,
+    -0.996312618f, -0.99518472f, -0.993906975f, -0.992479503f, -0.990902603f, -0.989176512f,
+    -0.987301409f, -0.985277653f, -0.983105481f, -0.980785251f, -0.97831738f, -0.975702107f,
+    -0.972939909f, -0.970031261f, -0.966976464f, -0.963776052f, -0.960430503f, -0.956940293f,
+    -0.953306019f, -0.949528158f, -0.945607305f, -0.941544056f, -0.937338948f, -0.932992816f,
+    -0.928506076f, -0.923879504f, -0.919113874f, -0.914209723f, -0.909168005f, -0.903989315f,
+    -0.898674428f, -0.893224299f, -0.887639582f, -0.881921232f, -0.876070023f, -0.870087028f,
+    -0.863972843f, -0.857728601f, -0.851355135f, -0.84485352f, -0.838224649f, -0.831469536f,
+    -0.824589312f, -0.817584813f, -0.81045717f, -0.803207517f, -0.795836866f, -0.78834635f,
+    -0.780737102f, -0.773010492f, -0.765167236f, -0.757208824f, -0.749136329f, -0.740951061f,
+    -0.732654154f, -0.724246979f, -0.715730846f, -0.707106769f, -0.698376238f, -0.689540505f,
+    -0.680600941f, -0.671558857f, -0.662415624f, -0.653172851f, -0.643831551f, -0.634393275f,
+    -0.624859452f, -0.615231514f, -0.60551095f, -0.595699131f, -0.585797846f, -0.575808167f,
+    -0.565731764f, -0.555570185f, -0.545324862f, -0.534997463f, -0.524589539f, -0.514102757f,
+    -0.50353837f, -0.492898136f, -0.482183695f, -0.471396625f, -0.460538566f, -0.449611366f,
+    -0.438616246f, -0.427555054f, -0.41642949f, -0.405241221f, -0.393991917f, -0.382683277f,
+    -0.371317238f, -0.359895051f, -0.348418653f, -0.336889803f, -0.3253102f, -0.313681602f,
+    -0.302005798f, -0.290284723f, -0.27851969f, -0.266712725f, -0.254865587f, -0.242980078f,
+    -0.231057972f, -0.219101071f, -0.207111403f, -0.195090309f, -0.183039844f, -0.170961812f,
+    -0.158858031f, -0.146730334f, -0.134580523f, -0.1224107f, -0.110222198f, -0.0980170965f,
+    -0.0857972279f, -0.0735644475f, -0.0613205843f, -0.0490674861f, -0.0368072391f, -0.0245412104f,
+    -0.0122714853f
+};
+
+static const uint16_t qwen_dsp_mel_start[128] = {
+    1, 1, 2, 3, 3, 4, 5, 6, 6, 7, 8, 9,
+    9, 10, 11, 12, 12, 13, 14, 15, 15, 16, 17, 18,
+    18, 19, 20, 21, 21, 22, 23, 24, 24, 25, 26, 27,
+    27, 28, 29, 30, 30, 31, 32, 33, 33, 34, 35, 36,
+    37, 38, 39, 40, 40, 41, 42, 43, 45, 46, 47, 48,
+    49, 50, 51, 53, 54, 55, 57, 58, 59, 61, 62, 64,
+    65, 67, 68, 70, 72, 74, 75, 77, 79, 81, 83, 85,
+    87, 89, 91, 93, 96, 98, 100, 103, 105, 108, 111, 113,
+    116, 119, 122, 125, 128, 131, 134, 137, 141, 144, 148, 151,
+    155, 159, 162, 166, 170, 175, 179, 183, 188, 192, 197, 202,
+    207, 212, 217, 222, 227, 233, 239, 244
+};
+
+static const uint16_t qwen_dsp_mel_len[128] = {
+    1, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1,
+    2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1,
+    2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1,
+    2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 2, 2,
+    2, 2, 1, 1, 2, 2, 3, 3, 2, 2, 2, 2,
+    2, 3, 3, 2, 3, 3, 2, 3, 3, 3, 3, 3,
+    3, 3, 4, 4, 3, 3, 4, 4, 4, 4, 4, 4,
+    4, 4, 5, 5, 4, 5, 5, 5, 6, 5, 5, 6,
+    6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 8,
+    7, 7, 8, 9, 9, 8, 9, 9, 9, 10, 10, 10,
+    10, 10, 10, 11, 12, 11, 11, 12
+};
+
+static const uint16_t qwen_dsp_mel_off[128] = {
+    0, 1, 3, 4, 5, 7, 9, 10, 11, 13, 15, 16,
+    17, 19, 21, 22, 23, 25, 27, 28, 29, 31, 33, 34,
+    35, 37, 39, 40, 41, 43, 45, 46, 47, 49, 51, 52,
+    53, 55, 57, 58, 59, 61, 63, 64, 65, 67, 69, 71,
+    73, 75, 77, 78, 79, 81, 83, 86, 89, 91, 93, 95,
+    97, 99, 102, 105, 107, 110, 113, 115, 118, 121, 124, 127,
+    130, 133, 136, 140, 144, 147, 150, 154, 158, 162, 166, 170,
+    174, 178, 182, 187, 192, 196, 201, 206, 211, 217, 222, 227,
+    233, 239, 245, 251, 257, 263, 269, 276, 283, 290, 297, 304,
+    312, 319, 326, 334, 343, 352, 360, 369, 378, 387, 397, 407,
+    417, 427, 437, 447, 458, 470, 481, 492
+};
+
+static const float qwen_dsp_mel_vals[504] = {
+    0.0283775423f, 0.0143890111f, 0.0139885303f, 0.0287780222f, 0.0423660725f, 0.00040047965f,
+    0.0279770605f, 0.0147894928f, 0.0135880448f, 0.0291785114f, 0.0419655927f, 0.000800959591f,
+    0.0275765751f, 0.0151899736f, 0.013187577f, 0.0295789707f, 0.0415651277f, 0.00120143977f,
+    0.0271760952f, 0.015590474f, 0.0127870589f, 0.0299794879f, 0.0411645956f, 0.00160191755f,
+    0.0267756488f, 0.0159909073f, 0.0123866489f, 0.0303798877f, 0.0407641716f, 0.00200239546f,
+    0.0263751708f, 0.0163913779f, 0.0119861541f, 0.0307804123f, 0.040363688f, 0.00240287953f,
+    0.0259746537f, 0.0167918932f, 0.0115856854f, 0.0311808661f, 0.0399631597f, 0.00280340808f,
+    0.025574185f, 0.0171923824f, 0.0111851655f, 0.0315813608f, 0.0395627283f, 0.00320383534f,
+    0.0251737069f, 0.0175928287f, 0.0107846875f, 0.031981919f, 0.0391621478f, 0.0036043562f,
+    0.0247732513f, 0.0179932732f, 0.0103841908f, 0.0323824324f, 0.0387616791f, 0.00400478346f,
+    0.0243728124f, 0.0183206256f, 0.0102026267f, 0.031611532f, 0.0385537557f, 0.00165610935f,
+    0.0283606742f, 0.0106702093f, 0.0199556779f, 0.0179611798f, 0.0131712602f, 0.0236918926f,
+    0.00785240158f, 0.0280131958f, 0.00385507802f, 0.0310652219f, 0.00104684185f, 0.032976646f,
+    0.0325258076f, 0.000647029141f, 0.03098212f, 0.00138190982f, 0.0302656442f, 0.00132781744f,
+    0.0302833188f, 0.000853465695f, 0.00057513325f, 0.0293037407f, 0.002906068f, 0.026582012f,
+    0.00546437269f, 0.0233837739f, 0.0084595317f, 0.0197757483f, 0.0118284719f, 0.0158191081f,
+    0.0155134378f, 0.011569879f, 0.0194616746f, 0.00707923574f, 0.023625154f, 0.00262742327f,
+    0.00239372393f, 0.0228912234f, 0.00795070827f, 0.0170882158f, 0.0133589366f, 0.0112167532f,
+    0.0188182276f, 0.000649119786f, 0.00530958874f, 0.0230458602f, 0.0069842888f, 0.0162973963f,
+    0.0132722622f, 0.00960847363f, 0.0194903035f, 0.00376860215f, 0.00300097768f, 0.0183481798f,
+    0.0106366565f, 0.0111189205f, 0.0173618514f, 0.00308589311f, 0.00404161494f, 0.0179774668f,
+    0.0103264926f, 0.0104092704f, 0.0173665807f, 0.00440334715f, 0.00304872147f, 0.0157031193f,
+    0.0118445354f, 0.0079626888f, 0.0190403834f, 0.0072690649f, 0.000473097345f, 0.0119638862f,
+    0.0147694536f, 0.00355239143f, 0.00418805797f, 0.0151379006f, 0.0113018379f, 0.000612862408f,
+    0.00712984614f, 0.0175642055f, 0.0085606426f, 0.00937302783f, 0.0161810312f, 0.00647494523f,
+    0.00151175167f, 0.0109865703f, 0.0142281996f, 0.00497902045f, 0.00300568691f, 0.012034528f,
+    0.0128258383f, 0.00401215395f, 0.00397212198f, 0.012575754f, 0.0119169075f, 0.00351834274f,
+    0.00446638232f, 0.0126648694f, 0.0114488686f, 0.00344559643f, 0.00453973608f, 0.0123523446f,
+    0.0113728028f, 0.00374640711f, 0.00423957221f, 0.0116842557f, 0.0116440719f, 0.00437671086f,
+    0.00360924168f, 0.010703465f, 0.0122213634f, 0.00529618934f, 0.00268890383f, 0.00944905728f,
+    0.0130667677f, 0.0064677028f, 0.00151529128f, 0.00795712881f, 0.014145555f, 0.00785717927f,
+    0.00156880252f, 0.000122195692f, 0.00626075501f, 0.012399314f, 0.0094333794f, 0.00344107836f,
+    0.00439020712f, 0.0102397334f, 0.0111677265f, 0.00545757031f, 0.0023731878f, 0.00794732291f,
+    0.0130341928f, 0.00759281078f, 0.00215142872f, 0.000234961291f, 0.00554669695f, 0.0108584315f,
+    0.00982358493f, 0.00463845953f, 0.00306029595f, 0.00812183879f, 0.0121288262f, 0.00718791131f,
+    0.00224699662f, 0.000508507947f, 0.00533170253f, 0.0101548973f, 0.00978126191f, 0.00507294899f,
+    0.000364636711f, 0.00250594132f, 0.00710208854f, 0.0116982358f, 0.00791501906f, 0.00342838466f,
+    0.00404057093f, 0.0084203342f, 0.0107586123f, 0.00648314506f, 0.00220767758f, 0.000984416809f,
+    0.00515802298f, 0.00933162961f, 0.00951629691f, 0.00544217229f, 0.00136804674f, 0.00192344654f,
+    0.00590046262f, 0.0098774787f, 0.00863430277f, 0.00475208182f, 0.000869860232f, 0.00251718867f,
+    0.00630693184f, 0.0100966739f, 0.00807521679f, 0.00437569525f, 0.000676174182f, 0.00280221645f,
+    0.00641361158f, 0.0100250067f, 0.00780408969f, 0.00427877204f, 0.000753454107f, 0.00281232572f,
+    0.00625363085f, 0.00969493575f, 0.00778910099f, 0.00442979531f, 0.00107048987f, 0.00257840217f,
+    0.00585767115f, 0.00913694035f, 0.00800086837f, 0.00479972083f, 0.00159857306f, 0.0021290998f,
+    0.00525398972f, 0.00837887917f, 0.00841223914f, 0.00536178797f, 0.00231133658f, 0.00149074255f,
+    0.00446850574f, 0.00744626857f, 0.00899822451f, 0.00609143963f, 0.00318465498f, 0.000277870422f,
+    0.000687522232f, 0.00352504198f, 0.00636256207f, 0.00920008216f, 0.00696619181f, 0.00419626525f,
+    0.00142633892f, 0.00244546961f, 0.00514942035f, 0.00785337109f, 0.00796538778f, 0.0053258352f,
+    0.00268628169f, 4.67283426e-05f, 0.00124983699f, 0.00382648828f, 0.00640314026f, 0.00897979084f,
+    0.00655472092f, 0.00403950922f, 0.00152429705f, 0.00241180719f, 0.0048670806f, 0.00732235424f,
+    0.00786606316f, 0.00546926586f, 0.00307246926f, 0.000675672083f, 0.000921773433f, 0.0032614856f,
+    0.00560119795f, 0.00794090983f, 0.00696037384f, 0.00467638811f, 0.00239240308f, 0.000108417924f,
+    0.00160103536f, 0.0038305982f, 0.00606016163f, 0.00828972459f, 0.00632245466f, 0.00414603855f,
+    0.00196962268f, 0.00202370179f, 0.00414825371f, 0.00627280539f, 0.00799843483f, 0.0059244968f,
+    0.00385055807f, 0.00177661981f, 0.000192363179f, 0.00221690582f, 0.00424144836f, 0.00626599137f,
+    0.00771697052f, 0.00574063556f, 0.00376430037f, 0.00178796554f, 0.000276575185f, 0.00220581912f,
+    0.00413506292f, 0.00606430648f, 0.00763017312f, 0.00574692758f, 0.00386368297f, 0.0019804379f,
+    9.71930931e-05f, 0.000175219175f, 0.00201358437f, 0.0038519497f, 0.00569031481f, 0.00752868038f,
+    0.00592159759f, 0.00412702141f, 0.00233244477f, 0.000537868182f, 0.0016614229f, 0.00341325696f,
+    0.00516509078f, 0.00691692485f, 0.0062444224f, 0.00453430973f, 0.00282419752f, 0.00111408497f,
+    0.00116902194f, 0.0028383825f, 0.00450774282f, 0.00617710315f, 0.00669668848f, 0.00506713148f,
+    0.00343757519f, 0.00180801854f, 0.000178461909f, 0.000554416154f, 0.00214513764f, 0.00373585895f,
+    0.00532658072f, 0.0069173025f, 0.00570873963f, 0.00415590871f, 0.00260307803f, 0.00105024735f,
+    0.00134983833f, 0.00286568562f, 0.00438153325f, 0.00589738041f, 0.00644368446f, 0.00496393489f,
+    0.00348418532f, 0.00200443622f, 0.000524686766f, 0.000467519538f, 0.00191201374f, 0.00335650775f,
+    0.00480100233f, 0.00624549622f, 0.00584759703f, 0.00443753414f, 0.00302747102f, 0.00161740812f,
+    0.000207345336f, 0.000888395996f, 0.0022648538f, 0.00364131178f, 0.00501776952f, 0.0063942275f,
+    0.00545055326f, 0.00410689414f, 0.00276323501f, 0.00141957588f, 7.59167378e-05f, 0.00111877022f,
+    0.00243041362f, 0.0037420569f, 0.00505370041f, 0.00636534393f, 0.00523140142f, 0.00395100983f,
+    0.00267061777f, 0.0013902256f, 0.000109833636f, 0.00117926707f, 0.00242915284f, 0.00367903826f,
+    0.00492892368f, 0.0061788098f, 0.00517058233f, 0.00395047618f, 0.00273036934f, 0.00151026295f,
+    0.000290156546f, 0.00108886929f, 0.00227990723f, 0.0034709454f, 0.00466198334f, 0.00585302152f,
+    0.00525009772f, 0.00408743415f, 0.00292477058f, 0.00176210736f, 0.000599443854f, 0.000865055306f,
+    0.00200001895f, 0.00313498289f, 0.00426994683f, 0.00540491054f, 0.00545337098f, 0.00434544776f,
+    0.00323752454f, 0.00212960131f, 0.00102167833f, 0.00052391761f, 0.00160544936f, 0.00268698088f,
+    0.00376851251f, 0.00485004438f, 0.00576520013f, 0.00470942678f, 0.00365365297f, 0.00259787939f,
+    0.00154210581f, 0.000486332225f, 8.02272334e-05f, 0.00111084606f, 0.00214146497f, 0.00317208376f,
+    0.00420270255f, 0.00523332134f, 0.00516544189f, 0.00415938767f, 0.00315333414f, 0.00214728038f,
+    0.0011412265f, 0.000135172755f, 0.000529693381f, 0.00151177205f, 0.00249385089f, 0.00347592961f,
+    0.00445800833f, 0.00544008752f, 0.00474216696f, 0.00378348771f, 0.00282480847f, 0.00186612923f,
+    0.000907449867f, 0.000810103375f, 0.00174594612f, 0.00268178876f, 0.0036176315f, 0.00455347402f,
+    0.00539048947f, 0.00447693421f, 0.00356337917f, 0.0026498239f, 0.00173626863f, 0.00082271354f,
+    4.76550158e-05f, 0.000939444755f, 0.00183123455f, 0.00272302423f, 0.00361481425f, 0.00450660381f,
+    0.00522315269f, 0.00435261801f, 0.00348208379f, 0.00261154911f, 0.00174101465f, 0.000870480086f
+};
+
+#endif /* QWEN_ASR_DSP_TABLES_H */
@@ -17,6 +17,7 @@
 #include "qwen_asr_kernels.h"
 #include "qwen_asr_safetensors.h"
 #include "qwen_asr_quant.h"
+#include "qwen_asr_perf.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -185,6 +186,28 @@ int qwen_encoder_load(qwen_encoder_t *enc, multi_safetensors_t *ms,
  * Forward Pass (split into stem_chunk + transformer)
  * ======================================================================== */
 
+/* Grow the cached sinusoidal PE table to cover n_pos positions. Every
+ * chunk's PE starts at position 0, so one monotonically grown table
+ * serves all chunks instead of regenerating the rows per call (mirrors
+ * the decoder's ensure_rope_cache). Growth is rare and the table small,
+ * so it is simply recomputed from position 0. */
+static int ensure_encoder_pe(qwen_ctx_t *ctx, int n_pos) {
+    if (n_pos <= ctx->enc_pe_cache_cap) return 0;
+    int d_model = ctx->config.enc_d_model;
+
+    int new_cap = ctx->enc_pe_cache_cap > 0 ? ctx->enc_pe_cache_cap : 64;
+    while (new_cap < n_pos) new_cap *= 2;
+
+    float *tmp = (float *)realloc(ctx->enc_pe_cache,
+                                  (size_t)new_cap * d_model * sizeof(float));
+    if (!tmp) return -1;
+    ctx->enc_pe_cache = tmp;
+
+    qwen_sinusoidal_pe(ctx->enc_pe_cache, new_cap, d_model);
+    ctx->enc_pe_cache_cap = new_cap;
+    return 0;
+}
+
 /* Compute number of tokens produced by a mel chunk of given width */
 int qwen_encoder_stem_tokens(int chunk_w) {
     int w1 = (chunk_w + 2 - 3) / 2 + 1;
@@ -255,15 +278,61 @@ float *qwen_encoder_stem_chunk(qwen_ctx_t *ctx, const float *mel, int mel_frames
     free(reshaped);
 
     /* Add per-chunk sinusoidal position embeddings (starting from pos 0) */
-    float *pe = (float *)malloc(w3 * d_model * sizeof(float));
-    qwen_sinusoidal_pe(pe, w3, d_model);
-    qwen_add_inplace(projected, pe, w3 * d_model);
-    free(pe);
+    if (ensure_encoder_pe(ctx, w3) != 0) {
+        free(projected);
+        return NULL;
+    }
+    qwen_add_inplace(projected, ctx->enc_pe_cache, w3 * d_model);
 
     *out_n_tokens = w3;
     return projected;
 }
 
+/* Grow the persistent transformer scratch buffers to cover total_tokens.
+ * Streaming calls this every chunk for the partial tail window, so the
+ * buffers live on the context instead of being re-malloc'd per call
+ * (mirrors the decoder's pref_* buffers). */
+static int ensure_encoder_buffers(qwen_ctx_t *ctx, int total_tokens) {
+    const qwen_config_t *cfg = &ctx->config;
+    int d_model = cfg->enc_d_model;
+    int ffn_dim = cfg->enc_ffn_dim;
+
+    if (total_tokens <= ctx->enc_tok_cap) return 0;
+
+    int new_cap = ctx->enc_tok_cap > 0 ? ctx->enc_tok_cap : 64;
+    while (new_cap < total_tokens) new_cap *= 2;
+
+#define REALLOC_ENC(ptr, count) do {                                           \
+    void *tmp__ = realloc((ptr), (size_t)(count) * sizeof(float));             \
+    if (!tmp__) return -1;                                                      \
+    (ptr) = (float *)tmp__;                                                     \
+} while (0)
+
+    REALLOC_ENC(ctx->enc_x_norm, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_q, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_k, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_v, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_attn_out, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_proj_out, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_ffn_mid, new_cap * ffn_dim);
+    REALLOC_ENC(ctx->enc_ffn_out, new_cap * d_model);
+    REALLOC_ENC(ctx->enc_proj_mid, new_cap * d_model);
+
+#undef REALLOC_ENC
+
+    {
+        void *tmp = realloc(ctx->enc_k_f16, (size_t)new_cap * d_model * sizeof(uint16_t));
+        if (!tmp) return -1;
+        ctx->enc_k_f16 = (uint16_t *)tmp;
+        tmp = realloc(ctx->enc_v_f16, (size_t)new_cap * d_model * sizeof(uint16_t));
+        if (!tmp) return -1;
+        ctx->enc_v_f16 = (uint16_t *)tmp;
+    }
+
+    ctx->enc_tok_cap = new_cap;
+    return 0;
+}
+
 /* Run transformer layers + final projection on concatenated stem outputs.
  * stem_x: [total_tokens, d_model] -- consumed (freed internally).
  * Returns [total_tokens, output_dim] (caller owns). */
@@ -286,6 +355,11 @@ float *qwen_encoder_transformer(qwen_ctx_t *ctx, float *stem_x, int total_tokens
     int window_token_size = tokens_per_chunk * (n_window_infer / chunk_size);
     int n_windows = (total_tokens + window_token_size - 1) / window_token_size;
     int *window_starts = (int *)malloc((n_windows + 1) * sizeof(int));
+    if (!window_starts || ensure_encoder_buffers(ctx, total_tokens) != 0) {
+        free(window_starts);
+        free(stem_x);
+        return NULL;
+    }
     for (int w = 0; w < n_windows; w++) {
         window_starts[w] = w * window_token_size;
     }
@@ -293,19 +367,20 @@ float *qwen_encoder_transformer(qwen_ctx_t *ctx, float *stem_x, int total_tokens
 
     /* ---- Transformer layers ---- */
     float *x = stem_x;
-    float *x_norm = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *q = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *k = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *v = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *attn_out = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *proj_out = (float *)malloc(total_tokens * d_model * sizeof(float));
-    float *ffn_mid = (float *)malloc(total_tokens * ffn_dim * sizeof(float));
-    float *ffn_out = (float *)malloc(total_tokens * d_model * sizeof(float));
+    float *x_norm = ctx->enc_x_norm;
+    float *q = ctx->enc_q;
+    float *k = ctx->enc_k;
+    float *v = ctx->enc_v;
+    float *attn_out = ctx->enc_attn_out;
+    float *proj_out = ctx->enc_proj_out;
+    float *ffn_mid = ctx->enc_ffn_mid;
+    float *ffn_out = ctx->enc_ffn_out;
 
     float scale = 1.0f / sqrtf((float)head_dim);
 
     for (int layer = 0; layer < cfg->enc_layers; layer++) {
         qwen_enc_layer_t *l = &enc->layers[layer];
+        qwen_perf_set_layer(layer);
 
         /* ---- Self-attention ---- */
         qwen_layer_norm(x_norm, x, l->attn_norm_weight, l->attn_norm_bias,
@@ -317,9 +392,14 @@ float *qwen_encoder_transformer(qwen_ctx_t *ctx, float *stem_x, int total_tokens
                         l->wv_weight_q8, l->wv_bias,
                         total_tokens, d_model, d_model, d_model);
 
-        qwen_bidirectional_attention(attn_out, q, k, v,
-                                      total_tokens, n_heads, head_dim, scale,
-                                      window_starts, n_windows);
+        /* K/V are re-read by every query in their window: convert once to
+         * FP16 so the attention kernel streams half the bytes (accumulation
+         * stays FP32 inside the kernel). */
+        qwen_f32_to_f16(ctx->enc_k_f16, k, total_tokens * d_model);
+        qwen_f32_to_f16(ctx->enc_v_f16, v, total_tokens * d_model);
+        qwen_bidirectional_attention_f16(attn_out, q, ctx->enc_k_f16, ctx->enc_v_f16,
+                                          total_tokens, n_heads, head_dim, scale,
+                                          window_starts, n_windows);
 
         /* Output projection + residual */
         qwen_linear_q8(proj_out, attn_out, l->wo_weight_q8, l->wo_bias,
@@ -338,26 +418,26 @@ float *qwen_encoder_transformer(qwen_ctx_t *ctx, float *stem_x, int total_tokens
                          total_tokens, ffn_dim, d_model);
         qwen_add_inplace(x, ffn_out, total_tokens * d_model);
     }
+    qwen_perf_set_layer(-1);
 
     /* Final LayerNorm */
     qwen_layer_norm(x, x, enc->ln_post_weight, enc->ln_post_bias,
                     total_tokens, d_model, 1e-5f);
 
     /* Projection: proj1 (GELU) -> proj2 */
-    float *proj_mid = (float *)malloc(total_tokens * d_model * sizeof(float));
+    float *proj_mid = ctx->enc_proj_mid;
     qwen_linear_q8(proj_mid, x, enc->proj1_weight_q8, enc->proj1_bias,
                     total_tokens, d_model, d_model);
     qwen_gelu(proj_mid, total_tokens * d_model);
 
     float *enc_output = (float *)malloc(total_tokens * output_dim * sizeof(float));
-    qwen_linear_q8(enc_output, proj_mid, enc->proj2_weight_q8, enc->proj2_bias,
-                    total_tokens, d_model, output_dim);
-    free(proj_mid);
-
-    /* Clean up */
-    free(x); free(x_norm); free(q); free(k); free(v);
-    free(attn_out); free(proj_out);
-    free(ffn_mid); free(ffn_out);
+    if (enc_output) {
+        qwen_linear_q8(enc_output, proj_mid, enc->proj2_weight_q8, enc->proj2_bias,
+                        total_tokens, d_model, output_dim);
+    }
+
+    /* Clean up (scratch buffers persist on the context) */
+    free(x);
     free(window_starts);
 
     *out_seq_len = total_tokens;
@@ -1,134 +1,22 @@
 /*
  * qwen_asr_kernels.c - Math kernels for Qwen3-ASR inference
  * Adapted from voxtral-realtime project.
+ *
+ * The thread pool lives in qwen-kernels/qwen_pool.c, shared with the TTS
+ * engine.
  */
 
 #include "qwen_asr_kernels.h"
 #include "qwen_asr_kernels_impl.h"
+#include "qwen_asr_perf.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <pthread.h>
-#include <unistd.h>
 #ifdef __ARM_NEON
 #include <arm_neon.h>
 #endif
 
-/* ========================================================================
- * Thread Pool
- * ======================================================================== */
-
-#define QWEN_MAX_THREADS 16
-
-static struct {
-    pthread_t threads[QWEN_MAX_THREADS - 1];
-    int tids[QWEN_MAX_THREADS - 1];
-    int n_threads;
-    int shutdown;
-
-    parallel_fn_t fn;
-    void *arg;
-    int generation;
-
-    pthread_mutex_t mutex;
-    pthread_cond_t cond_work;
-    pthread_cond_t cond_done;
-    int n_done;
-} tp = {
-    .n_threads = 1,
-    .shutdown = 0,
-    .generation = 0,
-    .mutex = PTHREAD_MUTEX_INITIALIZER,
-    .cond_work = PTHREAD_COND_INITIALIZER,
-    .cond_done = PTHREAD_COND_INITIALIZER,
-};
-
-static void *worker_loop(void *arg) {
-    int tid = *(int *)arg;
-    int my_gen = 0;
-
-    for (;;) {
-        pthread_mutex_lock(&tp.mutex);
-        while (tp.generation == my_gen && !tp.shutdown)
-            pthread_cond_wait(&tp.cond_work, &tp.mutex);
-        if (tp.shutdown) {
-            pthread_mutex_unlock(&tp.mutex);
-            return NULL;
-        }
-        my_gen = tp.generation;
-        parallel_fn_t fn = tp.fn;
-        void *a = tp.arg;
-        int nt = tp.n_threads;
-        pthread_mutex_unlock(&tp.mutex);
-
-        fn(tid, nt, a);
-
-        pthread_mutex_lock(&tp.mutex);
-        if (++tp.n_done >= tp.n_threads - 1)
-            pthread_cond_signal(&tp.cond_done);
-        pthread_mutex_unlock(&tp.mutex);
-    }
-}
-
-void qwen_set_threads(int n) {
-    if (n < 1) n = 1;
-    if (n > QWEN_MAX_THREADS) n = QWEN_MAX_THREADS;
-
-    /* Shutdown existing workers */
-    if (tp.n_threads > 1) {
-        pthread_mutex_lock(&tp.mutex);
-        tp.shutdown = 1;
-        pthread_cond_broadcast(&tp.cond_work);
-        pthread_mutex_unlock(&tp.mutex);
-        for (int i = 0; i < tp.n_threads - 1; i++)
-            pthread_join(tp.threads[i], NULL);
-        tp.shutdown = 0;
-        tp.generation = 0;
-    }
-
-    tp.n_threads = n;
-    if (n <= 1) return;
-
-    for (int i = 0; i < n - 1; i++) {
-        tp.tids[i] = i + 1;
-        pthread_create(&tp.threads[i], NULL, worker_loop, &tp.tids[i]);
-    }
-
-    if (qwen_verbose >= 2)
-        fprintf(stderr, "Thread pool: %d threads\n", n);
-}
-
-int qwen_get_num_cpus(void) {
-    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
-    return n > 0 ? n : 1;
-}
-
-int qwen_get_n_threads(void) { return tp.n_threads; }
-
-/* Dispatch work to all threads; main thread is tid=0 */
-void qwen_parallel_for(parallel_fn_t fn, void *arg) {
-    if (tp.n_threads <= 1) {
-        fn(0, 1, arg);
-        return;
-    }
-
-    pthread_mutex_lock(&tp.mutex);
-    tp.fn = fn;
-    tp.arg = arg;
-    tp.n_done = 0;
-    tp.generation++;
-    pthread_cond_broadcast(&tp.cond_work);
-    pthread_mutex_unlock(&tp.mutex);
-
-    fn(0, tp.n_threads, arg);
-
-    pthread_mutex_lock(&tp.mutex);
-    while (tp.n_done < tp.n_threads - 1)
-        pthread_cond_wait(&tp.cond_done, &tp.mutex);
-    pthread_mutex_unlock(&tp.mutex);
-}
-
 /* ========================================================================
  * Basic Element-wise Operations
  * ======================================================================== */
@@ -192,25 +80,10 @@ void qwen_gemm_workspace_free(void) {
     free(gemm_ws.yt);    gemm_ws.yt = NULL;    gemm_ws.yt_cap = 0;
 }
 
-/* Q8_0 INT8 GEMM worker: INT8×INT8 dot products via vdotq_s32.
- * X_q8t: [n_blocks, M_pad] (transposed quantized input)
- * W_q8:  [N, n_blocks] (quantized weights)
- * Yt:    [N, M_pad] (output, pre-initialized with bias) */
-typedef struct {
-    float *Yt;                  /* [N, M_pad] */
-    const block_q8_0 *X_q8t;   /* [n_blocks, M_pad] */
-    const block_q8_0 *W_q8;    /* [N, n_blocks] */
-    int M_pad, N, n_blocks;
-} q8_gemm_task_t;
-
-static void q8_gemm_worker(int tid, int n_threads, void *arg) {
-    q8_gemm_task_t *t = (q8_gemm_task_t *)arg;
-    int chunk = (t->N + n_threads - 1) / n_threads;
-    int n_start = tid * chunk;
-    int n_end = n_start + chunk;
-    if (n_end > t->N) n_end = t->N;
-    if (n_start >= n_end) return;
-
+/* Baseline Q8_0 GEMM worker: SDOT (scalar off-NEON). The SMMLA variant
+ * lives in qwen_asr_kernels_i8mm.c and is selected at runtime in
+ * q8_gemm_batched when the CPU reports FEAT_I8MM. */
+static void q8_gemm_rows(q8_gemm_task_t *t, int n_start, int n_end) {
     int M_pad = t->M_pad;
     int n_blocks = t->n_blocks;
 
@@ -355,6 +228,18 @@ static void q8_gemm_worker(int tid, int n_threads, void *arg) {
 #endif
 }
 
+/* Selected once per GEMM in q8_gemm_batched, before workers start. */
+static void (*q8_gemm_rows_fn)(q8_gemm_task_t *, int, int) = q8_gemm_rows;
+
+static void q8_gemm_worker(int tid, int n_threads, void *arg) {
+    q8_gemm_task_t *t = (q8_gemm_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int n_start, n_end;
+    while (qwen_tile_queue_grab(&t->tiles, &n_start, &n_end))
+        q8_gemm_rows_fn(t, n_start, n_end);
+}
+
 /* Batched Q8_0 GEMM: Y[M,N] = X[M,K] @ W_q8[N,K/32 blocks]^T + bias[N]
  * Uses INT8 dot products: quantizes X to Q8_0, then vdotq_s32 for GEMM. */
 static void q8_gemm_batched(float *Y, const float *X, const block_q8_0 *W_q8,
@@ -373,8 +258,15 @@ static void q8_gemm_batched(float *Y, const float *X, const block_q8_0 *W_q8,
             yt_row[m] = (m < M) ? b : 0.0f;
     }
 
+    q8_gemm_rows_fn = q8_gemm_rows;
+#ifdef QWEN_ASR_RUNTIME_I8MM
+    if (qwen_cpu_features() & QWEN_CPU_I8MM)
+        q8_gemm_rows_fn = qwen_q8_gemm_rows_i8mm;
+#endif
+
     q8_gemm_task_t task = { gemm_ws.yt, gemm_ws.x_q8t, W_q8, M_pad, N, n_blocks };
-    if (tp.n_threads <= 1) {
+    qwen_tile_queue_init(&task.tiles, N, qwen_get_n_threads());
+    if (qwen_get_n_threads() <= 1) {
         q8_gemm_worker(0, 1, &task);
     } else {
         qwen_parallel_for(q8_gemm_worker, &task);
@@ -391,6 +283,7 @@ typedef struct {
     const float *bias;
     int n_blocks;
     int out_dim;
+    qwen_tile_queue_t tiles;
 } q8_matvec_task_t;
 
 static void q8_matvec_fused(float *y, const block_q8_0 *x_q8, const block_q8_0 *W_q8,
@@ -400,16 +293,15 @@ static void q8_matvec_fused(float *y, const block_q8_0 *x_q8, const block_q8_0 *
 
 static void q8_matvec_worker(int tid, int n_threads, void *arg) {
     q8_matvec_task_t *t = (q8_matvec_task_t *)arg;
-    int chunk = (t->out_dim + n_threads - 1) / n_threads;
-    int start = tid * chunk;
-    int end = start + chunk;
-    if (end > t->out_dim) end = t->out_dim;
-    if (start >= end) return;
-
-    q8_matvec_fused(t->y + start, t->x_q8,
-                     t->W_q8 + (size_t)start * t->n_blocks,
-                     t->bias ? t->bias + start : NULL,
-                     t->n_blocks, end - start);
+    (void)tid;
+    (void)n_threads;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end)) {
+        q8_matvec_fused(t->y + start, t->x_q8,
+                         t->W_q8 + (size_t)start * t->n_blocks,
+                         t->bias ? t->bias + start : NULL,
+                         t->n_blocks, end - start);
+    }
 }
 
 static void q8_matvec_threaded(float *y, const float *x, const block_q8_0 *W_q8,
@@ -420,10 +312,11 @@ static void q8_matvec_threaded(float *y, const float *x, const block_q8_0 *W_q8,
     block_q8_0 *x_q8 = (block_q8_0 *)malloc((size_t)n_blocks * sizeof(block_q8_0));
     quantize_f32_to_q8_0(x, x_q8, in_dim);
 
-    if (tp.n_threads <= 1) {
+    if (qwen_get_n_threads() <= 1) {
         q8_matvec_fused(y, x_q8, W_q8, bias, n_blocks, out_dim);
     } else {
         q8_matvec_task_t task = { y, x_q8, W_q8, bias, n_blocks, out_dim };
+        qwen_tile_queue_init(&task.tiles, out_dim, qwen_get_n_threads());
         qwen_parallel_for(q8_matvec_worker, &task);
     }
 
@@ -443,16 +336,10 @@ typedef struct {
     int q_dim;
     int kv_dim;
     int total_dim;
+    qwen_tile_queue_t tiles;
 } q8_qkv_matvec_task_t;
 
-static void q8_qkv_matvec_worker(int tid, int n_threads, void *arg) {
-    q8_qkv_matvec_task_t *t = (q8_qkv_matvec_task_t *)arg;
-    int chunk = (t->total_dim + n_threads - 1) / n_threads;
-    int start = tid * chunk;
-    int end = start + chunk;
-    if (end > t->total_dim) end = t->total_dim;
-    if (start >= end) return;
-
+static void q8_qkv_matvec_range(q8_qkv_matvec_task_t *t, int start, int end) {
     int q_end = t->q_dim;
     int k_end = q_end + t->kv_dim;
     int v_end = k_end + t->kv_dim;
@@ -490,22 +377,33 @@ static void q8_qkv_matvec_worker(int tid, int n_threads, void *arg) {
     }
 }
 
+static void q8_qkv_matvec_worker(int tid, int n_threads, void *arg) {
+    q8_qkv_matvec_task_t *t = (q8_qkv_matvec_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end))
+        q8_qkv_matvec_range(t, start, end);
+}
+
 void qwen_linear_nobias_q8_qkv(float *q, float *k, float *v, const float *x,
                                 const block_q8_0 *Wq_q8,
                                 const block_q8_0 *Wk_q8,
                                 const block_q8_0 *Wv_q8,
                                 int in_dim, int q_dim, int kv_dim) {
+    uint64_t perf_t0 = qwen_perf_tic();
     int n_blocks = in_dim / QK8_0;
 
     /* Quantize x once, shared across Q/K/V */
     block_q8_0 *x_q8 = (block_q8_0 *)malloc((size_t)n_blocks * sizeof(block_q8_0));
     quantize_f32_to_q8_0(x, x_q8, in_dim);
 
-    if (tp.n_threads <= 1) {
+    if (qwen_get_n_threads() <= 1) {
         q8_matvec_fused(q, x_q8, Wq_q8, NULL, n_blocks, q_dim);
         q8_matvec_fused(k, x_q8, Wk_q8, NULL, n_blocks, kv_dim);
         q8_matvec_fused(v, x_q8, Wv_q8, NULL, n_blocks, kv_dim);
         free(x_q8);
+        qwen_perf_toc(QWEN_PERF_LINEAR_Q8, perf_t0);
         return;
     }
 
@@ -522,26 +420,32 @@ void qwen_linear_nobias_q8_qkv(float *q, float *k, float *v, const float *x,
         .kv_dim = kv_dim,
         .total_dim = q_dim + 2 * kv_dim,
     };
+    qwen_tile_queue_init(&task.tiles, task.total_dim, qwen_get_n_threads());
     qwen_parallel_for(q8_qkv_matvec_worker, &task);
     free(x_q8);
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q8, perf_t0);
 }
 
 void qwen_linear_nobias_q8(float *y, const float *x, const block_q8_0 *W_q8,
                             int seq_len, int in_dim, int out_dim) {
+    uint64_t t0 = qwen_perf_tic();
     if (seq_len > 1) {
         q8_gemm_batched(y, x, W_q8, NULL, seq_len, in_dim, out_dim);
     } else {
         q8_matvec_threaded(y, x, W_q8, NULL, in_dim, out_dim);
     }
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q8, t0);
 }
 
 void qwen_linear_q8(float *y, const float *x, const block_q8_0 *W_q8,
                     const float *b, int seq_len, int in_dim, int out_dim) {
+    uint64_t t0 = qwen_perf_tic();
     if (seq_len > 1) {
         q8_gemm_batched(y, x, W_q8, b, seq_len, in_dim, out_dim);
     } else {
         q8_matvec_threaded(y, x, W_q8, b, in_dim, out_dim);
     }
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q8, t0);
 }
 
 /* Fused QKV GEMM: quantize input once, run Q/K/V projections sharing the
@@ -565,7 +469,8 @@ static void q8_gemm_batched_with_q8t(float *Y, const block_q8_0 *X_q8t,
     }
 
     q8_gemm_task_t task = { gemm_ws.yt, X_q8t, W_q8, M_pad, N, n_blocks };
-    if (tp.n_threads <= 1) {
+    qwen_tile_queue_init(&task.tiles, N, qwen_get_n_threads());
+    if (qwen_get_n_threads() <= 1) {
         q8_gemm_worker(0, 1, &task);
     } else {
         qwen_parallel_for(q8_gemm_worker, &task);
@@ -586,16 +491,20 @@ void qwen_linear_q8_qkv_batched(
     if (seq_len <= 1) {
         if (bq || bk || bv) {
             /* Encoder path with biases: separate matvec calls */
+            uint64_t t0 = qwen_perf_tic();
             q8_matvec_threaded(q, x, Wq_q8, bq, in_dim, q_dim);
             q8_matvec_threaded(k, x, Wk_q8, bk, in_dim, kv_dim);
             q8_matvec_threaded(v, x, Wv_q8, bv, in_dim, kv_dim);
+            qwen_perf_toc(QWEN_PERF_LINEAR_Q8, t0);
         } else {
+            /* Counts itself */
             qwen_linear_nobias_q8_qkv(q, k, v, x, Wq_q8, Wk_q8, Wv_q8,
                                         in_dim, q_dim, kv_dim);
         }
         return;
     }
 
+    uint64_t perf_t0 = qwen_perf_tic();
     int M_pad = (seq_len + 3) & ~3;
     int n_blocks = in_dim / QK8_0;
 
@@ -607,6 +516,7 @@ void qwen_linear_q8_qkv_batched(
     q8_gemm_batched_with_q8t(q, gemm_ws.x_q8t, Wq_q8, bq, seq_len, M_pad, n_blocks, q_dim);
     q8_gemm_batched_with_q8t(k, gemm_ws.x_q8t, Wk_q8, bk, seq_len, M_pad, n_blocks, kv_dim);
     q8_gemm_batched_with_q8t(v, gemm_ws.x_q8t, Wv_q8, bv, seq_len, M_pad, n_blocks, kv_dim);
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q8, perf_t0);
 }
 
 /* ========================================================================
@@ -620,29 +530,30 @@ typedef struct {
     const float *x;
     int in_dim;
     int out_dim;
+    qwen_tile_queue_t tiles;
 } q4k_matvec_task_t;
 
 static void q4k_matvec_worker(int tid, int n_threads, void *arg) {
     q4k_matvec_task_t *t = (q4k_matvec_task_t *)arg;
-    int chunk = (t->out_dim + n_threads - 1) / n_threads;
-    int start = tid * chunk;
-    int end = start + chunk;
-    if (end > t->out_dim) end = t->out_dim;
-    if (start >= end) return;
-
+    (void)tid;
+    (void)n_threads;
     int blocks_per_row = t->in_dim / QK_K;
-    qwen_q4k_matvec_fused_impl(t->y + start,
-                                 t->W_q4k + (size_t)start * blocks_per_row,
-                                 t->x, end - start, t->in_dim);
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end)) {
+        qwen_q4k_matvec_fused_impl(t->y + start,
+                                     t->W_q4k + (size_t)start * blocks_per_row,
+                                     t->x, end - start, t->in_dim);
+    }
 }
 
 static void q4k_matvec_threaded(float *y, const float *x, const block_q4_k *W_q4k,
                                   int in_dim, int out_dim) {
-    if (tp.n_threads <= 1) {
+    if (qwen_get_n_threads() <= 1) {
         qwen_q4k_matvec_fused_impl(y, W_q4k, x, out_dim, in_dim);
         return;
     }
     q4k_matvec_task_t task = { y, W_q4k, x, in_dim, out_dim };
+    qwen_tile_queue_init(&task.tiles, out_dim, qwen_get_n_threads());
     qwen_parallel_for(q4k_matvec_worker, &task);
 }
 
@@ -790,23 +701,23 @@ typedef struct {
     int M, K, N;
     int blocks_per_row;
     int total_subs;
+    qwen_tile_queue_t tiles;
 } q4k_gemm_task_t;
 
 static void q4k_gemm_worker(int tid, int n_threads, void *arg) {
     q4k_gemm_task_t *t = (q4k_gemm_task_t *)arg;
-    int chunk = (t->N + n_threads - 1) / n_threads;
-    int r_start = tid * chunk;
-    int r_end = r_start + chunk;
-    if (r_end > t->N) r_end = t->N;
-    if (r_start >= r_end) return;
-
-    qwen_q4k_gemm_chunk_impl(
-        t->Y, t->N,
-        t->W_q4k, t->blocks_per_row,
-        t->x_int8, t->K,
-        t->x_scales,
-        t->bsums, t->total_subs,
-        t->M, r_start, r_end);
+    (void)tid;
+    (void)n_threads;
+    int r_start, r_end;
+    while (qwen_tile_queue_grab(&t->tiles, &r_start, &r_end)) {
+        qwen_q4k_gemm_chunk_impl(
+            t->Y, t->N,
+            t->W_q4k, t->blocks_per_row,
+            t->x_int8, t->K,
+            t->x_scales,
+            t->bsums, t->total_subs,
+            t->M, r_start, r_end);
+    }
 }
 
 static void q4k_gemm_batched(float *Y, const float *X, const block_q4_k *W_q4k,
@@ -823,8 +734,9 @@ static void q4k_gemm_batched(float *Y, const float *X, const block_q4_k *W_q4k,
         .blocks_per_row = K / QK_K,
         .total_subs = K / 32,
     };
+    qwen_tile_queue_init(&task.tiles, N, qwen_get_n_threads());
 
-    if (tp.n_threads <= 1) {
+    if (qwen_get_n_threads() <= 1) {
         q4k_gemm_worker(0, 1, &task);
     } else {
         qwen_parallel_for(q4k_gemm_worker, &task);
@@ -833,11 +745,116 @@ static void q4k_gemm_batched(float *Y, const float *X, const block_q4_k *W_q4k,
 
 void qwen_linear_nobias_q4k(float *y, const float *x, const block_q4_k *W_q4k,
                               int seq_len, int in_dim, int out_dim) {
+    uint64_t t0 = qwen_perf_tic();
     if (seq_len <= 1) {
         q4k_matvec_threaded(y, x, W_q4k, in_dim, out_dim);
     } else {
         q4k_gemm_batched(y, x, W_q4k, seq_len, in_dim, out_dim);
     }
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, t0);
+}
+
+/* ---- Q4_K x4 interleaved variants ----
+ * Same call shapes over block_q4_kx4 tiles (4 rows per tile, produced by
+ * qwen_q4k_repack_x4). Tile queues run in quad units so a grabbed range
+ * never splits a tile. */
+
+typedef struct {
+    float *y;
+    const block_q4_kx4 *W_x4;
+    const float *x;
+    int in_dim;
+    int out_dim;
+    qwen_tile_queue_t tiles;   /* quad indices: [0, out_dim/4) */
+} q4k_matvec_x4_task_t;
+
+static void q4k_matvec_x4_worker(int tid, int n_threads, void *arg) {
+    q4k_matvec_x4_task_t *t = (q4k_matvec_x4_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int blocks_per_row = t->in_dim / QK_K;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end)) {
+        qwen_q4k_matvec_fused_x4_impl(t->y + start * 4,
+                                        t->W_x4 + (size_t)start * blocks_per_row,
+                                        t->x, (end - start) * 4, t->in_dim);
+    }
+}
+
+static void q4k_matvec_threaded_x4(float *y, const float *x,
+                                     const block_q4_kx4 *W_x4,
+                                     int in_dim, int out_dim) {
+    if (qwen_get_n_threads() <= 1) {
+        qwen_q4k_matvec_fused_x4_impl(y, W_x4, x, out_dim, in_dim);
+        return;
+    }
+    q4k_matvec_x4_task_t task = { y, W_x4, x, in_dim, out_dim };
+    qwen_tile_queue_init(&task.tiles, out_dim / 4, qwen_get_n_threads());
+    qwen_parallel_for(q4k_matvec_x4_worker, &task);
+}
+
+typedef struct {
+    float *Y;                      /* [M, N] row-major output */
+    const block_q4_kx4 *W_x4;     /* [N/4, K/QK_K tiles] */
+    const int8_t *x_int8;         /* [M, K] */
+    const float *x_scales;        /* [M] */
+    const int32_t *bsums;         /* [M, total_subs] */
+    int M, K, N;
+    int blocks_per_row;
+    int total_subs;
+    qwen_tile_queue_t tiles;       /* quad indices: [0, N/4) */
+} q4k_gemm_x4_task_t;
+
+static void q4k_gemm_x4_worker(int tid, int n_threads, void *arg) {
+    q4k_gemm_x4_task_t *t = (q4k_gemm_x4_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int q_start, q_end;
+    while (qwen_tile_queue_grab(&t->tiles, &q_start, &q_end)) {
+        qwen_q4k_gemm_chunk_x4_impl(
+            t->Y, t->N,
+            t->W_x4, t->blocks_per_row,
+            t->x_int8, t->K,
+            t->x_scales,
+            t->bsums, t->total_subs,
+            t->M, q_start * 4, q_end * 4);
+    }
+}
+
+static void q4k_gemm_batched_x4(float *Y, const float *X,
+                                  const block_q4_kx4 *W_x4,
+                                  int M, int K, int N) {
+    q4k_gemm_ws_ensure(M, K);
+    q4k_preq_batch(X, M, K);
+
+    q4k_gemm_x4_task_t task = {
+        .Y = Y, .W_x4 = W_x4,
+        .x_int8 = q4k_gemm_ws.x_int8,
+        .x_scales = q4k_gemm_ws.x_scales,
+        .bsums = q4k_gemm_ws.bsums,
+        .M = M, .K = K, .N = N,
+        .blocks_per_row = K / QK_K,
+        .total_subs = K / 32,
+    };
+    qwen_tile_queue_init(&task.tiles, N / 4, qwen_get_n_threads());
+
+    if (qwen_get_n_threads() <= 1) {
+        q4k_gemm_x4_worker(0, 1, &task);
+    } else {
+        qwen_parallel_for(q4k_gemm_x4_worker, &task);
+    }
+}
+
+void qwen_linear_nobias_q4k_x4(float *y, const float *x,
+                                 const block_q4_kx4 *W_x4,
+                                 int seq_len, int in_dim, int out_dim) {
+    uint64_t t0 = qwen_perf_tic();
+    if (seq_len <= 1) {
+        q4k_matvec_threaded_x4(y, x, W_x4, in_dim, out_dim);
+    } else {
+        q4k_gemm_batched_x4(y, x, W_x4, seq_len, in_dim, out_dim);
+    }
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, t0);
 }
 
 /* Q4_K QKV fused matvec for single-token decoder */
@@ -853,16 +870,10 @@ typedef struct {
     int q_dim;
     int kv_dim;
     int total_dim;
+    qwen_tile_queue_t tiles;
 } q4k_qkv_matvec_task_t;
 
-static void q4k_qkv_matvec_worker(int tid, int n_threads, void *arg) {
-    q4k_qkv_matvec_task_t *t = (q4k_qkv_matvec_task_t *)arg;
-    int chunk = (t->total_dim + n_threads - 1) / n_threads;
-    int start = tid * chunk;
-    int end = start + chunk;
-    if (end > t->total_dim) end = t->total_dim;
-    if (start >= end) return;
-
+static void q4k_qkv_matvec_range(q4k_qkv_matvec_task_t *t, int start, int end) {
     int blocks_per_row = t->in_dim / QK_K;
     int q_end = t->q_dim;
     int k_end = q_end + t->kv_dim;
@@ -901,15 +912,26 @@ static void q4k_qkv_matvec_worker(int tid, int n_threads, void *arg) {
     }
 }
 
+static void q4k_qkv_matvec_worker(int tid, int n_threads, void *arg) {
+    q4k_qkv_matvec_task_t *t = (q4k_qkv_matvec_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end))
+        q4k_qkv_matvec_range(t, start, end);
+}
+
 void qwen_linear_nobias_q4k_qkv(float *q, float *k, float *v, const float *x,
                                   const block_q4_k *Wq_q4k,
                                   const block_q4_k *Wk_q4k,
                                   const block_q4_k *Wv_q4k,
                                   int in_dim, int q_dim, int kv_dim) {
-    if (tp.n_threads <= 1) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    if (qwen_get_n_threads() <= 1) {
         qwen_q4k_matvec_fused_impl(q, Wq_q4k, x, q_dim, in_dim);
         qwen_q4k_matvec_fused_impl(k, Wk_q4k, x, kv_dim, in_dim);
         qwen_q4k_matvec_fused_impl(v, Wv_q4k, x, kv_dim, in_dim);
+        qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
         return;
     }
 
@@ -920,40 +942,160 @@ void qwen_linear_nobias_q4k_qkv(float *q, float *k, float *v, const float *x,
         .in_dim = in_dim, .q_dim = q_dim, .kv_dim = kv_dim,
         .total_dim = q_dim + 2 * kv_dim,
     };
+    qwen_tile_queue_init(&task.tiles, task.total_dim, qwen_get_n_threads());
     qwen_parallel_for(q4k_qkv_matvec_worker, &task);
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
+}
+
+/* Q4_K x4 QKV fused matvec: tile queue over quads so grabs stay aligned
+ * to the interleaved tiles. q_dim and kv_dim are head-dim multiples, so
+ * the Q/K/V boundaries always land on quad boundaries. */
+typedef struct {
+    float *q;
+    float *k;
+    float *v;
+    const block_q4_kx4 *Wq_x4;
+    const block_q4_kx4 *Wk_x4;
+    const block_q4_kx4 *Wv_x4;
+    const float *x;
+    int in_dim;
+    int q_quads;
+    int kv_quads;
+    qwen_tile_queue_t tiles;   /* quad indices: [0, q_quads + 2*kv_quads) */
+} q4k_qkv_matvec_x4_task_t;
+
+static void q4k_qkv_matvec_x4_range(q4k_qkv_matvec_x4_task_t *t, int start, int end) {
+    int blocks_per_row = t->in_dim / QK_K;
+    int q_end = t->q_quads;
+    int k_end = q_end + t->kv_quads;
+    int v_end = k_end + t->kv_quads;
+
+    if (start < q_end) {
+        int s = start;
+        int e = end < q_end ? end : q_end;
+        if (s < e) {
+            qwen_q4k_matvec_fused_x4_impl(t->q + s * 4,
+                                            t->Wq_x4 + (size_t)s * blocks_per_row,
+                                            t->x, (e - s) * 4, t->in_dim);
+        }
+    }
+
+    if (end > q_end && start < k_end) {
+        int s = start > q_end ? start - q_end : 0;
+        int e_abs = end < k_end ? end : k_end;
+        int e = e_abs - q_end;
+        if (s < e) {
+            qwen_q4k_matvec_fused_x4_impl(t->k + s * 4,
+                                            t->Wk_x4 + (size_t)s * blocks_per_row,
+                                            t->x, (e - s) * 4, t->in_dim);
+        }
+    }
+
+    if (end > k_end && start < v_end) {
+        int s = start > k_end ? start - k_end : 0;
+        int e_abs = end < v_end ? end : v_end;
+        int e = e_abs - k_end;
+        if (s < e) {
+            qwen_q4k_matvec_fused_x4_impl(t->v + s * 4,
+                                            t->Wv_x4 + (size_t)s * blocks_per_row,
+                                            t->x, (e - s) * 4, t->in_dim);
+        }
+    }
+}
+
+static void q4k_qkv_matvec_x4_worker(int tid, int n_threads, void *arg) {
+    q4k_qkv_matvec_x4_task_t *t = (q4k_qkv_matvec_x4_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end))
+        q4k_qkv_matvec_x4_range(t, start, end);
+}
+
+void qwen_linear_nobias_q4k_qkv_x4(float *q, float *k, float *v, const float *x,
+                                     const block_q4_kx4 *Wq_x4,
+                                     const block_q4_kx4 *Wk_x4,
+                                     const block_q4_kx4 *Wv_x4,
+                                     int in_dim, int q_dim, int kv_dim) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    if (qwen_get_n_threads() <= 1) {
+        qwen_q4k_matvec_fused_x4_impl(q, Wq_x4, x, q_dim, in_dim);
+        qwen_q4k_matvec_fused_x4_impl(k, Wk_x4, x, kv_dim, in_dim);
+        qwen_q4k_matvec_fused_x4_impl(v, Wv_x4, x, kv_dim, in_dim);
+        qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
+        return;
+    }
+
+    q4k_qkv_matvec_x4_task_t task = {
+        .q = q, .k = k, .v = v,
+        .Wq_x4 = Wq_x4, .Wk_x4 = Wk_x4, .Wv_x4 = Wv_x4,
+        .x = x,
+        .in_dim = in_dim,
+        .q_quads = q_dim / 4,
+        .kv_quads = kv_dim / 4,
+    };
+    qwen_tile_queue_init(&task.tiles, task.q_quads + 2 * task.kv_quads,
+                         qwen_get_n_threads());
+    qwen_parallel_for(q4k_qkv_matvec_x4_worker, &task);
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
 }
 
 /* Q4_K argmax */
+
+/* Fold one range's (argmax, best, runner-up) into a running top-2.
+ * val2 <= val always, so the else branch only needs to test val. */
+static inline void q4k_top2_merge(int idx, float val, float val2,
+                                  int *best, float *best_val,
+                                  float *second_val) {
+    if (val > *best_val) {
+        *second_val = (*best_val > val2) ? *best_val : val2;
+        *best_val = val;
+        *best = idx;
+    } else if (val > *second_val) {
+        *second_val = val;
+    }
+}
+
 typedef struct {
     const block_q4_k *W_q4k;
     const float *x;
     int in_dim;
     int out_dim;
+    qwen_tile_queue_t tiles;
     int best_idx[QWEN_MAX_THREADS];
     float best_val[QWEN_MAX_THREADS];
+    float second_val[QWEN_MAX_THREADS];
 } q4k_argmax_task_t;
 
 static void q4k_argmax_worker(int tid, int n_threads, void *arg) {
     q4k_argmax_task_t *t = (q4k_argmax_task_t *)arg;
-    int chunk = (t->out_dim + n_threads - 1) / n_threads;
-    int start = tid * chunk;
-    int end = start + chunk;
-    if (end > t->out_dim) end = t->out_dim;
-    if (start >= end) {
-        t->best_val[tid] = -1e30f;
-        t->best_idx[tid] = 0;
-        return;
+    (void)n_threads;
+    int best = 0;
+    float best_val = -1e30f;
+    float second_val = -1e30f;
+    int start, end;
+    while (qwen_tile_queue_grab(&t->tiles, &start, &end)) {
+        int idx;
+        float val, val2;
+        qwen_q4k_argmax_range_impl(t->W_q4k, t->x, t->in_dim, start, end,
+                                    &idx, &val, &val2);
+        q4k_top2_merge(idx, val, val2, &best, &best_val, &second_val);
     }
-    qwen_q4k_argmax_range_impl(t->W_q4k, t->x, t->in_dim, start, end,
-                                &t->best_idx[tid], &t->best_val[tid]);
+    t->best_idx[tid] = best;
+    t->best_val[tid] = best_val;
+    t->second_val[tid] = second_val;
 }
 
 int qwen_argmax_matvec_q4k(const float *x, const block_q4_k *W_q4k,
-                             int in_dim, int out_dim) {
-    if (tp.n_threads <= 1) {
+                             int in_dim, int out_dim, float *margin_out) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    if (qwen_get_n_threads() <= 1) {
         int best;
-        float best_val;
-        qwen_q4k_argmax_range_impl(W_q4k, x, in_dim, 0, out_dim, &best, &best_val);
+        float best_val, second_val;
+        qwen_q4k_argmax_range_impl(W_q4k, x, in_dim, 0, out_dim,
+                                    &best, &best_val, &second_val);
+        if (margin_out) *margin_out = best_val - second_val;
+        qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
         return best;
     }
 
@@ -962,16 +1104,164 @@ int qwen_argmax_matvec_q4k(const float *x, const block_q4_k *W_q4k,
     task.x = x;
     task.in_dim = in_dim;
     task.out_dim = out_dim;
+    qwen_tile_queue_init(&task.tiles, out_dim, qwen_get_n_threads());
     qwen_parallel_for(q4k_argmax_worker, &task);
 
     int best = task.best_idx[0];
     float best_val = task.best_val[0];
-    for (int i = 1; i < tp.n_threads; i++) {
-        if (task.best_val[i] > best_val) {
-            best_val = task.best_val[i];
-            best = task.best_idx[i];
+    float second_val = task.second_val[0];
+    for (int i = 1; i < qwen_get_n_threads(); i++) {
+        q4k_top2_merge(task.best_idx[i], task.best_val[i], task.second_val[i],
+                       &best, &best_val, &second_val);
+    }
+    if (margin_out) *margin_out = best_val - second_val;
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
+    return best;
+}
+
+/* Hierarchical Q4_K argmax: branch-and-bound over row groups.
+ *
+ * The scorers compute dot(x̂, roŵ) where x̂ is x quantized to int8 and roŵ
+ * the dequantized stored row. With c the group centroid and r the max
+ * distance of any group row to it (both over dequantized rows), Cauchy-
+ * Schwarz gives score ≤ dot(x̂, c) + ‖x̂‖·r — so groups whose bound falls
+ * below the running best can be skipped without changing the result.
+ * Groups are scanned in descending bound order, up to n_threads at a time. */
+typedef struct {
+    const block_q4_k *W_q4k;
+    const float *x;
+    int in_dim;
+    int out_dim;
+    int group_size;
+    const int *group_ids;
+    int n_round;
+    int best_idx[QWEN_MAX_THREADS];
+    float best_val[QWEN_MAX_THREADS];
+    float second_val[QWEN_MAX_THREADS];
+} q4k_argmax_hier_task_t;
+
+static void q4k_argmax_hier_worker(int tid, int n_threads, void *arg) {
+    q4k_argmax_hier_task_t *t = (q4k_argmax_hier_task_t *)arg;
+    int best = 0;
+    float best_val = -1e30f;
+    float second_val = -1e30f;
+    for (int i = tid; i < t->n_round; i += n_threads) {
+        int g = t->group_ids[i];
+        int start = g * t->group_size;
+        int end = start + t->group_size;
+        if (end > t->out_dim) end = t->out_dim;
+        int idx;
+        float val, val2;
+        qwen_q4k_argmax_range_impl(t->W_q4k, t->x, t->in_dim, start, end,
+                                    &idx, &val, &val2);
+        q4k_top2_merge(idx, val, val2, &best, &best_val, &second_val);
+    }
+    t->best_idx[tid] = best;
+    t->best_val[tid] = best_val;
+    t->second_val[tid] = second_val;
+}
+
+typedef struct { float ub; int g; } hier_bound_t;
+
+static int hier_bound_cmp(const void *a, const void *b) {
+    float ua = ((const hier_bound_t *)a)->ub;
+    float ub = ((const hier_bound_t *)b)->ub;
+    return (ua < ub) - (ua > ub); /* descending */
+}
+
+int qwen_argmax_matvec_q4k_hier(const float *x, const block_q4_k *W_q4k,
+                                  int in_dim, int out_dim,
+                                  const float *centroids, const float *radii,
+                                  int n_groups, int group_size,
+                                  float *margin_out) {
+    if (!centroids || !radii || n_groups <= 0 || group_size <= 0)
+        return qwen_argmax_matvec_q4k(x, W_q4k, in_dim, out_dim, margin_out);
+
+    /* Bounds must cover what the scorer sees: quantize x exactly like the
+     * argmax kernels do and bound dot(x̂, ·) rather than dot(x, ·). */
+    static int8_t *x_int8 = NULL;
+    static int x_int8_cap = 0;
+    static hier_bound_t *bounds = NULL;
+    static int bounds_cap = 0;
+    if (in_dim > x_int8_cap) {
+        free(x_int8);
+        x_int8 = (int8_t *)malloc((size_t)in_dim * sizeof(int8_t));
+        x_int8_cap = in_dim;
+    }
+    if (n_groups > bounds_cap) {
+        free(bounds);
+        bounds = (hier_bound_t *)malloc((size_t)n_groups * sizeof(hier_bound_t));
+        bounds_cap = n_groups;
+    }
+    if (!x_int8 || !bounds)
+        return qwen_argmax_matvec_q4k(x, W_q4k, in_dim, out_dim, margin_out);
+
+    uint64_t perf_t0 = qwen_perf_tic();
+    float x_scale;
+    q4k_quantize_x_int8_scalar(x, in_dim, x_int8, &x_scale);
+
+    float xhat_norm2 = 0.0f;
+    for (int i = 0; i < in_dim; i++)
+        xhat_norm2 += (float)x_int8[i] * (float)x_int8[i];
+    float xhat_norm = x_scale * sqrtf(xhat_norm2);
+
+    for (int g = 0; g < n_groups; g++) {
+        const float *c = centroids + (size_t)g * in_dim;
+        float dot = 0.0f;
+        for (int i = 0; i < in_dim; i++)
+            dot += (float)x_int8[i] * c[i];
+        /* Small slack absorbs float rounding in the scorer's block sums
+         * and the NEON/scalar x-quantization rounding difference. */
+        bounds[g].ub = x_scale * dot + xhat_norm * radii[g] * 1.0001f + 1e-3f;
+        bounds[g].g = g;
+    }
+    qsort(bounds, (size_t)n_groups, sizeof(hier_bound_t), hier_bound_cmp);
+
+    q4k_argmax_hier_task_t task;
+    task.W_q4k = W_q4k;
+    task.x = x;
+    task.in_dim = in_dim;
+    task.out_dim = out_dim;
+    task.group_size = group_size;
+
+    /* With margin_out the scan must also pin down the runner-up, so groups
+     * are pruned against the running second-best instead of the best (the
+     * runner-up may hide in a group whose bound is below the best) — in
+     * practice a group or two extra per call. */
+    int group_ids[QWEN_MAX_THREADS];
+    int best = 0;
+    float best_val = -1e30f;
+    float second_val = -1e30f;
+    float prune = -1e30f;
+    int pos = 0;
+    int round_max = qwen_get_n_threads() > 1 ? qwen_get_n_threads() : 1;
+    while (pos < n_groups && bounds[pos].ub > prune) {
+        int n_round = 0;
+        while (n_round < round_max && pos + n_round < n_groups &&
+               bounds[pos + n_round].ub > prune) {
+            group_ids[n_round] = bounds[pos + n_round].g;
+            n_round++;
+        }
+        task.group_ids = group_ids;
+        task.n_round = n_round;
+        if (qwen_get_n_threads() > 1 && n_round > 1) {
+            qwen_parallel_for(q4k_argmax_hier_worker, &task);
+            for (int i = 0; i < qwen_get_n_threads(); i++) {
+                q4k_top2_merge(task.best_idx[i], task.best_val[i],
+                               task.second_val[i],
+                               &best, &best_val, &second_val);
+            }
+        } else {
+            q4k_argmax_hier_worker(0, 1, &task);
+            q4k_top2_merge(task.best_idx[0], task.best_val[0],
+                           task.second_val[0],
+                           &best, &best_val, &second_val);
         }
+        prune = margin_out ? second_val : best_val;
+        pos += n_round;
     }
+    if (margin_out) *margin_out = best_val - second_val;
+    qwen_perf_toc(QWEN_PERF_LINEAR_Q4K, perf_t0);
     return best;
 }
 
@@ -1018,16 +1308,10 @@ typedef struct {
     int c_out;
     int patch_size;
     int spatial_out;
+    qwen_tile_queue_t tiles;
 } conv2d_gemm_task_t;
 
-static void conv2d_gemm_worker(int tid, int n_threads, void *arg) {
-    conv2d_gemm_task_t *t = (conv2d_gemm_task_t *)arg;
-    int chunk = (t->c_out + n_threads - 1) / n_threads;
-    int oc_start = tid * chunk;
-    int oc_end = oc_start + chunk;
-    if (oc_end > t->c_out) oc_end = t->c_out;
-    if (oc_start >= oc_end) return;
-
+static void conv2d_gemm_rows(conv2d_gemm_task_t *t, int oc_start, int oc_end) {
     int patch_size = t->patch_size;
     int spatial_out = t->spatial_out;
     const float *cols = t->cols;
@@ -1121,9 +1405,19 @@ static void conv2d_gemm_worker(int tid, int n_threads, void *arg) {
 #endif
 }
 
+static void conv2d_gemm_worker(int tid, int n_threads, void *arg) {
+    conv2d_gemm_task_t *t = (conv2d_gemm_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int oc_start, oc_end;
+    while (qwen_tile_queue_grab(&t->tiles, &oc_start, &oc_end))
+        conv2d_gemm_rows(t, oc_start, oc_end);
+}
+
 void qwen_conv2d(float *out, const float *in, const float *weight, const float *bias,
                  int c_in, int c_out, int h_in, int w_in,
                  int kh, int kw, int stride, int padding) {
+    uint64_t perf_t0 = qwen_perf_tic();
     int h_out = (h_in + 2 * padding - kh) / stride + 1;
     int w_out = (w_in + 2 * padding - kw) / stride + 1;
     int patch_size = c_in * kh * kw;
@@ -1156,7 +1450,9 @@ void qwen_conv2d(float *out, const float *in, const float *weight, const float *
         .out = out, .weight = weight, .cols = cols, .bias = bias,
         .c_out = c_out, .patch_size = patch_size, .spatial_out = spatial_out
     };
+    qwen_tile_queue_init(&task.tiles, c_out, qwen_get_n_threads());
     qwen_parallel_for(conv2d_gemm_worker, &task);
     free(cols);
 #endif
+    qwen_perf_toc(QWEN_PERF_CONV2D, perf_t0);
 }
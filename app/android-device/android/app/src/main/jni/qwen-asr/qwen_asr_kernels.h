@@ -111,6 +111,13 @@ void qwen_bidirectional_attention(float *out, const float *Q, const float *K,
                                    int head_dim, float scale,
                                    const int *window_starts, int n_windows);
 
+/* Same as qwen_bidirectional_attention but with FP16 K/V (uint16_t bit
+ * pattern, see qwen_f32_to_f16). Scores and output accumulate in FP32. */
+void qwen_bidirectional_attention_f16(float *out, const float *Q,
+                                       const uint16_t *K_fp16, const uint16_t *V_fp16,
+                                       int seq, int n_heads, int head_dim, float scale,
+                                       const int *window_starts, int n_windows);
+
 /*
  * Causal attention with GQA (decoder).
  * Q: [seq_q, n_heads * head_dim]
@@ -123,6 +130,19 @@ void qwen_causal_attention(float *out, const float *Q,
                             int seq_q, int seq_k, int n_heads, int n_kv_heads,
                             int head_dim, float scale, int q_offset);
 
+/*
+ * Causal attention with GQA over an INT8 KV cache.
+ * K_q8, V_q8: [seq_k, n_kv_heads * head_dim] as int8
+ * K_scale, V_scale: [seq_k, n_kv_heads] per-head dequant scales
+ * Q is quantized per head on the fly so score dot products run on int8
+ * (SDOT on dotprod-capable cores).
+ */
+void qwen_causal_attention_q8(float *out, const float *Q,
+                               const int8_t *K_q8, const float *K_scale,
+                               const int8_t *V_q8, const float *V_scale,
+                               int seq_q, int seq_k, int n_heads, int n_kv_heads,
+                               int head_dim, float scale, int q_offset);
+
 /* ========================================================================
  * Position Embeddings
  * ======================================================================== */
@@ -168,9 +188,36 @@ void qwen_linear_nobias_q4k_qkv(float *q, float *k, float *v, const float *x,
                                   const block_q4_k *Wv_q4k,
                                   int in_dim, int q_dim, int kv_dim);
 
-/* Q4_K streaming argmax: finds argmax(W_q4k @ x) using Q4_K dot products. */
+/* Q4_K x4 linear over interleaved tiles (qwen_q4k_repack_x4): same shapes
+ * as qwen_linear_nobias_q4k, but the 4 rows of each tile share x loads and
+ * stream contiguous scales/mins/nibbles. out_dim must be a multiple of 4. */
+void qwen_linear_nobias_q4k_x4(float *y, const float *x,
+                                 const block_q4_kx4 *W_x4,
+                                 int seq_len, int in_dim, int out_dim);
+
+/* Q4_K x4 fused QKV matvec; q_dim and kv_dim must be multiples of 4. */
+void qwen_linear_nobias_q4k_qkv_x4(float *q, float *k, float *v, const float *x,
+                                     const block_q4_kx4 *Wq_x4,
+                                     const block_q4_kx4 *Wk_x4,
+                                     const block_q4_kx4 *Wv_x4,
+                                     int in_dim, int q_dim, int kv_dim);
+
+/* Q4_K streaming argmax: finds argmax(W_q4k @ x) using Q4_K dot products.
+ * margin_out (optional) receives best minus runner-up logit. */
 int qwen_argmax_matvec_q4k(const float *x, const block_q4_k *W_q4k,
-                             int in_dim, int out_dim);
+                             int in_dim, int out_dim, float *margin_out);
+
+/* Hierarchical Q4_K argmax: scans a coarse per-group index (centroid +
+ * radius over group_size consecutive rows) and exact-scores only groups
+ * whose upper bound beats the running best. Result matches the full scan;
+ * falls back to it when the index is NULL. margin_out (optional) receives
+ * the exact best-minus-runner-up logit gap; requesting it makes the scan
+ * prune against the runner-up instead of the best. */
+int qwen_argmax_matvec_q4k_hier(const float *x, const block_q4_k *W_q4k,
+                                  int in_dim, int out_dim,
+                                  const float *centroids, const float *radii,
+                                  int n_groups, int group_size,
+                                  float *margin_out);
 
 /* ========================================================================
  * FP16 Conversion
@@ -182,18 +229,18 @@ void qwen_f32_to_f16(uint16_t *dst, const float *src, int n);
 /* Convert FP16 (uint16_t) array to FP32. NEON-accelerated on ARM. */
 void qwen_f16_to_f32(float *dst, const uint16_t *src, int n);
 
+/* Quantize one token's K or V vector to int8 with one absmax scale per head.
+ * src: [n_heads * head_dim], dst: [n_heads * head_dim], scales: [n_heads]. */
+void qwen_f32_to_q8_per_head(int8_t *dst, float *scales, const float *src,
+                              int n_heads, int head_dim);
+
 /* ========================================================================
  * Threading
  * ======================================================================== */
 
-/* Set number of threads for parallel operations (default: 1).
- * Creates a persistent thread pool. Call before inference. */
-void qwen_set_threads(int n);
-
-/* Get number of available CPU cores */
-int qwen_get_num_cpus(void);
-
-/* Global verbose flag */
-extern int qwen_verbose;
+/* The thread pool (qwen_set_threads, qwen_parallel_for, tile queues, the
+ * qwen_verbose flag) is shared with the TTS engine and lives in
+ * qwen-kernels/qwen_pool.h, pulled in via qwen_asr_kernels_impl.h and here. */
+#include "qwen_pool.h"
 
 #endif /* QWEN_ASR_KERNELS_H */
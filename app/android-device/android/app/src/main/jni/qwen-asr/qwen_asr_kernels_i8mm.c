@@ -0,0 +1,375 @@
+/*
+ * qwen_asr_kernels_i8mm.c - SMMLA (FEAT_I8MM) GEMM kernel variants
+ *
+ * Compiled with -march=armv8.2-a+dotprod+i8mm via a per-file option in
+ * CMakeLists.txt while the rest of the library stays on the Cortex-A55
+ * baseline; callers select these through qwen_cpu_features() so one
+ * arm64-v8a APK runs everywhere and still uses SMMLA on A710/A715.
+ */
+
+#include "qwen_asr_kernels_impl.h"
+
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_MATMUL_INT8)
+
+#include <arm_neon.h>
+
+/* Q8_0 GEMM rows: vmmlaq_s32 computes a 2x2 int32 tile (2 weight rows x
+ * 2 input columns) per instruction — roughly 2x SDOT throughput on
+ * Cortex-A710/A715 class cores, with no cross-lane reduction needed. */
+void qwen_q8_gemm_rows_i8mm(q8_gemm_task_t *t, int n_start, int n_end) {
+    int M_pad = t->M_pad;
+    int n_blocks = t->n_blocks;
+
+    /* N-tiling: tile the N dimension so Yt[Nc, M_pad] fits in L1D (~32KB).
+     * Same scheme as the baseline worker in qwen_asr_kernels.c. */
+    int Nc = 32768 / (M_pad * (int)sizeof(float));
+    if (Nc < 4) Nc = 4;
+    if (Nc > (n_end - n_start)) Nc = n_end - n_start;
+
+    for (int n_base = n_start; n_base < n_end; n_base += Nc) {
+        int n_tile_end = n_base + Nc;
+        if (n_tile_end > n_end) n_tile_end = n_end;
+
+        for (int kb = 0; kb < n_blocks; kb++) {
+            const block_q8_0 *x_col = t->X_q8t + (size_t)kb * M_pad;
+
+            int n = n_base;
+            for (; n + 1 < n_tile_end; n += 2) {
+                float *yt0 = t->Yt + (size_t)n * M_pad;
+                float *yt1 = yt0 + M_pad;
+                const block_q8_0 *wb0 = &t->W_q8[(size_t)n * n_blocks + kb];
+                const block_q8_0 *wb1 = &t->W_q8[(size_t)(n + 1) * n_blocks + kb];
+                float ws0 = wb0->scale;
+                float ws1 = wb1->scale;
+
+                /* A matrices: [w_n seg | w_n+1 seg] per 8-byte K segment */
+                int8x16_t a0 = vcombine_s8(vld1_s8(wb0->qs),      vld1_s8(wb1->qs));
+                int8x16_t a1 = vcombine_s8(vld1_s8(wb0->qs + 8),  vld1_s8(wb1->qs + 8));
+                int8x16_t a2 = vcombine_s8(vld1_s8(wb0->qs + 16), vld1_s8(wb1->qs + 16));
+                int8x16_t a3 = vcombine_s8(vld1_s8(wb0->qs + 24), vld1_s8(wb1->qs + 24));
+
+                for (int m = 0; m < M_pad; m += 2) {
+                    const block_q8_0 *xb0 = &x_col[m];
+                    const block_q8_0 *xb1 = &x_col[m + 1];
+
+                    int32x4_t acc = vmmlaq_s32(vdupq_n_s32(0), a0,
+                        vcombine_s8(vld1_s8(xb0->qs),      vld1_s8(xb1->qs)));
+                    acc = vmmlaq_s32(acc, a1,
+                        vcombine_s8(vld1_s8(xb0->qs + 8),  vld1_s8(xb1->qs + 8)));
+                    acc = vmmlaq_s32(acc, a2,
+                        vcombine_s8(vld1_s8(xb0->qs + 16), vld1_s8(xb1->qs + 16)));
+                    acc = vmmlaq_s32(acc, a3,
+                        vcombine_s8(vld1_s8(xb0->qs + 24), vld1_s8(xb1->qs + 24)));
+
+                    /* acc lanes = {n·m, n·m+1, n+1·m, n+1·m+1} */
+                    float32x4_t accf = vcvtq_f32_s32(acc);
+                    float32x4_t sc = {ws0 * xb0->scale, ws0 * xb1->scale,
+                                      ws1 * xb0->scale, ws1 * xb1->scale};
+                    float32x4_t scaled = vmulq_f32(accf, sc);
+
+                    vst1_f32(yt0 + m, vadd_f32(vld1_f32(yt0 + m), vget_low_f32(scaled)));
+                    vst1_f32(yt1 + m, vadd_f32(vld1_f32(yt1 + m), vget_high_f32(scaled)));
+                }
+            }
+
+            /* Odd output row: SDOT (every i8mm core also has dotprod) */
+            for (; n < n_tile_end; n++) {
+                float *yt_row = t->Yt + (size_t)n * M_pad;
+                const block_q8_0 *wb = &t->W_q8[(size_t)n * n_blocks + kb];
+                float w_scale = wb->scale;
+                int8x16_t w_lo = vld1q_s8(wb->qs);
+                int8x16_t w_hi = vld1q_s8(wb->qs + 16);
+
+                for (int m = 0; m < M_pad; m += 4) {
+                    const block_q8_0 *xb0 = &x_col[m];
+                    const block_q8_0 *xb1 = &x_col[m + 1];
+                    const block_q8_0 *xb2 = &x_col[m + 2];
+                    const block_q8_0 *xb3 = &x_col[m + 3];
+
+                    int32x4_t d0 = vdotq_s32(vdupq_n_s32(0), w_lo, vld1q_s8(xb0->qs));
+                    d0 = vdotq_s32(d0, w_hi, vld1q_s8(xb0->qs + 16));
+                    int32x4_t d1 = vdotq_s32(vdupq_n_s32(0), w_lo, vld1q_s8(xb1->qs));
+                    d1 = vdotq_s32(d1, w_hi, vld1q_s8(xb1->qs + 16));
+                    int32x4_t d2 = vdotq_s32(vdupq_n_s32(0), w_lo, vld1q_s8(xb2->qs));
+                    d2 = vdotq_s32(d2, w_hi, vld1q_s8(xb2->qs + 16));
+                    int32x4_t d3 = vdotq_s32(vdupq_n_s32(0), w_lo, vld1q_s8(xb3->qs));
+                    d3 = vdotq_s32(d3, w_hi, vld1q_s8(xb3->qs + 16));
+
+                    int32x4_t p01 = vpaddq_s32(d0, d1);
+                    int32x4_t p23 = vpaddq_s32(d2, d3);
+                    int32x4_t all4 = vpaddq_s32(p01, p23);
+
+                    float32x4_t dots_f = vcvtq_f32_s32(all4);
+                    float32x4_t xs = {xb0->scale, xb1->scale, xb2->scale, xb3->scale};
+                    float32x4_t scaled = vmulq_f32(vmulq_n_f32(dots_f, w_scale), xs);
+
+                    float32x4_t acc = vld1q_f32(yt_row + m);
+                    vst1q_f32(yt_row + m, vaddq_f32(acc, scaled));
+                }
+            }
+        }
+    }
+}
+
+/* Q4_K batched GEMM chunk: SMMLA computes a 2x2 tile (2 weight rows x
+ * 2 tokens) per instruction, so each unpacked nibble pair feeds 4 dot
+ * products with no cross-lane reduction. */
+void qwen_q4k_gemm_chunk_i8mm(
+    float *Y, int Y_stride,
+    const block_q4_k *W_q4k, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end
+) {
+    int n_rows = r_end - r_start;
+    if (n_rows <= 0) return;
+
+    const block_q4_k *W_chunk = W_q4k + (size_t)r_start * blocks_per_row;
+
+    uint8x16_t mask_0f = vdupq_n_u8(0x0F);
+
+    int r = 0;
+    for (; r + 1 < n_rows; r += 2) {
+        const block_q4_k *row0 = W_chunk + (size_t)r * blocks_per_row;
+        const block_q4_k *row1 = row0 + blocks_per_row;
+        int out0 = r_start + r;
+        int out1 = out0 + 1;
+
+        int m = 0;
+        for (; m + 1 < M; m += 2) {
+            const int8_t *xi0 = x_int8 + (size_t)m * K;
+            const int8_t *xi1 = x_int8 + (size_t)(m + 1) * K;
+            const int32_t *bs0 = bsums + (size_t)m * total_subs;
+            const int32_t *bs1 = bsums + (size_t)(m + 1) * total_subs;
+
+            float s00 = 0.0f, s01 = 0.0f, s10 = 0.0f, s11 = 0.0f;
+
+            for (int b = 0; b < blocks_per_row; b++) {
+                const block_q4_k *blk0 = &row0[b];
+                const block_q4_k *blk1 = &row1[b];
+                int boff = b * QK_K;
+                int bsoff = b * Q4K_NUM_SUBS;
+
+                int32x4_t acc = vdupq_n_s32(0);
+                int32_t ma00 = 0, ma01 = 0, ma10 = 0, ma11 = 0;
+
+                for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                    uint8x16_t p0 = vld1q_u8(blk0->qs + g * 16);
+                    int8x16_t w0lo = vreinterpretq_s8_u8(vandq_u8(p0, mask_0f));
+                    int8x16_t w0hi = vreinterpretq_s8_u8(vshrq_n_u8(p0, 4));
+                    int8x16x2_t z0 = vzipq_s8(w0lo, w0hi);
+
+                    uint8x16_t p1 = vld1q_u8(blk1->qs + g * 16);
+                    int8x16_t w1lo = vreinterpretq_s8_u8(vandq_u8(p1, mask_0f));
+                    int8x16_t w1hi = vreinterpretq_s8_u8(vshrq_n_u8(p1, 4));
+                    int8x16x2_t z1 = vzipq_s8(w1lo, w1hi);
+
+                    int goff = boff + g * 32;
+                    int8x16_t x0a = vld1q_s8(xi0 + goff);
+                    int8x16_t x0b = vld1q_s8(xi0 + goff + 16);
+                    int8x16_t x1a = vld1q_s8(xi1 + goff);
+                    int8x16_t x1b = vld1q_s8(xi1 + goff + 16);
+
+                    /* A = [row0 seg | row1 seg], B = [tok0 seg | tok1 seg];
+                     * 4 SMMLAs accumulate the full 32-element dots. */
+                    int32x4_t d = vmmlaq_s32(vdupq_n_s32(0),
+                        vcombine_s8(vget_low_s8(z0.val[0]), vget_low_s8(z1.val[0])),
+                        vcombine_s8(vget_low_s8(x0a), vget_low_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z0.val[0]), vget_high_s8(z1.val[0])),
+                        vcombine_s8(vget_high_s8(x0a), vget_high_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_low_s8(z0.val[1]), vget_low_s8(z1.val[1])),
+                        vcombine_s8(vget_low_s8(x0b), vget_low_s8(x1b)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z0.val[1]), vget_high_s8(z1.val[1])),
+                        vcombine_s8(vget_high_s8(x0b), vget_high_s8(x1b)));
+
+                    /* d lanes = {r0·m0, r0·m1, r1·m0, r1·m1} */
+                    int32x4_t scv = vcombine_s32(
+                        vdup_n_s32((int32_t)blk0->scales[g]),
+                        vdup_n_s32((int32_t)blk1->scales[g]));
+                    acc = vaddq_s32(acc, vmulq_s32(d, scv));
+
+                    int32_t mn0 = (int32_t)blk0->mins[g];
+                    int32_t mn1 = (int32_t)blk1->mins[g];
+                    ma00 += mn0 * bs0[bsoff + g];
+                    ma01 += mn0 * bs1[bsoff + g];
+                    ma10 += mn1 * bs0[bsoff + g];
+                    ma11 += mn1 * bs1[bsoff + g];
+                }
+
+                float d0 = blk0->d, dm0 = blk0->dmin;
+                float d1 = blk1->d, dm1 = blk1->dmin;
+                s00 += d0 * (float)vgetq_lane_s32(acc, 0) - dm0 * (float)ma00;
+                s01 += d0 * (float)vgetq_lane_s32(acc, 1) - dm0 * (float)ma01;
+                s10 += d1 * (float)vgetq_lane_s32(acc, 2) - dm1 * (float)ma10;
+                s11 += d1 * (float)vgetq_lane_s32(acc, 3) - dm1 * (float)ma11;
+            }
+
+            Y[(size_t)m * Y_stride + out0]       = s00 * x_scales[m];
+            Y[(size_t)(m + 1) * Y_stride + out0] = s01 * x_scales[m + 1];
+            Y[(size_t)m * Y_stride + out1]       = s10 * x_scales[m];
+            Y[(size_t)(m + 1) * Y_stride + out1] = s11 * x_scales[m + 1];
+        }
+
+        /* Token remainder: preq kernel handles both rows at once */
+        for (; m < M; m++) {
+            qwen_q4k_matvec_preq_neon(
+                Y + (size_t)m * Y_stride + out0,
+                row0,
+                x_int8 + (size_t)m * K,
+                x_scales[m],
+                bsums + (size_t)m * total_subs,
+                2, K);
+        }
+    }
+
+    /* Odd output row */
+    for (; r < n_rows; r++) {
+        const block_q4_k *row_blk = W_chunk + (size_t)r * blocks_per_row;
+        for (int m = 0; m < M; m++) {
+            qwen_q4k_matvec_preq_neon(
+                Y + (size_t)m * Y_stride + (r_start + r),
+                row_blk,
+                x_int8 + (size_t)m * K,
+                x_scales[m],
+                bsums + (size_t)m * total_subs,
+                1, K);
+        }
+    }
+}
+
+/* Q4_K x4 GEMM chunk over interleaved tiles: each quad runs as two SMMLA
+ * row pairs (rows 0-1 and 2-3), so the 2x2 tile shape is unchanged while
+ * the weight bytes and scales stream from one contiguous tile. r_start /
+ * r_end are row indices, always multiples of 4. */
+void qwen_q4k_gemm_chunk_x4_i8mm(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end
+) {
+    int n_quads = (r_end - r_start) / 4;
+    if (n_quads <= 0) return;
+
+    const block_q4_kx4 *W_chunk = W_x4 + (size_t)(r_start / 4) * blocks_per_row;
+
+    uint8x16_t mask_0f = vdupq_n_u8(0x0F);
+
+    for (int q = 0; q < n_quads; q++) {
+        const block_q4_kx4 *row_tile = W_chunk + (size_t)q * blocks_per_row;
+        int out_base = r_start + q * 4;
+
+        int m = 0;
+        for (; m + 1 < M; m += 2) {
+            const int8_t *xi0 = x_int8 + (size_t)m * K;
+            const int8_t *xi1 = x_int8 + (size_t)(m + 1) * K;
+            const int32_t *bs0 = bsums + (size_t)m * total_subs;
+            const int32_t *bs1 = bsums + (size_t)(m + 1) * total_subs;
+
+            /* s[row][token] */
+            float s[4][2] = {{0}};
+
+            for (int b = 0; b < blocks_per_row; b++) {
+                const block_q4_kx4 *t = &row_tile[b];
+                int boff = b * QK_K;
+                int bsoff = b * Q4K_NUM_SUBS;
+
+                int32x4_t acc_lo = vdupq_n_s32(0);  /* rows 0-1 */
+                int32x4_t acc_hi = vdupq_n_s32(0);  /* rows 2-3 */
+                int32_t ma[4][2] = {{0}};
+
+                for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                    int goff = boff + g * 32;
+                    int8x16_t x0a = vld1q_s8(xi0 + goff);
+                    int8x16_t x0b = vld1q_s8(xi0 + goff + 16);
+                    int8x16_t x1a = vld1q_s8(xi1 + goff);
+                    int8x16_t x1b = vld1q_s8(xi1 + goff + 16);
+                    int32_t b0 = bs0[bsoff + g];
+                    int32_t b1 = bs1[bsoff + g];
+
+                    int8x16x2_t z[4];
+                    for (int rr = 0; rr < 4; rr++) {
+                        uint8x16_t p = vld1q_u8(t->qs[g][rr]);
+                        z[rr] = vzipq_s8(
+                            vreinterpretq_s8_u8(vandq_u8(p, mask_0f)),
+                            vreinterpretq_s8_u8(vshrq_n_u8(p, 4)));
+                        ma[rr][0] += (int32_t)t->mins[g][rr] * b0;
+                        ma[rr][1] += (int32_t)t->mins[g][rr] * b1;
+                    }
+
+                    /* Rows 0-1: 4 SMMLAs accumulate the full 32-elem dots;
+                     * d lanes = {r0·m0, r0·m1, r1·m0, r1·m1} */
+                    int32x4_t d = vmmlaq_s32(vdupq_n_s32(0),
+                        vcombine_s8(vget_low_s8(z[0].val[0]), vget_low_s8(z[1].val[0])),
+                        vcombine_s8(vget_low_s8(x0a), vget_low_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z[0].val[0]), vget_high_s8(z[1].val[0])),
+                        vcombine_s8(vget_high_s8(x0a), vget_high_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_low_s8(z[0].val[1]), vget_low_s8(z[1].val[1])),
+                        vcombine_s8(vget_low_s8(x0b), vget_low_s8(x1b)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z[0].val[1]), vget_high_s8(z[1].val[1])),
+                        vcombine_s8(vget_high_s8(x0b), vget_high_s8(x1b)));
+                    int32x4_t scv = vcombine_s32(
+                        vdup_n_s32((int32_t)t->scales[g][0]),
+                        vdup_n_s32((int32_t)t->scales[g][1]));
+                    acc_lo = vaddq_s32(acc_lo, vmulq_s32(d, scv));
+
+                    /* Rows 2-3 */
+                    d = vmmlaq_s32(vdupq_n_s32(0),
+                        vcombine_s8(vget_low_s8(z[2].val[0]), vget_low_s8(z[3].val[0])),
+                        vcombine_s8(vget_low_s8(x0a), vget_low_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z[2].val[0]), vget_high_s8(z[3].val[0])),
+                        vcombine_s8(vget_high_s8(x0a), vget_high_s8(x1a)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_low_s8(z[2].val[1]), vget_low_s8(z[3].val[1])),
+                        vcombine_s8(vget_low_s8(x0b), vget_low_s8(x1b)));
+                    d = vmmlaq_s32(d,
+                        vcombine_s8(vget_high_s8(z[2].val[1]), vget_high_s8(z[3].val[1])),
+                        vcombine_s8(vget_high_s8(x0b), vget_high_s8(x1b)));
+                    scv = vcombine_s32(
+                        vdup_n_s32((int32_t)t->scales[g][2]),
+                        vdup_n_s32((int32_t)t->scales[g][3]));
+                    acc_hi = vaddq_s32(acc_hi, vmulq_s32(d, scv));
+                }
+
+                s[0][0] += t->d[0] * (float)vgetq_lane_s32(acc_lo, 0) - t->dmin[0] * (float)ma[0][0];
+                s[0][1] += t->d[0] * (float)vgetq_lane_s32(acc_lo, 1) - t->dmin[0] * (float)ma[0][1];
+                s[1][0] += t->d[1] * (float)vgetq_lane_s32(acc_lo, 2) - t->dmin[1] * (float)ma[1][0];
+                s[1][1] += t->d[1] * (float)vgetq_lane_s32(acc_lo, 3) - t->dmin[1] * (float)ma[1][1];
+                s[2][0] += t->d[2] * (float)vgetq_lane_s32(acc_hi, 0) - t->dmin[2] * (float)ma[2][0];
+                s[2][1] += t->d[2] * (float)vgetq_lane_s32(acc_hi, 1) - t->dmin[2] * (float)ma[2][1];
+                s[3][0] += t->d[3] * (float)vgetq_lane_s32(acc_hi, 2) - t->dmin[3] * (float)ma[3][0];
+                s[3][1] += t->d[3] * (float)vgetq_lane_s32(acc_hi, 3) - t->dmin[3] * (float)ma[3][1];
+            }
+
+            float xs0 = x_scales[m], xs1 = x_scales[m + 1];
+            float *y0 = Y + (size_t)m * Y_stride + out_base;
+            float *y1 = Y + (size_t)(m + 1) * Y_stride + out_base;
+            for (int rr = 0; rr < 4; rr++) {
+                y0[rr] = s[rr][0] * xs0;
+                y1[rr] = s[rr][1] * xs1;
+            }
+        }
+
+        /* Single token remainder */
+        for (; m < M; m++) {
+            qwen_q4k_matvec_preq_x4_neon(
+                Y + (size_t)m * Y_stride + out_base,
+                row_tile,
+                x_int8 + (size_t)m * K,
+                x_scales[m],
+                bsums + (size_t)m * total_subs,
+                4, K);
+        }
+    }
+}
+
+#endif /* __ARM_NEON && __ARM_FEATURE_MATMUL_INT8 */
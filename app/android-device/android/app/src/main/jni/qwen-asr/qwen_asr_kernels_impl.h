@@ -8,11 +8,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "qwen_asr_quant.h"
-
-/* Thread pool parallel_for (defined in qwen_asr_kernels.c) */
-typedef void (*parallel_fn_t)(int tid, int n_threads, void *arg);
-void qwen_parallel_for(parallel_fn_t fn, void *arg);
-int qwen_get_n_threads(void);
+#include "qwen_pool.h"  /* shared pool: qwen_parallel_for, tile queues */
+#include "qwen_cpu.h"   /* runtime feature bits for kernel dispatch */
 
 /* Q8_0 matvec */
 void qwen_q8_matvec_fused_neon(float *y, const block_q8_0 *x_q8,
@@ -36,7 +33,75 @@ void qwen_q4k_gemm_chunk_neon(
 void qwen_q4k_argmax_range_neon(const block_q4_k *blocks,
                                   const float *x, int cols,
                                   int start, int end,
-                                  int *best_out, float *best_val_out);
+                                  int *best_out, float *best_val_out,
+                                  float *second_val_out);
+
+/* Q4_K x4 interleaved variants (block_q4_kx4 tiles, rows % 4 == 0; GEMM
+ * r_start/r_end are row indices in multiples of 4). */
+void qwen_q4k_matvec_fused_x4_neon(float *out, const block_q4_kx4 *tiles,
+                                     const float *x, int rows, int cols);
+void qwen_q4k_matvec_preq_x4_neon(float *out, const block_q4_kx4 *tiles,
+                                    const int8_t *x_int8, float x_scale,
+                                    const int32_t *bsums,
+                                    int rows, int cols);
+void qwen_q4k_gemm_chunk_x4_neon(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end);
+
+/* Q8_0 batched-GEMM task, shared between the baseline SDOT worker in
+ * qwen_asr_kernels.c and the i8mm variant (a separate translation unit so
+ * it can be compiled with -march=+i8mm while everything else stays on the
+ * Cortex-A55-safe baseline).
+ * X_q8t: [n_blocks, M_pad] (transposed quantized input)
+ * W_q8:  [N, n_blocks] (quantized weights)
+ * Yt:    [N, M_pad] (output, pre-initialized with bias) */
+typedef struct {
+    float *Yt;
+    const block_q8_0 *X_q8t;
+    const block_q8_0 *W_q8;
+    int M_pad, N, n_blocks;
+    qwen_tile_queue_t tiles;
+} q8_gemm_task_t;
+
+#ifdef QWEN_ASR_RUNTIME_I8MM
+/* SMMLA kernel variants from qwen_asr_kernels_i8mm.c; only called when
+ * qwen_cpu_features() reports FEAT_I8MM. */
+void qwen_q8_gemm_rows_i8mm(q8_gemm_task_t *t, int n_start, int n_end);
+void qwen_q4k_gemm_chunk_i8mm(
+    float *Y, int Y_stride,
+    const block_q4_k *W_q4k, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end);
+void qwen_q4k_gemm_chunk_x4_i8mm(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end);
+#endif
+
+/* Runtime dispatchers over the SDOT / i8mm Q4_K GEMM variants. */
+void qwen_q4k_gemm_chunk(
+    float *Y, int Y_stride,
+    const block_q4_k *W_q4k, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end);
+void qwen_q4k_gemm_chunk_x4(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end);
 
 /* Vector ops */
 float qwen_dot_f32_neon(const float *a, const float *b, int n);
@@ -48,7 +113,10 @@ void qwen_vec_scale_add_neon(float *dst, const float *src, float correction, int
 #define qwen_q8_matvec_fused_impl qwen_q8_matvec_fused_neon
 #define qwen_q4k_matvec_fused_impl qwen_q4k_matvec_fused_neon
 #define qwen_q4k_matvec_preq_impl qwen_q4k_matvec_preq_neon
-#define qwen_q4k_gemm_chunk_impl qwen_q4k_gemm_chunk_neon
+#define qwen_q4k_gemm_chunk_impl qwen_q4k_gemm_chunk
+#define qwen_q4k_matvec_fused_x4_impl qwen_q4k_matvec_fused_x4_neon
+#define qwen_q4k_matvec_preq_x4_impl qwen_q4k_matvec_preq_x4_neon
+#define qwen_q4k_gemm_chunk_x4_impl qwen_q4k_gemm_chunk_x4
 #define qwen_q4k_argmax_range_impl qwen_q4k_argmax_range_neon
 #define qwen_dot_f32_impl qwen_dot_f32_neon
 #define qwen_vec_scale_inplace_impl qwen_vec_scale_inplace_neon
@@ -489,7 +489,8 @@ void qwen_q4k_matvec_preq_neon(float *out, const block_q4_k *blocks,
 void qwen_q4k_argmax_range_neon(const block_q4_k *blocks,
                                   const float *x, int cols,
                                   int start, int end,
-                                  int *best_out, float *best_val_out) {
+                                  int *best_out, float *best_val_out,
+                                  float *second_val_out) {
     int blocks_per_row = cols / QK_K;
 
     /* Quantize x to int8 */
@@ -534,6 +535,7 @@ void qwen_q4k_argmax_range_neon(const block_q4_k *blocks,
 
     int best = start;
     float best_val = -1e30f;
+    float second_val = -1e30f;
 
 #ifdef __ARM_FEATURE_DOTPROD
     for (int r = start; r < end; r++) {
@@ -561,7 +563,8 @@ void qwen_q4k_argmax_range_neon(const block_q4_k *blocks,
             row_sum += blk->d * (float)vaddvq_s32(acc) - blk->dmin * (float)min_acc;
         }
         float val = row_sum * x_scale;
-        if (val > best_val) { best_val = val; best = r; }
+        if (val > best_val) { second_val = best_val; best_val = val; best = r; }
+        else if (val > second_val) { second_val = val; }
     }
 #else
     for (int r = start; r < end; r++) {
@@ -588,12 +591,14 @@ void qwen_q4k_argmax_range_neon(const block_q4_k *blocks,
             row_sum += blk->d * (float)scale_acc - blk->dmin * (float)min_acc;
         }
         float val = row_sum * x_scale;
-        if (val > best_val) { best_val = val; best = r; }
+        if (val > best_val) { second_val = best_val; best_val = val; best = r; }
+        else if (val > second_val) { second_val = val; }
     }
 #endif
 
     *best_out = best;
     *best_val_out = best_val;
+    *second_val_out = second_val;
 }
 
 /* Q4_K batched GEMM inner: process a chunk of output rows for all M tokens.
@@ -611,7 +616,7 @@ void qwen_q4k_gemm_chunk_neon(
 
     const block_q4_k *W_chunk = W_q4k + (size_t)r_start * blocks_per_row;
 
-#ifdef __ARM_FEATURE_DOTPROD
+#if defined(__ARM_FEATURE_DOTPROD)
     uint8x16_t mask_0f = vdupq_n_u8(0x0F);
 
     for (int r = 0; r < n_rows; r++) {
@@ -756,4 +761,375 @@ void qwen_q4k_gemm_chunk_neon(
 #endif
 }
 
+/* ========================================================================
+ * Q4_K x4 Interleaved MatVec / GEMM (NEON + SDOT)
+ *
+ * Same math as the row-major kernels above, over block_q4_kx4 tiles: the
+ * four rows of a quad share every x load and their scales/mins/nibbles
+ * sit in one contiguous run, so the inner loop streams the weight bytes
+ * instead of gathering four row-strided blocks. Row counts are always
+ * multiples of 4 (enforced at repack time).
+ * ======================================================================== */
+
+void qwen_q4k_matvec_preq_x4_neon(float *out, const block_q4_kx4 *tiles,
+                                    const int8_t *x_int8, float x_scale,
+                                    const int32_t *bsums,
+                                    int rows, int cols) {
+    int blocks_per_row = cols / QK_K;
+    int n_quads = rows / 4;
+
+#ifdef __ARM_FEATURE_DOTPROD
+    uint8x16_t mask_0f = vdupq_n_u8(0x0F);
+
+    for (int q = 0; q < n_quads; q++) {
+        const block_q4_kx4 *row_tile = tiles + (size_t)q * blocks_per_row;
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+
+        for (int b = 0; b < blocks_per_row; b++) {
+            const block_q4_kx4 *t = &row_tile[b];
+            const int8_t *xq = x_int8 + b * QK_K;
+
+            int32x4_t a0 = vdupq_n_s32(0), a1 = vdupq_n_s32(0);
+            int32x4_t a2 = vdupq_n_s32(0), a3 = vdupq_n_s32(0);
+            int32_t m0 = 0, m1 = 0, m2 = 0, m3 = 0;
+
+            for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                /* x loaded once, shared by all 4 rows */
+                int8x16_t xlo = vld1q_s8(xq + g * 32);
+                int8x16_t xhi = vld1q_s8(xq + g * 32 + 16);
+                int32_t bs = bsums[b * Q4K_NUM_SUBS + g];
+
+                uint8x16_t p0 = vld1q_u8(t->qs[g][0]);
+                int8x16x2_t z0 = vzipq_s8(
+                    vreinterpretq_s8_u8(vandq_u8(p0, mask_0f)),
+                    vreinterpretq_s8_u8(vshrq_n_u8(p0, 4)));
+                int32x4_t d0 = vdotq_s32(vdupq_n_s32(0), z0.val[0], xlo);
+                d0 = vdotq_s32(d0, z0.val[1], xhi);
+                a0 = vaddq_s32(a0, vmulq_n_s32(d0, (int32_t)t->scales[g][0]));
+                m0 += (int32_t)t->mins[g][0] * bs;
+
+                uint8x16_t p1 = vld1q_u8(t->qs[g][1]);
+                int8x16x2_t z1 = vzipq_s8(
+                    vreinterpretq_s8_u8(vandq_u8(p1, mask_0f)),
+                    vreinterpretq_s8_u8(vshrq_n_u8(p1, 4)));
+                int32x4_t d1 = vdotq_s32(vdupq_n_s32(0), z1.val[0], xlo);
+                d1 = vdotq_s32(d1, z1.val[1], xhi);
+                a1 = vaddq_s32(a1, vmulq_n_s32(d1, (int32_t)t->scales[g][1]));
+                m1 += (int32_t)t->mins[g][1] * bs;
+
+                uint8x16_t p2 = vld1q_u8(t->qs[g][2]);
+                int8x16x2_t z2 = vzipq_s8(
+                    vreinterpretq_s8_u8(vandq_u8(p2, mask_0f)),
+                    vreinterpretq_s8_u8(vshrq_n_u8(p2, 4)));
+                int32x4_t d2 = vdotq_s32(vdupq_n_s32(0), z2.val[0], xlo);
+                d2 = vdotq_s32(d2, z2.val[1], xhi);
+                a2 = vaddq_s32(a2, vmulq_n_s32(d2, (int32_t)t->scales[g][2]));
+                m2 += (int32_t)t->mins[g][2] * bs;
+
+                uint8x16_t p3 = vld1q_u8(t->qs[g][3]);
+                int8x16x2_t z3 = vzipq_s8(
+                    vreinterpretq_s8_u8(vandq_u8(p3, mask_0f)),
+                    vreinterpretq_s8_u8(vshrq_n_u8(p3, 4)));
+                int32x4_t d3 = vdotq_s32(vdupq_n_s32(0), z3.val[0], xlo);
+                d3 = vdotq_s32(d3, z3.val[1], xhi);
+                a3 = vaddq_s32(a3, vmulq_n_s32(d3, (int32_t)t->scales[g][3]));
+                m3 += (int32_t)t->mins[g][3] * bs;
+            }
+
+            s0 += t->d[0] * (float)vaddvq_s32(a0) - t->dmin[0] * (float)m0;
+            s1 += t->d[1] * (float)vaddvq_s32(a1) - t->dmin[1] * (float)m1;
+            s2 += t->d[2] * (float)vaddvq_s32(a2) - t->dmin[2] * (float)m2;
+            s3 += t->d[3] * (float)vaddvq_s32(a3) - t->dmin[3] * (float)m3;
+        }
+
+        out[q * 4]     = s0 * x_scale;
+        out[q * 4 + 1] = s1 * x_scale;
+        out[q * 4 + 2] = s2 * x_scale;
+        out[q * 4 + 3] = s3 * x_scale;
+    }
+#else
+    for (int q = 0; q < n_quads; q++) {
+        const block_q4_kx4 *row_tile = tiles + (size_t)q * blocks_per_row;
+
+        for (int r = 0; r < 4; r++) {
+            float row_sum = 0.0f;
+
+            for (int b = 0; b < blocks_per_row; b++) {
+                const block_q4_kx4 *t = &row_tile[b];
+                const int8_t *xq = x_int8 + b * QK_K;
+
+                int32_t scale_acc = 0;
+                int32_t min_acc = 0;
+
+                for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                    int32_t dot = 0;
+                    for (int i = 0; i < 16; i++) {
+                        uint8_t pk = t->qs[g][r][i];
+                        int8_t lo_v = (int8_t)(pk & 0x0F);
+                        int8_t hi_v = (int8_t)(pk >> 4);
+                        dot += (int32_t)lo_v * (int32_t)xq[g * 32 + i * 2];
+                        dot += (int32_t)hi_v * (int32_t)xq[g * 32 + i * 2 + 1];
+                    }
+                    scale_acc += dot * (int32_t)t->scales[g][r];
+                    min_acc += (int32_t)t->mins[g][r] * bsums[b * Q4K_NUM_SUBS + g];
+                }
+
+                row_sum += t->d[r] * (float)scale_acc - t->dmin[r] * (float)min_acc;
+            }
+            out[q * 4 + r] = row_sum * x_scale;
+        }
+    }
+#endif
+}
+
+void qwen_q4k_matvec_fused_x4_neon(float *out, const block_q4_kx4 *tiles,
+                                     const float *x, int rows, int cols) {
+    /* Quantize x to int8 (reusable across rows) */
+    static int8_t *x_int8 = NULL;
+    static int x_int8_cap = 0;
+    if (cols > x_int8_cap) {
+        free(x_int8);
+        x_int8 = (int8_t *)malloc(((cols + 15) & ~15) * sizeof(int8_t));
+        x_int8_cap = cols;
+    }
+    float x_scale;
+    q4k_quantize_x_int8(x, cols, x_int8, &x_scale);
+
+    /* Precompute bsums: per-sub-group sum of x_int8 */
+    int total_subs = cols / 32;
+    static int32_t *bsums = NULL;
+    static int bsums_cap = 0;
+    if (total_subs > bsums_cap) {
+        free(bsums);
+        bsums = (int32_t *)malloc(total_subs * sizeof(int32_t));
+        bsums_cap = total_subs;
+    }
+
+#ifdef __ARM_FEATURE_DOTPROD
+    {
+        int8x16_t ones = vdupq_n_s8(1);
+        for (int s = 0; s < total_subs; s++) {
+            const int8_t *xg = x_int8 + s * 32;
+            int32x4_t sum4 = vdupq_n_s32(0);
+            sum4 = vdotq_s32(sum4, vld1q_s8(xg), ones);
+            sum4 = vdotq_s32(sum4, vld1q_s8(xg + 16), ones);
+            bsums[s] = vaddvq_s32(sum4);
+        }
+    }
+#else
+    for (int s = 0; s < total_subs; s++) {
+        int32_t sum = 0;
+        const int8_t *xg = x_int8 + s * 32;
+        for (int i = 0; i < 32; i++) sum += (int32_t)xg[i];
+        bsums[s] = sum;
+    }
+#endif
+
+    qwen_q4k_matvec_preq_x4_neon(out, tiles, x_int8, x_scale, bsums,
+                                   rows, cols);
+}
+
+/* Q4_K x4 batched GEMM inner: each quad's nibbles are unpacked once per
+ * 2 tokens, with all 4 rows fed from the same x loads. r_start/r_end are
+ * row indices, always multiples of 4 (tiles are claimed in quad units). */
+void qwen_q4k_gemm_chunk_x4_neon(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end
+) {
+    int n_quads = (r_end - r_start) / 4;
+    if (n_quads <= 0) return;
+
+    const block_q4_kx4 *W_chunk = W_x4 + (size_t)(r_start / 4) * blocks_per_row;
+
+#if defined(__ARM_FEATURE_DOTPROD)
+    uint8x16_t mask_0f = vdupq_n_u8(0x0F);
+
+    for (int q = 0; q < n_quads; q++) {
+        const block_q4_kx4 *row_tile = W_chunk + (size_t)q * blocks_per_row;
+        int out_base = r_start + q * 4;
+
+        /* 2-wide token loop: nibble unpack amortized over 8 dot products */
+        int m = 0;
+        for (; m + 1 < M; m += 2) {
+            const int8_t *xi0 = x_int8 + (size_t)m * K;
+            const int8_t *xi1 = x_int8 + (size_t)(m + 1) * K;
+            const int32_t *bs0 = bsums + (size_t)m * total_subs;
+            const int32_t *bs1 = bsums + (size_t)(m + 1) * total_subs;
+
+            float s00 = 0.0f, s10 = 0.0f, s20 = 0.0f, s30 = 0.0f;
+            float s01 = 0.0f, s11 = 0.0f, s21 = 0.0f, s31 = 0.0f;
+
+            for (int b = 0; b < blocks_per_row; b++) {
+                const block_q4_kx4 *t = &row_tile[b];
+                int boff = b * QK_K;
+                int bsoff = b * Q4K_NUM_SUBS;
+
+                int32x4_t a00 = vdupq_n_s32(0), a10 = vdupq_n_s32(0);
+                int32x4_t a20 = vdupq_n_s32(0), a30 = vdupq_n_s32(0);
+                int32x4_t a01 = vdupq_n_s32(0), a11 = vdupq_n_s32(0);
+                int32x4_t a21 = vdupq_n_s32(0), a31 = vdupq_n_s32(0);
+                int32_t ma00 = 0, ma10 = 0, ma20 = 0, ma30 = 0;
+                int32_t ma01 = 0, ma11 = 0, ma21 = 0, ma31 = 0;
+
+                for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                    int goff = boff + g * 32;
+                    int8x16_t x0lo = vld1q_s8(xi0 + goff);
+                    int8x16_t x0hi = vld1q_s8(xi0 + goff + 16);
+                    int8x16_t x1lo = vld1q_s8(xi1 + goff);
+                    int8x16_t x1hi = vld1q_s8(xi1 + goff + 16);
+                    int32_t b0 = bs0[bsoff + g];
+                    int32_t b1 = bs1[bsoff + g];
+
+                    uint8x16_t p0 = vld1q_u8(t->qs[g][0]);
+                    int8x16x2_t z0 = vzipq_s8(
+                        vreinterpretq_s8_u8(vandq_u8(p0, mask_0f)),
+                        vreinterpretq_s8_u8(vshrq_n_u8(p0, 4)));
+                    int32_t sc0 = (int32_t)t->scales[g][0];
+                    int32_t mn0 = (int32_t)t->mins[g][0];
+                    int32x4_t d00 = vdotq_s32(vdupq_n_s32(0), z0.val[0], x0lo);
+                    d00 = vdotq_s32(d00, z0.val[1], x0hi);
+                    a00 = vaddq_s32(a00, vmulq_n_s32(d00, sc0));
+                    int32x4_t d01 = vdotq_s32(vdupq_n_s32(0), z0.val[0], x1lo);
+                    d01 = vdotq_s32(d01, z0.val[1], x1hi);
+                    a01 = vaddq_s32(a01, vmulq_n_s32(d01, sc0));
+                    ma00 += mn0 * b0;
+                    ma01 += mn0 * b1;
+
+                    uint8x16_t p1 = vld1q_u8(t->qs[g][1]);
+                    int8x16x2_t z1 = vzipq_s8(
+                        vreinterpretq_s8_u8(vandq_u8(p1, mask_0f)),
+                        vreinterpretq_s8_u8(vshrq_n_u8(p1, 4)));
+                    int32_t sc1 = (int32_t)t->scales[g][1];
+                    int32_t mn1 = (int32_t)t->mins[g][1];
+                    int32x4_t d10 = vdotq_s32(vdupq_n_s32(0), z1.val[0], x0lo);
+                    d10 = vdotq_s32(d10, z1.val[1], x0hi);
+                    a10 = vaddq_s32(a10, vmulq_n_s32(d10, sc1));
+                    int32x4_t d11 = vdotq_s32(vdupq_n_s32(0), z1.val[0], x1lo);
+                    d11 = vdotq_s32(d11, z1.val[1], x1hi);
+                    a11 = vaddq_s32(a11, vmulq_n_s32(d11, sc1));
+                    ma10 += mn1 * b0;
+                    ma11 += mn1 * b1;
+
+                    uint8x16_t p2 = vld1q_u8(t->qs[g][2]);
+                    int8x16x2_t z2 = vzipq_s8(
+                        vreinterpretq_s8_u8(vandq_u8(p2, mask_0f)),
+                        vreinterpretq_s8_u8(vshrq_n_u8(p2, 4)));
+                    int32_t sc2 = (int32_t)t->scales[g][2];
+                    int32_t mn2 = (int32_t)t->mins[g][2];
+                    int32x4_t d20 = vdotq_s32(vdupq_n_s32(0), z2.val[0], x0lo);
+                    d20 = vdotq_s32(d20, z2.val[1], x0hi);
+                    a20 = vaddq_s32(a20, vmulq_n_s32(d20, sc2));
+                    int32x4_t d21 = vdotq_s32(vdupq_n_s32(0), z2.val[0], x1lo);
+                    d21 = vdotq_s32(d21, z2.val[1], x1hi);
+                    a21 = vaddq_s32(a21, vmulq_n_s32(d21, sc2));
+                    ma20 += mn2 * b0;
+                    ma21 += mn2 * b1;
+
+                    uint8x16_t p3 = vld1q_u8(t->qs[g][3]);
+                    int8x16x2_t z3 = vzipq_s8(
+                        vreinterpretq_s8_u8(vandq_u8(p3, mask_0f)),
+                        vreinterpretq_s8_u8(vshrq_n_u8(p3, 4)));
+                    int32_t sc3 = (int32_t)t->scales[g][3];
+                    int32_t mn3 = (int32_t)t->mins[g][3];
+                    int32x4_t d30 = vdotq_s32(vdupq_n_s32(0), z3.val[0], x0lo);
+                    d30 = vdotq_s32(d30, z3.val[1], x0hi);
+                    a30 = vaddq_s32(a30, vmulq_n_s32(d30, sc3));
+                    int32x4_t d31 = vdotq_s32(vdupq_n_s32(0), z3.val[0], x1lo);
+                    d31 = vdotq_s32(d31, z3.val[1], x1hi);
+                    a31 = vaddq_s32(a31, vmulq_n_s32(d31, sc3));
+                    ma30 += mn3 * b0;
+                    ma31 += mn3 * b1;
+                }
+
+                s00 += t->d[0] * (float)vaddvq_s32(a00) - t->dmin[0] * (float)ma00;
+                s01 += t->d[0] * (float)vaddvq_s32(a01) - t->dmin[0] * (float)ma01;
+                s10 += t->d[1] * (float)vaddvq_s32(a10) - t->dmin[1] * (float)ma10;
+                s11 += t->d[1] * (float)vaddvq_s32(a11) - t->dmin[1] * (float)ma11;
+                s20 += t->d[2] * (float)vaddvq_s32(a20) - t->dmin[2] * (float)ma20;
+                s21 += t->d[2] * (float)vaddvq_s32(a21) - t->dmin[2] * (float)ma21;
+                s30 += t->d[3] * (float)vaddvq_s32(a30) - t->dmin[3] * (float)ma30;
+                s31 += t->d[3] * (float)vaddvq_s32(a31) - t->dmin[3] * (float)ma31;
+            }
+
+            float xs0 = x_scales[m], xs1 = x_scales[m + 1];
+            float *y0 = Y + (size_t)m * Y_stride + out_base;
+            float *y1 = Y + (size_t)(m + 1) * Y_stride + out_base;
+            y0[0] = s00 * xs0; y0[1] = s10 * xs0;
+            y0[2] = s20 * xs0; y0[3] = s30 * xs0;
+            y1[0] = s01 * xs1; y1[1] = s11 * xs1;
+            y1[2] = s21 * xs1; y1[3] = s31 * xs1;
+        }
+
+        /* Single token remainder */
+        for (; m < M; m++) {
+            qwen_q4k_matvec_preq_x4_neon(
+                Y + (size_t)m * Y_stride + out_base,
+                row_tile,
+                x_int8 + (size_t)m * K,
+                x_scales[m],
+                bsums + (size_t)m * total_subs,
+                4, K);
+        }
+    }
+#else
+    /* Non-SDOT fallback: use preq kernel per token */
+    for (int m = 0; m < M; m++) {
+        qwen_q4k_matvec_preq_x4_neon(
+            Y + (size_t)m * Y_stride + r_start,
+            W_chunk,
+            x_int8 + (size_t)m * K,
+            x_scales[m],
+            bsums + (size_t)m * total_subs,
+            n_quads * 4, K);
+    }
+#endif
+}
+
+/* Runtime dispatch over the SDOT / SMMLA Q4_K GEMM variants. */
+void qwen_q4k_gemm_chunk(
+    float *Y, int Y_stride,
+    const block_q4_k *W_q4k, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end
+) {
+#ifdef QWEN_ASR_RUNTIME_I8MM
+    if (qwen_cpu_features() & QWEN_CPU_I8MM) {
+        qwen_q4k_gemm_chunk_i8mm(Y, Y_stride, W_q4k, blocks_per_row,
+                                 x_int8, K, x_scales, bsums, total_subs,
+                                 M, r_start, r_end);
+        return;
+    }
+#endif
+    qwen_q4k_gemm_chunk_neon(Y, Y_stride, W_q4k, blocks_per_row,
+                             x_int8, K, x_scales, bsums, total_subs,
+                             M, r_start, r_end);
+}
+
+void qwen_q4k_gemm_chunk_x4(
+    float *Y, int Y_stride,
+    const block_q4_kx4 *W_x4, int blocks_per_row,
+    const int8_t *x_int8, int K,
+    const float *x_scales,
+    const int32_t *bsums, int total_subs,
+    int M, int r_start, int r_end
+) {
+#ifdef QWEN_ASR_RUNTIME_I8MM
+    if (qwen_cpu_features() & QWEN_CPU_I8MM) {
+        qwen_q4k_gemm_chunk_x4_i8mm(Y, Y_stride, W_x4, blocks_per_row,
+                                    x_int8, K, x_scales, bsums, total_subs,
+                                    M, r_start, r_end);
+        return;
+    }
+#endif
+    qwen_q4k_gemm_chunk_x4_neon(Y, Y_stride, W_x4, blocks_per_row,
+                                x_int8, K, x_scales, bsums, total_subs,
+                                M, r_start, r_end);
+}
+
 #endif /* __ARM_NEON */
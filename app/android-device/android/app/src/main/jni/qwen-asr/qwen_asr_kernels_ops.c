@@ -5,6 +5,7 @@
 
 #include "qwen_asr_kernels.h"
 #include "qwen_asr_kernels_impl.h"
+#include "qwen_asr_perf.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -278,16 +279,10 @@ typedef struct {
     const float *gate_up;
     int seq_len;
     int intermediate;
+    qwen_tile_queue_t tiles;
 } swiglu_task_t;
 
-static void swiglu_worker(int tid, int n_threads, void *arg) {
-    swiglu_task_t *t = (swiglu_task_t *)arg;
-    int chunk = (t->seq_len + n_threads - 1) / n_threads;
-    int s0 = tid * chunk;
-    int s1 = s0 + chunk;
-    if (s1 > t->seq_len) s1 = t->seq_len;
-    if (s0 >= s1) return;
-
+static void swiglu_rows(swiglu_task_t *t, int s0, int s1) {
     int inter = t->intermediate;
     int alias_inplace = (t->out == t->gate_up);
     for (int s = s0; s < s1; s++) {
@@ -353,6 +348,15 @@ static void swiglu_worker(int tid, int n_threads, void *arg) {
     }
 }
 
+static void swiglu_worker(int tid, int n_threads, void *arg) {
+    swiglu_task_t *t = (swiglu_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int s0, s1;
+    while (qwen_tile_queue_grab(&t->tiles, &s0, &s1))
+        swiglu_rows(t, s0, s1);
+}
+
 void qwen_swiglu_multiply(float *out, const float *gate_up, int seq_len, int intermediate) {
     swiglu_task_t task = {
         .out = out,
@@ -360,6 +364,7 @@ void qwen_swiglu_multiply(float *out, const float *gate_up, int seq_len, int int
         .seq_len = seq_len,
         .intermediate = intermediate
     };
+    qwen_tile_queue_init(&task.tiles, seq_len, qwen_get_n_threads());
 
     if (qwen_get_n_threads() > 1 && seq_len >= 2 && intermediate >= 256) {
         qwen_parallel_for(swiglu_worker, &task);
@@ -369,6 +374,7 @@ void qwen_swiglu_multiply(float *out, const float *gate_up, int seq_len, int int
 }
 
 void qwen_softmax(float *x, int rows, int cols) {
+    uint64_t perf_t0 = qwen_perf_tic();
     for (int r = 0; r < rows; r++) {
         float *row = x + r * cols;
         float max_val = row[0];
@@ -385,6 +391,7 @@ void qwen_softmax(float *x, int rows, int cols) {
             row[c] *= inv_sum;
         }
     }
+    qwen_perf_toc(QWEN_PERF_SOFTMAX, perf_t0);
 }
 
 /* ========================================================================
@@ -474,6 +481,61 @@ void qwen_f16_to_f32(float *dst, const uint16_t *src, int n) {
 #endif
 }
 
+void qwen_f32_to_q8_per_head(int8_t *dst, float *scales, const float *src,
+                              int n_heads, int head_dim) {
+    for (int h = 0; h < n_heads; h++) {
+        const float *vec = src + h * head_dim;
+        int8_t *out = dst + h * head_dim;
+
+#ifdef __ARM_NEON
+        float32x4_t vabsmax = vdupq_n_f32(0.0f);
+        int d = 0;
+        for (; d + 4 <= head_dim; d += 4)
+            vabsmax = vmaxq_f32(vabsmax, vabsq_f32(vld1q_f32(vec + d)));
+        float absmax = vmaxvq_f32(vabsmax);
+        for (; d < head_dim; d++) {
+            float a = vec[d] > 0 ? vec[d] : -vec[d];
+            if (a > absmax) absmax = a;
+        }
+#else
+        float absmax = 0.0f;
+        for (int d = 0; d < head_dim; d++) {
+            float a = vec[d] > 0 ? vec[d] : -vec[d];
+            if (a > absmax) absmax = a;
+        }
+#endif
+        scales[h] = absmax / 127.0f;
+        float inv = (absmax > 0.0f) ? 127.0f / absmax : 0.0f;
+
+#ifdef __ARM_NEON
+        float32x4_t vinv = vdupq_n_f32(inv);
+        int j = 0;
+        for (; j + 8 <= head_dim; j += 8) {
+            int32x4_t i0 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(vec + j), vinv));
+            int32x4_t i1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(vec + j + 4), vinv));
+            int16x4_t s0 = vqmovn_s32(i0);
+            int16x4_t s1 = vqmovn_s32(i1);
+            vst1_s8(out + j, vqmovn_s16(vcombine_s16(s0, s1)));
+        }
+        for (; j < head_dim; j++) {
+            float v = vec[j] * inv;
+            int iv = (int)(v + (v > 0 ? 0.5f : -0.5f));
+            if (iv > 127) iv = 127;
+            if (iv < -128) iv = -128;
+            out[j] = (int8_t)iv;
+        }
+#else
+        for (int j = 0; j < head_dim; j++) {
+            float v = vec[j] * inv;
+            int iv = (int)(v + (v > 0 ? 0.5f : -0.5f));
+            if (iv > 127) iv = 127;
+            if (iv < -128) iv = -128;
+            out[j] = (int8_t)iv;
+        }
+#endif
+    }
+}
+
 /* Mixed-precision dot product: dot(fp32_a, fp16_b) with on-the-fly conversion */
 static inline float qwen_dot_f32_f16(const float *a, const uint16_t *b_fp16, int n) {
 #ifdef __ARM_NEON
@@ -509,6 +571,27 @@ static inline float qwen_dot_f32_f16(const float *a, const uint16_t *b_fp16, int
 #endif
 }
 
+#if defined(__ARM_FEATURE_FP16_FML)
+/* FP16 × FP16 dot with FP32 accumulation via FMLAL: one multiply per 8
+ * lanes instead of 4, without FP16 rounding in the accumulator. */
+static inline float qwen_dot_f16_f16(const uint16_t *a_fp16,
+                                     const uint16_t *b_fp16, int n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int d = 0;
+    for (; d + 8 <= n; d += 8) {
+        float16x8_t a16 = vreinterpretq_f16_u16(vld1q_u16(a_fp16 + d));
+        float16x8_t b16 = vreinterpretq_f16_u16(vld1q_u16(b_fp16 + d));
+        acc0 = vfmlalq_low_f16(acc0, a16, b16);
+        acc1 = vfmlalq_high_f16(acc1, a16, b16);
+    }
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; d < n; d++)
+        sum += f16_to_f32_scalar(a_fp16[d]) * f16_to_f32_scalar(b_fp16[d]);
+    return sum;
+}
+#endif /* __ARM_FEATURE_FP16_FML */
+
 /* dst += alpha * src_fp16 (with on-the-fly FP16→FP32 conversion) */
 static inline void qwen_vec_axpy_f16_inplace(float *dst, const uint16_t *src_fp16,
                                                float alpha, int n) {
@@ -594,8 +677,42 @@ static inline void qwen_vec_scale_add(float *dst, const float *src, float correc
     qwen_vec_scale_add_impl(dst, src, correction, n);
 }
 
-/* Max scores buffer size for 2-pass attention (stack allocated) */
-#define ATTN_MAX_KEYS 2048
+/* Key-tile size for online-softmax attention (stack-allocated score buffer).
+ * Scores never materialize beyond one tile: a running max/sum is kept per
+ * query and the accumulator is rescaled when the max moves, so the kernels
+ * handle arbitrary key counts with flat scratch and stay L1-resident. */
+#define ATTN_TILE_KEYS 128
+
+/* Upper bound on head_dim for the per-query FP16 Q scratch in the FP16
+ * attention path (encoder: 64, decoder: 128). */
+#define QWEN_ATTN_MAX_HEAD_DIM 128
+
+/* Exponentiate one score tile in place against running max m, return tile sum */
+static inline float attn_exp_tile(float *scores, int n, float m) {
+    float sum = 0.0f;
+#ifdef __ARM_NEON
+    float32x4_t vmax = vdupq_n_f32(m);
+    float32x4_t vsum = vdupq_n_f32(0.0f);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t s = vld1q_f32(scores + j);
+        float32x4_t e = neon_expf(vsubq_f32(s, vmax));
+        vst1q_f32(scores + j, e);
+        vsum = vaddq_f32(vsum, e);
+    }
+    sum = vaddvq_f32(vsum);
+    for (; j < n; j++) {
+        scores[j] = expf(scores[j] - m);
+        sum += scores[j];
+    }
+#else
+    for (int j = 0; j < n; j++) {
+        scores[j] = expf(scores[j] - m);
+        sum += scores[j];
+    }
+#endif
+    return sum;
+}
 
 static void qwen_bidirectional_attention_heads(float *out, const float *Q, const float *K,
                                                 const float *V, int n_heads, int head_dim,
@@ -612,49 +729,39 @@ static void qwen_bidirectional_attention_heads(float *out, const float *Q, const
                 const float *q_row = Q + i * hidden + h * head_dim;
                 float *o_row = out + i * hidden + h * head_dim;
                 int n_keys = we - ws;
-                float scores[ATTN_MAX_KEYS];
-
-                /* Pass 1: compute all scores and find max */
-                float max_score = -1e30f;
-                for (int j = 0; j < n_keys; j++) {
-                    const float *k_row = K + (ws + j) * hidden + h * head_dim;
-                    scores[j] = qwen_dot_f32(q_row, k_row, head_dim) * scale;
-                    if (scores[j] > max_score) max_score = scores[j];
-                }
 
-                /* Pass 2: NEON batch exp and accumulate weights */
-                float sum_exp = 0.0f;
-#ifdef __ARM_NEON
-                {
-                    float32x4_t vmax = vdupq_n_f32(max_score);
-                    float32x4_t vsum = vdupq_n_f32(0.0f);
-                    int j = 0;
-                    for (; j + 4 <= n_keys; j += 4) {
-                        float32x4_t s = vld1q_f32(scores + j);
-                        float32x4_t e = neon_expf(vsubq_f32(s, vmax));
-                        vst1q_f32(scores + j, e);
-                        vsum = vaddq_f32(vsum, e);
+                float run_max = -1e30f;
+                float run_sum = 0.0f;
+                for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
+
+                for (int j0 = 0; j0 < n_keys; j0 += ATTN_TILE_KEYS) {
+                    int jn = n_keys - j0;
+                    if (jn > ATTN_TILE_KEYS) jn = ATTN_TILE_KEYS;
+                    float scores[ATTN_TILE_KEYS];
+
+                    float tile_max = run_max;
+                    for (int j = 0; j < jn; j++) {
+                        const float *k_row = K + (ws + j0 + j) * hidden + h * head_dim;
+                        scores[j] = qwen_dot_f32(q_row, k_row, head_dim) * scale;
+                        if (scores[j] > tile_max) tile_max = scores[j];
                     }
-                    sum_exp = vaddvq_f32(vsum);
-                    for (; j < n_keys; j++) {
-                        scores[j] = expf(scores[j] - max_score);
-                        sum_exp += scores[j];
+
+                    if (tile_max > run_max) {
+                        float correction = expf(run_max - tile_max);
+                        qwen_vec_scale_inplace(o_row, correction, head_dim);
+                        run_sum *= correction;
+                        run_max = tile_max;
                     }
-                }
-#else
-                for (int j = 0; j < n_keys; j++) {
-                    scores[j] = expf(scores[j] - max_score);
-                    sum_exp += scores[j];
-                }
-#endif
 
-                /* Pass 3: weighted V sum */
-                float inv_sum = (sum_exp > 0.0f) ? 1.0f / sum_exp : 0.0f;
-                for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
-                for (int j = 0; j < n_keys; j++) {
-                    const float *v_row = V + (ws + j) * hidden + h * head_dim;
-                    qwen_vec_axpy_inplace(o_row, v_row, scores[j] * inv_sum, head_dim);
+                    run_sum += attn_exp_tile(scores, jn, run_max);
+                    for (int j = 0; j < jn; j++) {
+                        const float *v_row = V + (ws + j0 + j) * hidden + h * head_dim;
+                        qwen_vec_axpy_inplace(o_row, v_row, scores[j], head_dim);
+                    }
                 }
+
+                float inv_sum = (run_sum > 0.0f) ? 1.0f / run_sum : 0.0f;
+                qwen_vec_scale_inplace(o_row, inv_sum, head_dim);
             }
         }
     }
@@ -670,37 +777,158 @@ typedef struct {
     float scale;
     const int *window_starts;
     int n_windows;
+    qwen_tile_queue_t tiles;
 } bidir_attn_task_t;
 
 static void bidir_attn_worker(int tid, int n_threads, void *arg) {
     bidir_attn_task_t *t = (bidir_attn_task_t *)arg;
-    int chunk = (t->n_heads + n_threads - 1) / n_threads;
-    int h0 = tid * chunk;
-    int h1 = h0 + chunk;
-    if (h1 > t->n_heads) h1 = t->n_heads;
-    if (h0 >= h1) return;
-
-    qwen_bidirectional_attention_heads(t->out, t->Q, t->K, t->V,
-                                        t->n_heads, t->head_dim, t->scale,
-                                        t->window_starts, t->n_windows, h0, h1);
+    (void)tid;
+    (void)n_threads;
+    int h0, h1;
+    while (qwen_tile_queue_grab(&t->tiles, &h0, &h1)) {
+        qwen_bidirectional_attention_heads(t->out, t->Q, t->K, t->V,
+                                            t->n_heads, t->head_dim, t->scale,
+                                            t->window_starts, t->n_windows, h0, h1);
+    }
 }
 
 void qwen_bidirectional_attention(float *out, const float *Q, const float *K,
                                    const float *V, int seq __attribute__((unused)),
                                    int n_heads, int head_dim, float scale,
                                    const int *window_starts, int n_windows) {
+    uint64_t perf_t0 = qwen_perf_tic();
     if (qwen_get_n_threads() > 1 && n_heads >= 2) {
         bidir_attn_task_t task = {
             .out = out, .Q = Q, .K = K, .V = V,
             .n_heads = n_heads, .head_dim = head_dim, .scale = scale,
             .window_starts = window_starts, .n_windows = n_windows
         };
+        qwen_tile_queue_init(&task.tiles, n_heads, qwen_get_n_threads());
         qwen_parallel_for(bidir_attn_worker, &task);
-        return;
+    } else {
+        qwen_bidirectional_attention_heads(out, Q, K, V, n_heads, head_dim, scale,
+                                            window_starts, n_windows, 0, n_heads);
+    }
+    qwen_perf_toc(QWEN_PERF_ATTENTION, perf_t0);
+}
+
+/* FP16 K/V variant of the bidirectional attention above. Scores and the
+ * weighted sum accumulate in FP32; only the K/V streams (re-read once per
+ * query in the window) are halved to FP16, doubling effective load width. */
+static void qwen_bidirectional_attention_f16_heads(float *out, const float *Q,
+                                                    const uint16_t *K_fp16,
+                                                    const uint16_t *V_fp16,
+                                                    int n_heads, int head_dim,
+                                                    float scale, const int *window_starts,
+                                                    int n_windows, int head_start, int head_end) {
+    int hidden = n_heads * head_dim;
+#if defined(__ARM_FEATURE_FP16_FML)
+    /* ops.c is compiled with +fp16fml per-file; gate the FMLAL path on the
+     * running CPU so the same .so works on cores without FEAT_FHM. */
+    int cpu_has_fml = (qwen_cpu_features() & QWEN_CPU_FP16FML) != 0;
+#endif
+
+    for (int h = head_start; h < head_end; h++) {
+        for (int w = 0; w < n_windows; w++) {
+            int ws = window_starts[w];
+            int we = window_starts[w + 1];
+
+            for (int i = ws; i < we; i++) {
+                const float *q_row = Q + i * hidden + h * head_dim;
+                float *o_row = out + i * hidden + h * head_dim;
+                int n_keys = we - ws;
+
+#if defined(__ARM_FEATURE_FP16_FML)
+                uint16_t q_f16[QWEN_ATTN_MAX_HEAD_DIM];
+                int use_fml = cpu_has_fml && head_dim <= QWEN_ATTN_MAX_HEAD_DIM;
+                if (use_fml) qwen_f32_to_f16(q_f16, q_row, head_dim);
+#endif
+
+                float run_max = -1e30f;
+                float run_sum = 0.0f;
+                for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
+
+                for (int j0 = 0; j0 < n_keys; j0 += ATTN_TILE_KEYS) {
+                    int jn = n_keys - j0;
+                    if (jn > ATTN_TILE_KEYS) jn = ATTN_TILE_KEYS;
+                    float scores[ATTN_TILE_KEYS];
+
+                    float tile_max = run_max;
+                    for (int j = 0; j < jn; j++) {
+                        const uint16_t *k_row = K_fp16 + (size_t)(ws + j0 + j) * hidden + h * head_dim;
+#if defined(__ARM_FEATURE_FP16_FML)
+                        scores[j] = (use_fml ? qwen_dot_f16_f16(q_f16, k_row, head_dim)
+                                             : qwen_dot_f32_f16(q_row, k_row, head_dim)) * scale;
+#else
+                        scores[j] = qwen_dot_f32_f16(q_row, k_row, head_dim) * scale;
+#endif
+                        if (scores[j] > tile_max) tile_max = scores[j];
+                    }
+
+                    if (tile_max > run_max) {
+                        float correction = expf(run_max - tile_max);
+                        qwen_vec_scale_inplace(o_row, correction, head_dim);
+                        run_sum *= correction;
+                        run_max = tile_max;
+                    }
+
+                    run_sum += attn_exp_tile(scores, jn, run_max);
+                    for (int j = 0; j < jn; j++) {
+                        const uint16_t *v_row = V_fp16 + (size_t)(ws + j0 + j) * hidden + h * head_dim;
+                        qwen_vec_axpy_f16_inplace(o_row, v_row, scores[j], head_dim);
+                    }
+                }
+
+                float inv_sum = (run_sum > 0.0f) ? 1.0f / run_sum : 0.0f;
+                qwen_vec_scale_inplace(o_row, inv_sum, head_dim);
+            }
+        }
+    }
+}
+
+typedef struct {
+    float *out;
+    const float *Q;
+    const uint16_t *K_fp16;
+    const uint16_t *V_fp16;
+    int n_heads;
+    int head_dim;
+    float scale;
+    const int *window_starts;
+    int n_windows;
+    qwen_tile_queue_t tiles;
+} bidir_attn_f16_task_t;
+
+static void bidir_attn_f16_worker(int tid, int n_threads, void *arg) {
+    bidir_attn_f16_task_t *t = (bidir_attn_f16_task_t *)arg;
+    (void)tid;
+    (void)n_threads;
+    int h0, h1;
+    while (qwen_tile_queue_grab(&t->tiles, &h0, &h1)) {
+        qwen_bidirectional_attention_f16_heads(t->out, t->Q, t->K_fp16, t->V_fp16,
+                                                t->n_heads, t->head_dim, t->scale,
+                                                t->window_starts, t->n_windows, h0, h1);
     }
+}
 
-    qwen_bidirectional_attention_heads(out, Q, K, V, n_heads, head_dim, scale,
-                                        window_starts, n_windows, 0, n_heads);
+void qwen_bidirectional_attention_f16(float *out, const float *Q, const uint16_t *K_fp16,
+                                       const uint16_t *V_fp16, int seq __attribute__((unused)),
+                                       int n_heads, int head_dim, float scale,
+                                       const int *window_starts, int n_windows) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    if (qwen_get_n_threads() > 1 && n_heads >= 2) {
+        bidir_attn_f16_task_t task = {
+            .out = out, .Q = Q, .K_fp16 = K_fp16, .V_fp16 = V_fp16,
+            .n_heads = n_heads, .head_dim = head_dim, .scale = scale,
+            .window_starts = window_starts, .n_windows = n_windows
+        };
+        qwen_tile_queue_init(&task.tiles, n_heads, qwen_get_n_threads());
+        qwen_parallel_for(bidir_attn_f16_worker, &task);
+    } else {
+        qwen_bidirectional_attention_f16_heads(out, Q, K_fp16, V_fp16, n_heads, head_dim,
+                                                scale, window_starts, n_windows, 0, n_heads);
+    }
+    qwen_perf_toc(QWEN_PERF_ATTENTION, perf_t0);
 }
 
 static void qwen_causal_attention_heads(float *out, const float *Q,
@@ -724,49 +952,38 @@ static void qwen_causal_attention_heads(float *out, const float *Q,
             int k_end = global_pos + 1;
             if (k_end > seq_k) k_end = seq_k;
 
-            float scores[ATTN_MAX_KEYS];
+            float run_max = -1e30f;
+            float run_sum = 0.0f;
+            for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
 
-            /* Pass 1: compute all scores and find max */
-            float max_score = -1e30f;
-            for (int j = 0; j < k_end; j++) {
-                const uint16_t *k_row = K_fp16 + j * kv_hidden + kv_h * head_dim;
-                scores[j] = qwen_dot_f32_f16(q_row, k_row, head_dim) * scale;
-                if (scores[j] > max_score) max_score = scores[j];
-            }
+            for (int j0 = 0; j0 < k_end; j0 += ATTN_TILE_KEYS) {
+                int jn = k_end - j0;
+                if (jn > ATTN_TILE_KEYS) jn = ATTN_TILE_KEYS;
+                float scores[ATTN_TILE_KEYS];
 
-            /* Pass 2: NEON batch exp and accumulate weights */
-            float sum_exp = 0.0f;
-#ifdef __ARM_NEON
-            {
-                float32x4_t vmax = vdupq_n_f32(max_score);
-                float32x4_t vsum = vdupq_n_f32(0.0f);
-                int j = 0;
-                for (; j + 4 <= k_end; j += 4) {
-                    float32x4_t s = vld1q_f32(scores + j);
-                    float32x4_t e = neon_expf(vsubq_f32(s, vmax));
-                    vst1q_f32(scores + j, e);
-                    vsum = vaddq_f32(vsum, e);
+                float tile_max = run_max;
+                for (int j = 0; j < jn; j++) {
+                    const uint16_t *k_row = K_fp16 + (size_t)(j0 + j) * kv_hidden + kv_h * head_dim;
+                    scores[j] = qwen_dot_f32_f16(q_row, k_row, head_dim) * scale;
+                    if (scores[j] > tile_max) tile_max = scores[j];
                 }
-                sum_exp = vaddvq_f32(vsum);
-                for (; j < k_end; j++) {
-                    scores[j] = expf(scores[j] - max_score);
-                    sum_exp += scores[j];
+
+                if (tile_max > run_max) {
+                    float correction = expf(run_max - tile_max);
+                    qwen_vec_scale_inplace(o_row, correction, head_dim);
+                    run_sum *= correction;
+                    run_max = tile_max;
                 }
-            }
-#else
-            for (int j = 0; j < k_end; j++) {
-                scores[j] = expf(scores[j] - max_score);
-                sum_exp += scores[j];
-            }
-#endif
 
-            /* Pass 3: weighted V sum */
-            float inv_sum = (sum_exp > 0.0f) ? 1.0f / sum_exp : 0.0f;
-            for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
-            for (int j = 0; j < k_end; j++) {
-                const uint16_t *v_row = V_fp16 + j * kv_hidden + kv_h * head_dim;
-                qwen_vec_axpy_f16_inplace(o_row, v_row, scores[j] * inv_sum, head_dim);
+                run_sum += attn_exp_tile(scores, jn, run_max);
+                for (int j = 0; j < jn; j++) {
+                    const uint16_t *v_row = V_fp16 + (size_t)(j0 + j) * kv_hidden + kv_h * head_dim;
+                    qwen_vec_axpy_f16_inplace(o_row, v_row, scores[j], head_dim);
+                }
             }
+
+            float inv_sum = (run_sum > 0.0f) ? 1.0f / run_sum : 0.0f;
+            qwen_vec_scale_inplace(o_row, inv_sum, head_dim);
         }
     }
 }
@@ -800,6 +1017,7 @@ void qwen_causal_attention(float *out, const float *Q,
                             const uint16_t *K_fp16, const uint16_t *V_fp16,
                             int seq_q, int seq_k, int n_heads, int n_kv_heads,
                             int head_dim, float scale, int q_offset) {
+    uint64_t perf_t0 = qwen_perf_tic();
     if (qwen_get_n_threads() > 1 && n_heads >= 2 && (seq_q >= 2 || seq_k >= 128)) {
         causal_attn_task_t task = {
             .out = out, .Q = Q, .K_fp16 = K_fp16, .V_fp16 = V_fp16,
@@ -808,12 +1026,180 @@ void qwen_causal_attention(float *out, const float *Q,
             .head_dim = head_dim, .scale = scale, .q_offset = q_offset
         };
         qwen_parallel_for(causal_attn_worker, &task);
-        return;
+    } else {
+        qwen_causal_attention_heads(out, Q, K_fp16, V_fp16,
+                                    seq_q, seq_k, n_heads, n_kv_heads,
+                                    head_dim, scale, q_offset, 0, n_heads);
+    }
+    qwen_perf_toc(QWEN_PERF_ATTENTION, perf_t0);
+}
+
+/* int8 × int8 dot product (SDOT on dotprod cores) */
+static inline int32_t qwen_dot_s8(const int8_t *a, const int8_t *b, int n) {
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_DOTPROD)
+    int32x4_t acc = vdupq_n_s32(0);
+    int d = 0;
+    for (; d + 16 <= n; d += 16)
+        acc = vdotq_s32(acc, vld1q_s8(a + d), vld1q_s8(b + d));
+    int32_t sum = vaddvq_s32(acc);
+    for (; d < n; d++) sum += (int32_t)a[d] * (int32_t)b[d];
+    return sum;
+#elif defined(__ARM_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    int d = 0;
+    for (; d + 8 <= n; d += 8) {
+        int16x8_t prod = vmull_s8(vld1_s8(a + d), vld1_s8(b + d));
+        acc = vpadalq_s16(acc, prod);
+    }
+    int32_t sum = vaddvq_s32(acc);
+    for (; d < n; d++) sum += (int32_t)a[d] * (int32_t)b[d];
+    return sum;
+#else
+    int32_t sum = 0;
+    for (int d = 0; d < n; d++) sum += (int32_t)a[d] * (int32_t)b[d];
+    return sum;
+#endif
+}
+
+/* dst += alpha * src_q8 (with on-the-fly int8→FP32 conversion) */
+static inline void qwen_vec_axpy_q8_inplace(float *dst, const int8_t *src_q8,
+                                              float alpha, int n) {
+#ifdef __ARM_NEON
+    float32x4_t va = vdupq_n_f32(alpha);
+    int d = 0;
+    for (; d + 8 <= n; d += 8) {
+        int16x8_t s16 = vmovl_s8(vld1_s8(src_q8 + d));
+        float32x4_t s0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16)));
+        float32x4_t s1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16)));
+        vst1q_f32(dst + d, vfmaq_f32(vld1q_f32(dst + d), s0, va));
+        vst1q_f32(dst + d + 4, vfmaq_f32(vld1q_f32(dst + d + 4), s1, va));
+    }
+    for (; d < n; d++) dst[d] += alpha * (float)src_q8[d];
+#else
+    for (int d = 0; d < n; d++) dst[d] += alpha * (float)src_q8[d];
+#endif
+}
+
+static void qwen_causal_attention_q8_heads(float *out, const float *Q,
+                                            const int8_t *K_q8, const float *K_scale,
+                                            const int8_t *V_q8, const float *V_scale,
+                                            int seq_q, int seq_k,
+                                            int n_heads, int n_kv_heads, int head_dim,
+                                            float scale, int q_offset,
+                                            int head_start, int head_end) {
+    int heads_per_kv = n_heads / n_kv_heads;
+    int q_hidden = n_heads * head_dim;
+    int kv_hidden = n_kv_heads * head_dim;
+
+    /* Per-query quantized Q vector (single head) */
+    int8_t q_q8[256];
+    float q_scale_arr[1];
+
+    for (int h = head_start; h < head_end; h++) {
+        int kv_h = h / heads_per_kv;
+
+        for (int i = 0; i < seq_q; i++) {
+            const float *q_row = Q + i * q_hidden + h * head_dim;
+            float *o_row = out + i * q_hidden + h * head_dim;
+            int global_pos = q_offset + i;
+            int k_end = global_pos + 1;
+            if (k_end > seq_k) k_end = seq_k;
+
+            /* Quantize this query head once; scores become
+             * q_scale * k_scale[j] * int_dot. */
+            qwen_f32_to_q8_per_head(q_q8, q_scale_arr, q_row, 1, head_dim);
+            float q_scale = q_scale_arr[0] * scale;
+
+            float run_max = -1e30f;
+            float run_sum = 0.0f;
+            for (int d = 0; d < head_dim; d++) o_row[d] = 0.0f;
+
+            for (int j0 = 0; j0 < k_end; j0 += ATTN_TILE_KEYS) {
+                int jn = k_end - j0;
+                if (jn > ATTN_TILE_KEYS) jn = ATTN_TILE_KEYS;
+                float scores[ATTN_TILE_KEYS];
+
+                float tile_max = run_max;
+                for (int j = 0; j < jn; j++) {
+                    const int8_t *k_row = K_q8 + (size_t)(j0 + j) * kv_hidden + kv_h * head_dim;
+                    float k_scale = K_scale[(size_t)(j0 + j) * n_kv_heads + kv_h];
+                    scores[j] = (float)qwen_dot_s8(q_q8, k_row, head_dim) * q_scale * k_scale;
+                    if (scores[j] > tile_max) tile_max = scores[j];
+                }
+
+                if (tile_max > run_max) {
+                    float correction = expf(run_max - tile_max);
+                    qwen_vec_scale_inplace(o_row, correction, head_dim);
+                    run_sum *= correction;
+                    run_max = tile_max;
+                }
+
+                run_sum += attn_exp_tile(scores, jn, run_max);
+
+                /* V dequant folded into the axpy alpha */
+                for (int j = 0; j < jn; j++) {
+                    const int8_t *v_row = V_q8 + (size_t)(j0 + j) * kv_hidden + kv_h * head_dim;
+                    float v_scale = V_scale[(size_t)(j0 + j) * n_kv_heads + kv_h];
+                    qwen_vec_axpy_q8_inplace(o_row, v_row, scores[j] * v_scale, head_dim);
+                }
+            }
+
+            float inv_sum = (run_sum > 0.0f) ? 1.0f / run_sum : 0.0f;
+            qwen_vec_scale_inplace(o_row, inv_sum, head_dim);
+        }
     }
+}
 
-    qwen_causal_attention_heads(out, Q, K_fp16, V_fp16,
-                                seq_q, seq_k, n_heads, n_kv_heads,
-                                head_dim, scale, q_offset, 0, n_heads);
+typedef struct {
+    float *out;
+    const float *Q;
+    const int8_t *K_q8;
+    const float *K_scale;
+    const int8_t *V_q8;
+    const float *V_scale;
+    int seq_q, seq_k;
+    int n_heads, n_kv_heads;
+    int head_dim;
+    float scale;
+    int q_offset;
+} causal_attn_q8_task_t;
+
+static void causal_attn_q8_worker(int tid, int n_threads, void *arg) {
+    causal_attn_q8_task_t *t = (causal_attn_q8_task_t *)arg;
+    int chunk = (t->n_heads + n_threads - 1) / n_threads;
+    int h0 = tid * chunk;
+    int h1 = h0 + chunk;
+    if (h1 > t->n_heads) h1 = t->n_heads;
+    if (h0 >= h1) return;
+
+    qwen_causal_attention_q8_heads(t->out, t->Q, t->K_q8, t->K_scale,
+                                   t->V_q8, t->V_scale,
+                                   t->seq_q, t->seq_k, t->n_heads, t->n_kv_heads,
+                                   t->head_dim, t->scale, t->q_offset, h0, h1);
+}
+
+void qwen_causal_attention_q8(float *out, const float *Q,
+                               const int8_t *K_q8, const float *K_scale,
+                               const int8_t *V_q8, const float *V_scale,
+                               int seq_q, int seq_k, int n_heads, int n_kv_heads,
+                               int head_dim, float scale, int q_offset) {
+    uint64_t perf_t0 = qwen_perf_tic();
+    if (qwen_get_n_threads() > 1 && n_heads >= 2 && (seq_q >= 2 || seq_k >= 128)) {
+        causal_attn_q8_task_t task = {
+            .out = out, .Q = Q,
+            .K_q8 = K_q8, .K_scale = K_scale,
+            .V_q8 = V_q8, .V_scale = V_scale,
+            .seq_q = seq_q, .seq_k = seq_k,
+            .n_heads = n_heads, .n_kv_heads = n_kv_heads,
+            .head_dim = head_dim, .scale = scale, .q_offset = q_offset
+        };
+        qwen_parallel_for(causal_attn_q8_worker, &task);
+    } else {
+        qwen_causal_attention_q8_heads(out, Q, K_q8, K_scale, V_q8, V_scale,
+                                       seq_q, seq_k, n_heads, n_kv_heads,
+                                       head_dim, scale, q_offset, 0, n_heads);
+    }
+    qwen_perf_toc(QWEN_PERF_ATTENTION, perf_t0);
 }
 
 /* ========================================================================
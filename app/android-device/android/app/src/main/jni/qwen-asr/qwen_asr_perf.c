@@ -0,0 +1,129 @@
+/*
+ * qwen_asr_perf.c - Per-kernel-class / per-layer performance counters
+ */
+
+#include "qwen_asr_perf.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* One counter block per thread, linked into a global list on first use.
+ * The hot path touches only the calling thread's block; the list and
+ * mutex are hit once per thread lifetime plus once per report/reset. */
+typedef struct perf_block_s {
+    uint64_t ns[QWEN_PERF_N_CLASSES][QWEN_PERF_MAX_LAYERS + 1];
+    uint64_t calls[QWEN_PERF_N_CLASSES];
+    int layer;   /* current layer bucket, QWEN_PERF_MAX_LAYERS = none */
+    struct perf_block_s *next;
+} perf_block_t;
+
+static perf_block_t *perf_blocks = NULL;
+static pthread_mutex_t perf_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread perf_block_t *tls_block = NULL;
+
+static const char *perf_class_names[QWEN_PERF_N_CLASSES] = {
+    "linear_q8", "linear_q4k", "attention", "conv2d", "mel", "softmax",
+};
+
+static perf_block_t *perf_get_block(void) {
+    if (!tls_block) {
+        perf_block_t *b = (perf_block_t *)calloc(1, sizeof(perf_block_t));
+        if (!b) return NULL;
+        b->layer = QWEN_PERF_MAX_LAYERS;
+        pthread_mutex_lock(&perf_mutex);
+        b->next = perf_blocks;
+        perf_blocks = b;
+        pthread_mutex_unlock(&perf_mutex);
+        tls_block = b;
+    }
+    return tls_block;
+}
+
+uint64_t qwen_perf_tic(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void qwen_perf_toc(qwen_perf_class_t cls, uint64_t t0) {
+    perf_block_t *b = perf_get_block();
+    if (!b) return;
+    b->ns[cls][b->layer] += qwen_perf_tic() - t0;
+    b->calls[cls]++;
+}
+
+void qwen_perf_set_layer(int layer) {
+    perf_block_t *b = perf_get_block();
+    if (!b) return;
+    b->layer = (layer >= 0 && layer < QWEN_PERF_MAX_LAYERS)
+                   ? layer : QWEN_PERF_MAX_LAYERS;
+}
+
+/* Reset races benignly with in-flight kernels (a single counter bump may
+ * survive or be lost); counters are telemetry, not accounting. */
+void qwen_perf_reset(void) {
+    pthread_mutex_lock(&perf_mutex);
+    for (perf_block_t *b = perf_blocks; b; b = b->next) {
+        memset(b->ns, 0, sizeof(b->ns));
+        memset(b->calls, 0, sizeof(b->calls));
+    }
+    pthread_mutex_unlock(&perf_mutex);
+}
+
+int qwen_perf_report(char *buf, size_t buf_size) {
+    uint64_t ns[QWEN_PERF_N_CLASSES][QWEN_PERF_MAX_LAYERS + 1];
+    uint64_t calls[QWEN_PERF_N_CLASSES];
+    memset(ns, 0, sizeof(ns));
+    memset(calls, 0, sizeof(calls));
+
+    pthread_mutex_lock(&perf_mutex);
+    for (perf_block_t *b = perf_blocks; b; b = b->next) {
+        for (int c = 0; c < QWEN_PERF_N_CLASSES; c++) {
+            calls[c] += b->calls[c];
+            for (int l = 0; l <= QWEN_PERF_MAX_LAYERS; l++)
+                ns[c][l] += b->ns[c][l];
+        }
+    }
+    pthread_mutex_unlock(&perf_mutex);
+
+    int off = 0;
+#define APPEND(...) do { \
+        if ((size_t)off < buf_size) \
+            off += snprintf(buf + off, buf_size - off, __VA_ARGS__); \
+    } while (0)
+
+    APPEND("%-12s %10s %8s\n", "class", "total_ms", "calls");
+    for (int c = 0; c < QWEN_PERF_N_CLASSES; c++) {
+        uint64_t total = 0;
+        for (int l = 0; l <= QWEN_PERF_MAX_LAYERS; l++)
+            total += ns[c][l];
+        APPEND("%-12s %10.2f %8llu\n", perf_class_names[c],
+               total / 1e6, (unsigned long long)calls[c]);
+    }
+
+    APPEND("layer breakdown (ms):\n");
+    for (int l = 0; l <= QWEN_PERF_MAX_LAYERS; l++) {
+        uint64_t layer_total = 0;
+        for (int c = 0; c < QWEN_PERF_N_CLASSES; c++)
+            layer_total += ns[c][l];
+        if (layer_total == 0) continue;
+        if (l == QWEN_PERF_MAX_LAYERS)
+            APPEND("  (none)");
+        else
+            APPEND("  L%-5d", l);
+        for (int c = 0; c < QWEN_PERF_N_CLASSES; c++) {
+            if (ns[c][l] == 0) continue;
+            APPEND(" %s=%.2f", perf_class_names[c], ns[c][l] / 1e6);
+        }
+        APPEND("\n");
+    }
+#undef APPEND
+
+    if (buf_size > 0 && (size_t)off >= buf_size) {
+        off = (int)buf_size - 1;
+        buf[off] = '\0';
+    }
+    return off;
+}
@@ -0,0 +1,49 @@
+/*
+ * qwen_asr_perf.h - Per-kernel-class / per-layer performance counters
+ *
+ * Lightweight instrumentation meant to stay on in production: each thread
+ * owns a TLS counter block (no atomics or locks on the hot path), and the
+ * blocks are aggregated only when a report is pulled. Cost is one
+ * clock_gettime pair per kernel call (~50ns) against kernel runtimes in
+ * the microsecond-to-millisecond range.
+ */
+
+#ifndef QWEN_ASR_PERF_H
+#define QWEN_ASR_PERF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    QWEN_PERF_LINEAR_Q8 = 0,   /* Q8_0 matvec/GEMM (encoder + projections) */
+    QWEN_PERF_LINEAR_Q4K,      /* Q4_K matvec/GEMM/argmax (decoder weights) */
+    QWEN_PERF_ATTENTION,       /* encoder + decoder attention */
+    QWEN_PERF_CONV2D,          /* encoder conv stem */
+    QWEN_PERF_MEL,             /* mel spectrogram (batch + streaming) */
+    QWEN_PERF_SOFTMAX,
+    QWEN_PERF_N_CLASSES
+} qwen_perf_class_t;
+
+/* Layers 0..QWEN_PERF_MAX_LAYERS-1 get their own bucket; kernel calls made
+ * outside any layer loop land in one extra "no layer" bucket. */
+#define QWEN_PERF_MAX_LAYERS 64
+
+/* Timestamp in ns for a later qwen_perf_toc() */
+uint64_t qwen_perf_tic(void);
+
+/* Credit the elapsed time since t0 to (class, current layer) */
+void qwen_perf_toc(qwen_perf_class_t cls, uint64_t t0);
+
+/* Tag subsequent kernel calls on the calling thread with a layer index
+ * (-1 = outside any layer). Layer loops set this at iteration start and
+ * clear it after the loop. */
+void qwen_perf_set_layer(int layer);
+
+/* Zero all counters (call at utterance start) */
+void qwen_perf_reset(void);
+
+/* Aggregate counters across all threads into a human-readable report.
+ * Returns the number of bytes written (excluding the NUL terminator). */
+int qwen_perf_report(char *buf, size_t buf_size);
+
+#endif /* QWEN_ASR_PERF_H */
@@ -352,3 +352,51 @@ void dequantize_q8_0_to_f32(const block_q8_0 *src, float *dst, int n) {
 #endif
     }
 }
+
+block_q4_kx4 *qwen_q4k_repack_x4(const block_q4_k *src, int rows, int cols) {
+    if ((rows % 4) != 0 || (cols % QK_K) != 0) return NULL;
+
+    int blocks_per_row = cols / QK_K;
+    int n_quads = rows / 4;
+    block_q4_kx4 *dst =
+        (block_q4_kx4 *)malloc((size_t)n_quads * blocks_per_row * sizeof(block_q4_kx4));
+    if (!dst) return NULL;
+
+    for (int q = 0; q < n_quads; q++) {
+        for (int b = 0; b < blocks_per_row; b++) {
+            block_q4_kx4 *tile = &dst[(size_t)q * blocks_per_row + b];
+            for (int r = 0; r < 4; r++) {
+                const block_q4_k *blk =
+                    &src[(size_t)(4 * q + r) * blocks_per_row + b];
+                tile->d[r] = blk->d;
+                tile->dmin[r] = blk->dmin;
+                for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+                    tile->scales[g][r] = blk->scales[g];
+                    tile->mins[g][r] = blk->mins[g];
+                    memcpy(tile->qs[g][r], blk->qs + g * 16, 16);
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+void dequantize_q4k_to_f32(const block_q4_k *src, float *dst, int n) {
+    int n_blocks = n / QK_K;
+
+    for (int b = 0; b < n_blocks; b++) {
+        const block_q4_k *blk = &src[b];
+        float *dp = dst + b * QK_K;
+
+        for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+            float scale = blk->d * (float)blk->scales[g];
+            float min = blk->dmin * (float)blk->mins[g];
+            /* Low nibble = even index, high nibble = odd index */
+            for (int i = 0; i < 16; i++) {
+                uint8_t packed = blk->qs[g * 16 + i];
+                dp[g * 32 + i * 2] = scale * (float)(packed & 0x0F) - min;
+                dp[g * 32 + i * 2 + 1] = scale * (float)(packed >> 4) - min;
+            }
+        }
+    }
+}
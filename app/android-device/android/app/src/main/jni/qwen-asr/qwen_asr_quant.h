@@ -16,36 +16,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#define QK8_0 32  /* block size */
-
-typedef struct {
-    float scale;           /* shared scale factor */
-    int8_t qs[QK8_0];     /* quantized values */
-} block_q8_0;             /* 36 bytes total */
-
-/* ========================================================================
- * Q4_K Super-Block Quantization Format
- *
- * 256 weights per super-block, 8 sub-groups of 32.
- * Two-level quantization: super-block scale/min (float) + sub-group
- * integer scales/mins (uint8). Unsigned 4-bit quantized values [0,15].
- *
- * Dequantization: weight ≈ d * scales[g] * q - dmin * mins[g]
- *
- * Memory: 152 bytes per 256 weights = 0.59375 bytes/weight
- * vs Q8_0: 1.125 bytes/weight (1.89x compression)
- * ======================================================================== */
-
-#define QK_K 256
-#define Q4K_NUM_SUBS 8   /* QK_K / 32 */
-
-typedef struct {
-    float d;               /* 4B: super-block scale */
-    float dmin;            /* 4B: super-block min (asymmetric offset) */
-    uint8_t scales[8];     /* 8B: per-sub-group integer scales (0-255) */
-    uint8_t mins[8];       /* 8B: per-sub-group integer mins (0-255) */
-    uint8_t qs[128];       /* 128B: 256 unsigned int4 [0,15] packed nibbles */
-} block_q4_k;              /* 152 bytes / 256 elements */
+/* block_q8_0 / block_q4_k and the QK8_0 / QK_K / Q4K_NUM_SUBS constants are
+ * shared with the TTS engine. */
+#include "qwen_quant_formats.h"
 
 /* Quantize n float32 values to Q8_0 blocks.
  * n must be a multiple of QK8_0.
@@ -69,6 +42,17 @@ void dequantize_q8_0_to_f32(const block_q8_0 *src, float *dst, int n);
 void quantize_bf16_to_q4k(const uint16_t *bf16, int rows, int cols,
                             block_q4_k **out_blocks);
 
+/* Dequantize Q4_K super-blocks back to float32.
+ * n is the number of float values (must be multiple of QK_K).
+ * dst must have n floats allocated. */
+void dequantize_q4k_to_f32(const block_q4_k *src, float *dst, int n);
+
+/* Repack row-major Q4_K blocks into the 4-row interleaved block_q4_kx4
+ * layout consumed by the _x4 matvec/GEMM kernels. rows must be a multiple
+ * of 4 and cols a multiple of QK_K. Returns a malloc'd array of
+ * (rows/4) * (cols/QK_K) tiles (caller frees), NULL on bad shape or OOM. */
+block_q4_kx4 *qwen_q4k_repack_x4(const block_q4_k *src, int rows, int cols);
+
 /* Quantize X[M, K] row-wise to Q8_0 in transposed-block layout.
  * Output: X_q8t[n_blocks * M_pad] where n_blocks = K / QK8_0.
  * X_q8t[b * M_pad + m] = Q8_0 block for row m, K-block b.
@@ -6,10 +6,12 @@
 #include "qwen_asr_kernels.h"
 #include "qwen_asr_audio.h"
 #include "qwen_asr_tokenizer.h"
+#include "qwen_asr_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #include <math.h>
 #include <sys/time.h>
 
@@ -78,7 +80,8 @@ typedef struct {
 
 static void stream_clear_stem_cache(stream_stem_entry_t *stem_cache,
                                     int *n_stem_cached,
-                                    float *stem_mel_global_max) {
+                                    float *stem_mel_global_max,
+                                    qwen_mel_stream_t *mel_stream) {
     if (stem_cache && n_stem_cached) {
         for (int i = 0; i < *n_stem_cached; i++) {
             free(stem_cache[i].stem_output);
@@ -88,6 +91,8 @@ static void stream_clear_stem_cache(stream_stem_entry_t *stem_cache,
     }
     if (stem_mel_global_max)
         *stem_mel_global_max = -1e30f;
+    /* The mel frame cache shares the stem cache's span-start invariant */
+    qwen_mel_stream_reset(mel_stream);
 }
 
 static void stream_clear_enc_cache(stream_enc_window_t *enc_cache,
@@ -115,6 +120,7 @@ static void stream_clear_enc_cache(stream_enc_window_t *enc_cache,
  * Returns encoder output [seq_len, output_dim] (caller owns), or NULL on failure. */
 static float *stream_encode_stem_cached(
     qwen_ctx_t *ctx, const float *samples, int n_samples,
+    qwen_mel_stream_t *mel_stream,
     stream_stem_entry_t **stem_cache_ptr, int *n_stem_cached_ptr,
     int *stem_cache_cap_ptr, float *stem_mel_global_max_ptr,
     int *out_seq_len, int *out_stem_hits, int *out_stem_total)
@@ -124,10 +130,20 @@ static float *stream_encode_stem_cached(
     if (out_stem_total) *out_stem_total = 0;
     if (n_samples <= 0) return NULL;
 
+    /* The incremental mel path reuses cached FFT frames from earlier calls
+     * on the same growing span; it is reset together with the stem cache. */
     int mel_frames = 0;
-    float *mel = qwen_mel_spectrogram(samples, n_samples, &mel_frames,
-                                       stem_mel_global_max_ptr);
+    double mel_t0 = get_time_ms();
+    qwen_trace_begin("asr_mel");
+    float *mel = mel_stream
+        ? qwen_mel_stream_process(mel_stream, samples, n_samples, &mel_frames,
+                                  stem_mel_global_max_ptr)
+        : qwen_mel_spectrogram(samples, n_samples, &mel_frames,
+                               stem_mel_global_max_ptr);
+    qwen_trace_end();
     if (!mel) return NULL;
+    qwen_trace_emit("mel", "\"frames\":%d,\"ms\":%.1f",
+                    mel_frames, get_time_ms() - mel_t0);
 
     int mel_chunk_size = ctx->config.enc_chunk_size;
     int n_mel_chunks = (mel_frames + mel_chunk_size - 1) / mel_chunk_size;
@@ -155,6 +171,8 @@ static float *stream_encode_stem_cached(
 
     /* Process each mel chunk with cache */
     int total_tokens = 0;
+    double stem_t0 = get_time_ms();
+    qwen_trace_begin("asr_stem");
     for (int c = 0; c < n_mel_chunks; c++) {
         int cs = c * mel_chunk_size;
         int ce = cs + mel_chunk_size;
@@ -179,6 +197,9 @@ static float *stream_encode_stem_cached(
             total_tokens += n_tok;
         }
     }
+    qwen_trace_end();
+    qwen_trace_emit("stem", "\"hits\":%d,\"total\":%d,\"ms\":%.1f",
+                    stem_hits, n_mel_chunks, get_time_ms() - stem_t0);
     /* Free entries beyond current chunk count */
     for (int c = n_mel_chunks; c < n_sc; c++) {
         free(sc[c].stem_output);
@@ -210,6 +231,206 @@ static float *stream_encode_stem_cached(
     return enc_out;
 }
 
+/* ========================================================================
+ * Pipelined stem prefetch
+ *
+ * While the decoder drains chunk N, a worker thread computes the mel
+ * spectrogram + Conv2D stem for chunk N+1's partial tail window.  The mel
+ * and stem only depend on the audio span and the running mel max, both of
+ * which are known as soon as the next chunk's samples are buffered.
+ *
+ * The worker runs kernels pool-serially (qwen_set_thread_serial) so it
+ * never races the shared thread pool, and it only touches the Q8 GEMM
+ * workspace — disjoint from the Q4_K workspace the decoder uses.  The main
+ * thread still syncs with the worker before running any encoder kernels of
+ * its own.
+ *
+ * At consume time the result is only installed if the span and starting
+ * mel max match exactly (a reset or window rollover in between makes it
+ * stale); otherwise it is dropped and the main thread recomputes.
+ * ======================================================================== */
+
+typedef struct {
+    qwen_ctx_t *ctx;
+    pthread_t thread;
+    int thread_started;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int has_job;      /* worker owns the job fields */
+    int has_result;   /* result fields valid, awaiting consume */
+    int shutdown;
+
+    /* Job: copy of the audio span (worker frees it). */
+    float *job_samples;
+    int job_n_samples;
+    int64_t job_start_sample;
+    float job_mel_global_max;
+
+    /* Result: per-mel-chunk stem outputs for the job span. */
+    stream_stem_entry_t *entries;
+    int n_entries;
+    int failed;
+} stream_stem_prefetch_t;
+
+static void *stream_stem_prefetch_worker(void *arg) {
+    stream_stem_prefetch_t *pf = (stream_stem_prefetch_t *)arg;
+    qwen_set_thread_serial(1);
+    pthread_mutex_lock(&pf->mutex);
+    for (;;) {
+        while (!pf->has_job && !pf->shutdown)
+            pthread_cond_wait(&pf->cond, &pf->mutex);
+        if (pf->shutdown) break;
+
+        qwen_ctx_t *ctx = pf->ctx;
+        float *samples = pf->job_samples;
+        int n_samples = pf->job_n_samples;
+        float gmax = pf->job_mel_global_max;
+        pf->job_samples = NULL;
+        pthread_mutex_unlock(&pf->mutex);
+
+        stream_stem_entry_t *entries = NULL;
+        int n_entries = 0;
+        int failed = 0;
+        int mel_frames = 0;
+        float *mel = qwen_mel_spectrogram(samples, n_samples, &mel_frames, &gmax);
+        free(samples);
+        if (mel) {
+            int mel_chunk_size = ctx->config.enc_chunk_size;
+            int n_mel_chunks = (mel_frames + mel_chunk_size - 1) / mel_chunk_size;
+            entries = (stream_stem_entry_t *)calloc(
+                (size_t)n_mel_chunks, sizeof(stream_stem_entry_t));
+            if (entries) {
+                n_entries = n_mel_chunks;
+                for (int c = 0; c < n_mel_chunks && !failed; c++) {
+                    int cs = c * mel_chunk_size;
+                    int ce = cs + mel_chunk_size;
+                    if (ce > mel_frames) ce = mel_frames;
+                    int n_tok = 0;
+                    entries[c].stem_output = qwen_encoder_stem_chunk(
+                        ctx, mel, mel_frames, cs, ce - cs, &n_tok);
+                    entries[c].n_tokens = n_tok;
+                    if (!entries[c].stem_output) failed = 1;
+                }
+            } else {
+                failed = 1;
+            }
+            free(mel);
+        } else {
+            failed = 1;
+        }
+
+        pthread_mutex_lock(&pf->mutex);
+        pf->entries = entries;
+        pf->n_entries = n_entries;
+        pf->failed = failed;
+        pf->has_job = 0;
+        pf->has_result = 1;
+        pthread_cond_broadcast(&pf->cond);
+    }
+    pthread_mutex_unlock(&pf->mutex);
+    return NULL;
+}
+
+/* Wait for any in-flight prefetch job to finish (its result stays queued).
+ * Must be called before the main thread runs encoder kernels: the worker
+ * shares the Q8 GEMM workspace with them. */
+static void stream_stem_prefetch_sync(stream_stem_prefetch_t *pf) {
+    if (!pf->thread_started) return;
+    pthread_mutex_lock(&pf->mutex);
+    while (pf->has_job)
+        pthread_cond_wait(&pf->cond, &pf->mutex);
+    pthread_mutex_unlock(&pf->mutex);
+}
+
+static void stream_stem_prefetch_drop_result(stream_stem_prefetch_t *pf) {
+    for (int i = 0; i < pf->n_entries; i++)
+        free(pf->entries[i].stem_output);
+    free(pf->entries);
+    pf->entries = NULL;
+    pf->n_entries = 0;
+    pf->has_result = 0;
+}
+
+/* Install a pending prefetch result as the stem cache if it matches the
+ * span/mel-max the main thread is about to encode. Returns 1 on hit. */
+static int stream_stem_prefetch_consume(
+    stream_stem_prefetch_t *pf, int64_t start_sample, int n_samples,
+    float mel_global_max, stream_stem_entry_t **stem_cache_ptr,
+    int *n_stem_cached_ptr, int *stem_cache_cap_ptr)
+{
+    if (!pf->thread_started) return 0;
+    stream_stem_prefetch_sync(pf);
+    if (!pf->has_result) return 0;
+
+    if (pf->failed ||
+        pf->job_start_sample != start_sample ||
+        pf->job_n_samples != n_samples ||
+        pf->job_mel_global_max != mel_global_max) {
+        stream_stem_prefetch_drop_result(pf);
+        return 0;
+    }
+
+    for (int i = 0; i < *n_stem_cached_ptr; i++)
+        free((*stem_cache_ptr)[i].stem_output);
+    free(*stem_cache_ptr);
+    *stem_cache_ptr = pf->entries;
+    *n_stem_cached_ptr = pf->n_entries;
+    *stem_cache_cap_ptr = pf->n_entries;
+    pf->entries = NULL;
+    pf->n_entries = 0;
+    pf->has_result = 0;
+    return 1;
+}
+
+/* Queue the next chunk's partial span for prefetch. No-op while a job or
+ * unconsumed result is pending. Starts the worker thread lazily. */
+static void stream_stem_prefetch_submit(stream_stem_prefetch_t *pf,
+                                        qwen_ctx_t *ctx,
+                                        const float *samples, int n_samples,
+                                        int64_t start_sample,
+                                        float mel_global_max) {
+    if (n_samples <= 0) return;
+    if (!pf->thread_started) {
+        pf->ctx = ctx;
+        if (pthread_create(&pf->thread, NULL, stream_stem_prefetch_worker, pf) != 0)
+            return;
+        pf->thread_started = 1;
+    }
+    pthread_mutex_lock(&pf->mutex);
+    if (pf->has_job || pf->has_result) {
+        pthread_mutex_unlock(&pf->mutex);
+        return;
+    }
+    float *copy = (float *)malloc((size_t)n_samples * sizeof(float));
+    if (!copy) {
+        pthread_mutex_unlock(&pf->mutex);
+        return;
+    }
+    memcpy(copy, samples, (size_t)n_samples * sizeof(float));
+    pf->job_samples = copy;
+    pf->job_n_samples = n_samples;
+    pf->job_start_sample = start_sample;
+    pf->job_mel_global_max = mel_global_max;
+    pf->has_job = 1;
+    pthread_cond_broadcast(&pf->cond);
+    pthread_mutex_unlock(&pf->mutex);
+}
+
+static void stream_stem_prefetch_shutdown(stream_stem_prefetch_t *pf) {
+    if (!pf->thread_started) return;
+    pthread_mutex_lock(&pf->mutex);
+    while (pf->has_job)
+        pthread_cond_wait(&pf->cond, &pf->mutex);
+    pf->shutdown = 1;
+    pthread_cond_broadcast(&pf->cond);
+    pthread_mutex_unlock(&pf->mutex);
+    pthread_join(pf->thread, NULL);
+    pf->thread_started = 0;
+    if (pf->has_result)
+        stream_stem_prefetch_drop_result(pf);
+}
+
 /* Re-anchor stream text state to a short committed tail so decoding can
  * continue after a hard reset without replaying the full text history. */
 static int stream_reanchor_text_state(qwen_ctx_t *ctx,
@@ -303,6 +524,12 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     const float *audio_samples = samples;
     int64_t audio_n_samples = n_samples;
     float *compacted_samples = NULL;
+    if (live && ctx->skip_silence) {
+        /* Live analog of compact_silence: gate silence at the source so
+         * silent spans never wake the encoder (the loop just blocks on
+         * the condvar until voiced audio arrives). */
+        qwen_live_audio_set_vad(live, 1);
+    }
     if (!live && ctx->skip_silence) {
         int compacted_n = n_samples;
         compacted_samples = compact_silence(samples, n_samples, &compacted_n);
@@ -397,6 +624,10 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     #define QWEN_STREAM_STALE_CHUNKS 4
     #define QWEN_STREAM_RESET_INTERVAL_CHUNKS 45
     #define QWEN_STREAM_RESET_CARRY_TOKENS 24
+    /* Greedy logit margin above which a tail token counts as settled for
+     * the confidence gate (the runner-up holds e^-margin of the winner's
+     * probability, so 5.0 leaves it under 1%). */
+    #define QWEN_STREAM_FIX_MARGIN 5.0f
 
     if (qwen_verbose >= 2) {
         if (live)
@@ -460,6 +691,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     int *raw_tokens = (int *)malloc(8192 * sizeof(int));
     int n_raw_tokens = 0;
     int raw_tokens_cap = 8192;
+    /* Decode-time logit margin per raw token (confidence gate input). */
+    float *raw_margins = (float *)malloc(8192 * sizeof(float));
+    int raw_margins_cap = 8192;
 
     /* Stable committed text tokens already emitted to stdout. */
     int *stable_text_tokens = (int *)malloc(8192 * sizeof(int));
@@ -473,8 +707,10 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     size_t result_cap = 4096;
     size_t result_len = 0;
     char *result = (char *)malloc(result_cap);
-    if (!raw_tokens || !stable_text_tokens || !emitted_text_tokens || !result) {
+    if (!raw_tokens || !raw_margins || !stable_text_tokens ||
+        !emitted_text_tokens || !result) {
         free(raw_tokens);
+        free(raw_margins);
         free(stable_text_tokens);
         free(emitted_text_tokens);
         free(result);
@@ -488,6 +724,7 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     float *tmp_embed = (float *)malloc(dim * sizeof(float));
     if (!tmp_embed) {
         free(raw_tokens);
+        free(raw_margins);
         free(stable_text_tokens);
         free(emitted_text_tokens);
         free(result);
@@ -498,6 +735,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
 
     int chunk_idx = 0;
     int64_t audio_cursor = 0;
+    /* Tokens to actually re-decode next chunk: shrunk below `rollback`
+     * when the tail was decoded with high logit margins (confidence gate). */
+    int cur_rollback = rollback;
     stream_enc_window_t *enc_cache = NULL;
     int n_enc_cache = 0;
     int enc_cache_start = 0;  /* first live entry (older ones evicted) */
@@ -513,9 +753,26 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     int n_stem_cached = 0;
     int stem_cache_cap = 0;
     float stem_mel_global_max = -1e30f;
+    /* Incremental mel for the growing partial-window span: persistent FFT
+     * tables plus finished-frame reuse (falls back to the batch path if
+     * allocation fails). Reset alongside the stem cache. */
+    qwen_mel_stream_t *mel_stream = qwen_mel_stream_create();
     int prefill_total_tokens = 0;
     int prefill_reused_tokens = 0;
 
+    /* Pipelined stem prefetch: overlap next chunk's mel + Conv2D stem with
+     * this chunk's decode (debug fallback: QWEN_STREAM_NO_PIPELINE=1). */
+    stream_stem_prefetch_t prefetch = {
+        .mutex = PTHREAD_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER,
+    };
+    const char *no_pipeline_env = getenv("QWEN_STREAM_NO_PIPELINE");
+    int use_pipeline = use_enc_cache &&
+        !(no_pipeline_env && no_pipeline_env[0] != '\0' &&
+          strcmp(no_pipeline_env, "0") != 0);
+    int prefetch_hits = 0;
+    int prefetch_misses = 0;
+
     while (audio_cursor < audio_n_samples || (live && !live_eof)) {
         /* Live mode: wait until we have enough data for the next chunk. */
         if (live) {
@@ -588,6 +845,8 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         if (audio_cursor > audio_n_samples) audio_cursor = audio_n_samples;
         int is_final = live ? (live_eof && audio_cursor >= audio_n_samples)
                             : (audio_cursor >= audio_n_samples);
+        qwen_trace_emit("chunk", "\"idx\":%d,\"audio_s\":%.2f,\"final\":%d",
+                        chunk_idx, (float)audio_cursor / QWEN_SAMPLE_RATE, is_final);
 
         /* Skip cold-start chunks entirely — their decode output is discarded
          * (candidate_len=0), so the encoder + prefill + decode work is wasted.
@@ -612,6 +871,10 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         float *enc_output = NULL;
         int64_t full_end = (audio_cursor / enc_window_samples) * (int64_t)enc_window_samples;
 
+        /* Join any in-flight prefetch before running encoder kernels here
+         * (the worker shares the Q8 GEMM workspace with them). */
+        stream_stem_prefetch_sync(&prefetch);
+
         if (!use_enc_cache) {
             if (audio_cursor > INT_MAX) {
                 ctx->perf_total_ms += get_time_ms() - chunk_t0;
@@ -635,6 +898,7 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                         (float)audio_cursor / QWEN_SAMPLE_RATE,
                         enc_ms);
             }
+            qwen_trace_emit("encoder", "\"tokens\":%d,\"ms\":%.1f", enc_seq_len, enc_ms);
         } else {
             int enc_failed = 0;
             int prev_n_enc_cache = n_enc_cache;
@@ -649,6 +913,8 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                 }
                 float *win_enc = NULL;
                 int win_seq = 0;
+                double win_t0 = get_time_ms();
+                qwen_trace_begin("asr_enc_window");
 
                 /* Use stem-cached encoding when cache is available
                  * (reuses Conv2D outputs from partial window processing) */
@@ -656,14 +922,14 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                 if (n_stem_cached > 0) {
                     win_enc = stream_encode_stem_cached(
                         ctx, audio_samples + (size_t)ws_local_off,
-                        enc_window_samples,
+                        enc_window_samples, mel_stream,
                         &stem_cache, &n_stem_cached, &stem_cache_cap,
                         &stem_mel_global_max,
                         &win_seq, &win_stem_hits, &win_stem_total);
                     /* Clear stem cache after encoding complete window
                      * (next partial window starts from new boundary) */
                     stream_clear_stem_cache(stem_cache, &n_stem_cached,
-                                            &stem_mel_global_max);
+                                            &stem_mel_global_max, mel_stream);
                 } else {
                     if (stream_encode_span(ctx,
                                            audio_samples + (size_t)ws_local_off,
@@ -673,11 +939,14 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                     }
                 }
 
+                qwen_trace_end();
                 if (!win_enc || win_seq <= 0) {
                     free(win_enc);
                     enc_failed = 1;
                     break;
                 }
+                qwen_trace_emit("enc_window", "\"tokens\":%d,\"ms\":%.1f",
+                                win_seq, get_time_ms() - win_t0);
 
                 if (qwen_verbose >= 2 && win_stem_total > 0) {
                     fprintf(stderr,
@@ -718,13 +987,28 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                     partial_off64 + partial_samples64 > local_n_samples) {
                     enc_failed = 1;
                 } else {
+                    /* Install prefetched stems computed during the previous
+                     * chunk's decode; on mismatch the cached path below just
+                     * recomputes (the first chunk and window-rollover chunks
+                     * miss by design — the rollover encode shifts the mel max). */
+                    if (use_pipeline) {
+                        if (stream_stem_prefetch_consume(
+                                &prefetch, full_end, (int)partial_samples64,
+                                stem_mel_global_max,
+                                &stem_cache, &n_stem_cached, &stem_cache_cap))
+                            prefetch_hits++;
+                        else
+                            prefetch_misses++;
+                    }
                     int partial_stem_hits = 0, partial_stem_total = 0;
+                    qwen_trace_begin("asr_enc_partial");
                     partial_enc = stream_encode_stem_cached(
                         ctx, audio_samples + (size_t)partial_off64,
-                        (int)partial_samples64,
+                        (int)partial_samples64, mel_stream,
                         &stem_cache, &n_stem_cached, &stem_cache_cap,
                         &stem_mel_global_max,
                         &partial_seq, &partial_stem_hits, &partial_stem_total);
+                    qwen_trace_end();
                     if (!partial_enc) enc_failed = 1;
 
                     if (qwen_verbose >= 2 && partial_stem_total > 0) {
@@ -747,17 +1031,42 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
              * to keep decoder sequence length (and KV cache) bounded. */
             {
                 int evicted = 0;
+                int evicted_seq = 0;
                 while (n_enc_cache - enc_cache_start > QWEN_STREAM_MAX_ENC_WINDOWS) {
                     enc_cached_seq_total -= enc_cache[enc_cache_start].seq_len;
+                    evicted_seq += enc_cache[enc_cache_start].seq_len;
                     free(enc_cache[enc_cache_start].enc_output);
                     enc_cache[enc_cache_start].enc_output = NULL;
                     enc_cache_start++;
                     evicted++;
                 }
+                if (evicted) {
+                    /* Drop the evicted windows' span from the decoder KV in
+                     * place (survivors keep their stored RoPE rotations, see
+                     * qwen_decoder_evict_kv) and from the embed-reuse mirror,
+                     * so the prefill below re-runs only the new tail instead
+                     * of everything behind the evicted windows. */
+                    int evict_at = PREFIX_HEAD_LEN + ctx->n_prompt_tokens + PREFIX_TAIL_LEN;
+                    if (prev_prefill_embeds &&
+                        prev_prefill_len >= evict_at + evicted_seq &&
+                        ctx->kv_cache_len >= evict_at + evicted_seq) {
+                        qwen_decoder_evict_kv(ctx, evict_at, evicted_seq);
+                        memmove(prev_prefill_embeds + (size_t)evict_at * dim,
+                                prev_prefill_embeds + (size_t)(evict_at + evicted_seq) * dim,
+                                (size_t)(prev_prefill_len - evict_at - evicted_seq) *
+                                    dim * sizeof(float));
+                        prev_prefill_len -= evicted_seq;
+                    } else {
+                        prev_prefill_len = 0;  /* fall back to a full prefill */
+                    }
+                }
                 if (evicted && qwen_monitor) {
                     fprintf(stderr, "\xe2\x9f\xb3");  /* ⟳ = window eviction */
                     fflush(stderr);
                 }
+                if (evicted)
+                    qwen_trace_emit("evict", "\"windows\":%d,\"tokens\":%d",
+                                    evicted, evicted_seq);
             }
 
             enc_seq_len = enc_cached_seq_total + partial_seq;
@@ -789,9 +1098,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             }
             free(partial_enc);
 
+            double enc_ms = get_time_ms() - t0;
+            ctx->perf_encode_ms += enc_ms;
             if (qwen_verbose >= 2) {
-                double enc_ms = get_time_ms() - t0;
-                ctx->perf_encode_ms += enc_ms;
                 fprintf(stderr,
                         "  Encoder: %d tokens from 0.0-%.1f s (cached windows=%d, partial=%.1f s, %.0f ms)\n",
                         enc_seq_len,
@@ -800,10 +1109,8 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                         (float)(audio_cursor - full_end) / QWEN_SAMPLE_RATE,
                         enc_ms);
             }
-            if (qwen_verbose < 2) {
-                double enc_ms = get_time_ms() - t0;
-                ctx->perf_encode_ms += enc_ms;
-            }
+            qwen_trace_emit("encoder", "\"tokens\":%d,\"windows\":%d,\"ms\":%.1f",
+                            enc_seq_len, n_enc_cache - enc_cache_start, enc_ms);
             if (qwen_monitor) {
                 fprintf(stderr, "\xe2\x96\xb6");  /* ▶ = encoder */
                 fflush(stderr);
@@ -811,13 +1118,16 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         }
 
         /* Prefix rollback state:
-         * we feed previously decoded raw tokens minus last `rollback` tokens.
-         * This mirrors official streaming and keeps boundary text stable. */
+         * we feed previously decoded raw tokens minus the last unfixed
+         * tokens. This mirrors official streaming, except the unfixed count
+         * adapts per chunk: `cur_rollback` is the confidence-gated tail from
+         * the previous commit (at most `rollback`), so tokens already fixed
+         * on a high margin are re-fed as prefix instead of re-decoded. */
         int n_prefix_tokens_full = 0;
         int n_prefix_tokens = 0;
         int prefix_offset = 0;
         if (ctx->past_text_conditioning && chunk_idx >= unfixed_chunks && n_raw_tokens > 0) {
-            n_prefix_tokens_full = n_raw_tokens - rollback;
+            n_prefix_tokens_full = n_raw_tokens - cur_rollback;
             if (n_prefix_tokens_full < 0) n_prefix_tokens_full = 0;
             n_prefix_tokens = n_prefix_tokens_full;
             if (n_prefix_tokens > QWEN_STREAM_MAX_PREFIX_TOKENS) {
@@ -884,6 +1194,7 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
 
         /* ---- Decoder prefill + first token ---- */
         t0 = get_time_ms();
+        qwen_trace_begin("asr_prefill");
         int prefill_len = total_seq - 1;
         int reused_prefill = 0;
         if (prev_prefill_embeds && prev_prefill_len > 0) {
@@ -898,6 +1209,12 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         }
         /* Decoder KV reuse:
          * keep the longest unchanged prefill prefix and only prefill delta tokens. */
+        if (reused_prefill == 0) {
+            /* First chunk of this stream: seed the prompt prefix from the
+             * cross-utterance snapshot instead of re-prefilling it. */
+            reused_prefill = qwen_decoder_restore_prefix(ctx, prefix_len);
+        }
+        if (reused_prefill == 0) ctx->kv_pos_offset = 0;  /* positions restart */
         ctx->kv_cache_len = reused_prefill;
         int delta_prefill = prefill_len - reused_prefill;
         if (delta_prefill > 0) {
@@ -905,6 +1222,8 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                                  input_embeds + (size_t)reused_prefill * dim,
                                  delta_prefill);
         }
+        if (ctx->prefix_kv_len != prefix_len)
+            qwen_decoder_snapshot_prefix(ctx, prefix_len);
         prefill_total_tokens += prefill_len;
         prefill_reused_tokens += reused_prefill;
 
@@ -932,11 +1251,14 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         }
         free(input_embeds);
 
+        qwen_trace_end();
         double prefill_ms = get_time_ms() - t0;
         ctx->perf_decode_ms += prefill_ms;
         if (qwen_verbose >= 2)
             fprintf(stderr, "  Prefill: %d tokens (%d prefix, reused %d) (%.0f ms)\n",
                     total_seq, n_prefix_tokens, reused_prefill, prefill_ms);
+        qwen_trace_emit("prefill", "\"tokens\":%d,\"reused\":%d,\"ms\":%.1f",
+                        prefill_len, reused_prefill, prefill_ms);
         if (qwen_monitor) {
             fprintf(stderr, "\xc2\xb7");  /* · = prefill */
             fflush(stderr);
@@ -952,9 +1274,13 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         if (chunk_idx < unfixed_chunks)
             effective_max_new = 5;
 
-        /* Collect ALL generated tokens (including language, <asr_text>, etc.) */
+        /* Collect ALL generated tokens (including language, <asr_text>, etc.)
+         * plus each token's decode-time logit margin for the confidence gate. */
         int *chunk_tokens = (int *)malloc((size_t)effective_max_new * sizeof(int));
-        if (!chunk_tokens) {
+        float *chunk_margins = (float *)malloc((size_t)effective_max_new * sizeof(float));
+        if (!chunk_tokens || !chunk_margins) {
+            free(chunk_tokens);
+            free(chunk_margins);
             ctx->perf_total_ms += get_time_ms() - chunk_t0;
             chunk_idx++;
             continue;
@@ -965,10 +1291,22 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             n_generated++;
             if (token == QWEN_TOKEN_ENDOFTEXT || token == QWEN_TOKEN_IM_END) break;
 
-            chunk_tokens[n_chunk_tokens++] = token;
+            /* last_logit_margin still belongs to the forward that produced
+             * `token` (the next forward happens below). */
+            chunk_tokens[n_chunk_tokens] = token;
+            chunk_margins[n_chunk_tokens] = ctx->last_logit_margin;
+            n_chunk_tokens++;
 
             tok_embed_bf16_to_f32(tmp_embed, ctx->decoder.tok_embeddings_bf16, token, dim);
-            token = qwen_decoder_forward(ctx, tmp_embed);
+            if (qwen_trace_mode()) {
+                double tok_t0 = get_time_ms();
+                qwen_trace_begin("asr_token");
+                token = qwen_decoder_forward(ctx, tmp_embed);
+                qwen_trace_end();
+                qwen_trace_emit("token", "\"ms\":%.1f", get_time_ms() - tok_t0);
+            } else {
+                token = qwen_decoder_forward(ctx, tmp_embed);
+            }
         }
 
         double decode_ms = get_time_ms() - t0;
@@ -986,6 +1324,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             fprintf(stderr, "%s", ms_per_tok > 30 ? "\xe2\x96\xb8" : "\xe2\x96\xaa");
             fflush(stderr);
         }
+        qwen_trace_emit("decode", "\"tokens\":%d,\"ms\":%.1f,\"ms_per_tok\":%.1f",
+                        n_generated, decode_ms,
+                        n_generated > 0 ? decode_ms / n_generated : 0.0);
 
         /* Update raw token history = full prefix + newly generated continuation.
          * Uses n_prefix_tokens_full (uncapped) so raw_tokens keeps the complete
@@ -1021,6 +1362,7 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                     dropped_repeat_tokens++;
                     continue;
                 }
+                chunk_margins[out] = chunk_margins[i];
                 chunk_tokens[out++] = tok;
             }
             n_chunk_tokens = out;
@@ -1032,18 +1374,35 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             int *tmp_raw = (int *)realloc(raw_tokens, (size_t)raw_tokens_cap * sizeof(int));
             if (!tmp_raw) {
                 free(chunk_tokens);
+                free(chunk_margins);
                 ctx->perf_total_ms += get_time_ms() - chunk_t0;
                 chunk_idx++;
                 continue;
             }
             raw_tokens = tmp_raw;
         }
+        if (n_raw_new > raw_margins_cap) {
+            while (n_raw_new > raw_margins_cap) raw_margins_cap *= 2;
+            float *tmp_margins = (float *)realloc(raw_margins,
+                                                  (size_t)raw_margins_cap * sizeof(float));
+            if (!tmp_margins) {
+                free(chunk_tokens);
+                free(chunk_margins);
+                ctx->perf_total_ms += get_time_ms() - chunk_t0;
+                chunk_idx++;
+                continue;
+            }
+            raw_margins = tmp_margins;
+        }
         if (n_chunk_tokens > 0) {
             memcpy(raw_tokens + n_prefix_tokens_full, chunk_tokens,
                    (size_t)n_chunk_tokens * sizeof(int));
+            memcpy(raw_margins + n_prefix_tokens_full, chunk_margins,
+                   (size_t)n_chunk_tokens * sizeof(float));
         }
         n_raw_tokens = n_raw_new;
         free(chunk_tokens);
+        free(chunk_margins);
         if (dropped_repeat_tokens > 0 && qwen_verbose >= 2) {
             fprintf(stderr, "  Decode: dropped %d repeated tokens\n", dropped_repeat_tokens);
         }
@@ -1066,20 +1425,41 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
         if (text_start > n_raw_tokens) text_start = n_raw_tokens;
         int n_text_tokens = n_raw_tokens - text_start;
 
+        /* Confidence gate: keeping a fixed `rollback` tokens unfixed assumes
+         * every tail token is uncertain, but most are decoded with a large
+         * logit margin and never change on re-decode. Hold back only the
+         * span reaching the oldest low-margin token among the tokens decoded
+         * this chunk (capped at `rollback`); a confident tail above that is
+         * fixed — and skipped from the next chunk's re-decode — right away.
+         * The newest token always stays unfixed: its margin was computed
+         * against audio truncated at the chunk edge. */
+        int eff_rollback = rollback;
+        if (!is_final && n_text_tokens > 0) {
+            int window = n_raw_tokens - n_prefix_tokens_full; /* decoded this chunk */
+            if (window > rollback) window = rollback;
+            if (window > n_text_tokens) window = n_text_tokens;
+            eff_rollback = 1;
+            for (int i = 0; i < window; i++) {
+                if (raw_margins[n_raw_tokens - 1 - i] < QWEN_STREAM_FIX_MARGIN)
+                    eff_rollback = i + 1;
+            }
+        }
+
         /* "Fixed" frontier for this chunk:
          * - cold-start chunks: emit nothing,
-         * - intermediate chunks: keep last `rollback` text tokens unfixed,
-         *   but if text is shorter than rollback keep only 1 token unfixed so
+         * - intermediate chunks: keep the low-margin tail unfixed, but if
+         *   text is shorter than the tail keep only 1 token unfixed so
          *   streaming still advances,
          * - final chunk: emit everything. */
         int candidate_len = 0;
         if (is_final) {
             candidate_len = n_text_tokens;
         } else if (chunk_idx >= unfixed_chunks) {
-            candidate_len = n_text_tokens - rollback;
+            candidate_len = n_text_tokens - eff_rollback;
             if (candidate_len <= 0 && n_text_tokens > 0) candidate_len = n_text_tokens - 1;
             if (candidate_len < 0) candidate_len = 0;
         }
+        cur_rollback = eff_rollback;
 
         /* Streaming commit: emit token delta against the previous candidate.
          * We do not attempt monotonic byte-level reconciliation here. */
@@ -1119,6 +1499,11 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                     n_raw_tokens = 0;
                     n_stable_text_tokens = 0;
                 }
+                /* Carried tokens are already-committed text: mark them
+                 * confident and fall back to the full rollback budget. */
+                for (int i = 0; i < n_raw_tokens && i < raw_margins_cap; i++)
+                    raw_margins[i] = 1e30f;
+                cur_rollback = rollback;
                 prev_prefill_len = 0;
                 stream_clear_enc_cache(enc_cache,
                                        &n_enc_cache,
@@ -1126,13 +1511,20 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                                        &enc_cached_seq_total,
                                        &next_window_start,
                                        full_end);
-                stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max);
+                stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max, mel_stream);
                 stagnant_chunks = 0;
                 did_recovery_reset = 1;
                 if (qwen_monitor) {
                     fprintf(stderr, "!");
                     fflush(stderr);
                 }
+                qwen_trace_emit("reset",
+                                "\"reason\":\"%s\"",
+                                (tail_period > 0 &&
+                                 tail_reps >= QWEN_STREAM_DEGEN_MIN_REPEATS)
+                                    ? "degenerate"
+                                    : (dropped_repeat_tokens >= 8 ? "repeats"
+                                                                  : "stagnant"));
             } else {
                 if (candidate_len > stable_text_cap) {
                     while (candidate_len > stable_text_cap) stable_text_cap *= 2;
@@ -1151,6 +1543,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                        stable_text_tokens[lcp] == candidate_tokens[lcp]) {
                     lcp++;
                 }
+                /* Previously-stable tokens the model rewrote this chunk */
+                int rolled_back = n_stable_text_tokens > lcp
+                                      ? n_stable_text_tokens - lcp : 0;
                 for (int i = lcp; i < candidate_len; i++) {
                     stable_text_tokens[i] = candidate_tokens[i];
                 }
@@ -1275,6 +1670,11 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                 }
 
                 n_stable_text_tokens = candidate_len;
+                qwen_trace_emit("commit",
+                                "\"candidate\":%d,\"emitted\":%d,\"rollback\":%d,"
+                                "\"unfixed\":%d",
+                                candidate_len, candidate_len - emit_start,
+                                rolled_back, eff_rollback);
 
                 int periodic_reset =
                     (!is_final &&
@@ -1292,6 +1692,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                         n_raw_tokens = 0;
                         n_stable_text_tokens = 0;
                     }
+                    for (int i = 0; i < n_raw_tokens && i < raw_margins_cap; i++)
+                        raw_margins[i] = 1e30f;
+                    cur_rollback = rollback;
                     prev_prefill_len = 0;
                     stream_clear_enc_cache(enc_cache,
                                            &n_enc_cache,
@@ -1299,8 +1702,9 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
                                            &enc_cached_seq_total,
                                            &next_window_start,
                                            full_end);
-                    stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max);
+                    stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max, mel_stream);
                     did_periodic_reset = 1;
+                    qwen_trace_emit("reset", "\"reason\":\"periodic\"");
                 }
             }
         }
@@ -1314,8 +1718,8 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             } else if (did_periodic_reset) {
                 fprintf(stderr, "  Periodic reset applied\n");
             }
-            fprintf(stderr, "  Commit: candidate=%d tokens, emitted_total=%d\n",
-                    candidate_len, n_emitted_text_tokens);
+            fprintf(stderr, "  Commit: candidate=%d tokens, emitted_total=%d, unfixed=%d/%d\n",
+                    candidate_len, n_emitted_text_tokens, eff_rollback, rollback);
         }
 
         if (live && use_enc_cache) {
@@ -1338,17 +1742,61 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
             }
         }
 
+        /* Queue next chunk's partial tail for prefetch while this chunk's
+         * result is being consumed downstream. Only when its samples are
+         * already buffered locally (live audio may not have arrived yet). */
+        if (use_pipeline && !is_final) {
+            int64_t next_cursor = audio_cursor + chunk_samples;
+            if (next_cursor > audio_n_samples) next_cursor = audio_n_samples;
+            int64_t next_full_end =
+                (next_cursor / enc_window_samples) * (int64_t)enc_window_samples;
+            int64_t next_partial64 = next_cursor - next_full_end;
+            int64_t next_off64 = next_full_end - local_base_sample;
+            if (next_partial64 > 0 && next_partial64 <= INT_MAX &&
+                next_off64 >= 0 &&
+                next_off64 + next_partial64 <= local_n_samples) {
+                stream_stem_prefetch_submit(&prefetch, ctx,
+                                            audio_samples + (size_t)next_off64,
+                                            (int)next_partial64,
+                                            next_full_end, stem_mel_global_max);
+            }
+        }
+
         ctx->perf_total_ms += get_time_ms() - chunk_t0;
+        /* Feed the pool governor one throughput sample per full chunk:
+         * a live session can run for minutes, so per-chunk reports are
+         * what lets the pool adapt as the device heats up mid-session.
+         * We are between kernel dispatches here, so it is safe for the
+         * governor to resize the pool. */
+        qwen_pool_governor_report(1000.0 * (double)chunk_samples / QWEN_SAMPLE_RATE,
+                                  get_time_ms() - chunk_t0);
         chunk_idx++;
     }
 
+    if (live && ctx->skip_silence && qwen_verbose >= 1) {
+        pthread_mutex_lock(&live->mutex);
+        int64_t vad_in = live->vad_in_samples;
+        int64_t vad_drop = live->vad_dropped_samples;
+        pthread_mutex_unlock(&live->mutex);
+        if (vad_in > 0) {
+            fprintf(stderr, "Silence skip (live VAD): dropped %.1f%% (%lld of %lld samples)\n",
+                    100.0 * (double)vad_drop / (double)vad_in,
+                    (long long)vad_drop, (long long)vad_in);
+        }
+    }
+    stream_stem_prefetch_shutdown(&prefetch);
+    if (qwen_verbose >= 2 && prefetch_hits + prefetch_misses > 0) {
+        fprintf(stderr, "  Stem prefetch: %d hits, %d misses\n",
+                prefetch_hits, prefetch_misses);
+    }
     free(tmp_embed);
     for (int i = enc_cache_start; i < n_enc_cache; i++) {
         free(enc_cache[i].enc_output);
     }
     free(enc_cache);
-    stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max);
+    stream_clear_stem_cache(stem_cache, &n_stem_cached, &stem_mel_global_max, mel_stream);
     free(stem_cache);
+    qwen_mel_stream_free(mel_stream);
     if (qwen_verbose >= 2 && prefill_total_tokens > 0) {
         double reuse_pct = 100.0 * (double)prefill_reused_tokens / (double)prefill_total_tokens;
         fprintf(stderr, "  Prefill reuse: %d/%d tokens (%.1f%%)\n",
@@ -1356,6 +1804,7 @@ static char *stream_impl(qwen_ctx_t *ctx, const float *samples, int n_samples,
     }
     free(prev_prefill_embeds);
     free(raw_tokens);
+    free(raw_margins);
     free(stable_text_tokens);
     free(emitted_text_tokens);
     qwen_tokenizer_free(tokenizer);
@@ -227,14 +227,51 @@ static int map_insert(str_int_entry_t *map, int cap, char *key, int value) {
     return -1;
 }
 
-static int map_get(const str_int_entry_t *map, int cap, const char *key) {
-    if (!map || cap <= 0 || !key) return -1;
+/* Lookup by (ptr, len) substring without materializing a NUL-terminated
+ * copy (BPE symbols are spans of the mapped input string). */
+static uint64_t fnv1a_hash_n(const char *s, size_t n) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static int map_get_n(const str_int_entry_t *map, int cap, const char *s, size_t n) {
+    if (!map || cap <= 0 || !s) return -1;
     int mask = cap - 1;
-    int pos = (int)(fnv1a_hash(key) & (uint64_t)mask);
+    int pos = (int)(fnv1a_hash_n(s, n) & (uint64_t)mask);
     for (int i = 0; i < cap; i++) {
         int idx = (pos + i) & mask;
         if (!map[idx].key) return -1;
-        if (strcmp(map[idx].key, key) == 0) return map[idx].value;
+        if (strncmp(map[idx].key, s, n) == 0 && map[idx].key[n] == '\0')
+            return map[idx].value;
+    }
+    return -1;
+}
+
+/* Lookup the merge rank of the pair "a b" without building the key string. */
+static int map_get_pair(const str_int_entry_t *map, int cap,
+                        const char *a, size_t la, const char *b, size_t lb) {
+    if (!map || cap <= 0) return -1;
+    uint64_t h = fnv1a_hash_n(a, la);
+    h ^= (unsigned char)' ';
+    h *= 1099511628211ULL;
+    for (size_t i = 0; i < lb; i++) {
+        h ^= (unsigned char)b[i];
+        h *= 1099511628211ULL;
+    }
+    int mask = cap - 1;
+    int pos = (int)(h & (uint64_t)mask);
+    for (int i = 0; i < cap; i++) {
+        int idx = (pos + i) & mask;
+        const char *k = map[idx].key;
+        if (!k) return -1;
+        if (strlen(k) == la + 1 + lb &&
+            memcmp(k, a, la) == 0 && k[la] == ' ' &&
+            memcmp(k + la + 1, b, lb) == 0)
+            return map[idx].value;
     }
     return -1;
 }
@@ -251,68 +288,6 @@ static int utf8_char_len(unsigned char c) {
     return 1;
 }
 
-static int split_utf8_symbols(const char *s, char ***out_syms, int *out_n) {
-    *out_syms = NULL;
-    *out_n = 0;
-    if (!s || !*s) return 0;
-
-    int n = 0;
-    for (const unsigned char *p = (const unsigned char *)s; *p; ) {
-        int l = utf8_char_len(*p);
-        p += l;
-        n++;
-    }
-    if (n <= 0) return 0;
-
-    char **syms = (char **)calloc((size_t)n, sizeof(char *));
-    if (!syms) return -1;
-
-    int i = 0;
-    for (const unsigned char *p = (const unsigned char *)s; *p; ) {
-        int l = utf8_char_len(*p);
-        syms[i] = (char *)malloc((size_t)l + 1);
-        if (!syms[i]) {
-            for (int j = 0; j < i; j++) free(syms[j]);
-            free(syms);
-            return -1;
-        }
-        memcpy(syms[i], p, (size_t)l);
-        syms[i][l] = '\0';
-        p += l;
-        i++;
-    }
-
-    *out_syms = syms;
-    *out_n = n;
-    return 0;
-}
-
-static char *str_concat2(const char *a, const char *b) {
-    size_t la = strlen(a), lb = strlen(b);
-    char *r = (char *)malloc(la + lb + 1);
-    if (!r) return NULL;
-    memcpy(r, a, la);
-    memcpy(r + la, b, lb);
-    r[la + lb] = '\0';
-    return r;
-}
-
-static int merge_rank(const qwen_tokenizer_t *tok, const char *a, const char *b) {
-    if (!tok->merge_map || tok->merge_map_cap <= 0) return INT_MAX;
-
-    size_t la = strlen(a), lb = strlen(b);
-    char *pair = (char *)malloc(la + 1 + lb + 1);
-    if (!pair) return INT_MAX;
-    memcpy(pair, a, la);
-    pair[la] = ' ';
-    memcpy(pair + la + 1, b, lb);
-    pair[la + 1 + lb] = '\0';
-
-    int rank = map_get((const str_int_entry_t *)tok->merge_map, tok->merge_map_cap, pair);
-    free(pair);
-    return rank >= 0 ? rank : INT_MAX;
-}
-
 static int append_id(int **arr, int *n, int *cap, int id) {
     if (*n >= *cap) {
         int new_cap = (*cap == 0) ? 16 : (*cap * 2);
@@ -344,65 +319,101 @@ static char *text_to_bpe_unicode(const char *text) {
     return out;
 }
 
+/* One live BPE symbol: a contiguous span of the mapped input string.
+ * Merging two adjacent symbols just widens the left span, so the merge
+ * loop never copies or allocates symbol text. */
+typedef struct {
+    int start;          /* byte offset into mapped */
+    int len;            /* span length in bytes */
+    int prev, next;     /* doubly linked list of live symbols (-1 = end) */
+    int rank;           /* merge rank of (this, next), INT_MAX = no merge */
+} bpe_sym_t;
+
 /* Encode one mapped BPE unicode string to token IDs. */
 static int encode_bpe_word(const qwen_tokenizer_t *tok, const char *mapped, int **out_ids, int *out_n) {
     *out_ids = NULL;
     *out_n = 0;
     if (!mapped || !*mapped) return 0;
 
-    char **syms = NULL;
+    const str_int_entry_t *merges = (const str_int_entry_t *)tok->merge_map;
+    int merges_cap = tok->merge_map_cap;
+
+    /* Split into UTF-8 symbols as spans of 'mapped'. */
     int n_syms = 0;
-    if (split_utf8_symbols(mapped, &syms, &n_syms) != 0) return -1;
-    if (n_syms <= 0) {
-        free(syms);
-        return 0;
+    for (const unsigned char *p = (const unsigned char *)mapped; *p; ) {
+        p += utf8_char_len(*p);
+        n_syms++;
     }
+    if (n_syms <= 0) return 0;
 
-    while (n_syms > 1) {
+    bpe_sym_t *syms = (bpe_sym_t *)malloc((size_t)n_syms * sizeof(bpe_sym_t));
+    if (!syms) return -1;
+
+    int off = 0;
+    for (int i = 0; i < n_syms; i++) {
+        int l = utf8_char_len((unsigned char)mapped[off]);
+        syms[i].start = off;
+        syms[i].len = l;
+        syms[i].prev = i - 1;
+        syms[i].next = (i + 1 < n_syms) ? i + 1 : -1;
+        syms[i].rank = INT_MAX;
+        off += l;
+    }
+
+#define PAIR_RANK(i) do {                                                      \
+    int nx__ = syms[i].next;                                                    \
+    if (nx__ < 0) { syms[i].rank = INT_MAX; break; }                            \
+    int r__ = map_get_pair(merges, merges_cap,                                  \
+                           mapped + syms[i].start, (size_t)syms[i].len,         \
+                           mapped + syms[nx__].start, (size_t)syms[nx__].len);  \
+    syms[i].rank = (r__ >= 0) ? r__ : INT_MAX;                                  \
+} while (0)
+
+    for (int i = 0; i < n_syms; i++) PAIR_RANK(i);
+
+    /* Repeatedly merge the lowest-rank adjacent pair. Only the merged
+     * symbol's and its left neighbor's pair ranks can change, so each
+     * iteration is one O(live) scan of int ranks plus two rank lookups. */
+    int head = 0;
+    for (;;) {
+        int best = -1;
         int best_rank = INT_MAX;
-        int best_i = -1;
-        for (int i = 0; i < n_syms - 1; i++) {
-            int r = merge_rank(tok, syms[i], syms[i + 1]);
-            if (r < best_rank) {
-                best_rank = r;
-                best_i = i;
+        for (int i = head; i >= 0; i = syms[i].next) {
+            if (syms[i].rank < best_rank) {
+                best_rank = syms[i].rank;
+                best = i;
             }
         }
-        if (best_i < 0 || best_rank == INT_MAX) break;
+        if (best < 0) break;
 
-        char *merged = str_concat2(syms[best_i], syms[best_i + 1]);
-        if (!merged) {
-            for (int i = 0; i < n_syms; i++) free(syms[i]);
-            free(syms);
-            return -1;
-        }
-        free(syms[best_i]);
-        free(syms[best_i + 1]);
-        syms[best_i] = merged;
-        for (int j = best_i + 1; j < n_syms - 1; j++) syms[j] = syms[j + 1];
-        n_syms--;
+        int right = syms[best].next;
+        syms[best].len += syms[right].len;
+        syms[best].next = syms[right].next;
+        if (syms[right].next >= 0) syms[syms[right].next].prev = best;
+
+        PAIR_RANK(best);
+        if (syms[best].prev >= 0) PAIR_RANK(syms[best].prev);
     }
 
+#undef PAIR_RANK
+
     int *ids = NULL;
     int n_ids = 0, cap = 0;
-    for (int i = 0; i < n_syms; i++) {
-        int id = map_get((const str_int_entry_t *)tok->vocab_map, tok->vocab_map_cap, syms[i]);
+    for (int i = head; i >= 0; i = syms[i].next) {
+        int id = map_get_n((const str_int_entry_t *)tok->vocab_map, tok->vocab_map_cap,
+                           mapped + syms[i].start, (size_t)syms[i].len);
         if (id < 0) {
             /* Should not happen with valid vocab + merges + byte-level mapping. */
-            for (int k = 0; k < n_syms; k++) free(syms[k]);
             free(syms);
             free(ids);
             return -1;
         }
         if (append_id(&ids, &n_ids, &cap, id) != 0) {
-            for (int k = 0; k < n_syms; k++) free(syms[k]);
             free(syms);
             free(ids);
             return -1;
         }
     }
-
-    for (int i = 0; i < n_syms; i++) free(syms[i]);
     free(syms);
 
     *out_ids = ids;
@@ -0,0 +1,82 @@
+/*
+ * qwen_asr_trace.c - Structured streaming-pipeline trace
+ *
+ * JSONL events are built into a stack buffer and written with a single
+ * fputs per event (stderr is unbuffered, so concurrent emitters — the
+ * stream loop and the stem prefetch worker — produce whole lines, and the
+ * JNI stderr redirect forwards each as one logcat line). Timestamps are
+ * CLOCK_MONOTONIC ms relative to the first event, which is what perfetto
+ * and per-device log diffs want.
+ */
+
+#include "qwen_asr_trace.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__ANDROID__) && __ANDROID_API__ >= 23
+#include <android/trace.h>
+#define QWEN_TRACE_HAVE_ATRACE 1
+#endif
+
+static int g_trace_mode = 0;
+
+static pthread_once_t g_base_once = PTHREAD_ONCE_INIT;
+static uint64_t g_base_ns = 0;
+
+static uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void trace_init_base(void) {
+    g_base_ns = trace_now_ns();
+}
+
+void qwen_trace_set(int mode) {
+    g_trace_mode = mode;
+}
+
+int qwen_trace_mode(void) {
+    return g_trace_mode;
+}
+
+void qwen_trace_emit(const char *ev, const char *extra_fmt, ...) {
+    if (!(g_trace_mode & QWEN_TRACE_JSONL)) return;
+
+    pthread_once(&g_base_once, trace_init_base);
+    double t_ms = (double)(trace_now_ns() - g_base_ns) / 1e6;
+
+    char line[512];
+    int n = snprintf(line, sizeof(line), "{\"t_ms\":%.3f,\"ev\":\"%s\"", t_ms, ev);
+    if (extra_fmt && n > 0 && n < (int)sizeof(line) - 3) {
+        line[n++] = ',';
+        int avail = (int)sizeof(line) - n - 3;  /* room left before "}\n\0" */
+        va_list ap;
+        va_start(ap, extra_fmt);
+        int m = vsnprintf(line + n, (size_t)avail + 1, extra_fmt, ap);
+        va_end(ap);
+        if (m > 0) n += (m <= avail) ? m : avail;
+    }
+    line[n++] = '}';
+    line[n++] = '\n';
+    line[n] = '\0';
+    fputs(line, stderr);
+}
+
+void qwen_trace_begin(const char *section) {
+#ifdef QWEN_TRACE_HAVE_ATRACE
+    if (g_trace_mode & QWEN_TRACE_ATRACE) ATrace_beginSection(section);
+#else
+    (void)section;
+#endif
+}
+
+void qwen_trace_end(void) {
+#ifdef QWEN_TRACE_HAVE_ATRACE
+    if (g_trace_mode & QWEN_TRACE_ATRACE) ATrace_endSection();
+#endif
+}
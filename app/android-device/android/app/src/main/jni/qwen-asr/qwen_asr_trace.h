@@ -0,0 +1,33 @@
+/*
+ * qwen_asr_trace.h - Structured streaming-pipeline trace
+ *
+ * Machine-readable companion to the qwen_monitor glyphs: each pipeline
+ * phase (mel, stem, encoder, prefill, per-token decode, eviction, reset)
+ * emits a timestamped JSONL line on stderr and/or an ATrace section, so
+ * fleet logs and perfetto captures can answer "which phase regressed"
+ * without reproducing locally. Off by default; toggled at runtime (the
+ * JNI layer exposes nativeSetTraceMode).
+ */
+
+#ifndef QWEN_ASR_TRACE_H
+#define QWEN_ASR_TRACE_H
+
+/* Mode bitmask */
+#define QWEN_TRACE_JSONL  1  /* {"t_ms":..,"ev":"..",..} lines on stderr */
+#define QWEN_TRACE_ATRACE 2  /* ATrace begin/end sections (Android only) */
+
+void qwen_trace_set(int mode);
+int qwen_trace_mode(void);
+
+/* Emit one JSONL event. extra_fmt is NULL or a printf format producing
+ * additional JSON members, e.g. "\"tokens\":%d,\"ms\":%.1f". No-op unless
+ * QWEN_TRACE_JSONL is set. */
+void qwen_trace_emit(const char *ev, const char *extra_fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/* Bracket a pipeline phase as an ATrace section (nestable). No-op unless
+ * QWEN_TRACE_ATRACE is set and the platform has ATrace. */
+void qwen_trace_begin(const char *section);
+void qwen_trace_end(void);
+
+#endif /* QWEN_ASR_TRACE_H */
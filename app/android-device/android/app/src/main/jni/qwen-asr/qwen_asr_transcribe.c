@@ -188,80 +188,49 @@ static int find_split_point(const float *samples, int n_samples,
     return best_center;
 }
 
+/* Upper bound on tokens drafted per speculative verify step */
+#define QWEN_SPEC_MAX_DRAFT 8
+
 /*
- * Transcribe a single audio segment. Returns malloc'd text or NULL.
- * The tokenizer is passed in so we only load it once.
+ * Build the full decoder input embedding sequence for one segment:
+ * prompt prefix + audio + suffix + optional past-text conditioning.
+ * Token ids (system prompt, forced language, past text) come from ctx;
+ * the embedding table and hidden size come from 'model' so a draft model
+ * can embed the exact same token sequence. enc_output must be
+ * [enc_seq_len, model dec_hidden] and is copied, not consumed.
+ * Returns malloc'd [*out_total_seq, dec_hidden] or NULL.
  */
-char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
-                                int n_samples, qwen_tokenizer_t *tokenizer,
-                                const int *past_tokens, int n_past_tokens,
-                                int *out_text_tokens) {
-    const qwen_config_t *cfg = &ctx->config;
-    int dim = cfg->dec_hidden;
-    double seg_t0 = get_time_ms();
-    int n_text_tokens = 0;
-
-    /* ---- Mel spectrogram ---- */
-    double t0 = get_time_ms();
-    int mel_frames = 0;
-    float *mel = qwen_mel_spectrogram(samples, n_samples, &mel_frames, NULL);
-    if (!mel) return NULL;
-    double mel_ms = get_time_ms() - t0;
-
-    if (qwen_verbose >= 2)
-        fprintf(stderr, "  Mel: %d frames (%.0f ms)\n", mel_frames, mel_ms);
-
-    /* ---- Encoder ---- */
-    t0 = get_time_ms();
-    int enc_seq_len = 0;
-    float *enc_output = qwen_encoder_forward(ctx, mel, mel_frames, &enc_seq_len);
-    free(mel);
-    if (!enc_output) return NULL;
-    double enc_ms = get_time_ms() - t0;
-
-    if (qwen_verbose >= 2)
-        fprintf(stderr, "  Encoder: %d tokens (%.0f ms)\n", enc_seq_len, enc_ms);
-
-    if (prepare_prompt_tokens(ctx, tokenizer) != 0) {
-        free(enc_output);
-        return NULL;
-    }
-
-    /* ---- Build input embeddings ---- */
+static float *build_segment_embeds(qwen_ctx_t *ctx, qwen_ctx_t *model,
+                                   const float *enc_output, int enc_seq_len,
+                                   const int *past_tokens, int n_past_tokens,
+                                   int *out_total_seq) {
+    int dim = model->config.dec_hidden;
+    const uint16_t *emb = model->decoder.tok_embeddings_bf16;
     int prefix_len = PREFIX_HEAD_LEN + ctx->n_prompt_tokens + PREFIX_TAIL_LEN;
     int suffix_len = SUFFIX_BASE_LEN + ctx->n_force_prompt_tokens;
     int n_past_prompt_tokens = (n_past_tokens > 0) ? (n_past_tokens + 1) : 0; /* + <asr_text> */
     int total_seq = prefix_len + enc_seq_len + suffix_len + n_past_prompt_tokens;
     float *input_embeds = (float *)malloc((size_t)total_seq * dim * sizeof(float));
-    float *tmp_embed = (float *)malloc(dim * sizeof(float));
-    if (!input_embeds || !tmp_embed) {
-        free(enc_output);
-        free(input_embeds);
-        free(tmp_embed);
-        return NULL;
-    }
+    if (!input_embeds) return NULL;
 
     /* Embed prefix head: <|im_start|>system\n */
     int off = 0;
     for (int i = 0; i < PREFIX_HEAD_LEN; i++) {
-        tok_embed_bf16_to_f32(input_embeds + off * dim,
-                              ctx->decoder.tok_embeddings_bf16,
+        tok_embed_bf16_to_f32(input_embeds + off * dim, emb,
                               PROMPT_PREFIX_HEAD[i], dim);
         off++;
     }
 
     /* Embed optional prompt text (system content) */
     for (int i = 0; i < ctx->n_prompt_tokens; i++) {
-        tok_embed_bf16_to_f32(input_embeds + off * dim,
-                              ctx->decoder.tok_embeddings_bf16,
+        tok_embed_bf16_to_f32(input_embeds + off * dim, emb,
                               ctx->prompt_tokens[i], dim);
         off++;
     }
 
     /* Embed prefix tail: <|im_end|>\n<|im_start|>user\n<|audio_start|> */
     for (int i = 0; i < PREFIX_TAIL_LEN; i++) {
-        tok_embed_bf16_to_f32(input_embeds + off * dim,
-                              ctx->decoder.tok_embeddings_bf16,
+        tok_embed_bf16_to_f32(input_embeds + off * dim, emb,
                               PROMPT_PREFIX_TAIL[i], dim);
         off++;
     }
@@ -272,21 +241,18 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
                enc_output + i * dim,
                dim * sizeof(float));
     }
-    free(enc_output);
 
     /* Embed suffix base: <|audio_end|><|im_end|>\n<|im_start|>assistant\n */
     int suffix_off = prefix_len + enc_seq_len;
     for (int i = 0; i < SUFFIX_BASE_LEN; i++) {
-        tok_embed_bf16_to_f32(input_embeds + (suffix_off + i) * dim,
-                              ctx->decoder.tok_embeddings_bf16,
+        tok_embed_bf16_to_f32(input_embeds + (suffix_off + i) * dim, emb,
                               PROMPT_SUFFIX_BASE[i], dim);
     }
 
     /* Optional forced-language suffix: "language X" + <asr_text> */
     for (int i = 0; i < ctx->n_force_prompt_tokens; i++) {
         tok_embed_bf16_to_f32(input_embeds + (suffix_off + SUFFIX_BASE_LEN + i) * dim,
-                              ctx->decoder.tok_embeddings_bf16,
-                              ctx->force_prompt_tokens[i], dim);
+                              emb, ctx->force_prompt_tokens[i], dim);
     }
 
     /* Optional past-text conditioning tokens (for segmented mode).
@@ -294,21 +260,133 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
      * restarts from a new ASR span instead of terminating immediately. */
     int past_off = suffix_off + suffix_len;
     for (int i = 0; i < n_past_tokens; i++) {
-        tok_embed_bf16_to_f32(input_embeds + (past_off + i) * dim,
-                              ctx->decoder.tok_embeddings_bf16,
+        tok_embed_bf16_to_f32(input_embeds + (past_off + i) * dim, emb,
                               past_tokens[i], dim);
     }
     if (n_past_tokens > 0) {
         tok_embed_bf16_to_f32(input_embeds + (past_off + n_past_tokens) * dim,
-                              ctx->decoder.tok_embeddings_bf16,
-                              QWEN_TOKEN_ASR_TEXT, dim);
+                              emb, QWEN_TOKEN_ASR_TEXT, dim);
     }
 
+    *out_total_seq = total_seq;
+    return input_embeds;
+}
+
+/*
+ * Transcribe a single audio segment. Returns malloc'd text or NULL.
+ * The tokenizer is passed in so we only load it once.
+ */
+char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
+                                int n_samples, qwen_tokenizer_t *tokenizer,
+                                const int *past_tokens, int n_past_tokens,
+                                int *out_text_tokens) {
+    const qwen_config_t *cfg = &ctx->config;
+    int dim = cfg->dec_hidden;
+    double seg_t0 = get_time_ms();
+    int n_text_tokens = 0;
+
+    /* ---- Mel spectrogram ---- */
+    double t0 = get_time_ms();
+    int mel_frames = 0;
+    float *mel = qwen_mel_spectrogram(samples, n_samples, &mel_frames, NULL);
+    if (!mel) return NULL;
+    double mel_ms = get_time_ms() - t0;
+
+    if (qwen_verbose >= 2)
+        fprintf(stderr, "  Mel: %d frames (%.0f ms)\n", mel_frames, mel_ms);
+
+    /* ---- Encoder ---- */
+    t0 = get_time_ms();
+    int enc_seq_len = 0;
+    float *enc_output = qwen_encoder_forward(ctx, mel, mel_frames, &enc_seq_len);
+    if (!enc_output) {
+        free(mel);
+        return NULL;
+    }
+    double enc_ms = get_time_ms() - t0;
+
+    if (qwen_verbose >= 2)
+        fprintf(stderr, "  Encoder: %d tokens (%.0f ms)\n", enc_seq_len, enc_ms);
+
+    if (prepare_prompt_tokens(ctx, tokenizer) != 0) {
+        free(mel);
+        free(enc_output);
+        return NULL;
+    }
+
+    /* ---- Build input embeddings ---- */
+    int prompt_prefix_len = PREFIX_HEAD_LEN + ctx->n_prompt_tokens + PREFIX_TAIL_LEN;
+    int total_seq = 0;
+    float *input_embeds = build_segment_embeds(ctx, ctx, enc_output, enc_seq_len,
+                                               past_tokens, n_past_tokens, &total_seq);
+    free(enc_output);
+    float *tmp_embed = (float *)malloc(dim * sizeof(float));
+    if (!input_embeds || !tmp_embed) {
+        free(mel);
+        free(input_embeds);
+        free(tmp_embed);
+        return NULL;
+    }
+
+    /* ---- Optional draft model (speculative decoding) ----
+     * Run the draft's own encoder on the same mel and mirror the prompt so
+     * its KV cache covers the identical token sequence. If anything about
+     * the draft setup fails, fall back to plain decode for this segment. */
+    qwen_ctx_t *draft = ctx->draft_ctx;
+    int spec_active = 0;
+    int draft_dim = 0;
+    float *draft_embed = NULL;
+    if (draft) {
+        draft_dim = draft->config.dec_hidden;
+        int draft_enc_len = 0;
+        float *draft_enc = qwen_encoder_forward(draft, mel, mel_frames, &draft_enc_len);
+        float *draft_embeds = NULL;
+        int draft_total = 0;
+        if (draft_enc && draft_enc_len == enc_seq_len) {
+            draft_embeds = build_segment_embeds(ctx, draft, draft_enc, enc_seq_len,
+                                                past_tokens, n_past_tokens,
+                                                &draft_total);
+        }
+        free(draft_enc);
+        if (draft_embeds)
+            draft_embed = (float *)malloc(draft_dim * sizeof(float));
+        if (draft_embeds && draft_embed) {
+            draft->kv_cache_len = 0;
+            draft->kv_pos_offset = 0;
+            /* The draft shares the main context's prompt tokens, so its
+             * prefix snapshot has the same length. */
+            int draft_reused = qwen_decoder_restore_prefix(draft, prompt_prefix_len);
+            qwen_decoder_prefill(draft,
+                                 draft_embeds + (size_t)draft_reused * draft_dim,
+                                 draft_total - 1 - draft_reused);
+            if (draft_reused == 0)
+                qwen_decoder_snapshot_prefix(draft, prompt_prefix_len);
+            /* Consume the last prompt embed so the draft KV length matches
+             * the main model after its first token; the draft's own first
+             * prediction is discarded (drafting restarts from verified
+             * tokens). */
+            (void)qwen_decoder_forward(draft,
+                    draft_embeds + (size_t)(draft_total - 1) * draft_dim);
+            spec_active = 1;
+        }
+        free(draft_embeds);
+        if (!spec_active) {
+            free(draft_embed);
+            draft_embed = NULL;
+        }
+    }
+    free(mel);
+
     /* ---- Decoder prefill ---- */
     t0 = get_time_ms();
     ctx->kv_cache_len = 0; /* Reset KV cache for this segment */
+    ctx->kv_pos_offset = 0;
     int prefill_len = total_seq - 1; /* prefill all but last */
-    qwen_decoder_prefill(ctx, input_embeds, prefill_len);
+    int reused = qwen_decoder_restore_prefix(ctx, prompt_prefix_len);
+    qwen_decoder_prefill(ctx, input_embeds + (size_t)reused * dim,
+                         prefill_len - reused);
+    if (reused == 0)
+        qwen_decoder_snapshot_prefix(ctx, prompt_prefix_len);
 
     /* First token from last prefill position */
     float *last_embed = input_embeds + (size_t)prefill_len * dim;
@@ -326,6 +404,19 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
     /* If language is forced, <asr_text> is already part of prompt suffix. */
     int past_asr_text = (ctx->n_force_prompt_tokens > 0 || n_past_tokens > 0) ? 1 : 0;
 
+    int spec_k = ctx->spec_n_draft;
+    if (spec_k < 1) spec_k = 1;
+    if (spec_k > QWEN_SPEC_MAX_DRAFT) spec_k = QWEN_SPEC_MAX_DRAFT;
+    float *verify_embeds = NULL;
+    if (spec_active) {
+        verify_embeds = (float *)malloc((size_t)(spec_k + 1) * dim * sizeof(float));
+        if (!verify_embeds) spec_active = 0;
+    }
+    /* Tokens verified this step but not yet emitted */
+    int pending[QWEN_SPEC_MAX_DRAFT + 1];
+    int n_pending = 0, pending_i = 0;
+    int seg_spec_drafted = 0, seg_spec_accepted = 0;
+
     size_t text_cap = 4096;
     size_t text_len = 0;
     char *text = (char *)malloc(text_cap);
@@ -358,6 +449,71 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
                 ctx->token_cb(piece, ctx->token_cb_userdata);
         }
 
+        /* Emit remaining verified tokens before decoding any further */
+        if (pending_i < n_pending) {
+            token = pending[pending_i++];
+            continue;
+        }
+
+        if (spec_active) {
+            /* Draft spec_k tokens on the small model, then verify them plus
+             * one bonus position in a single batched pass on the main model.
+             * Greedy decoding makes the comparison exact: every accepted
+             * draft is the token the main model would have produced. */
+            int d[QWEN_SPEC_MAX_DRAFT];
+            int g[QWEN_SPEC_MAX_DRAFT + 1];
+            int base_len = ctx->kv_cache_len; /* == draft->kv_cache_len */
+            int t = token;
+            for (int i = 0; i < spec_k; i++) {
+                tok_embed_bf16_to_f32(draft_embed, draft->decoder.tok_embeddings_bf16,
+                                      t, draft_dim);
+                t = qwen_decoder_forward(draft, draft_embed);
+                d[i] = t;
+            }
+
+            /* Verify sequence: current token followed by the drafts */
+            tok_embed_bf16_to_f32(verify_embeds, ctx->decoder.tok_embeddings_bf16,
+                                  token, dim);
+            for (int i = 0; i < spec_k; i++)
+                tok_embed_bf16_to_f32(verify_embeds + (size_t)(i + 1) * dim,
+                                      ctx->decoder.tok_embeddings_bf16, d[i], dim);
+            if (qwen_decoder_prefill_argmax(ctx, verify_embeds, spec_k + 1, g) != 0) {
+                /* Verify pass failed to allocate: drop back to plain decode */
+                draft->kv_cache_len = base_len;
+                spec_active = 0;
+                tok_embed_bf16_to_f32(tmp_embed, ctx->decoder.tok_embeddings_bf16,
+                                      token, dim);
+                token = qwen_decoder_forward(ctx, tmp_embed);
+                continue;
+            }
+
+            int m = 0;
+            while (m < spec_k && d[m] == g[m]) m++;
+            seg_spec_drafted += spec_k;
+            seg_spec_accepted += m;
+
+            /* Keep only the verified prefix in both KV caches */
+            ctx->kv_cache_len = base_len + m + 1;
+            if (m == spec_k) {
+                /* All drafts accepted: g[spec_k] is a free extra token.
+                 * Advance the draft over the last accepted token so both
+                 * caches stay aligned. */
+                tok_embed_bf16_to_f32(draft_embed, draft->decoder.tok_embeddings_bf16,
+                                      d[spec_k - 1], draft_dim);
+                (void)qwen_decoder_forward(draft, draft_embed);
+            } else {
+                draft->kv_cache_len = base_len + m + 1;
+            }
+
+            /* Queue accepted drafts, then the main model's next token */
+            n_pending = 0;
+            pending_i = 0;
+            for (int i = 0; i < m; i++) pending[n_pending++] = d[i];
+            pending[n_pending++] = (m == spec_k) ? g[spec_k] : g[m];
+            token = pending[pending_i++];
+            continue;
+        }
+
         /* Embed and generate next token */
         tok_embed_bf16_to_f32(tmp_embed, ctx->decoder.tok_embeddings_bf16, token, dim);
         token = qwen_decoder_forward(ctx, tmp_embed);
@@ -368,8 +524,14 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
         fprintf(stderr, "  Decode: %d tokens (%.0f ms, %.1f ms/token)\n",
                 n_generated, decode_ms,
                 n_generated > 0 ? decode_ms / n_generated : 0);
+    if (qwen_verbose >= 2 && seg_spec_drafted > 0)
+        fprintf(stderr, "  Spec: accepted %d/%d drafts (%.0f%%)\n",
+                seg_spec_accepted, seg_spec_drafted,
+                100.0f * (float)seg_spec_accepted / (float)seg_spec_drafted);
 
     free(tmp_embed);
+    free(verify_embeds);
+    free(draft_embed);
 
     /* Trim whitespace */
     size_t rlen = strlen(text);
@@ -382,6 +544,8 @@ char *transcribe_segment(qwen_ctx_t *ctx, const float *samples,
     ctx->perf_text_tokens += n_text_tokens;
     ctx->perf_encode_ms += mel_ms + enc_ms;
     ctx->perf_decode_ms += prefill_ms + decode_ms;
+    ctx->perf_spec_drafted += seg_spec_drafted;
+    ctx->perf_spec_accepted += seg_spec_accepted;
     if (out_text_tokens) *out_text_tokens = n_text_tokens;
 
     return text;
@@ -449,6 +613,8 @@ char *qwen_transcribe_audio(qwen_ctx_t *ctx, const float *samples, int n_samples
     ctx->perf_audio_ms = 1000.0 * (double)n_samples / (double)QWEN_SAMPLE_RATE;
     ctx->perf_encode_ms = 0;
     ctx->perf_decode_ms = 0;
+    ctx->perf_spec_drafted = 0;
+    ctx->perf_spec_accepted = 0;
 
     const float *audio_samples = samples;
     int audio_n_samples = n_samples;
@@ -497,6 +663,7 @@ char *qwen_transcribe_audio(qwen_ctx_t *ctx, const float *samples, int n_samples
         char *text = transcribe_segment(ctx, audio_samples, audio_n_samples, tokenizer, NULL, 0, NULL);
         qwen_tokenizer_free(tokenizer);
         free(compacted_samples);
+        qwen_pool_governor_report(ctx->perf_audio_ms, ctx->perf_total_ms);
         return text;
     }
 
@@ -654,5 +821,188 @@ char *qwen_transcribe_audio(qwen_ctx_t *ctx, const float *samples, int n_samples
     ctx->token_cb_userdata = saved_cb_userdata;
     qwen_tokenizer_free(tokenizer);
     free(compacted_samples);
+    qwen_pool_governor_report(ctx->perf_audio_ms, ctx->perf_total_ms);
     return result;
 }
+
+/* ========================================================================
+ * Batched multi-clip transcription (weight-sharing sessions)
+ * ======================================================================== */
+
+/* Append a decoded piece to a growing text buffer */
+static void append_piece(char **text, size_t *len, size_t *cap, const char *piece) {
+    size_t piece_len = strlen(piece);
+    if (*len + piece_len + 1 > *cap) {
+        while (*len + piece_len + 1 > *cap) *cap *= 2;
+        *text = (char *)realloc(*text, *cap);
+    }
+    memcpy(*text + *len, piece, piece_len);
+    *len += piece_len;
+    (*text)[*len] = '\0';
+}
+
+int qwen_transcribe_audio_batch(qwen_ctx_t **sessions, int n,
+                                const float **samples, const int *n_samples,
+                                char **out_texts) {
+    if (n <= 0 || !sessions || !samples || !n_samples || !out_texts) return -1;
+    for (int i = 0; i < n; i++) out_texts[i] = NULL;
+    if (n == 1) {
+        out_texts[0] = qwen_transcribe_audio(sessions[0], samples[0], n_samples[0]);
+        return out_texts[0] ? 0 : -1;
+    }
+
+    double t0 = get_time_ms();
+    int dim = sessions[0]->config.dec_hidden;
+
+    /* All sessions share one weight set, so one tokenizer serves them all */
+    char vocab_path[1024];
+    snprintf(vocab_path, sizeof(vocab_path), "%s/vocab.json", sessions[0]->model_dir);
+    qwen_tokenizer_t *tokenizer = qwen_tokenizer_load(vocab_path);
+    if (!tokenizer) return -1;
+
+    int *token = (int *)calloc((size_t)n, sizeof(int));
+    int *next = (int *)calloc((size_t)n, sizeof(int));
+    int *step_idx = (int *)calloc((size_t)n, sizeof(int));
+    int *gen = (int *)calloc((size_t)n, sizeof(int));
+    int *past_asr = (int *)calloc((size_t)n, sizeof(int));
+    int *n_text = (int *)calloc((size_t)n, sizeof(int));
+    unsigned char *active = (unsigned char *)calloc((size_t)n, 1);
+    char **text = (char **)calloc((size_t)n, sizeof(char *));
+    size_t *text_len = (size_t *)calloc((size_t)n, sizeof(size_t));
+    size_t *text_cap = (size_t *)calloc((size_t)n, sizeof(size_t));
+    qwen_ctx_t **step_sess = (qwen_ctx_t **)calloc((size_t)n, sizeof(qwen_ctx_t *));
+    float *step_embeds = (float *)malloc((size_t)n * dim * sizeof(float));
+    if (!token || !next || !step_idx || !gen || !past_asr || !n_text ||
+        !active || !text || !text_len || !text_cap || !step_sess || !step_embeds) {
+        goto fail;
+    }
+
+    /* ---- Phase 1: per-clip encode + prefill ----
+     * Prefill GEMMs are already batched within a clip, so only the decode
+     * loop below is interleaved. Each clip runs as a single segment. */
+    for (int i = 0; i < n; i++) {
+        qwen_ctx_t *s = sessions[i];
+        s->perf_total_ms = 0;
+        s->perf_text_tokens = 0;
+        s->perf_audio_ms = 1000.0 * (double)n_samples[i] / (double)QWEN_SAMPLE_RATE;
+        s->perf_encode_ms = 0;
+        s->perf_decode_ms = 0;
+        s->perf_spec_drafted = 0;
+        s->perf_spec_accepted = 0;
+
+        double clip_t0 = get_time_ms();
+        int mel_frames = 0;
+        float *mel = qwen_mel_spectrogram(samples[i], n_samples[i], &mel_frames, NULL);
+        if (!mel) continue;
+        int enc_seq_len = 0;
+        float *enc_output = qwen_encoder_forward(s, mel, mel_frames, &enc_seq_len);
+        free(mel);
+        if (!enc_output) continue;
+        s->perf_encode_ms = get_time_ms() - clip_t0;
+
+        if (prepare_prompt_tokens(s, tokenizer) != 0) {
+            free(enc_output);
+            continue;
+        }
+        int total_seq = 0;
+        float *input_embeds = build_segment_embeds(s, s, enc_output, enc_seq_len,
+                                                   NULL, 0, &total_seq);
+        free(enc_output);
+        if (!input_embeds) continue;
+
+        double pf_t0 = get_time_ms();
+        s->kv_cache_len = 0;
+        s->kv_pos_offset = 0;
+        int s_prefix_len = PREFIX_HEAD_LEN + s->n_prompt_tokens + PREFIX_TAIL_LEN;
+        int s_reused = qwen_decoder_restore_prefix(s, s_prefix_len);
+        qwen_decoder_prefill(s, input_embeds + (size_t)s_reused * dim,
+                             total_seq - 1 - s_reused);
+        if (s_reused == 0)
+            qwen_decoder_snapshot_prefix(s, s_prefix_len);
+        token[i] = qwen_decoder_forward(s, input_embeds + (size_t)(total_seq - 1) * dim);
+        free(input_embeds);
+        s->perf_decode_ms = get_time_ms() - pf_t0;
+
+        text_cap[i] = 4096;
+        text[i] = (char *)malloc(text_cap[i]);
+        if (!text[i]) continue;
+        text[i][0] = '\0';
+        past_asr[i] = (s->n_force_prompt_tokens > 0) ? 1 : 0;
+        active[i] = 1;
+    }
+
+    /* ---- Phase 2: interleaved decode ----
+     * Per step: emit/check each active clip's token, then advance all of
+     * them with one batched forward so weight traffic is shared. */
+    {
+        double dec_t0 = get_time_ms();
+        int max_tokens = 2048;
+        for (;;) {
+            int nb = 0;
+            for (int i = 0; i < n; i++) {
+                if (!active[i]) continue;
+                gen[i]++;
+                if (gen[i] > max_tokens ||
+                    token[i] == QWEN_TOKEN_ENDOFTEXT || token[i] == QWEN_TOKEN_IM_END) {
+                    active[i] = 0;
+                    continue;
+                }
+                if (token[i] == QWEN_TOKEN_ASR_TEXT) {
+                    past_asr[i] = 1;
+                } else if (past_asr[i]) {
+                    const char *piece = qwen_tokenizer_decode(tokenizer, token[i]);
+                    append_piece(&text[i], &text_len[i], &text_cap[i], piece);
+                    n_text[i]++;
+                    if (sessions[i]->token_cb)
+                        sessions[i]->token_cb(piece, sessions[i]->token_cb_userdata);
+                }
+                step_idx[nb] = i;
+                step_sess[nb] = sessions[i];
+                tok_embed_bf16_to_f32(step_embeds + (size_t)nb * dim,
+                                      sessions[i]->decoder.tok_embeddings_bf16,
+                                      token[i], dim);
+                nb++;
+            }
+            if (nb == 0) break;
+            if (qwen_decoder_forward_batch(step_sess, nb, step_embeds, next) != 0)
+                break;
+            for (int b = 0; b < nb; b++)
+                token[step_idx[b]] = next[b];
+        }
+        double dec_ms = get_time_ms() - dec_t0;
+        for (int i = 0; i < n; i++)
+            if (text[i]) sessions[i]->perf_decode_ms += dec_ms;
+    }
+
+    /* ---- Finalize: trim whitespace, hand out results ---- */
+    for (int i = 0; i < n; i++) {
+        if (!text[i]) continue;
+        size_t rlen = strlen(text[i]);
+        while (rlen > 0 && isspace((unsigned char)text[i][rlen - 1])) text[i][--rlen] = '\0';
+        char *start = text[i];
+        while (*start && isspace((unsigned char)*start)) start++;
+        if (start != text[i]) memmove(text[i], start, strlen(start) + 1);
+        sessions[i]->perf_text_tokens = n_text[i];
+        sessions[i]->perf_total_ms = get_time_ms() - t0;
+        out_texts[i] = text[i];
+        text[i] = NULL;
+    }
+
+    free(token); free(next); free(step_idx); free(gen);
+    free(past_asr); free(n_text); free(active);
+    free(text); free(text_len); free(text_cap);
+    free(step_sess); free(step_embeds);
+    qwen_tokenizer_free(tokenizer);
+    return 0;
+
+fail:
+    free(token); free(next); free(step_idx); free(gen);
+    free(past_asr); free(n_text); free(active);
+    if (text) {
+        for (int i = 0; i < n; i++) free(text[i]);
+    }
+    free(text); free(text_len); free(text_cap);
+    free(step_sess); free(step_embeds);
+    qwen_tokenizer_free(tokenizer);
+    return -1;
+}
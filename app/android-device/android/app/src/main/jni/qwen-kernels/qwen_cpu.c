@@ -0,0 +1,69 @@
+/*
+ * qwen_cpu.c - Runtime CPU feature detection (see qwen_cpu.h)
+ */
+
+#include "qwen_cpu.h"
+
+#if defined(__aarch64__) && defined(__linux__)
+
+#include <sys/auxv.h>
+
+/* <asm/hwcap.h> values; defined here so old sysroots still build. */
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+#ifndef HWCAP_ASIMDFHM
+#define HWCAP_ASIMDFHM (1 << 23)
+#endif
+#ifndef HWCAP2_I8MM
+#define HWCAP2_I8MM (1 << 13)
+#endif
+
+static int detect_features(void) {
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    int f = 0;
+    if (hwcap & HWCAP_ASIMDDP) f |= QWEN_CPU_DOTPROD;
+    if (hwcap & HWCAP_ASIMDHP) f |= QWEN_CPU_FP16;
+    if (hwcap & HWCAP_ASIMDFHM) f |= QWEN_CPU_FP16FML;
+    if (hwcap2 & HWCAP2_I8MM) f |= QWEN_CPU_I8MM;
+    return f;
+}
+
+#elif defined(__aarch64__) && defined(__APPLE__)
+
+#include <sys/sysctl.h>
+
+static int sysctl_flag(const char *name) {
+    int v = 0;
+    size_t sz = sizeof(v);
+    if (sysctlbyname(name, &v, &sz, NULL, 0) != 0) return 0;
+    return v != 0;
+}
+
+static int detect_features(void) {
+    /* Every Apple Silicon core has dotprod + fp16; probe the rest. */
+    int f = QWEN_CPU_DOTPROD | QWEN_CPU_FP16;
+    if (sysctl_flag("hw.optional.arm.FEAT_FHM")) f |= QWEN_CPU_FP16FML;
+    if (sysctl_flag("hw.optional.arm.FEAT_I8MM")) f |= QWEN_CPU_I8MM;
+    return f;
+}
+
+#else
+
+static int detect_features(void) {
+    return 0;
+}
+
+#endif
+
+int qwen_cpu_features(void) {
+    /* Benign race: detect_features() is idempotent, so concurrent first
+     * calls just compute the same mask twice. */
+    static int cached = -1;
+    if (cached < 0) cached = detect_features();
+    return cached;
+}
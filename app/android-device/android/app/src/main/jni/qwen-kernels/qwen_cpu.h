@@ -0,0 +1,31 @@
+/*
+ * qwen_cpu.h - Runtime CPU feature detection shared by the ASR/TTS engines
+ *
+ * One arm64-v8a APK runs on everything from Cortex-A55 to A715, so the
+ * libraries are compiled against a conservative baseline and the hot
+ * kernels pick richer variants (i8mm, fp16fml) at runtime. Detection
+ * uses getauxval(AT_HWCAP/AT_HWCAP2) on Linux/Android and is cached
+ * after the first call.
+ */
+
+#ifndef QWEN_CPU_H
+#define QWEN_CPU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define QWEN_CPU_DOTPROD (1 << 0) /* SDOT/UDOT (FEAT_DotProd) */
+#define QWEN_CPU_FP16    (1 << 1) /* FP16 vector arithmetic (FEAT_FP16) */
+#define QWEN_CPU_FP16FML (1 << 2) /* FMLAL/FMLSL (FEAT_FHM) */
+#define QWEN_CPU_I8MM    (1 << 3) /* SMMLA/USMMLA (FEAT_I8MM) */
+
+/* Bitmask of QWEN_CPU_* flags for the calling CPU. Thread-safe; the
+ * first call probes the kernel, later calls return the cached mask. */
+int qwen_cpu_features(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QWEN_CPU_H */
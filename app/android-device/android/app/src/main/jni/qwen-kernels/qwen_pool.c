@@ -0,0 +1,441 @@
+/*
+ * qwen_pool.c - Shared inference thread pool
+ *
+ * Moved from qwen_asr_kernels.c so the ASR and TTS engines run on one set
+ * of workers. Two additions over the original: qwen_parallel_for tolerates
+ * concurrent dispatchers (the loser of the dispatch race runs inline), and
+ * qwen_parallel_chunks provides the dynamically-scheduled loop shape the
+ * TTS kernels previously got from OpenMP.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE   /* sched_setaffinity / cpu_set_t on glibc */
+#endif
+
+#include "qwen_pool.h"
+#include <stdio.h>
+#include <pthread.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+int qwen_verbose = 0;
+
+static struct {
+    pthread_t threads[QWEN_MAX_THREADS - 1];
+    int tids[QWEN_MAX_THREADS - 1];
+    int n_threads;
+    int shutdown;
+
+    parallel_fn_t fn;
+    void *arg;
+    int generation;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_work;
+    pthread_cond_t cond_done;
+    int n_done;
+
+    int pin_cores;                     /* pin workers to big cores first */
+    int core_ids[QWEN_MAX_THREADS];    /* cores sorted fastest-first */
+    int n_cores;
+} tp = {
+    .n_threads = 1,
+    .shutdown = 0,
+    .generation = 0,
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond_work = PTHREAD_COND_INITIALIZER,
+    .cond_done = PTHREAD_COND_INITIALIZER,
+};
+
+/* Single dispatcher slot: with both engines on one pool, their inference
+ * threads can race to dispatch. Arbitration is by priority class:
+ * interactive callers (the default — ASR decode) wait briefly for the
+ * slot, background callers (TTS vocoding) never wait and yield the slot
+ * whenever an interactive dispatcher is queued behind it. */
+static pthread_mutex_t dispatch_mu = PTHREAD_MUTEX_INITIALIZER;
+static int interactive_waiting = 0;  /* atomic */
+
+/* Read one cpufreq sysfs value for a core; 0 when unavailable. */
+static long read_core_freq(int core, const char *file) {
+    char path[96];
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%d/cpufreq/%s", core, file);
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+    long v = 0;
+    if (fscanf(f, "%ld", &v) != 1) v = 0;
+    fclose(f);
+    return v;
+}
+
+/* Rank CPUs fastest-first (big cores first on big.LITTLE). Ranks by the
+ * current thermal cap (scaling_max_freq) when readable so a clamped big
+ * core loses its slot to a cool mid core, falling back to the silicon
+ * spec (cpuinfo_max_freq) and then to identity order. */
+static void rank_cores_by_freq(void) {
+    int n = qwen_get_num_cpus();
+    if (n > QWEN_MAX_THREADS) n = QWEN_MAX_THREADS;
+    long freqs[QWEN_MAX_THREADS];
+    for (int i = 0; i < n; i++) {
+        tp.core_ids[i] = i;
+        freqs[i] = read_core_freq(i, "scaling_max_freq");
+        if (freqs[i] == 0) freqs[i] = read_core_freq(i, "cpuinfo_max_freq");
+    }
+    /* Insertion sort, stable: descending frequency */
+    for (int i = 1; i < n; i++) {
+        int id = tp.core_ids[i];
+        long fr = freqs[i];
+        int j = i - 1;
+        while (j >= 0 && freqs[j] < fr) {
+            tp.core_ids[j + 1] = tp.core_ids[j];
+            freqs[j + 1] = freqs[j];
+            j--;
+        }
+        tp.core_ids[j + 1] = id;
+        freqs[j + 1] = fr;
+    }
+    tp.n_cores = n;
+}
+
+/* Pin the calling thread to one core (Linux only; no-op elsewhere). */
+static void pin_self_to_core(int core) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+/* Set for pool worker threads: a kernel running on a worker that itself
+ * calls qwen_parallel_for (nested dispatch, e.g. a TTS codec matvec going
+ * through qwen_parallel_chunks) must run inline. Workers are what the
+ * current dispatch is waiting on, so letting one block for the dispatcher
+ * slot would deadlock the pool against its own barrier. */
+static __thread int tls_pool_worker = 0;
+
+static void *worker_loop(void *arg) {
+    int tid = *(int *)arg;
+    int my_gen = 0;
+
+    tls_pool_worker = 1;
+
+    /* tid 0 is the dispatcher; workers take cores 1..n-1 of the
+     * fastest-first ranking so big cores are claimed before LITTLE ones. */
+    if (tp.pin_cores && tid < tp.n_cores)
+        pin_self_to_core(tp.core_ids[tid]);
+
+    for (;;) {
+        pthread_mutex_lock(&tp.mutex);
+        while (tp.generation == my_gen && !tp.shutdown)
+            pthread_cond_wait(&tp.cond_work, &tp.mutex);
+        if (tp.shutdown) {
+            pthread_mutex_unlock(&tp.mutex);
+            return NULL;
+        }
+        my_gen = tp.generation;
+        parallel_fn_t fn = tp.fn;
+        void *a = tp.arg;
+        int nt = tp.n_threads;
+        pthread_mutex_unlock(&tp.mutex);
+
+        fn(tid, nt, a);
+
+        pthread_mutex_lock(&tp.mutex);
+        if (++tp.n_done >= tp.n_threads - 1)
+            pthread_cond_signal(&tp.cond_done);
+        pthread_mutex_unlock(&tp.mutex);
+    }
+}
+
+void qwen_set_threads(int n) {
+    if (n < 1) n = 1;
+    if (n > QWEN_MAX_THREADS) n = QWEN_MAX_THREADS;
+
+    /* Shutdown existing workers */
+    if (tp.n_threads > 1) {
+        pthread_mutex_lock(&tp.mutex);
+        tp.shutdown = 1;
+        pthread_cond_broadcast(&tp.cond_work);
+        pthread_mutex_unlock(&tp.mutex);
+        for (int i = 0; i < tp.n_threads - 1; i++)
+            pthread_join(tp.threads[i], NULL);
+        tp.shutdown = 0;
+        tp.generation = 0;
+    }
+
+    tp.n_threads = n;
+    if (n <= 1) return;
+
+    if (tp.pin_cores) {
+        rank_cores_by_freq();
+        /* Dispatcher (tid 0) gets the fastest core */
+        if (tp.n_cores > 0)
+            pin_self_to_core(tp.core_ids[0]);
+    }
+
+    for (int i = 0; i < n - 1; i++) {
+        tp.tids[i] = i + 1;
+        pthread_create(&tp.threads[i], NULL, worker_loop, &tp.tids[i]);
+    }
+
+    if (qwen_verbose >= 2)
+        fprintf(stderr, "Thread pool: %d threads%s\n", n,
+                tp.pin_cores ? " (pinned, big cores first)" : "");
+}
+
+void qwen_ensure_threads(int n) {
+    if (n > tp.n_threads)
+        qwen_set_threads(n);
+}
+
+void qwen_set_thread_affinity(int enable) {
+    tp.pin_cores = enable ? 1 : 0;
+}
+
+int qwen_get_num_cpus(void) {
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? n : 1;
+}
+
+int qwen_get_n_threads(void) { return tp.n_threads; }
+
+/* Threads marked serial run qwen_parallel_for inline instead of dispatching
+ * to the shared pool. The pool has a single dispatcher slot, so any helper
+ * thread that runs kernels concurrently with the main thread may set this;
+ * unmarked threads fall back to inline execution anyway when the slot is
+ * taken, this just skips the trylock. */
+static __thread int tls_serial = 0;
+
+void qwen_set_thread_serial(int enable) {
+    tls_serial = enable ? 1 : 0;
+}
+
+static __thread int tls_background = 0;
+
+void qwen_set_thread_background(int enable) {
+    tls_background = enable ? 1 : 0;
+}
+
+/* Set while this thread holds the dispatcher slot: it participates in its
+ * own dispatch as tid 0, so a kernel nesting another qwen_parallel_for
+ * from it must run inline too — the trylock below would fail against the
+ * slot the thread itself holds and the interactive branch would then
+ * block on it forever. */
+static __thread int tls_dispatching = 0;
+
+/* Dispatch work to all threads; main thread is tid=0 */
+void qwen_parallel_for(parallel_fn_t fn, void *arg) {
+    if (tp.n_threads <= 1 || tls_serial || tls_pool_worker || tls_dispatching) {
+        fn(0, 1, arg);
+        return;
+    }
+    if (pthread_mutex_trylock(&dispatch_mu) != 0) {
+        if (tls_background) {
+            /* Background caller found the pool busy: run inline rather
+             * than wait or double-dispatch. */
+            fn(0, 1, arg);
+            return;
+        }
+        /* Interactive caller: the holder finishes within one kernel
+         * dispatch (ms at most), so waiting for the workers beats
+         * degrading a latency-critical kernel to single-threaded. The
+         * waiter count tells background dispatchers to stand down. */
+        __atomic_fetch_add(&interactive_waiting, 1, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&dispatch_mu);
+        __atomic_sub_fetch(&interactive_waiting, 1, __ATOMIC_RELAXED);
+    } else if (tls_background &&
+               __atomic_load_n(&interactive_waiting, __ATOMIC_RELAXED) > 0) {
+        /* An interactive dispatcher is queued for the slot we just won:
+         * hand the workers over and run this kernel inline. */
+        pthread_mutex_unlock(&dispatch_mu);
+        fn(0, 1, arg);
+        return;
+    }
+
+    tls_dispatching = 1;
+
+    pthread_mutex_lock(&tp.mutex);
+    tp.fn = fn;
+    tp.arg = arg;
+    tp.n_done = 0;
+    tp.generation++;
+    pthread_cond_broadcast(&tp.cond_work);
+    pthread_mutex_unlock(&tp.mutex);
+
+    fn(0, tp.n_threads, arg);
+
+    pthread_mutex_lock(&tp.mutex);
+    while (tp.n_done < tp.n_threads - 1)
+        pthread_cond_wait(&tp.cond_done, &tp.mutex);
+    pthread_mutex_unlock(&tp.mutex);
+
+    tls_dispatching = 0;
+    pthread_mutex_unlock(&dispatch_mu);
+}
+
+/* ---- Dynamically-scheduled chunk loop ---- */
+
+typedef struct {
+    int next;     /* atomic claim cursor */
+    int total;
+    int chunk;
+    qwen_chunk_fn_t fn;
+    void *arg;
+} chunks_ctx_t;
+
+static void chunks_worker(int tid, int n_threads, void *argp) {
+    chunks_ctx_t *c = (chunks_ctx_t *)argp;
+    (void)tid; (void)n_threads;
+    for (;;) {
+        int s = __atomic_fetch_add(&c->next, c->chunk, __ATOMIC_RELAXED);
+        if (s >= c->total) return;
+        int e = s + c->chunk;
+        if (e > c->total) e = c->total;
+        c->fn(s, e, c->arg);
+    }
+}
+
+void qwen_parallel_chunks(int total, int chunk, qwen_chunk_fn_t fn, void *arg) {
+    if (total <= 0) return;
+    if (chunk < 1) chunk = 1;
+    if (total <= chunk || tp.n_threads <= 1) {
+        fn(0, total, arg);
+        return;
+    }
+    chunks_ctx_t c = { 0, total, chunk, fn, arg };
+    qwen_parallel_for(chunks_worker, &c);
+}
+
+/* ---- Adaptive governor ----
+ * Hill-climbs the worker count on measured utterance throughput
+ * (work_ms / wall_ms, i.e. the realtime factor). Per-width scores are
+ * EMAs; widths that fell out of favour decay and are eventually
+ * forgotten so they get re-probed after the thermal state changes —
+ * without that, a width measured while the device was hot would stay
+ * condemned forever. Throttle state comes from scaling_max_freq, which
+ * Android thermal engines clamp when hot; scaling_cur_freq is useless
+ * here because idling cores report their parked frequency. */
+
+static struct {
+    int enabled;
+    int max_threads;                     /* ceiling: width set via qwen_set_threads */
+    double score[QWEN_MAX_THREADS + 1];  /* EMA realtime factor per width */
+    int measured[QWEN_MAX_THREADS + 1];
+    int utterances;
+    int settle;                          /* reports to skip after a resize */
+} gov;
+
+void qwen_pool_governor_enable(int enable) {
+    gov.enabled = enable ? 1 : 0;
+    if (enable) {
+        gov.max_threads = tp.n_threads;
+        for (int m = 0; m <= QWEN_MAX_THREADS; m++) {
+            gov.score[m] = 0;
+            gov.measured[m] = 0;
+        }
+        gov.utterances = 0;
+        gov.settle = 0;
+    }
+}
+
+void qwen_pool_governor_report(double work_ms, double wall_ms) {
+    if (!gov.enabled || work_ms <= 0 || wall_ms <= 0) return;
+    int n = tp.n_threads;
+    if (n > gov.max_threads) gov.max_threads = n;  /* qwen_ensure_threads grew the pool */
+    if (n < 2 || gov.max_threads < 2) return;
+    gov.utterances++;
+    if (gov.settle > 0) {  /* first report after a resize is warm-up noise */
+        gov.settle--;
+        return;
+    }
+
+    double thr = work_ms / wall_ms;
+    gov.score[n] = gov.measured[n] ? 0.7 * gov.score[n] + 0.3 * thr : thr;
+    gov.measured[n] = 1;
+
+    /* Decay the widths we are not running so the climb can revisit them;
+     * once a score falls to half of the current width's it is forgotten
+     * and becomes a probe target again. */
+    for (int m = 2; m <= gov.max_threads; m++) {
+        if (m == n || !gov.measured[m]) continue;
+        gov.score[m] *= 0.99;
+        if (gov.score[m] < 0.5 * gov.score[n]) gov.measured[m] = 0;
+    }
+
+    int throttled = 0;
+    {
+        int core = tp.n_cores > 0 ? tp.core_ids[0] : 0;
+        long cap = read_core_freq(core, "scaling_max_freq");
+        long max = read_core_freq(core, "cpuinfo_max_freq");
+        throttled = (cap > 0 && max > 0 && cap * 10 < max * 9);
+    }
+
+    int lo = n > 2 ? n - 1 : n;
+    int hi = n < gov.max_threads ? n + 1 : n;
+
+    /* Every 8th report probe an unmeasured neighbour — downward first
+     * when throttled, upward otherwise; in between, move only to a
+     * measured neighbour that beats the current width by >2%. */
+    int target = n;
+    if ((gov.utterances & 7) == 0) {
+        int first = throttled ? lo : hi;
+        int second = throttled ? hi : lo;
+        if (first != n && !gov.measured[first]) target = first;
+        else if (second != n && !gov.measured[second]) target = second;
+    }
+    if (target == n) {
+        for (int m = lo; m <= hi; m++)
+            if (gov.measured[m] && gov.score[m] > 1.02 * gov.score[target])
+                target = m;
+    }
+
+    if (target != n) {
+        /* Block out new dispatches (concurrent kernels fall back to
+         * inline execution) while the workers are joined and recreated. */
+        pthread_mutex_lock(&dispatch_mu);
+        qwen_set_threads(target);
+        pthread_mutex_unlock(&dispatch_mu);
+        gov.settle = 1;
+        if (qwen_verbose >= 1)
+            fprintf(stderr, "Pool governor: %d -> %d threads (%.2fx realtime%s)\n",
+                    n, target, thr, throttled ? ", throttled" : "");
+    } else if (throttled && tp.pin_cores && (gov.utterances & 31) == 0) {
+        /* Width is right but the device is hot: recreate at the same
+         * width to re-rank placement by the current thermal caps, which
+         * can move workers off a clamped big core. */
+        pthread_mutex_lock(&dispatch_mu);
+        qwen_set_threads(n);
+        pthread_mutex_unlock(&dispatch_mu);
+        gov.settle = 1;
+    }
+}
+
+/* ---- Dynamic tile scheduler ----
+ * Workers claim fixed-size tiles from a shared atomic cursor instead of
+ * taking one equal slice each, so a slow core only ever holds back one
+ * tile's worth of work at the barrier. ~8 tiles per thread balances claim
+ * overhead (one atomic add per tile) against load-balance granularity. */
+
+void qwen_tile_queue_init(qwen_tile_queue_t *q, int total, int n_threads) {
+    int tile = total / (n_threads * 8);
+    if (tile < 1) tile = 1;
+    if (tile > 64) tile = 64;
+    q->next = 0;
+    q->total = total;
+    q->tile = tile;
+}
+
+int qwen_tile_queue_grab(qwen_tile_queue_t *q, int *start, int *end) {
+    int s = __atomic_fetch_add(&q->next, q->tile, __ATOMIC_RELAXED);
+    if (s >= q->total) return 0;
+    int e = s + q->tile;
+    if (e > q->total) e = q->total;
+    *start = s;
+    *end = e;
+    return 1;
+}
@@ -0,0 +1,101 @@
+/*
+ * qwen_pool.h - Shared inference thread pool for the Qwen engines
+ *
+ * One process-wide worker pool used by both the ASR and TTS engines, so
+ * overlapping inference (live transcription while speech synthesis runs)
+ * shares a single set of workers instead of two pools fighting over the
+ * same big cores. Moved here from qwen_asr_kernels.c.
+ */
+
+#ifndef QWEN_POOL_H
+#define QWEN_POOL_H
+
+/* Upper bound on pool size; kernels may use it to size per-thread
+ * scratch arrays on the stack. */
+#define QWEN_MAX_THREADS 16
+
+/* Worker entry point for qwen_parallel_for; main thread is tid=0. */
+typedef void (*parallel_fn_t)(int tid, int n_threads, void *arg);
+
+/* Chunk entry point for qwen_parallel_chunks: process items [start, end). */
+typedef void (*qwen_chunk_fn_t)(int start, int end, void *arg);
+
+/* Set number of threads for parallel operations (default: 1).
+ * Creates a persistent thread pool. Call before inference. */
+void qwen_set_threads(int n);
+
+/* Grow the pool to at least n threads; never shrinks. For engines that
+ * share the pool: the second engine to initialize must not cut down a
+ * larger pool the first one configured. */
+void qwen_ensure_threads(int n);
+
+/* Optionally pin pool threads to CPU cores, fastest (big) cores first,
+ * ranked by cpuinfo_max_freq. The dispatcher thread takes the fastest
+ * core. Call before qwen_set_threads; takes effect when the pool is
+ * (re)created. No-op on non-Linux platforms. */
+void qwen_set_thread_affinity(int enable);
+
+/* Mark the calling thread as pool-serial: kernels invoked from it run
+ * inline instead of dispatching to the shared worker pool. Required for
+ * helper threads that run kernels concurrently with the main thread. */
+void qwen_set_thread_serial(int enable);
+
+/* Mark the calling thread as a background dispatcher (TTS vocoding and
+ * synthesis; the default class is interactive, used by ASR decode).
+ * Background threads never wait for the pool and give it up to a queued
+ * interactive dispatcher, so barge-in transcription keeps the workers
+ * while a reply is being spoken. */
+void qwen_set_thread_background(int enable);
+
+/* Get number of available CPU cores */
+int qwen_get_num_cpus(void);
+
+int qwen_get_n_threads(void);
+
+/* Dispatch fn to all pool threads and wait. Safe to call from several
+ * threads at once: the pool has one dispatcher slot, arbitrated by
+ * priority class. An interactive caller that finds it busy waits for the
+ * slot (the holder finishes within one kernel); a background caller runs
+ * its work inline on its own core instead of blocking or oversubscribing
+ * the workers, and yields the slot to any queued interactive caller. */
+void qwen_parallel_for(parallel_fn_t fn, void *arg);
+
+/* Dynamically-scheduled parallel loop over [0, total): pool threads claim
+ * `chunk`-sized ranges from an atomic cursor until the range drains.
+ * Equivalent to an OpenMP `parallel for schedule(dynamic, chunk)`. Runs
+ * inline when total is small or the pool is unavailable. */
+void qwen_parallel_chunks(int total, int chunk, qwen_chunk_fn_t fn, void *arg);
+
+/* ---- Adaptive governor ----
+ * Under sustained streaming our devices thermal-throttle after a couple
+ * of minutes, and a pool sized for cold big cores then oversubscribes the
+ * shrunken ones: sustained latency ends up worse than a narrower pool
+ * would give. When enabled, the pool re-tunes itself between utterances.
+ * Engines report each finished unit of work (work_ms of audio handled,
+ * wall_ms of inference spent on it) and the governor hill-climbs the
+ * worker count on the measured throughput, reading the per-core thermal
+ * frequency caps (scaling_max_freq, which Android thermal engines clamp
+ * when hot) to bias exploration downward under throttle and to refresh
+ * big/LITTLE placement when pinning is on. Reconfiguration happens only
+ * inside qwen_pool_governor_report, never under a kernel dispatch. */
+void qwen_pool_governor_enable(int enable);
+void qwen_pool_governor_report(double work_ms, double wall_ms);
+
+/* Dynamic tile scheduler for parallel_for workers. The dispatcher seeds an
+ * atomic cursor over fixed-size item tiles; workers claim tiles until the
+ * range drains. On big.LITTLE cores this keeps the fast cores pulling work
+ * while the slow ones lag, instead of the slowest core gating the barrier
+ * as the old equal-slice split did. */
+typedef struct {
+    int next;    /* atomic claim cursor */
+    int total;   /* number of items */
+    int tile;    /* items per claim */
+} qwen_tile_queue_t;
+
+void qwen_tile_queue_init(qwen_tile_queue_t *q, int total, int n_threads);
+int qwen_tile_queue_grab(qwen_tile_queue_t *q, int *start, int *end);
+
+/* Global verbose flag (shared by both engines) */
+extern int qwen_verbose;
+
+#endif /* QWEN_POOL_H */
@@ -0,0 +1,61 @@
+/*
+ * qwen_quant_formats.h - Quantized block formats shared by the Qwen engines
+ *
+ * The ASR and TTS engines use byte-identical block layouts; this header is
+ * the single definition both qwen_asr_quant.h and qwen_tts_quant.h build
+ * on, so a format change (or a kernel written against one) carries over to
+ * the other engine by construction. The quantize/dequantize entry points
+ * remain per-engine — their APIs diverged.
+ *
+ * Q8_0: 32 weights per block, symmetric quantization.
+ * Each block stores a float scale and 32 int8 quantized values.
+ * weight[i] = scale * qs[i]
+ * Memory: 36 bytes per 32 weights = 1.125 bytes/weight
+ *
+ * Q4_K: 256 weights per super-block, 8 sub-groups of 32.
+ * Two-level quantization: super-block scale/min (float) + sub-group
+ * integer scales/mins (uint8). Unsigned 4-bit quantized values [0,15].
+ * weight ≈ d * scales[g] * q - dmin * mins[g]
+ * Memory: 152 bytes per 256 weights = 0.59375 bytes/weight
+ */
+
+#ifndef QWEN_QUANT_FORMATS_H
+#define QWEN_QUANT_FORMATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define QK8_0 32  /* block size */
+
+typedef struct {
+    float scale;           /* shared scale factor */
+    int8_t qs[QK8_0];     /* quantized values */
+} block_q8_0;             /* 36 bytes total */
+
+#define QK_K 256
+#define Q4K_NUM_SUBS 8   /* QK_K / 32 */
+
+typedef struct {
+    float d;               /* 4B: super-block scale */
+    float dmin;            /* 4B: super-block min (asymmetric offset) */
+    uint8_t scales[8];     /* 8B: per-sub-group integer scales (0-255) */
+    uint8_t mins[8];       /* 8B: per-sub-group integer mins (0-255) */
+    uint8_t qs[128];       /* 128B: 256 unsigned int4 [0,15] packed nibbles */
+} block_q4_k;              /* 152 bytes / 256 elements */
+
+/* Q4_K x4: the same super-block column of 4 consecutive weight rows,
+ * interleaved into one tile. A 4-row matvec inner loop then reads all
+ * four rows' nibbles, scales and mins from one contiguous run instead of
+ * gathering them at row stride, and the quantized input is loaded once
+ * per 4 rows. Exactly 4x sizeof(block_q4_k), so a repacked tensor is
+ * byte-for-byte the same size as its row-major source; produced by
+ * repacking at load/qcache-build time, never quantized into directly. */
+typedef struct {
+    float d[4];                       /* per-row super-block scales */
+    float dmin[4];                    /* per-row super-block mins */
+    uint8_t scales[Q4K_NUM_SUBS][4];  /* [sub-group][row] */
+    uint8_t mins[Q4K_NUM_SUBS][4];    /* [sub-group][row] */
+    uint8_t qs[Q4K_NUM_SUBS][4][16];  /* [sub-group][row][packed nibbles] */
+} block_q4_kx4;                       /* 608 bytes / 4x256 elements */
+
+#endif /* QWEN_QUANT_FORMATS_H */
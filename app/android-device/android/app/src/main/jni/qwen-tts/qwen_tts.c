@@ -358,9 +358,9 @@ static int load_config(qwen_tts_ctx_t *ctx) {
 }
 
 /* ========================================================================
- * Q8_0 Quantization Helpers
+ * Quantization Helpers
  *
- * Allocate and quantize a weight matrix [rows, cols] to Q8_0 blocks.
+ * Allocate and quantize a weight matrix [rows, cols] to quantized blocks.
  * Returns malloc'd block array. Caller must free.
  * ======================================================================== */
 
@@ -382,6 +382,35 @@ static block_q8_0 *quantize_weight_f32(const float *f32, int rows, int cols) {
     return dst;
 }
 
+/* Q4_K variant for talker/sub-talker layer weights. Returns NULL when cols
+ * is not a multiple of QK_K; the caller falls back to Q8_0 for that weight. */
+static block_q4_k *quantize_weight_bf16_q4k(const uint16_t *bf16, int rows, int cols) {
+    if (cols % QK_K != 0) return NULL;
+    size_t n_blocks = (size_t)rows * (cols / QK_K);
+    block_q4_k *dst = (block_q4_k *)malloc(n_blocks * sizeof(block_q4_k));
+    if (!dst) return NULL;
+    quantize_bf16_to_q4_k(bf16, dst, rows, cols);
+    return dst;
+}
+
+/* QWEN_TTS_Q4K=1 selects Q4_K for the talker/sub-talker layer weights at
+ * cache-build time (default is Q8_0). The choice is recorded in the qcache
+ * header, so a cache built with the other format is re-quantized. */
+static int use_q4k(void) {
+    const char *e = getenv("QWEN_TTS_Q4K");
+    return e && e[0] == '1';
+}
+
+/* QWEN_TTS_CODEC_Q8=1 routes the codec transformer through the dynamic
+ * INT8 path (per-row Q8_0 activation quantization + SDOT matvecs) instead
+ * of FP16 weights. The Q8_0 copies always exist as the qcache fallback;
+ * this skips the FP16 copies entirely, halving codec weight memory and
+ * favouring cores where SDOT outpaces FP16 FMA. */
+static int use_codec_q8(void) {
+    const char *e = getenv("QWEN_TTS_CODEC_Q8");
+    return e && e[0] == '1';
+}
+
 /* ========================================================================
  * Pre-quantized Weight Cache (Q8_0)
  *
@@ -389,15 +418,29 @@ static block_q8_0 *quantize_weight_f32(const float *f32, int rows, int cols) {
  * weights to a binary cache file. Subsequent loads mmap the cache,
  * avoiding the expensive quantization step.
  *
- * Cache format:
- *   header (qcache_header_t)
+ * Cache format (v4):
+ *   header (qcache_header_t), then each tensor page-aligned in order:
  *   for each talker layer:
  *     wqkv_q8 | wo_q8 | gate_up_q8 | down_q8
  *   for each subtalker layer:
  *     wqkv_q8 | wo_q8 | gate_up_q8 | down_q8
  *   non-layer weights:
  *     text_proj_fc1_q8 | text_proj_fc2_q8 | codec_head_q8
- *     input_proj_q8 | lm_heads_q8[31]
+ *     input_proj_q8 | lm_heads_block_q8
+ *
+ * v4 page-aligns every tensor so load is a single mmap with pointer
+ * fixups: weights stay file-backed (no malloc+memcpy, no RSS doubling)
+ * and the kernel can drop clean weight pages under memory pressure.
+ *
+ * v5 fuses the 31 sub-talker LM heads into one page-aligned block: the
+ * per-step head evaluations walk one contiguous file-backed region in
+ * group order, so mmap readahead stays sequential instead of faulting
+ * 31 separately padded slots.
+ *
+ * The per-layer tensors are stored in whichever format was selected at
+ * cache-build time (layer_quant: 0 = Q8_0, 1 = Q4_K via QWEN_TTS_Q4K=1);
+ * the per-layer byte sizes in the header are for the active format.
+ * Non-layer weights are always Q8_0.
  * ======================================================================== */
 
 #ifndef __EMSCRIPTEN__
@@ -408,7 +451,8 @@ static block_q8_0 *quantize_weight_f32(const float *f32, int rows, int cols) {
 #endif
 
 #define QCACHE_MAGIC   0x33435151   /* "QQC3" */
-#define QCACHE_VERSION 3
+#define QCACHE_VERSION 5
+#define QCACHE_ALIGN   4096
 
 typedef struct {
     uint32_t magic;
@@ -416,23 +460,24 @@ typedef struct {
     uint64_t source_size;         /* original safetensors total file size for validation */
     uint32_t n_talker_layers;
     uint32_t n_subtalker_layers;
-    /* Talker per-layer Q8_0 byte sizes */
-    uint32_t tk_wqkv_q8_bytes;   /* per layer */
-    uint32_t tk_wo_q8_bytes;
-    uint32_t tk_gate_up_q8_bytes;
-    uint32_t tk_down_q8_bytes;
-    /* Subtalker per-layer Q8_0 byte sizes */
-    uint32_t st_wqkv_q8_bytes;
-    uint32_t st_wo_q8_bytes;
-    uint32_t st_gate_up_q8_bytes;
-    uint32_t st_down_q8_bytes;
-    /* Non-layer weight sizes */
+    /* Talker per-layer byte sizes (in the layer_quant format) */
+    uint32_t tk_wqkv_bytes;      /* per layer */
+    uint32_t tk_wo_bytes;
+    uint32_t tk_gate_up_bytes;
+    uint32_t tk_down_bytes;
+    /* Subtalker per-layer byte sizes (in the layer_quant format) */
+    uint32_t st_wqkv_bytes;
+    uint32_t st_wo_bytes;
+    uint32_t st_gate_up_bytes;
+    uint32_t st_down_bytes;
+    /* Non-layer weight sizes (always Q8_0) */
     uint32_t text_proj_fc1_q8_bytes;
     uint32_t text_proj_fc2_q8_bytes;
     uint32_t codec_head_q8_bytes;
     uint32_t input_proj_q8_bytes;
     uint32_t lm_head_q8_bytes;   /* per lm_head */
-    uint32_t reserved[3];         /* future use */
+    uint32_t layer_quant;         /* layer-weight format: 0 = Q8_0, 1 = Q4_K */
+    uint32_t reserved[2];         /* future use */
 } qcache_header_t;
 
 #ifndef __EMSCRIPTEN__
@@ -465,12 +510,25 @@ static inline uint32_t q8_bytes(int rows, int cols) {
     return (uint32_t)(((size_t)rows * cols / QK8_0) * sizeof(block_q8_0));
 }
 
+static inline uint32_t q4k_bytes(int rows, int cols) {
+    return (uint32_t)(((size_t)rows * cols / QK_K) * sizeof(block_q4_k));
+}
+
+static size_t qcache_align(size_t off) {
+    return (off + QCACHE_ALIGN - 1) & ~(size_t)(QCACHE_ALIGN - 1);
+}
+
 static int save_quantized_cache(qwen_tts_ctx_t *ctx) {
     qwen_tts_config_t *cfg = &ctx->config;
     char path[1024];
+
+    /* Weights already come from a mapped cache file; rewriting it would
+     * truncate our own mapping. */
+    if (ctx->qcache_map) return 0;
+
     snprintf(path, sizeof(path), "%s/model.qcache", ctx->cache_dir);
 
-    /* Compute per-layer Q8_0 sizes */
+    /* Compute per-layer sizes */
     int tk_qkv_rows = cfg->talker_heads * cfg->talker_head_dim +
                        2 * cfg->talker_kv_heads * cfg->talker_head_dim;
     int tk_q_dim = cfg->talker_heads * cfg->talker_head_dim;
@@ -479,6 +537,29 @@ static int save_quantized_cache(qwen_tts_ctx_t *ctx) {
                        2 * cfg->subtalker_kv_heads * cfg->subtalker_head_dim;
     int st_q_dim = cfg->subtalker_heads * cfg->subtalker_head_dim;
 
+    int layer_q4k = (cfg->talker_layers > 0 && ctx->talker.layers[0].wqkv_q4k != NULL);
+
+    /* A fixed per-layer slot size requires a uniform format; if any weight
+     * fell back to Q8_0 (cols not a multiple of QK_K), don't cache. */
+    if (layer_q4k) {
+        for (int i = 0; i < cfg->talker_layers; i++) {
+            qwen_tts_talker_layer_t *l = &ctx->talker.layers[i];
+            if (!l->wqkv_q4k || !l->wo_q4k || !l->gate_up_q4k || !l->down_q4k) {
+                if (qwen_tts_verbose >= 1)
+                    fprintf(stderr, "Warning: mixed Q4_K/Q8_0 layer weights, skipping qcache\n");
+                return -1;
+            }
+        }
+        for (int i = 0; i < cfg->subtalker_layers; i++) {
+            qwen_tts_subtalker_layer_t *l = &ctx->subtalker.layers[i];
+            if (!l->wqkv_q4k || !l->wo_q4k || !l->gate_up_q4k || !l->down_q4k) {
+                if (qwen_tts_verbose >= 1)
+                    fprintf(stderr, "Warning: mixed Q4_K/Q8_0 layer weights, skipping qcache\n");
+                return -1;
+            }
+        }
+    }
+
     qcache_header_t hdr;
     memset(&hdr, 0, sizeof(hdr));
     hdr.magic = QCACHE_MAGIC;
@@ -486,14 +567,26 @@ static int save_quantized_cache(qwen_tts_ctx_t *ctx) {
     hdr.source_size = get_safetensors_size(ctx->model_dir);
     hdr.n_talker_layers = (uint32_t)cfg->talker_layers;
     hdr.n_subtalker_layers = (uint32_t)cfg->subtalker_layers;
-    hdr.tk_wqkv_q8_bytes = q8_bytes(tk_qkv_rows, cfg->talker_hidden);
-    hdr.tk_wo_q8_bytes = q8_bytes(cfg->talker_hidden, tk_q_dim);
-    hdr.tk_gate_up_q8_bytes = q8_bytes(2 * cfg->talker_intermediate, cfg->talker_hidden);
-    hdr.tk_down_q8_bytes = q8_bytes(cfg->talker_hidden, cfg->talker_intermediate);
-    hdr.st_wqkv_q8_bytes = q8_bytes(st_qkv_rows, cfg->subtalker_hidden);
-    hdr.st_wo_q8_bytes = q8_bytes(cfg->subtalker_hidden, st_q_dim);
-    hdr.st_gate_up_q8_bytes = q8_bytes(2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
-    hdr.st_down_q8_bytes = q8_bytes(cfg->subtalker_hidden, cfg->subtalker_intermediate);
+    hdr.layer_quant = layer_q4k ? 1 : 0;
+    if (layer_q4k) {
+        hdr.tk_wqkv_bytes = q4k_bytes(tk_qkv_rows, cfg->talker_hidden);
+        hdr.tk_wo_bytes = q4k_bytes(cfg->talker_hidden, tk_q_dim);
+        hdr.tk_gate_up_bytes = q4k_bytes(2 * cfg->talker_intermediate, cfg->talker_hidden);
+        hdr.tk_down_bytes = q4k_bytes(cfg->talker_hidden, cfg->talker_intermediate);
+        hdr.st_wqkv_bytes = q4k_bytes(st_qkv_rows, cfg->subtalker_hidden);
+        hdr.st_wo_bytes = q4k_bytes(cfg->subtalker_hidden, st_q_dim);
+        hdr.st_gate_up_bytes = q4k_bytes(2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
+        hdr.st_down_bytes = q4k_bytes(cfg->subtalker_hidden, cfg->subtalker_intermediate);
+    } else {
+        hdr.tk_wqkv_bytes = q8_bytes(tk_qkv_rows, cfg->talker_hidden);
+        hdr.tk_wo_bytes = q8_bytes(cfg->talker_hidden, tk_q_dim);
+        hdr.tk_gate_up_bytes = q8_bytes(2 * cfg->talker_intermediate, cfg->talker_hidden);
+        hdr.tk_down_bytes = q8_bytes(cfg->talker_hidden, cfg->talker_intermediate);
+        hdr.st_wqkv_bytes = q8_bytes(st_qkv_rows, cfg->subtalker_hidden);
+        hdr.st_wo_bytes = q8_bytes(cfg->subtalker_hidden, st_q_dim);
+        hdr.st_gate_up_bytes = q8_bytes(2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
+        hdr.st_down_bytes = q8_bytes(cfg->subtalker_hidden, cfg->subtalker_intermediate);
+    }
     hdr.text_proj_fc1_q8_bytes = q8_bytes(cfg->talker_text_hidden, cfg->talker_text_hidden);
     hdr.text_proj_fc2_q8_bytes = q8_bytes(cfg->talker_hidden, cfg->talker_text_hidden);
     hdr.codec_head_q8_bytes = q8_bytes(cfg->talker_vocab_size, cfg->talker_hidden);
@@ -511,35 +604,45 @@ static int save_quantized_cache(qwen_tts_ctx_t *ctx) {
 
     fwrite(&hdr, sizeof(hdr), 1, f);
 
+    /* Pad to the next page boundary so every tensor is page-aligned */
+    static const uint8_t zero_page[QCACHE_ALIGN] = {0};
+    #define PAD_TO_PAGE() do { \
+        size_t pos = (size_t)ftell(f); \
+        size_t pad = qcache_align(pos) - pos; \
+        if (pad > 0) fwrite(zero_page, 1, pad, f); \
+    } while(0)
+
+    PAD_TO_PAGE();
+
     /* Only write data for non-NULL pointers; header byte sizes are 0 for absent weights */
-    #define WRITE_Q8(ptr, n_bytes) do { \
-        if ((ptr) && (n_bytes) > 0) fwrite(ptr, 1, n_bytes, f); \
+    #define WRITE_TENSOR(ptr, n_bytes) do { \
+        if ((ptr) && (n_bytes) > 0) { fwrite(ptr, 1, n_bytes, f); PAD_TO_PAGE(); } \
     } while(0)
 
     for (int i = 0; i < cfg->talker_layers; i++) {
         qwen_tts_talker_layer_t *l = &ctx->talker.layers[i];
-        WRITE_Q8(l->wqkv_q8, hdr.tk_wqkv_q8_bytes);
-        WRITE_Q8(l->wo_q8, hdr.tk_wo_q8_bytes);
-        WRITE_Q8(l->gate_up_q8, hdr.tk_gate_up_q8_bytes);
-        WRITE_Q8(l->down_q8, hdr.tk_down_q8_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->wqkv_q4k : (const void *)l->wqkv_q8, hdr.tk_wqkv_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->wo_q4k : (const void *)l->wo_q8, hdr.tk_wo_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->gate_up_q4k : (const void *)l->gate_up_q8, hdr.tk_gate_up_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->down_q4k : (const void *)l->down_q8, hdr.tk_down_bytes);
     }
     for (int i = 0; i < cfg->subtalker_layers; i++) {
         qwen_tts_subtalker_layer_t *l = &ctx->subtalker.layers[i];
-        WRITE_Q8(l->wqkv_q8, hdr.st_wqkv_q8_bytes);
-        WRITE_Q8(l->wo_q8, hdr.st_wo_q8_bytes);
-        WRITE_Q8(l->gate_up_q8, hdr.st_gate_up_q8_bytes);
-        WRITE_Q8(l->down_q8, hdr.st_down_q8_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->wqkv_q4k : (const void *)l->wqkv_q8, hdr.st_wqkv_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->wo_q4k : (const void *)l->wo_q8, hdr.st_wo_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->gate_up_q4k : (const void *)l->gate_up_q8, hdr.st_gate_up_bytes);
+        WRITE_TENSOR(layer_q4k ? (const void *)l->down_q4k : (const void *)l->down_q8, hdr.st_down_bytes);
     }
     /* Non-layer weights */
-    WRITE_Q8(ctx->talker.text_proj_fc1_q8, hdr.text_proj_fc1_q8_bytes);
-    WRITE_Q8(ctx->talker.text_proj_fc2_q8, hdr.text_proj_fc2_q8_bytes);
-    WRITE_Q8(ctx->talker.codec_head_q8, hdr.codec_head_q8_bytes);
-    WRITE_Q8(ctx->subtalker.input_proj_q8, hdr.input_proj_q8_bytes);
-    for (int g = 0; g < cfg->num_code_groups - 1; g++) {
-        WRITE_Q8(ctx->subtalker.lm_heads_q8[g], hdr.lm_head_q8_bytes);
-    }
+    WRITE_TENSOR(ctx->talker.text_proj_fc1_q8, hdr.text_proj_fc1_q8_bytes);
+    WRITE_TENSOR(ctx->talker.text_proj_fc2_q8, hdr.text_proj_fc2_q8_bytes);
+    WRITE_TENSOR(ctx->talker.codec_head_q8, hdr.codec_head_q8_bytes);
+    WRITE_TENSOR(ctx->subtalker.input_proj_q8, hdr.input_proj_q8_bytes);
+    WRITE_TENSOR(ctx->subtalker.lm_heads_block_q8,
+             (size_t)hdr.lm_head_q8_bytes * (cfg->num_code_groups - 1));
 
-    #undef WRITE_Q8
+    #undef WRITE_TENSOR
+    #undef PAD_TO_PAGE
 
     fclose(f);
     if (qwen_tts_verbose >= 1)
@@ -586,15 +689,26 @@ static int load_quantized_cache(qwen_tts_ctx_t *ctx) {
         return -1;
     }
 
-    /* Validate total file size */
-    size_t tk_per_layer = (size_t)hdr->tk_wqkv_q8_bytes + hdr->tk_wo_q8_bytes +
-                          hdr->tk_gate_up_q8_bytes + hdr->tk_down_q8_bytes;
-    size_t st_per_layer = (size_t)hdr->st_wqkv_q8_bytes + hdr->st_wo_q8_bytes +
-                          hdr->st_gate_up_q8_bytes + hdr->st_down_q8_bytes;
-    size_t non_layer = (size_t)hdr->text_proj_fc1_q8_bytes + hdr->text_proj_fc2_q8_bytes +
-                       hdr->codec_head_q8_bytes + hdr->input_proj_q8_bytes +
-                       (size_t)hdr->lm_head_q8_bytes * (cfg->num_code_groups - 1);
-    size_t expected_size = sizeof(qcache_header_t) +
+    int layer_q4k = (hdr->layer_quant == 1);
+    if (layer_q4k != use_q4k()) {
+        if (qwen_tts_verbose >= 1)
+            fprintf(stderr, "qcache: layer format mismatch (cache=%s, requested=%s), re-quantizing\n",
+                    layer_q4k ? "Q4_K" : "Q8_0", use_q4k() ? "Q4_K" : "Q8_0");
+        munmap(mapped, file_size);
+        return -1;
+    }
+
+    /* Validate total file size (every tensor occupies a page-aligned slot) */
+    size_t tk_per_layer = qcache_align(hdr->tk_wqkv_bytes) + qcache_align(hdr->tk_wo_bytes) +
+                          qcache_align(hdr->tk_gate_up_bytes) + qcache_align(hdr->tk_down_bytes);
+    size_t st_per_layer = qcache_align(hdr->st_wqkv_bytes) + qcache_align(hdr->st_wo_bytes) +
+                          qcache_align(hdr->st_gate_up_bytes) + qcache_align(hdr->st_down_bytes);
+    size_t non_layer = qcache_align(hdr->text_proj_fc1_q8_bytes) +
+                       qcache_align(hdr->text_proj_fc2_q8_bytes) +
+                       qcache_align(hdr->codec_head_q8_bytes) +
+                       qcache_align(hdr->input_proj_q8_bytes) +
+                       qcache_align((size_t)hdr->lm_head_q8_bytes * (cfg->num_code_groups - 1));
+    size_t expected_size = qcache_align(sizeof(qcache_header_t)) +
                            tk_per_layer * hdr->n_talker_layers +
                            st_per_layer * hdr->n_subtalker_layers +
                            non_layer;
@@ -603,45 +717,67 @@ static int load_quantized_cache(qwen_tts_ctx_t *ctx) {
         return -1;
     }
 
-    const uint8_t *ptr = (const uint8_t *)mapped + sizeof(qcache_header_t);
+    /* Fix up weight pointers directly into the mapping: weights stay
+     * file-backed for the lifetime of the context (no copies). */
+    const uint8_t *ptr = (const uint8_t *)mapped + qcache_align(sizeof(qcache_header_t));
 
-    #define CACHE_COPY(dst, type, n_bytes) do { \
+    #define CACHE_PTR(dst, type, n_bytes) do { \
         if ((n_bytes) > 0) { \
-            dst = (type)malloc(n_bytes); \
-            if (dst) memcpy(dst, ptr, n_bytes); \
-            ptr += (n_bytes); \
+            dst = (type)ptr; \
+            ptr += qcache_align(n_bytes); \
         } \
     } while(0)
 
     for (int i = 0; i < cfg->talker_layers; i++) {
         qwen_tts_talker_layer_t *l = &ctx->talker.layers[i];
-        CACHE_COPY(l->wqkv_q8, block_q8_0 *, hdr->tk_wqkv_q8_bytes);
-        CACHE_COPY(l->wo_q8, block_q8_0 *, hdr->tk_wo_q8_bytes);
-        CACHE_COPY(l->gate_up_q8, block_q8_0 *, hdr->tk_gate_up_q8_bytes);
-        CACHE_COPY(l->down_q8, block_q8_0 *, hdr->tk_down_q8_bytes);
+        if (layer_q4k) {
+            CACHE_PTR(l->wqkv_q4k, block_q4_k *, hdr->tk_wqkv_bytes);
+            CACHE_PTR(l->wo_q4k, block_q4_k *, hdr->tk_wo_bytes);
+            CACHE_PTR(l->gate_up_q4k, block_q4_k *, hdr->tk_gate_up_bytes);
+            CACHE_PTR(l->down_q4k, block_q4_k *, hdr->tk_down_bytes);
+        } else {
+            CACHE_PTR(l->wqkv_q8, block_q8_0 *, hdr->tk_wqkv_bytes);
+            CACHE_PTR(l->wo_q8, block_q8_0 *, hdr->tk_wo_bytes);
+            CACHE_PTR(l->gate_up_q8, block_q8_0 *, hdr->tk_gate_up_bytes);
+            CACHE_PTR(l->down_q8, block_q8_0 *, hdr->tk_down_bytes);
+        }
     }
     for (int i = 0; i < cfg->subtalker_layers; i++) {
         qwen_tts_subtalker_layer_t *l = &ctx->subtalker.layers[i];
-        CACHE_COPY(l->wqkv_q8, block_q8_0 *, hdr->st_wqkv_q8_bytes);
-        CACHE_COPY(l->wo_q8, block_q8_0 *, hdr->st_wo_q8_bytes);
-        CACHE_COPY(l->gate_up_q8, block_q8_0 *, hdr->st_gate_up_q8_bytes);
-        CACHE_COPY(l->down_q8, block_q8_0 *, hdr->st_down_q8_bytes);
+        if (layer_q4k) {
+            CACHE_PTR(l->wqkv_q4k, block_q4_k *, hdr->st_wqkv_bytes);
+            CACHE_PTR(l->wo_q4k, block_q4_k *, hdr->st_wo_bytes);
+            CACHE_PTR(l->gate_up_q4k, block_q4_k *, hdr->st_gate_up_bytes);
+            CACHE_PTR(l->down_q4k, block_q4_k *, hdr->st_down_bytes);
+        } else {
+            CACHE_PTR(l->wqkv_q8, block_q8_0 *, hdr->st_wqkv_bytes);
+            CACHE_PTR(l->wo_q8, block_q8_0 *, hdr->st_wo_bytes);
+            CACHE_PTR(l->gate_up_q8, block_q8_0 *, hdr->st_gate_up_bytes);
+            CACHE_PTR(l->down_q8, block_q8_0 *, hdr->st_down_bytes);
+        }
     }
     /* Non-layer weights */
-    CACHE_COPY(ctx->talker.text_proj_fc1_q8, block_q8_0 *, hdr->text_proj_fc1_q8_bytes);
-    CACHE_COPY(ctx->talker.text_proj_fc2_q8, block_q8_0 *, hdr->text_proj_fc2_q8_bytes);
-    CACHE_COPY(ctx->talker.codec_head_q8, block_q8_0 *, hdr->codec_head_q8_bytes);
-    CACHE_COPY(ctx->subtalker.input_proj_q8, block_q8_0 *, hdr->input_proj_q8_bytes);
-    for (int g = 0; g < cfg->num_code_groups - 1; g++) {
-        CACHE_COPY(ctx->subtalker.lm_heads_q8[g], block_q8_0 *, hdr->lm_head_q8_bytes);
+    CACHE_PTR(ctx->talker.text_proj_fc1_q8, block_q8_0 *, hdr->text_proj_fc1_q8_bytes);
+    CACHE_PTR(ctx->talker.text_proj_fc2_q8, block_q8_0 *, hdr->text_proj_fc2_q8_bytes);
+    CACHE_PTR(ctx->talker.codec_head_q8, block_q8_0 *, hdr->codec_head_q8_bytes);
+    CACHE_PTR(ctx->subtalker.input_proj_q8, block_q8_0 *, hdr->input_proj_q8_bytes);
+    CACHE_PTR(ctx->subtalker.lm_heads_block_q8, block_q8_0 *,
+              (size_t)hdr->lm_head_q8_bytes * (cfg->num_code_groups - 1));
+    if (ctx->subtalker.lm_heads_block_q8) {
+        size_t head_blocks = (size_t)cfg->subtalker_vocab_size * (cfg->subtalker_hidden / QK8_0);
+        for (int g = 0; g < cfg->num_code_groups - 1; g++)
+            ctx->subtalker.lm_heads_q8[g] = ctx->subtalker.lm_heads_block_q8 + g * head_blocks;
     }
 
-    #undef CACHE_COPY
+    #undef CACHE_PTR
 
-    munmap(mapped, file_size);
+    /* Keep the mapping alive; qwen_tts_free() unmaps it instead of freeing
+     * the individual weight buffers. */
+    ctx->qcache_map = mapped;
+    ctx->qcache_map_size = file_size;
 
     if (qwen_tts_verbose >= 1)
-        fprintf(stderr, "Loaded quantized cache from %s (input_proj: %s)\n",
+        fprintf(stderr, "Loaded quantized cache from %s (mmap, input_proj: %s)\n",
                 path, ctx->subtalker.input_proj_q8 ? "present" : "absent");
     return 0;
 }
@@ -789,8 +925,8 @@ static int load_talker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
         snprintf(name, sizeof(name), "talker.model.layers.%d.post_attention_layernorm.weight", i);
         LOAD_F32_CHECK(l->post_attn_norm, ms, name);
 
-        /* Fuse Q+K+V -> Q8_0 (skip if loaded from cache) */
-        if (!l->wqkv_q8) {
+        /* Fuse Q+K+V -> Q4_K/Q8_0 (skip if loaded from cache) */
+        if (!l->wqkv_q8 && !l->wqkv_q4k) {
             uint16_t *wq = NULL, *wk = NULL, *wv = NULL;
             snprintf(name, sizeof(name), "talker.model.layers.%d.self_attn.q_proj.weight", i);
             GET_BF16_CHECK(wq, ms, name);
@@ -808,22 +944,29 @@ static int load_talker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
                 memcpy(fused, wq, (size_t)q_rows * row_elems * sizeof(uint16_t));
                 memcpy(fused + (size_t)q_rows * row_elems, wk, (size_t)kv_rows * row_elems * sizeof(uint16_t));
                 memcpy(fused + (size_t)(q_rows + kv_rows) * row_elems, wv, (size_t)kv_rows * row_elems * sizeof(uint16_t));
-                l->wqkv_q8 = quantize_weight_bf16(fused, total_rows, (int)row_elems);
+                if (use_q4k())
+                    l->wqkv_q4k = quantize_weight_bf16_q4k(fused, total_rows, (int)row_elems);
+                if (!l->wqkv_q4k)
+                    l->wqkv_q8 = quantize_weight_bf16(fused, total_rows, (int)row_elems);
             }
             free(fused);
         }
 
-        /* wo -> Q8_0 */
-        if (!l->wo_q8) {
+        /* wo -> Q4_K/Q8_0 */
+        if (!l->wo_q8 && !l->wo_q4k) {
             uint16_t *wo = NULL;
             snprintf(name, sizeof(name), "talker.model.layers.%d.self_attn.o_proj.weight", i);
             GET_BF16_CHECK(wo, ms, name);
-            if (wo)
-                l->wo_q8 = quantize_weight_bf16(wo, cfg->talker_hidden, cfg->talker_heads * cfg->talker_head_dim);
+            if (wo) {
+                if (use_q4k())
+                    l->wo_q4k = quantize_weight_bf16_q4k(wo, cfg->talker_hidden, cfg->talker_heads * cfg->talker_head_dim);
+                if (!l->wo_q4k)
+                    l->wo_q8 = quantize_weight_bf16(wo, cfg->talker_hidden, cfg->talker_heads * cfg->talker_head_dim);
+            }
         }
 
-        /* Fuse gate+up -> Q8_0 */
-        if (!l->gate_up_q8) {
+        /* Fuse gate+up -> Q4_K/Q8_0 */
+        if (!l->gate_up_q8 && !l->gate_up_q4k) {
             uint16_t *gate = NULL, *up = NULL;
             snprintf(name, sizeof(name), "talker.model.layers.%d.mlp.gate_proj.weight", i);
             GET_BF16_CHECK(gate, ms, name);
@@ -835,18 +978,25 @@ static int load_talker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
             if (fused && gate && up) {
                 memcpy(fused, gate, gu_size * sizeof(uint16_t));
                 memcpy(fused + gu_size, up, gu_size * sizeof(uint16_t));
-                l->gate_up_q8 = quantize_weight_bf16(fused, 2 * cfg->talker_intermediate, cfg->talker_hidden);
+                if (use_q4k())
+                    l->gate_up_q4k = quantize_weight_bf16_q4k(fused, 2 * cfg->talker_intermediate, cfg->talker_hidden);
+                if (!l->gate_up_q4k)
+                    l->gate_up_q8 = quantize_weight_bf16(fused, 2 * cfg->talker_intermediate, cfg->talker_hidden);
             }
             free(fused);
         }
 
-        /* down -> Q8_0 */
-        if (!l->down_q8) {
+        /* down -> Q4_K/Q8_0 */
+        if (!l->down_q8 && !l->down_q4k) {
             uint16_t *down = NULL;
             snprintf(name, sizeof(name), "talker.model.layers.%d.mlp.down_proj.weight", i);
             GET_BF16_CHECK(down, ms, name);
-            if (down)
-                l->down_q8 = quantize_weight_bf16(down, cfg->talker_hidden, cfg->talker_intermediate);
+            if (down) {
+                if (use_q4k())
+                    l->down_q4k = quantize_weight_bf16_q4k(down, cfg->talker_hidden, cfg->talker_intermediate);
+                if (!l->down_q4k)
+                    l->down_q8 = quantize_weight_bf16(down, cfg->talker_hidden, cfg->talker_intermediate);
+            }
         }
     }
 
@@ -904,8 +1054,8 @@ static void load_subtalker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_
         snprintf(name, sizeof(name), "talker.code_predictor.model.layers.%d.post_attention_layernorm.weight", i);
         LOAD_F32_CHECK(l->post_attn_norm, ms, name);
 
-        /* Fuse Q+K+V -> Q8_0 (skip if loaded from cache) */
-        if (!l->wqkv_q8) {
+        /* Fuse Q+K+V -> Q4_K/Q8_0 (skip if loaded from cache) */
+        if (!l->wqkv_q8 && !l->wqkv_q4k) {
             uint16_t *wq = NULL, *wk = NULL, *wv = NULL;
             snprintf(name, sizeof(name), "talker.code_predictor.model.layers.%d.self_attn.q_proj.weight", i);
             GET_BF16_CHECK(wq, ms, name);
@@ -923,22 +1073,29 @@ static void load_subtalker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_
                 memcpy(fused, wq, (size_t)q_rows * row_elems * sizeof(uint16_t));
                 memcpy(fused + (size_t)q_rows * row_elems, wk, (size_t)kv_rows * row_elems * sizeof(uint16_t));
                 memcpy(fused + (size_t)(q_rows + kv_rows) * row_elems, wv, (size_t)kv_rows * row_elems * sizeof(uint16_t));
-                l->wqkv_q8 = quantize_weight_bf16(fused, total_rows, (int)row_elems);
+                if (use_q4k())
+                    l->wqkv_q4k = quantize_weight_bf16_q4k(fused, total_rows, (int)row_elems);
+                if (!l->wqkv_q4k)
+                    l->wqkv_q8 = quantize_weight_bf16(fused, total_rows, (int)row_elems);
             }
             free(fused);
         }
 
-        /* wo -> Q8_0 */
-        if (!l->wo_q8) {
+        /* wo -> Q4_K/Q8_0 */
+        if (!l->wo_q8 && !l->wo_q4k) {
             uint16_t *wo = NULL;
             snprintf(name, sizeof(name), "talker.code_predictor.model.layers.%d.self_attn.o_proj.weight", i);
             GET_BF16_CHECK(wo, ms, name);
-            if (wo)
-                l->wo_q8 = quantize_weight_bf16(wo, cfg->subtalker_hidden, cfg->subtalker_heads * cfg->subtalker_head_dim);
+            if (wo) {
+                if (use_q4k())
+                    l->wo_q4k = quantize_weight_bf16_q4k(wo, cfg->subtalker_hidden, cfg->subtalker_heads * cfg->subtalker_head_dim);
+                if (!l->wo_q4k)
+                    l->wo_q8 = quantize_weight_bf16(wo, cfg->subtalker_hidden, cfg->subtalker_heads * cfg->subtalker_head_dim);
+            }
         }
 
-        /* Fuse gate+up -> Q8_0 */
-        if (!l->gate_up_q8) {
+        /* Fuse gate+up -> Q4_K/Q8_0 */
+        if (!l->gate_up_q8 && !l->gate_up_q4k) {
             uint16_t *gate = NULL, *up = NULL;
             snprintf(name, sizeof(name), "talker.code_predictor.model.layers.%d.mlp.gate_proj.weight", i);
             GET_BF16_CHECK(gate, ms, name);
@@ -950,32 +1107,51 @@ static void load_subtalker_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_
             if (fused && gate && up) {
                 memcpy(fused, gate, gu_size * sizeof(uint16_t));
                 memcpy(fused + gu_size, up, gu_size * sizeof(uint16_t));
-                l->gate_up_q8 = quantize_weight_bf16(fused, 2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
+                if (use_q4k())
+                    l->gate_up_q4k = quantize_weight_bf16_q4k(fused, 2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
+                if (!l->gate_up_q4k)
+                    l->gate_up_q8 = quantize_weight_bf16(fused, 2 * cfg->subtalker_intermediate, cfg->subtalker_hidden);
             }
             free(fused);
         }
 
-        /* down -> Q8_0 */
-        if (!l->down_q8) {
+        /* down -> Q4_K/Q8_0 */
+        if (!l->down_q8 && !l->down_q4k) {
             uint16_t *down = NULL;
             snprintf(name, sizeof(name), "talker.code_predictor.model.layers.%d.mlp.down_proj.weight", i);
             GET_BF16_CHECK(down, ms, name);
-            if (down)
-                l->down_q8 = quantize_weight_bf16(down, cfg->subtalker_hidden, cfg->subtalker_intermediate);
+            if (down) {
+                if (use_q4k())
+                    l->down_q4k = quantize_weight_bf16_q4k(down, cfg->subtalker_hidden, cfg->subtalker_intermediate);
+                if (!l->down_q4k)
+                    l->down_q8 = quantize_weight_bf16(down, cfg->subtalker_hidden, cfg->subtalker_intermediate);
+            }
         }
     }
 
     /* Final norm */
     LOAD_F32_CHECK(ctx->subtalker.norm, ms, "talker.code_predictor.model.norm.weight");
 
-    /* 31 LM heads: BF16 -> Q8_0 (skip if loaded from cache) */
-    for (int g = 0; g < cfg->num_code_groups - 1; g++) {
-        if (!ctx->subtalker.lm_heads_q8[g]) {
+    /* 31 LM heads: BF16 -> Q8_0 into one fused block (skip if loaded from
+     * cache). Group g's head sits at offset g so the per-step evaluations
+     * stream the block front to back. */
+    {
+        size_t head_elems = (size_t)cfg->subtalker_vocab_size * cfg->subtalker_hidden;
+        size_t head_blocks = head_elems / QK8_0;
+        for (int g = 0; g < cfg->num_code_groups - 1; g++) {
+            if (ctx->subtalker.lm_heads_q8[g]) continue;
             uint16_t *lm_bf16 = NULL;
             snprintf(name, sizeof(name), "talker.code_predictor.lm_head.%d.weight", g);
             GET_BF16_CHECK(lm_bf16, ms, name);
-            if (lm_bf16)
-                ctx->subtalker.lm_heads_q8[g] = quantize_weight_bf16(lm_bf16, cfg->subtalker_vocab_size, cfg->subtalker_hidden);
+            if (!lm_bf16) continue;
+            if (!ctx->subtalker.lm_heads_block_q8) {
+                ctx->subtalker.lm_heads_block_q8 = (block_q8_0 *)malloc(
+                    head_blocks * (cfg->num_code_groups - 1) * sizeof(block_q8_0));
+                if (!ctx->subtalker.lm_heads_block_q8) break;
+            }
+            block_q8_0 *dst = ctx->subtalker.lm_heads_block_q8 + g * head_blocks;
+            quantize_bf16_to_q8_0(lm_bf16, dst, (int)head_elems);
+            ctx->subtalker.lm_heads_q8[g] = dst;
         }
     }
 
@@ -1058,6 +1234,9 @@ static void load_codec_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
     LOAD_F32_CHECK(codec->transformer_output_proj_bias, ms, "decoder.pre_transformer.output_proj.bias");
     LOAD_F32_CHECK(codec->transformer_norm, ms, "decoder.pre_transformer.norm.weight");
 
+    if (qwen_tts_verbose >= 1 && use_codec_q8())
+        fprintf(stderr, "Codec transformer: dynamic INT8 (Q8_0 + SDOT) path selected\n");
+
     for (int i = 0; i < cfg->codec_layers; i++) {
         qwen_tts_codec_transformer_layer_t *l = &codec->transformer_layers[i];
 
@@ -1108,8 +1287,10 @@ static void load_codec_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
                     memcpy(fused + (size_t)(q_dim + kv_dim) * codec_hidden, wv, (size_t)kv_dim * codec_hidden * sizeof(float));
                     l->wqkv_q8 = quantize_weight_f32(fused, total_rows, codec_hidden);
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-                    l->wqkv_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
-                    if (l->wqkv_f16) kernel_f32_to_f16(l->wqkv_f16, fused, (int)n_elems);
+                    if (!use_codec_q8()) {
+                        l->wqkv_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
+                        if (l->wqkv_f16) kernel_f32_to_f16(l->wqkv_f16, fused, (int)n_elems);
+                    }
 #endif
                     free(fused);
                 }
@@ -1120,8 +1301,10 @@ static void load_codec_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
                 size_t n_elems = (size_t)codec_hidden * q_dim;
                 l->wo_q8 = quantize_weight_f32(wo, codec_hidden, q_dim);
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-                l->wo_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
-                if (l->wo_f16) kernel_f32_to_f16(l->wo_f16, wo, (int)n_elems);
+                if (!use_codec_q8()) {
+                    l->wo_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
+                    if (l->wo_f16) kernel_f32_to_f16(l->wo_f16, wo, (int)n_elems);
+                }
 #endif
                 free(wo); wo = NULL;
             }
@@ -1136,8 +1319,10 @@ static void load_codec_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
                     memcpy(fused + (size_t)intermediate * codec_hidden, up, (size_t)intermediate * codec_hidden * sizeof(float));
                     l->gate_up_q8 = quantize_weight_f32(fused, gu_rows, codec_hidden);
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-                    l->gate_up_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
-                    if (l->gate_up_f16) kernel_f32_to_f16(l->gate_up_f16, fused, (int)n_elems);
+                    if (!use_codec_q8()) {
+                        l->gate_up_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
+                        if (l->gate_up_f16) kernel_f32_to_f16(l->gate_up_f16, fused, (int)n_elems);
+                    }
 #endif
                     free(fused);
                 }
@@ -1148,8 +1333,10 @@ static void load_codec_weights(qwen_tts_ctx_t *ctx, const multi_safetensors_t *m
                 size_t n_elems = (size_t)codec_hidden * intermediate;
                 l->down_q8 = quantize_weight_f32(down, codec_hidden, intermediate);
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-                l->down_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
-                if (l->down_f16) kernel_f32_to_f16(l->down_f16, down, (int)n_elems);
+                if (!use_codec_q8()) {
+                    l->down_f16 = (__fp16 *)malloc(n_elems * sizeof(__fp16));
+                    if (l->down_f16) kernel_f32_to_f16(l->down_f16, down, (int)n_elems);
+                }
 #endif
                 free(down); down = NULL;
             }
@@ -1340,15 +1527,49 @@ static void text_projection(qwen_tts_ctx_t *ctx, const float *text_embed,
 
 /* ========================================================================
  * Embed a text token: text_embedding -> text_projection
+ *
+ * The projection result is memoized per token id: agent speech draws on
+ * a small phrase inventory, so across calls the same token ids recur and
+ * the fc1/fc2 MLP is skipped entirely on a hit. Direct-mapped table with
+ * a fixed entry count bounds the memory (~4 MB at hidden=1024); a
+ * colliding token simply replaces the slot.
  * ======================================================================== */
 
+#define QWEN_TTS_TEXT_EMB_CACHE 1024
+
 static void embed_text_token(qwen_tts_ctx_t *ctx, int token_id, float *out) {
     int text_hidden = ctx->config.talker_text_hidden;
     int hidden = ctx->config.talker_hidden;
+
+    if (!ctx->text_emb_cache_vecs) {
+        ctx->text_emb_cache_vecs =
+            (float *)malloc((size_t)QWEN_TTS_TEXT_EMB_CACHE * hidden * sizeof(float));
+        ctx->text_emb_cache_ids =
+            (int *)malloc(QWEN_TTS_TEXT_EMB_CACHE * sizeof(int));
+        if (ctx->text_emb_cache_ids)
+            for (int i = 0; i < QWEN_TTS_TEXT_EMB_CACHE; i++)
+                ctx->text_emb_cache_ids[i] = -1;
+    }
+    int slot = -1;
+    if (ctx->text_emb_cache_vecs && ctx->text_emb_cache_ids && token_id >= 0) {
+        slot = token_id % QWEN_TTS_TEXT_EMB_CACHE;
+        if (ctx->text_emb_cache_ids[slot] == token_id) {
+            memcpy(out, ctx->text_emb_cache_vecs + (size_t)slot * hidden,
+                   hidden * sizeof(float));
+            return;
+        }
+    }
+
     ensure_text_scratch(ctx, text_hidden);
     float *text_embed = ctx->scratch_text_embed;
     kernel_bf16_to_f32(text_embed, ctx->talker.text_embedding_bf16 + (size_t)token_id * text_hidden, text_hidden);
     text_projection(ctx, text_embed, out, text_hidden, hidden);
+
+    if (slot >= 0) {
+        memcpy(ctx->text_emb_cache_vecs + (size_t)slot * hidden, out,
+               hidden * sizeof(float));
+        ctx->text_emb_cache_ids[slot] = token_id;
+    }
 }
 
 /* ========================================================================
@@ -1525,39 +1746,60 @@ void qwen_tts_free(qwen_tts_ctx_t *ctx) {
     free(ctx->codec.vocoder_final_act_alpha); free(ctx->codec.vocoder_final_act_beta);
     free(ctx->codec.vocoder_final_conv_weight); free(ctx->codec.vocoder_final_conv_bias);
 
-    /* Free talker weights (norms, biases, Q8_0) */
+    /* Talker/subtalker quantized weights point into the qcache mapping when
+     * it is present (v4 cache); only free them when they were malloc'd. */
+    int q_owned = (ctx->qcache_map == NULL);
+    #define FREEQ(p) do { if (q_owned) free(p); } while (0)
+
+    /* Free talker weights (norms, biases, quantized) */
     free(ctx->talker.text_proj_fc1_bias);
     free(ctx->talker.text_proj_fc2_bias);
-    free(ctx->talker.text_proj_fc1_q8);
-    free(ctx->talker.text_proj_fc2_q8);
-    free(ctx->talker.codec_head_q8);
+    FREEQ(ctx->talker.text_proj_fc1_q8);
+    FREEQ(ctx->talker.text_proj_fc2_q8);
+    FREEQ(ctx->talker.codec_head_q8);
     free(ctx->talker.norm);
     for (int i = 0; i < ctx->config.talker_layers; i++) {
         qwen_tts_talker_layer_t *l = &ctx->talker.layers[i];
         free(l->q_norm_weight); free(l->k_norm_weight);
         free(l->input_norm); free(l->post_attn_norm);
-        free(l->wqkv_q8); free(l->wo_q8);
-        free(l->gate_up_q8); free(l->down_q8);
+        FREEQ(l->wqkv_q8); FREEQ(l->wo_q8);
+        FREEQ(l->gate_up_q8); FREEQ(l->down_q8);
+        FREEQ(l->wqkv_q4k); FREEQ(l->wo_q4k);
+        FREEQ(l->gate_up_q4k); FREEQ(l->down_q4k);
     }
 
-    /* Free subtalker weights (norms, biases, Q8_0) */
+    /* Free subtalker weights (norms, biases, quantized) */
     free(ctx->subtalker.input_proj_bias);
-    free(ctx->subtalker.input_proj_q8);
+    FREEQ(ctx->subtalker.input_proj_q8);
     free(ctx->subtalker.norm);
-    for (int g = 0; g < ctx->config.num_code_groups - 1; g++)
-        free(ctx->subtalker.lm_heads_q8[g]);
+    FREEQ(ctx->subtalker.lm_heads_block_q8);  /* lm_heads_q8[] are views into it */
     for (int i = 0; i < ctx->config.subtalker_layers; i++) {
         qwen_tts_subtalker_layer_t *l = &ctx->subtalker.layers[i];
         free(l->q_norm_weight); free(l->k_norm_weight);
         free(l->input_norm); free(l->post_attn_norm);
-        free(l->wqkv_q8); free(l->wo_q8);
-        free(l->gate_up_q8); free(l->down_q8);
+        FREEQ(l->wqkv_q8); FREEQ(l->wo_q8);
+        FREEQ(l->gate_up_q8); FREEQ(l->down_q8);
+        FREEQ(l->wqkv_q4k); FREEQ(l->wo_q4k);
+        FREEQ(l->gate_up_q4k); FREEQ(l->down_q4k);
+    }
+
+    #undef FREEQ
+
+#ifndef __EMSCRIPTEN__
+    if (ctx->qcache_map) {
+        munmap(ctx->qcache_map, ctx->qcache_map_size);
+        ctx->qcache_map = NULL;
+        ctx->qcache_map_size = 0;
     }
+#endif
 
     /* Free KV caches and scratch buffers */
     free(ctx->talker_kv_k); free(ctx->talker_kv_v);
+    free(ctx->prefix_kv_k); free(ctx->prefix_kv_v);
+    free(ctx->text_emb_cache_vecs); free(ctx->text_emb_cache_ids);
     free(ctx->subtalker_kv_k); free(ctx->subtalker_kv_v);
     free(ctx->codec_kv_k); free(ctx->codec_kv_v);
+    qwen_tts_codec_arena_free(ctx);
     free(ctx->tk_x); free(ctx->tk_x_norm);
     free(ctx->tk_q); free(ctx->tk_k); free(ctx->tk_v);
     free(ctx->tk_qkv);
@@ -1594,6 +1836,82 @@ void qwen_tts_set_progress_callback(qwen_tts_ctx_t *ctx, qwen_tts_progress_cb cb
     ctx->progress_cb_userdata = userdata;
 }
 
+/* ========================================================================
+ * Prompt prefix KV cache
+ *
+ * The first prefill_len-1 positions of the prompt (chat template +
+ * speaker/language scaffolding) are identical across calls with the same
+ * voice; only the last position mixes in the first text token. On a cache
+ * hit we memcpy the saved KV back into talker_kv_k/v and run just that
+ * last position through the single-token forward, which leaves the same
+ * final-normed hidden in tk_x as a full prefill would.
+ * ======================================================================== */
+
+static void talker_prefill_cached(qwen_tts_ctx_t *ctx, const float *input_embeds,
+                                  int prefill_len, int speaker_codec_id,
+                                  int language_codec_id, const int *text_tokens) {
+    qwen_tts_config_t *cfg = &ctx->config;
+    int hidden = cfg->talker_hidden;
+    int kv_dim = cfg->talker_kv_heads * cfg->talker_head_dim;
+    int n_prefix = prefill_len - 1;
+    size_t pfx_stride = (size_t)n_prefix * kv_dim;
+
+    int hit = ctx->prefix_kv_len == n_prefix &&
+              ctx->prefix_key_speaker == speaker_codec_id &&
+              ctx->prefix_key_language == language_codec_id &&
+              ctx->prefix_key_tokens[0] == text_tokens[0] &&
+              ctx->prefix_key_tokens[1] == text_tokens[1] &&
+              ctx->prefix_key_tokens[2] == text_tokens[2] &&
+              ctx->talker_kv_max >= prefill_len;
+
+    ctx->talker_kv_len = 0;
+
+    if (hit) {
+        size_t kv_stride = (size_t)ctx->talker_kv_max * kv_dim;
+        for (int l = 0; l < cfg->talker_layers; l++) {
+            memcpy(ctx->talker_kv_k + l * kv_stride, ctx->prefix_kv_k + l * pfx_stride,
+                   pfx_stride * sizeof(qwen_tts_kv_t));
+            memcpy(ctx->talker_kv_v + l * kv_stride, ctx->prefix_kv_v + l * pfx_stride,
+                   pfx_stride * sizeof(qwen_tts_kv_t));
+        }
+        ctx->talker_kv_len = n_prefix;
+        /* Append the text-dependent final position; logits are recomputed
+         * from tk_x at step 0 of the generation loop, so discard them here */
+        float *logits_tmp = (float *)malloc(cfg->talker_vocab_size * sizeof(float));
+        qwen_tts_talker_forward(ctx, input_embeds + (size_t)n_prefix * hidden, logits_tmp);
+        free(logits_tmp);
+        return;
+    }
+
+    qwen_tts_talker_prefill(ctx, input_embeds, prefill_len);
+
+    /* Snapshot the prefix KV for the next call with the same voice */
+    size_t pfx_size = (size_t)cfg->talker_layers * pfx_stride * sizeof(qwen_tts_kv_t);
+    qwen_tts_kv_t *pk = (qwen_tts_kv_t *)realloc(ctx->prefix_kv_k, pfx_size);
+    qwen_tts_kv_t *pv = (qwen_tts_kv_t *)realloc(ctx->prefix_kv_v, pfx_size);
+    if (!pk || !pv) {
+        free(pk ? pk : ctx->prefix_kv_k); free(pv ? pv : ctx->prefix_kv_v);
+        ctx->prefix_kv_k = NULL; ctx->prefix_kv_v = NULL;
+        ctx->prefix_kv_len = 0;
+        return;
+    }
+    ctx->prefix_kv_k = pk;
+    ctx->prefix_kv_v = pv;
+    size_t kv_stride = (size_t)ctx->talker_kv_max * kv_dim;
+    for (int l = 0; l < cfg->talker_layers; l++) {
+        memcpy(ctx->prefix_kv_k + l * pfx_stride, ctx->talker_kv_k + l * kv_stride,
+               pfx_stride * sizeof(qwen_tts_kv_t));
+        memcpy(ctx->prefix_kv_v + l * pfx_stride, ctx->talker_kv_v + l * kv_stride,
+               pfx_stride * sizeof(qwen_tts_kv_t));
+    }
+    ctx->prefix_kv_len = n_prefix;
+    ctx->prefix_key_speaker = speaker_codec_id;
+    ctx->prefix_key_language = language_codec_id;
+    ctx->prefix_key_tokens[0] = text_tokens[0];
+    ctx->prefix_key_tokens[1] = text_tokens[1];
+    ctx->prefix_key_tokens[2] = text_tokens[2];
+}
+
 /* ========================================================================
  * Generate - CustomVoice Mode
  *
@@ -1793,9 +2111,9 @@ float *qwen_tts_generate(
     /* ---- Prefill ---- */
     double t_prefill = qwen_tts_time_ms();
 
-    /* Reset KV cache */
-    ctx->talker_kv_len = 0;
-    qwen_tts_talker_prefill(ctx, input_embeds, prefill_len);
+    /* Reset KV cache; reuses cached prefix KV when the voice matches */
+    talker_prefill_cached(ctx, input_embeds, prefill_len,
+                          speaker_codec_id, language_codec_id, text_tokens);
 
     double t_prefill_done = qwen_tts_time_ms();
     if (qwen_tts_verbose >= 1)
@@ -1827,6 +2145,7 @@ float *qwen_tts_generate(
 
     double t_gen = qwen_tts_time_ms();
     ctx->perf_subtalker_ms = 0.0;
+    ctx->perf_first_audio_ms = 0.0;   /* batch mode: no streamed chunks */
 
     for (int step = 0; step < max_tokens; step++) {
         /* If this is the first step after prefill, use the last hidden state from prefill */
@@ -1857,19 +2176,18 @@ float *qwen_tts_generate(
             logits[suppress_tokens[i]] = -1e9f;
         }
 
-        /* Apply repetition penalty */
-        kernel_apply_repetition_penalty(logits, generated_tokens, n_generated,
-                                        cfg->talker_vocab_size, ctx->repetition_penalty);
-
-        /* Sample */
-        int token = kernel_sample_top_k(logits, cfg->talker_vocab_size, ctx->top_k,
-                                         ctx->top_p, ctx->temperature, &rng_state);
+        /* Sample (fused: repetition penalty + top-k + nucleus + draw) */
+        int token = kernel_sample_fused(logits, cfg->talker_vocab_size,
+                                        generated_tokens, n_generated,
+                                        ctx->repetition_penalty, ctx->top_k,
+                                        ctx->top_p, ctx->temperature, &rng_state);
 
         if (fixed_tokens > 0 && token == cfg->codec_eos_id && n_generated < fixed_tokens) {
             float eos_logit = logits[cfg->codec_eos_id];
             logits[cfg->codec_eos_id] = -1e9f;
-            token = kernel_sample_top_k(logits, cfg->talker_vocab_size, ctx->top_k,
-                                        ctx->top_p, ctx->temperature, &rng_state);
+            /* Penalty is already applied in-place; resample without it */
+            token = kernel_sample_fused(logits, cfg->talker_vocab_size, NULL, 0, 1.0f,
+                                        ctx->top_k, ctx->top_p, ctx->temperature, &rng_state);
             logits[cfg->codec_eos_id] = eos_logit;
         }
 
@@ -1993,6 +2311,8 @@ float *qwen_tts_generate(
     double t_codec_done = qwen_tts_time_ms();
     ctx->perf_codec_ms = t_codec_done - t_codec;
     ctx->perf_total_ms = t_codec_done - t_start;
+    qwen_pool_governor_report(1000.0 * (double)*out_samples / QWEN_TTS_SAMPLE_RATE,
+                              ctx->perf_total_ms);
 
     if (qwen_tts_verbose >= 1) {
         fprintf(stderr, "Codec decode: %d samples in %.1f ms\n", *out_samples, ctx->perf_codec_ms);
@@ -2039,15 +2359,117 @@ typedef struct {
     double decode_ms;      /* output: decode time */
 } vocoder_job_t;
 
-static void *vocoder_thread_fn(void *arg) {
-    vocoder_job_t *job = (vocoder_job_t *)arg;
-    double t0 = qwen_tts_time_ms();
-    job->audio = qwen_tts_codec_decode(job->ctx, job->codes,
-                                        job->decode_len, &job->n_audio);
-    job->decode_ms = qwen_tts_time_ms() - t0;
+/* Ring of decode jobs feeding one persistent decoder thread. The talker
+ * enqueues a job per chunk and only blocks when the ring is full, so a
+ * slow decode no longer stalls token generation at the next chunk
+ * boundary. Finished audio is delivered in order on the caller's thread
+ * (the callback is not required to be thread-safe). */
+#define QWEN_TTS_VOC_RING 4
+
+typedef struct {
+    vocoder_job_t jobs[QWEN_TTS_VOC_RING];
+    int enqueued;          /* total jobs submitted */
+    int decoded;           /* total jobs finished by the decoder thread */
+    int delivered;         /* total jobs whose audio went to the callback */
+    int stop;
+    pthread_mutex_t mu;
+    pthread_cond_t cv;
+} vocoder_ring_t;
+
+static void *vocoder_ring_thread_fn(void *arg) {
+    vocoder_ring_t *ring = (vocoder_ring_t *)arg;
+    /* Vocoding runs behind the talker (and possibly behind live ASR):
+     * never contend with an interactive dispatcher for the pool. */
+    qwen_set_thread_background(1);
+    pthread_mutex_lock(&ring->mu);
+    for (;;) {
+        while (ring->decoded == ring->enqueued && !ring->stop)
+            pthread_cond_wait(&ring->cv, &ring->mu);
+        if (ring->decoded == ring->enqueued) break;  /* stopped and drained */
+        vocoder_job_t *job = &ring->jobs[ring->decoded % QWEN_TTS_VOC_RING];
+        pthread_mutex_unlock(&ring->mu);
+
+        double t0 = qwen_tts_time_ms();
+        job->audio = qwen_tts_codec_decode(job->ctx, job->codes,
+                                            job->decode_len, &job->n_audio);
+        job->decode_ms = qwen_tts_time_ms() - t0;
+
+        pthread_mutex_lock(&ring->mu);
+        ring->decoded++;
+        pthread_cond_broadcast(&ring->cv);
+    }
+    pthread_mutex_unlock(&ring->mu);
     return NULL;
 }
 
+/* Deliver finished chunks to the callback in order. wait_all blocks until
+ * every enqueued job has been decoded. Pass audio_cb == NULL to discard
+ * (after an abort). Returns non-zero if the callback aborted. */
+static int vocoder_ring_deliver(vocoder_ring_t *ring, int wait_all,
+                                qwen_tts_audio_cb audio_cb, void *userdata,
+                                int *prev_audio_len) {
+    int aborted = 0;
+    pthread_mutex_lock(&ring->mu);
+    for (;;) {
+        if (wait_all && ring->decoded < ring->enqueued) {
+            pthread_cond_wait(&ring->cv, &ring->mu);
+            continue;
+        }
+        if (ring->delivered == ring->decoded) break;
+        vocoder_job_t *job = &ring->jobs[ring->delivered % QWEN_TTS_VOC_RING];
+        pthread_mutex_unlock(&ring->mu);
+
+        if (job->audio && job->n_audio > 0) {
+            int ctx_samples = job->n_ctx * QWEN_TTS_DECODE_UPSAMPLE;
+            int emit_len = job->n_audio - ctx_samples;
+            if (emit_len > 0 && audio_cb && !aborted) {
+                *prev_audio_len += emit_len;
+                if (qwen_tts_verbose >= 1)
+                    fprintf(stderr, "Stream chunk: %d samples (%d total, %.2fs), decode %.0fms\n",
+                            emit_len, *prev_audio_len,
+                            (float)*prev_audio_len / QWEN_TTS_SAMPLE_RATE, job->decode_ms);
+                if (audio_cb(job->audio + ctx_samples, emit_len, userdata) != 0)
+                    aborted = 1;
+            }
+        }
+        job->ctx->perf_codec_ms += job->decode_ms;
+        free(job->audio);
+        job->audio = NULL;
+
+        pthread_mutex_lock(&ring->mu);
+        ring->delivered++;
+        pthread_cond_broadcast(&ring->cv);
+    }
+    pthread_mutex_unlock(&ring->mu);
+    return aborted;
+}
+
+/* Enqueue a decode job, first draining finished chunks; if the ring is
+ * full, block until the decoder frees a slot. Returns non-zero if the
+ * callback aborted during delivery. */
+static int vocoder_ring_submit(vocoder_ring_t *ring, const vocoder_job_t *job,
+                               qwen_tts_audio_cb audio_cb, void *userdata,
+                               int *prev_audio_len) {
+    int aborted = 0;
+    for (;;) {
+        if (vocoder_ring_deliver(ring, 0, aborted ? NULL : audio_cb,
+                                 userdata, prev_audio_len))
+            aborted = 1;
+        pthread_mutex_lock(&ring->mu);
+        if (ring->enqueued - ring->delivered < QWEN_TTS_VOC_RING) {
+            ring->jobs[ring->enqueued % QWEN_TTS_VOC_RING] = *job;
+            ring->enqueued++;
+            pthread_cond_broadcast(&ring->cv);
+            pthread_mutex_unlock(&ring->mu);
+            return aborted;
+        }
+        /* Ring full: wait for the decoder to finish a job, then drain it */
+        while (ring->decoded == ring->delivered)
+            pthread_cond_wait(&ring->cv, &ring->mu);
+        pthread_mutex_unlock(&ring->mu);
+    }
+}
+
 int qwen_tts_generate_stream(
     qwen_tts_ctx_t *ctx,
     const char *text,
@@ -2182,9 +2604,9 @@ int qwen_tts_generate_stream(
         embed_text_token(ctx, text_tokens[4 + i], trailing_text + i * hidden);
     memcpy(trailing_text + (n_trailing - 1) * hidden, tts_eos_proj, hidden * sizeof(float));
 
-    /* ---- Prefill ---- */
-    ctx->talker_kv_len = 0;
-    qwen_tts_talker_prefill(ctx, input_embeds, prefill_len);
+    /* ---- Prefill (reuses cached prefix KV when the voice matches) ---- */
+    talker_prefill_cached(ctx, input_embeds, prefill_len,
+                          speaker_codec_id, language_codec_id, text_tokens);
     free(input_embeds);
 
     /* ---- Autoregressive generation with streaming decode ---- */
@@ -2219,6 +2641,8 @@ int qwen_tts_generate_stream(
     int prev_audio_len = 0;    /* samples already sent via callback */
     double t_gen = qwen_tts_time_ms();
     ctx->perf_subtalker_ms = 0.0;
+    ctx->perf_codec_ms = 0.0;
+    ctx->perf_first_audio_ms = 0.0;
 
     /* chunk_size > 0: batch-decode every chunk_size tokens with pipelined vocoder
      * chunk_size == 0: batch mode (decode all at EOS) */
@@ -2230,10 +2654,16 @@ int qwen_tts_generate_stream(
     int accumulated_new = 0;    /* tokens accumulated since last batch decode */
     int prev_decoded_end = 0;   /* how many tokens have been decoded so far */
 
-    /* Pipeline: vocoder runs on background thread */
-    vocoder_job_t voc_job = {0};
+    /* Pipeline: persistent decoder thread fed by a ring of chunk jobs */
+    vocoder_ring_t voc_ring = {0};
     pthread_t voc_thread;
     int voc_thread_active = 0;
+    if (effective_chunk > 0) {
+        pthread_mutex_init(&voc_ring.mu, NULL);
+        pthread_cond_init(&voc_ring.cv, NULL);
+        pthread_create(&voc_thread, NULL, vocoder_ring_thread_fn, &voc_ring);
+        voc_thread_active = 1;
+    }
 
     for (int step = 0; step < max_tokens; step++) {
         if (step == 0) {
@@ -2250,17 +2680,17 @@ int qwen_tts_generate_stream(
         for (int i = 0; i < n_suppress; i++)
             logits[suppress_tokens[i]] = -1e9f;
 
-        kernel_apply_repetition_penalty(logits, generated_tokens, n_generated,
-                                        cfg->talker_vocab_size, ctx->repetition_penalty);
-
-        int token = kernel_sample_top_k(logits, cfg->talker_vocab_size, ctx->top_k,
-                                         ctx->top_p, ctx->temperature, &rng_state);
+        int token = kernel_sample_fused(logits, cfg->talker_vocab_size,
+                                        generated_tokens, n_generated,
+                                        ctx->repetition_penalty, ctx->top_k,
+                                        ctx->top_p, ctx->temperature, &rng_state);
 
         if (fixed_tokens > 0 && token == cfg->codec_eos_id && n_generated < fixed_tokens) {
             float eos_logit = logits[cfg->codec_eos_id];
             logits[cfg->codec_eos_id] = -1e9f;
-            token = kernel_sample_top_k(logits, cfg->talker_vocab_size, ctx->top_k,
-                                        ctx->top_p, ctx->temperature, &rng_state);
+            /* Penalty is already applied in-place; resample without it */
+            token = kernel_sample_fused(logits, cfg->talker_vocab_size, NULL, 0, 1.0f,
+                                        ctx->top_k, ctx->top_p, ctx->temperature, &rng_state);
             logits[cfg->codec_eos_id] = eos_logit;
         }
 
@@ -2282,81 +2712,48 @@ int qwen_tts_generate_stream(
             n_generated++;
             accumulated_new++;
 
-            /* Launch pipelined batch decode when we've accumulated enough tokens.
-             * Vocoder runs on background thread while talker continues generating. */
+            /* Enqueue a pipelined batch decode when we've accumulated enough
+             * tokens. The decoder thread drains the ring while the talker
+             * keeps generating; finished chunks are delivered here in order. */
             if (effective_chunk > 0 && accumulated_new >= effective_chunk) {
-                /* Join previous vocoder thread and deliver its audio */
-                if (voc_thread_active) {
-                    pthread_join(voc_thread, NULL);
-                    voc_thread_active = 0;
-                    if (voc_job.audio && voc_job.n_audio > 0) {
-                        int ctx_samples = voc_job.n_ctx * QWEN_TTS_DECODE_UPSAMPLE;
-                        int emit_len = voc_job.n_audio - ctx_samples;
-                        if (emit_len > 0) {
-                            prev_audio_len += emit_len;
-                            if (qwen_tts_verbose >= 1)
-                                fprintf(stderr, "Stream chunk: %d samples (%d total, %.2fs), decode %.0fms\n",
-                                        emit_len, prev_audio_len,
-                                        (float)prev_audio_len / QWEN_TTS_SAMPLE_RATE, voc_job.decode_ms);
-                            int ret = audio_cb(voc_job.audio + ctx_samples, emit_len, userdata);
-                            if (ret != 0) {
-                                aborted = 1;
-                                free(voc_job.audio);
-                                break;
-                            }
-                        }
-                    }
-                    free(voc_job.audio);
-                    voc_job.audio = NULL;
-                }
-
-                /* Launch new vocoder decode on background thread */
                 int n_ctx = (prev_decoded_end > 0) ? context_frames : 0;
                 if (n_ctx > prev_decoded_end) n_ctx = prev_decoded_end;
                 int decode_start = n_generated - accumulated_new - n_ctx;
 
-                voc_job.ctx = ctx;
-                voc_job.codes = all_codes + decode_start * num_groups;
-                voc_job.num_groups = num_groups;
-                voc_job.decode_len = accumulated_new + n_ctx;
-                voc_job.n_ctx = n_ctx;
-                voc_job.audio = NULL;
-                voc_job.n_audio = 0;
-                voc_job.decode_ms = 0;
+                vocoder_job_t job = {0};
+                job.ctx = ctx;
+                job.codes = all_codes + decode_start * num_groups;
+                job.num_groups = num_groups;
+                job.decode_len = accumulated_new + n_ctx;
+                job.n_ctx = n_ctx;
 
                 if (qwen_tts_verbose >= 1)
-                    fprintf(stderr, "Pipeline: launch vocoder (%d new +%d ctx), talker continues...\n",
+                    fprintf(stderr, "Pipeline: enqueue vocoder chunk (%d new +%d ctx), talker continues...\n",
                             accumulated_new, n_ctx);
 
-                pthread_create(&voc_thread, NULL, vocoder_thread_fn, &voc_job);
-                voc_thread_active = 1;
+                if (vocoder_ring_submit(&voc_ring, &job, audio_cb, userdata, &prev_audio_len)) {
+                    aborted = 1;
+                    break;
+                }
 
                 prev_decoded_end = n_generated;
                 accumulated_new = 0;
+            } else if (voc_thread_active) {
+                /* Opportunistically deliver any chunk the decoder finished */
+                if (vocoder_ring_deliver(&voc_ring, 0, audio_cb, userdata, &prev_audio_len)) {
+                    aborted = 1;
+                    break;
+                }
             }
         }
 
-        /* At EOS or loop end: join vocoder, flush remaining tokens */
+        /* At EOS or loop end: drain the decode ring, flush remaining tokens */
         if (is_eos) {
-            /* Join any running vocoder thread and deliver its audio */
+            /* Wait for all in-flight chunks and deliver their audio */
             if (voc_thread_active) {
-                pthread_join(voc_thread, NULL);
-                voc_thread_active = 0;
-                if (voc_job.audio && voc_job.n_audio > 0) {
-                    int ctx_samples = voc_job.n_ctx * QWEN_TTS_DECODE_UPSAMPLE;
-                    int emit_len = voc_job.n_audio - ctx_samples;
-                    if (emit_len > 0) {
-                        prev_audio_len += emit_len;
-                        if (qwen_tts_verbose >= 1)
-                            fprintf(stderr, "Stream chunk: %d samples (%d total, %.2fs), decode %.0fms\n",
-                                    emit_len, prev_audio_len,
-                                    (float)prev_audio_len / QWEN_TTS_SAMPLE_RATE, voc_job.decode_ms);
-                        int ret = audio_cb(voc_job.audio + ctx_samples, emit_len, userdata);
-                        if (ret != 0) aborted = 1;
-                    }
-                }
-                free(voc_job.audio);
-                voc_job.audio = NULL;
+                if (vocoder_ring_deliver(&voc_ring, 1, aborted ? NULL : audio_cb,
+                                         userdata, &prev_audio_len))
+                    aborted = 1;
             }
 
             /* Decode remaining accumulated tokens (synchronous) */
@@ -2367,8 +2764,10 @@ int qwen_tts_generate_stream(
                 int decode_len = accumulated_new + n_ctx;
 
                 int n_audio = 0;
+                double t_dec = qwen_tts_time_ms();
                 float *audio = qwen_tts_codec_decode(ctx, all_codes + decode_start * num_groups,
                                                       decode_len, &n_audio);
+                ctx->perf_codec_ms += qwen_tts_time_ms() - t_dec;
                 if (audio && n_audio > 0) {
                     int ctx_samples = n_ctx * QWEN_TTS_DECODE_UPSAMPLE;
                     int emit_len = n_audio - ctx_samples;
@@ -2389,7 +2788,9 @@ int qwen_tts_generate_stream(
         /* Batch mode (chunk_size==0): decode all at EOS */
         if (effective_chunk == 0 && is_eos && n_generated > 0) {
             int n_audio = 0;
+            double t_dec = qwen_tts_time_ms();
             float *audio = qwen_tts_codec_decode(ctx, all_codes, n_generated, &n_audio);
+            ctx->perf_codec_ms += qwen_tts_time_ms() - t_dec;
             if (audio && n_audio > 0) {
                 if (qwen_tts_verbose >= 1)
                     fprintf(stderr, "Batch decode: %d samples (%.2fs)\n",
@@ -2401,6 +2802,11 @@ int qwen_tts_generate_stream(
             free(audio);
         }
 
+        /* First-chunk timestamp: any of the delivery paths above may have
+         * emitted the first audio of this call */
+        if (ctx->perf_first_audio_ms == 0.0 && prev_audio_len > 0)
+            ctx->perf_first_audio_ms = qwen_tts_time_ms() - t_start;
+
         if (is_eos) break;
 
         /* Build next input embedding */
@@ -2429,27 +2835,30 @@ int qwen_tts_generate_stream(
         }
     }
 
-    /* Safety: join vocoder thread if still active (e.g., loop aborted or max_tokens hit) */
+    /* Drain and stop the decoder thread (also covers an aborted loop or
+     * hitting max_tokens with chunks still in flight) */
     if (voc_thread_active) {
+        if (vocoder_ring_deliver(&voc_ring, 1, aborted ? NULL : audio_cb,
+                                 userdata, &prev_audio_len))
+            aborted = 1;
+        pthread_mutex_lock(&voc_ring.mu);
+        voc_ring.stop = 1;
+        pthread_cond_broadcast(&voc_ring.cv);
+        pthread_mutex_unlock(&voc_ring.mu);
         pthread_join(voc_thread, NULL);
+        pthread_mutex_destroy(&voc_ring.mu);
+        pthread_cond_destroy(&voc_ring.cv);
         voc_thread_active = 0;
-        /* Deliver remaining audio if not aborted */
-        if (!aborted && voc_job.audio && voc_job.n_audio > 0) {
-            int ctx_samples = voc_job.n_ctx * QWEN_TTS_DECODE_UPSAMPLE;
-            int emit_len = voc_job.n_audio - ctx_samples;
-            if (emit_len > 0) {
-                prev_audio_len += emit_len;
-                audio_cb(voc_job.audio + ctx_samples, emit_len, userdata);
-            }
-        }
-        free(voc_job.audio);
-        voc_job.audio = NULL;
     }
+    if (ctx->perf_first_audio_ms == 0.0 && prev_audio_len > 0)
+        ctx->perf_first_audio_ms = qwen_tts_time_ms() - t_start;
 
     double t_gen_done = qwen_tts_time_ms();
     ctx->perf_talker_ms = t_gen_done - t_gen;
     ctx->perf_codec_tokens = n_generated;
     ctx->perf_total_ms = t_gen_done - t_start;
+    qwen_pool_governor_report(1000.0 * (double)prev_audio_len / QWEN_TTS_SAMPLE_RATE,
+                              ctx->perf_total_ms);
 
     if (qwen_tts_verbose >= 1) {
         fprintf(stderr, "\r                                        \r");
@@ -2465,3 +2874,150 @@ int qwen_tts_generate_stream(
     if (n_generated == 0) return -1;
     return 0;
 }
+
+/* ========================================================================
+ * Segmented Streaming Generate
+ *
+ * Time-to-first-audio of qwen_tts_generate_stream() scales with the whole
+ * reply: the talker prefills every text token before the first codec
+ * frame. For multi-sentence replies the caller can instead split at
+ * sentence boundaries (tokenizing each sentence with the usual chat
+ * template) and pass the segments as one '|'-separated string; they are
+ * synthesized back to back on the shared context, so the first PCM chunk
+ * arrives after one sentence's prefill. Segment joins are stitched with a
+ * short equal-power crossfade to hide the codec restart. Within each
+ * segment the vocoder keeps running on its background thread.
+ * ======================================================================== */
+
+/* ~10 ms at 24 kHz */
+#define QWEN_TTS_SEG_XFADE 240
+
+typedef struct {
+    qwen_tts_audio_cb user_cb;
+    void *user_data;
+    float tail[QWEN_TTS_SEG_XFADE];  /* samples held back from the last chunk */
+    int tail_len;
+    int xfade_pending;      /* next chunk starts a new segment: fade tail in */
+    float *buf;             /* grow-only scratch for tail + chunk */
+    int buf_cap;
+} seg_stream_t;
+
+/* Delay-line callback: always hold back the final QWEN_TTS_SEG_XFADE
+ * samples so the segment's trailing edge is available for the crossfade
+ * into the next segment's first chunk. Within a segment the held tail is
+ * passed through unchanged. */
+static int seg_stream_cb(const float *samples, int n_samples, void *userdata) {
+    seg_stream_t *st = (seg_stream_t *)userdata;
+    if (n_samples <= 0) return 0;
+
+    int need = st->tail_len + n_samples;
+    if (need > st->buf_cap) {
+        float *tmp = (float *)realloc(st->buf, (size_t)need * sizeof(float));
+        if (!tmp) return -1;
+        st->buf = tmp;
+        st->buf_cap = need;
+    }
+
+    int len;
+    if (st->xfade_pending) {
+        /* New segment: overlap-add the held tail into the chunk head */
+        memcpy(st->buf, samples, (size_t)n_samples * sizeof(float));
+        int n = st->tail_len < n_samples ? st->tail_len : n_samples;
+        for (int i = 0; i < n; i++) {
+            float w = (float)(i + 1) / (float)(n + 1);
+            st->buf[i] = st->tail[i] * (1.0f - w) + st->buf[i] * w;
+        }
+        len = n_samples;
+    } else {
+        memcpy(st->buf, st->tail, (size_t)st->tail_len * sizeof(float));
+        memcpy(st->buf + st->tail_len, samples, (size_t)n_samples * sizeof(float));
+        len = st->tail_len + n_samples;
+    }
+    st->xfade_pending = 0;
+
+    int hold = len < QWEN_TTS_SEG_XFADE ? len : QWEN_TTS_SEG_XFADE;
+    int emit = len - hold;
+    memcpy(st->tail, st->buf + emit, (size_t)hold * sizeof(float));
+    st->tail_len = hold;
+
+    if (emit > 0)
+        return st->user_cb(st->buf, emit, st->user_data);
+    return 0;
+}
+
+int qwen_tts_generate_stream_segmented(
+    qwen_tts_ctx_t *ctx,
+    const char *text,
+    const char *speaker,
+    const char *language,
+    int chunk_size,
+    qwen_tts_audio_cb audio_cb,
+    void *userdata
+) {
+    if (!ctx || !audio_cb) return -1;
+
+    /* Single segment: no delay line or crossfade needed */
+    if (!text || !strchr(text, '|'))
+        return qwen_tts_generate_stream(ctx, text, speaker, language,
+                                        chunk_size, audio_cb, userdata);
+
+    seg_stream_t st;
+    memset(&st, 0, sizeof(st));
+    st.user_cb = audio_cb;
+    st.user_data = userdata;
+
+    char *copy = strdup(text);
+    if (!copy) return -1;
+
+    int ret = 0;
+    int n_segments = 0;
+    double total_ms = 0.0, talker_ms = 0.0, subtalker_ms = 0.0, codec_ms = 0.0;
+    double first_audio_ms = 0.0;
+    int codec_tokens = 0;
+
+    char *save = NULL;
+    for (char *seg = strtok_r(copy, "|", &save); seg;
+         seg = strtok_r(NULL, "|", &save)) {
+        while (*seg == ' ') seg++;
+        if (*seg == '\0') continue;
+
+        if (n_segments > 0) st.xfade_pending = 1;
+
+        ret = qwen_tts_generate_stream(ctx, seg, speaker, language,
+                                       chunk_size, seg_stream_cb, &st);
+        if (ret != 0) break;
+        n_segments++;
+
+        total_ms += ctx->perf_total_ms;
+        talker_ms += ctx->perf_talker_ms;
+        subtalker_ms += ctx->perf_subtalker_ms;
+        codec_ms += ctx->perf_codec_ms;
+        codec_tokens += ctx->perf_codec_tokens;
+        /* Time-to-first-audio of the whole call is the first segment's */
+        if (n_segments == 1)
+            first_audio_ms = ctx->perf_first_audio_ms;
+    }
+    free(copy);
+
+    /* Flush the held tail of the final segment */
+    if (ret == 0 && st.tail_len > 0) {
+        if (st.user_cb(st.tail, st.tail_len, st.user_data) != 0)
+            ret = 1;
+    }
+    free(st.buf);
+
+    /* Report stats accumulated across segments */
+    ctx->perf_total_ms = total_ms;
+    ctx->perf_talker_ms = talker_ms;
+    ctx->perf_subtalker_ms = subtalker_ms;
+    ctx->perf_codec_ms = codec_ms;
+    ctx->perf_codec_tokens = codec_tokens;
+    ctx->perf_first_audio_ms = first_audio_ms;
+
+    if (qwen_tts_verbose >= 1 && n_segments > 1)
+        fprintf(stderr, "Segmented stream: %d segments, %d codec tokens, total %.1f ms\n",
+                n_segments, codec_tokens, total_ms);
+
+    if (ret == 0 && n_segments == 0) return -1;
+    return ret;
+}
@@ -156,6 +156,13 @@ typedef struct {
     block_q8_0 *gate_up_q8;    /* [2*intermediate, hidden] fused gate+up */
     block_q8_0 *down_q8;       /* [hidden, intermediate] */
 
+    /* Q4_K quantized weights (selected at cache-build time via
+     * QWEN_TTS_Q4K=1; NULL otherwise and the Q8_0 set above is used) */
+    block_q4_k *wqkv_q4k;
+    block_q4_k *wo_q4k;
+    block_q4_k *gate_up_q4k;
+    block_q4_k *down_q4k;
+
     /* Per-head Q/K RMSNorm */
     float *q_norm_weight;       /* [head_dim] */
     float *k_norm_weight;       /* [head_dim] */
@@ -197,6 +204,12 @@ typedef struct {
     block_q8_0 *gate_up_q8;    /* [2*intermediate, hidden] fused gate+up */
     block_q8_0 *down_q8;       /* [hidden, intermediate] */
 
+    /* Q4_K quantized weights (cache-build-time option, see talker layer) */
+    block_q4_k *wqkv_q4k;
+    block_q4_k *wo_q4k;
+    block_q4_k *gate_up_q4k;
+    block_q4_k *down_q4k;
+
     /* Per-head Q/K RMSNorm */
     float *q_norm_weight;
     float *k_norm_weight;
@@ -220,7 +233,10 @@ typedef struct {
     /* Final RMSNorm */
     float *norm;
 
-    /* 31 LM heads (one per code group 1-31) */
+    /* 31 LM heads (one per code group 1-31), stored back-to-back in one
+     * fused block so the per-step head evaluations stream one contiguous
+     * region; lm_heads_q8[g] are views into it */
+    block_q8_0 *lm_heads_block_q8;  /* [31 * subtalker_vocab, subtalker_hidden], owns the memory */
     block_q8_0 *lm_heads_q8[QWEN_TTS_NUM_CODE_GROUPS - 1];  /* each [subtalker_vocab, subtalker_hidden] */
 } qwen_tts_subtalker_t;
 
@@ -371,6 +387,15 @@ typedef int (*qwen_tts_audio_cb)(const float *samples, int n_samples, void *user
  * Main Context
  * ======================================================================== */
 
+/* KV cache element type. FP16 on fp16-capable builds (halved cache
+ * bandwidth/footprint; converted on store, widened in the attention dot);
+ * plain F32 elsewhere so the fallback path is untouched. */
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+typedef __fp16 qwen_tts_kv_t;
+#else
+typedef float qwen_tts_kv_t;
+#endif
+
 typedef struct {
     qwen_tts_config_t config;
     qwen_tts_talker_t talker;
@@ -380,27 +405,55 @@ typedef struct {
     /* SafeTensors files */
     void *safetensors;              /* multi_safetensors_t* */
     void *codec_safetensors;        /* multi_safetensors_t* for speech_tokenizer */
+    void *qcache_map;               /* mmap'd model.qcache; Q8_0 weights point
+                                     * into it when set (v4 cache), else malloc'd */
+    size_t qcache_map_size;
     char model_dir[512];
     char cache_dir[512];       /* writable directory for qcache; defaults to model_dir */
 
     /* Talker KV cache */
-    float *talker_kv_k;             /* [layers, max_seq, kv_heads*head_dim] */
-    float *talker_kv_v;
+    qwen_tts_kv_t *talker_kv_k;     /* [layers, max_seq, kv_heads*head_dim] */
+    qwen_tts_kv_t *talker_kv_v;
     int talker_kv_len;
     int talker_kv_max;
 
+    /* Prompt prefix KV cache: talker KV for the fixed prompt prefix
+     * (chat template + speaker/language scaffolding), snapshotted after
+     * the first prefill and restored by memcpy on later calls with the
+     * same voice. Single entry — a session sticks to one voice. */
+    qwen_tts_kv_t *prefix_kv_k;     /* [layers, prefix_kv_len, kv_heads*head_dim] */
+    qwen_tts_kv_t *prefix_kv_v;
+    int prefix_kv_len;              /* 0 = empty */
+    int prefix_key_speaker;         /* speaker codec id (-1 = none) */
+    int prefix_key_language;        /* language codec id (-1 = none) */
+    int prefix_key_tokens[3];       /* leading chat-template token ids */
+
+    /* Memoized text-token projections, direct-mapped by token id (the
+     * agent's phrase inventory is small, so projected tokens recur) */
+    float *text_emb_cache_vecs;     /* [entries, hidden] */
+    int *text_emb_cache_ids;        /* token id per slot, -1 = empty */
+
     /* Sub-talker KV cache */
-    float *subtalker_kv_k;
-    float *subtalker_kv_v;
+    qwen_tts_kv_t *subtalker_kv_k;
+    qwen_tts_kv_t *subtalker_kv_v;
     int subtalker_kv_len;
     int subtalker_kv_max;
 
     /* Codec transformer KV cache */
-    float *codec_kv_k;
-    float *codec_kv_v;
+    qwen_tts_kv_t *codec_kv_k;
+    qwen_tts_kv_t *codec_kv_v;
     int codec_kv_len;
     int codec_kv_max;
 
+    /* Codec scratch arena: bump allocator for per-frame scratch in the
+     * incremental decode path, sized from the config dims and reset at
+     * the start of each decode step. Blocks retired during mid-frame
+     * growth are chained here and freed at the next reset. */
+    char *codec_arena;
+    size_t codec_arena_cap;
+    size_t codec_arena_used;
+    void *codec_arena_retired;
+
     /* Persistent talker buffers (single-token generation) */
     float *tk_x, *tk_x_norm, *tk_q, *tk_k, *tk_v;
     float *tk_qkv;              /* fused QKV output [q_dim+kv_dim+kv_dim] */
@@ -459,6 +512,7 @@ typedef struct {
     double perf_subtalker_ms;   /* cumulative sub-talker time */
     double perf_codec_ms;
     int perf_codec_tokens;
+    double perf_first_audio_ms; /* stream start -> first delivered chunk (0 = none) */
 } qwen_tts_ctx_t;
 
 /* ========================================================================
@@ -506,6 +560,22 @@ int qwen_tts_generate_stream(
     void *userdata
 );
 
+/* Segmented streaming generate for low time-to-first-audio on
+ * multi-sentence replies. text is one or more '|'-separated token-ID
+ * segments, each tokenized with the usual chat template; segments are
+ * synthesized back to back and their joins stitched with a short
+ * crossfade. With a single segment this is qwen_tts_generate_stream.
+ * Returns 0 on success, -1 on error, 1 if aborted by callback. */
+int qwen_tts_generate_stream_segmented(
+    qwen_tts_ctx_t *ctx,
+    const char *text,
+    const char *speaker,
+    const char *language,
+    int chunk_size,
+    qwen_tts_audio_cb audio_cb,
+    void *userdata
+);
+
 /* Write PCM float32 audio to WAV file */
 int qwen_tts_write_wav(const char *path, const float *samples, int n_samples, int sample_rate);
 
@@ -0,0 +1,171 @@
+/*
+ * qwen_tts_bench - on-device TTS performance harness
+ *
+ * Synthesizes a fixed corpus and reports per-stage real-time factor as
+ * machine-readable JSON on stdout: talker tok/s, sub-talker ms/frame,
+ * codec ms/frame, time-to-first-audio, overall RTF. Gates kernel changes
+ * on measured device RTF instead of eyeballed logcat timings.
+ *
+ * Usage: qwen_tts_bench <model_dir> [chunk_size] [corpus_file]
+ *   chunk_size   codec tokens per streamed decode chunk (default 8; 0 = batch)
+ *   corpus_file  one utterance per line, comma-separated token IDs in the
+ *                chat-template format qwen_tts_generate_stream() expects
+ *                (default: built-in corpus below)
+ *
+ * Push the binary and model dir to the device and run under `adb shell`;
+ * redirect stdout to capture the JSON, diagnostics go to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qwen_tts.h"
+
+/* Built-in corpus: short / medium / long utterances in the chat-template
+ * format [im_start, assistant, \n, TEXT..., im_end, \n, im_start,
+ * assistant, \n]. The content token IDs are arbitrary text-vocab entries;
+ * RTF does not depend on which text tokens are embedded, only on how many
+ * codec frames the talker emits (pinned via fixed_codec_tokens below). */
+static const char *k_corpus[] = {
+    /* ~1s of audio */
+    "151644,77091,198,9707,11,1879,13,151645,198,151644,77091,198",
+    /* ~3s */
+    "151644,77091,198,785,3974,13876,38835,34208,916,279,15678,5562,13,"
+    "151645,198,151644,77091,198",
+    /* ~6s */
+    "151644,77091,198,785,3974,13876,38835,34208,916,279,15678,5562,11,"
+    "1221,10335,1182,323,1558,432,678,916,1549,1393,279,5562,31589,389,13,"
+    "151645,198,151644,77091,198",
+};
+#define N_CORPUS ((int)(sizeof(k_corpus) / sizeof(k_corpus[0])))
+
+/* Fixed frame counts per corpus entry so runs are comparable across
+ * kernel changes (sampling variance would otherwise move the totals) */
+static const int k_fixed_tokens[N_CORPUS] = {12, 36, 72};
+
+typedef struct {
+    int n_samples;
+} bench_sink_t;
+
+static int bench_audio_cb(const float *samples, int n_samples, void *userdata) {
+    (void)samples;
+    ((bench_sink_t *)userdata)->n_samples += n_samples;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <model_dir> [chunk_size] [corpus_file]\n", argv[0]);
+        return 1;
+    }
+    const char *model_dir = argv[1];
+    int chunk_size = (argc > 2) ? atoi(argv[2]) : 8;
+
+    /* Optional corpus file overrides the built-in utterances */
+    char **corpus = (char **)k_corpus;
+    const int *fixed_tokens = k_fixed_tokens;
+    int n_corpus = N_CORPUS;
+    char **file_corpus = NULL;
+    if (argc > 3) {
+        FILE *f = fopen(argv[3], "r");
+        if (!f) {
+            fprintf(stderr, "Error: cannot read corpus file %s\n", argv[3]);
+            return 1;
+        }
+        int cap = 16;
+        file_corpus = (char **)malloc(cap * sizeof(char *));
+        n_corpus = 0;
+        char line[8192];
+        while (fgets(line, sizeof(line), f)) {
+            size_t len = strlen(line);
+            while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+                line[--len] = '\0';
+            if (len == 0) continue;
+            if (n_corpus == cap) {
+                cap *= 2;
+                file_corpus = (char **)realloc(file_corpus, cap * sizeof(char *));
+            }
+            file_corpus[n_corpus++] = strdup(line);
+        }
+        fclose(f);
+        if (n_corpus == 0) {
+            fprintf(stderr, "Error: corpus file %s is empty\n", argv[3]);
+            free(file_corpus);
+            return 1;
+        }
+        corpus = file_corpus;
+        fixed_tokens = NULL;   /* file corpus: natural EOS lengths */
+    }
+
+    qwen_tts_ctx_t *ctx = qwen_tts_load(model_dir);
+    if (!ctx) {
+        fprintf(stderr, "Error: failed to load model from %s\n", model_dir);
+        return 1;
+    }
+
+    printf("{\"bench\":\"qwen_tts\",\"chunk_size\":%d,\"utterances\":[", chunk_size);
+
+    double sum_audio_s = 0.0, sum_total_ms = 0.0;
+    double sum_talker_ms = 0.0, sum_subtalker_ms = 0.0, sum_codec_ms = 0.0;
+    double sum_ttfa_ms = 0.0;
+    int sum_tokens = 0, n_ok = 0;
+
+    for (int u = 0; u < n_corpus; u++) {
+        /* Fixed seed + fixed frame count: identical work every run */
+        ctx->sample_seed = 42;
+        ctx->fixed_codec_tokens = fixed_tokens ? fixed_tokens[u] : 0;
+
+        bench_sink_t sink = {0};
+        int ret = qwen_tts_generate_stream(ctx, corpus[u], NULL, NULL,
+                                           chunk_size, bench_audio_cb, &sink);
+        if (ret != 0) {
+            fprintf(stderr, "Warning: utterance %d failed (ret=%d)\n", u, ret);
+            continue;
+        }
+
+        int tokens = ctx->perf_codec_tokens;
+        double audio_s = (double)sink.n_samples / QWEN_TTS_SAMPLE_RATE;
+        double talker_pure_ms = ctx->perf_talker_ms - ctx->perf_subtalker_ms;
+
+        if (n_ok > 0) printf(",");
+        printf("{\"tokens\":%d,\"audio_s\":%.3f,\"total_ms\":%.1f,"
+               "\"first_audio_ms\":%.1f,"
+               "\"talker_tok_s\":%.1f,\"subtalker_ms_frame\":%.2f,"
+               "\"codec_ms_frame\":%.2f,\"rtf\":%.3f}",
+               tokens, audio_s, ctx->perf_total_ms,
+               ctx->perf_first_audio_ms,
+               talker_pure_ms > 0 ? tokens / (talker_pure_ms / 1000.0) : 0.0,
+               tokens > 0 ? ctx->perf_subtalker_ms / tokens : 0.0,
+               tokens > 0 ? ctx->perf_codec_ms / tokens : 0.0,
+               ctx->perf_total_ms > 0 ? audio_s / (ctx->perf_total_ms / 1000.0) : 0.0);
+
+        sum_audio_s += audio_s;
+        sum_total_ms += ctx->perf_total_ms;
+        sum_talker_ms += talker_pure_ms;
+        sum_subtalker_ms += ctx->perf_subtalker_ms;
+        sum_codec_ms += ctx->perf_codec_ms;
+        sum_ttfa_ms += ctx->perf_first_audio_ms;
+        sum_tokens += tokens;
+        n_ok++;
+    }
+
+    printf("],\"aggregate\":{\"utterances\":%d,\"tokens\":%d,"
+           "\"audio_s\":%.3f,\"total_ms\":%.1f,"
+           "\"mean_first_audio_ms\":%.1f,"
+           "\"talker_tok_s\":%.1f,\"subtalker_ms_frame\":%.2f,"
+           "\"codec_ms_frame\":%.2f,\"rtf\":%.3f}}\n",
+           n_ok, sum_tokens, sum_audio_s, sum_total_ms,
+           n_ok > 0 ? sum_ttfa_ms / n_ok : 0.0,
+           sum_talker_ms > 0 ? sum_tokens / (sum_talker_ms / 1000.0) : 0.0,
+           sum_tokens > 0 ? sum_subtalker_ms / sum_tokens : 0.0,
+           sum_tokens > 0 ? sum_codec_ms / sum_tokens : 0.0,
+           sum_total_ms > 0 ? sum_audio_s / (sum_total_ms / 1000.0) : 0.0);
+
+    if (file_corpus) {
+        for (int i = 0; i < n_corpus; i++) free(file_corpus[i]);
+        free(file_corpus);
+    }
+    qwen_tts_free(ctx);
+    return n_ok == n_corpus ? 0 : 1;
+}
@@ -125,6 +125,30 @@ static inline void codec_axpy(int n, float alpha, const float *x, float *y) {
 #endif
 }
 
+/* KV cache accessors for the autoregressive transformer step: the cache
+ * element (qwen_tts_kv_t) is FP16 on fp16 builds, F32 otherwise. */
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+static inline void codec_kv_store(qwen_tts_kv_t *dst, const float *src, int n) {
+    kernel_f32_to_f16(dst, src, n);
+}
+static inline float codec_kv_dot(const float *a, const qwen_tts_kv_t *b, int n) {
+    return kernel_dot_f32_f16(a, b, n);
+}
+static inline void codec_kv_axpy(int n, float alpha, const qwen_tts_kv_t *x, float *y) {
+    kernel_axpy_f16(n, alpha, x, y);
+}
+#else
+static inline void codec_kv_store(qwen_tts_kv_t *dst, const float *src, int n) {
+    memcpy(dst, src, (size_t)n * sizeof(float));
+}
+static inline float codec_kv_dot(const float *a, const qwen_tts_kv_t *b, int n) {
+    return codec_dot(a, b, n);
+}
+static inline void codec_kv_axpy(int n, float alpha, const qwen_tts_kv_t *x, float *y) {
+    codec_axpy(n, alpha, x, y);
+}
+#endif
+
 /* ========================================================================
  * RVQ Dequantization
  * ======================================================================== */
@@ -287,6 +311,156 @@ static float *codec_rvq_dequantize(qwen_tts_ctx_t *ctx, const int *codes,
  * Codec Transformer (8 layers, sliding window attention, LayerScale)
  * ======================================================================== */
 
+/* Per-token / per-head workers for codec_transformer_forward. One context
+ * is filled per layer and handed to the shared pool, replacing the old
+ * OpenMP parallel-for regions. */
+typedef struct {
+    qwen_tts_codec_transformer_layer_t *l;
+    float *x_norm, *q_all, *k_all, *v_all, *attn_out, *gate_all;
+    int codec_hidden, heads, head_dim, kv_dim;
+    int seq_len, sliding_window, groups_per_head, intermediate;
+    float scale;
+} codec_tf_ctx_t;
+
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+static void codec_qkv_f16_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int q_dim = c->heads * c->head_dim;
+    int total_rows = q_dim + c->kv_dim + c->kv_dim;
+    for (int t = start; t < end; t++) {
+        float qkv_tmp[total_rows];
+        kernel_matvec_f16w(qkv_tmp, c->l->wqkv_f16, c->x_norm + (size_t)t * c->codec_hidden,
+                           total_rows, c->codec_hidden);
+        memcpy(c->q_all + (size_t)t * q_dim, qkv_tmp, q_dim * sizeof(float));
+        memcpy(c->k_all + (size_t)t * c->kv_dim, qkv_tmp + q_dim, c->kv_dim * sizeof(float));
+        memcpy(c->v_all + (size_t)t * c->kv_dim, qkv_tmp + q_dim + c->kv_dim, c->kv_dim * sizeof(float));
+    }
+}
+#endif
+
+static void codec_qkv_q8_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int q_dim = c->heads * c->head_dim;
+    int total_rows = q_dim + c->kv_dim + c->kv_dim;
+    int n_blocks = c->codec_hidden / QK8_0;
+    for (int t = start; t < end; t++) {
+        float qkv_tmp[total_rows];
+        block_q8_0 xn_q8[n_blocks];
+        kernel_quantize_x_q8(c->x_norm + (size_t)t * c->codec_hidden, c->codec_hidden, xn_q8);
+        kernel_matvec_q8(qkv_tmp, c->l->wqkv_q8, xn_q8, total_rows, n_blocks);
+        memcpy(c->q_all + (size_t)t * q_dim, qkv_tmp, q_dim * sizeof(float));
+        memcpy(c->k_all + (size_t)t * c->kv_dim, qkv_tmp + q_dim, c->kv_dim * sizeof(float));
+        memcpy(c->v_all + (size_t)t * c->kv_dim, qkv_tmp + q_dim + c->kv_dim, c->kv_dim * sizeof(float));
+    }
+}
+
+static void codec_attn_heads(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int seq_len = c->seq_len;
+    for (int h = start; h < end; h++) {
+        int kv_h = h / c->groups_per_head;
+        float attn_scores[c->sliding_window];
+        for (int qi = 0; qi < seq_len; qi++) {
+            float *qh = c->q_all + (size_t)qi * c->heads * c->head_dim + (size_t)h * c->head_dim;
+            int win_start = qi - c->sliding_window + 1;
+            if (win_start < 0) win_start = 0;
+
+            /* Compute attention scores within window */
+            int wlen = qi - win_start + 1;
+            for (int i = 0; i < wlen; i++) {
+                int ki = win_start + i;
+                float *kh = c->k_all + (size_t)ki * c->kv_dim + (size_t)kv_h * c->head_dim;
+                attn_scores[i] = codec_dot(qh, kh, c->head_dim) * c->scale;
+            }
+            kernel_softmax(attn_scores, wlen);
+
+            float *oh = c->attn_out + (size_t)qi * c->heads * c->head_dim + (size_t)h * c->head_dim;
+            for (int i = 0; i < wlen; i++) {
+                int ki = win_start + i;
+                float w = attn_scores[i];
+                float *vh = c->v_all + (size_t)ki * c->kv_dim + (size_t)kv_h * c->head_dim;
+                codec_axpy(c->head_dim, w, vh, oh);
+            }
+        }
+    }
+}
+
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+static void codec_wo_f16_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int q_dim = c->heads * c->head_dim;
+    for (int t = start; t < end; t++)
+        kernel_matvec_f16w(c->x_norm + (size_t)t * c->codec_hidden, c->l->wo_f16,
+                           c->attn_out + (size_t)t * q_dim, c->codec_hidden, q_dim);
+}
+#endif
+
+static void codec_wo_q8_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int q_dim = c->heads * c->head_dim;
+    int n_blocks = q_dim / QK8_0;
+    for (int t = start; t < end; t++) {
+        block_q8_0 attn_q8[n_blocks];
+        kernel_quantize_x_q8(c->attn_out + (size_t)t * q_dim, q_dim, attn_q8);
+        kernel_matvec_q8(c->x_norm + (size_t)t * c->codec_hidden, c->l->wo_q8, attn_q8,
+                         c->codec_hidden, n_blocks);
+    }
+}
+
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+static void codec_mlp_f16_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    float *gu_tmp = (float *)malloc(2 * (size_t)c->intermediate * sizeof(float));
+    if (!gu_tmp) return;
+    for (int t = start; t < end; t++) {
+        kernel_matvec_f16w(gu_tmp, c->l->gate_up_f16, c->x_norm + (size_t)t * c->codec_hidden,
+                           2 * c->intermediate, c->codec_hidden);
+        float *g_out = c->gate_all + (size_t)t * c->intermediate;
+        for (int i = 0; i < c->intermediate; i++) {
+            float g = gu_tmp[i];
+            g_out[i] = (g / (1.0f + expf(-g))) * gu_tmp[c->intermediate + i];
+        }
+        kernel_matvec_f16w(c->x_norm + (size_t)t * c->codec_hidden, c->l->down_f16,
+                           g_out, c->codec_hidden, c->intermediate);
+    }
+    free(gu_tmp);
+}
+#endif
+
+static void codec_mlp_f32_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    float *gu_tmp = (float *)malloc(2 * (size_t)c->intermediate * sizeof(float));
+    if (!gu_tmp) return;
+    for (int t = start; t < end; t++) {
+        kernel_matvec_f32(gu_tmp, c->l->gate_up_f32, c->x_norm + (size_t)t * c->codec_hidden,
+                          2 * c->intermediate, c->codec_hidden);
+        float *g_out = c->gate_all + (size_t)t * c->intermediate;
+        for (int i = 0; i < c->intermediate; i++) {
+            float g = gu_tmp[i];
+            g_out[i] = (g / (1.0f + expf(-g))) * gu_tmp[c->intermediate + i];
+        }
+        kernel_matvec_f32(c->x_norm + (size_t)t * c->codec_hidden, c->l->down_f32,
+                          g_out, c->codec_hidden, c->intermediate);
+    }
+    free(gu_tmp);
+}
+
+static void codec_mlp_q8_tokens(int start, int end, void *argp) {
+    const codec_tf_ctx_t *c = (const codec_tf_ctx_t *)argp;
+    int n_blocks_h = c->codec_hidden / QK8_0;
+    int n_blocks_i = c->intermediate / QK8_0;
+    for (int t = start; t < end; t++) {
+        block_q8_0 xn_q8[n_blocks_h];
+        kernel_quantize_x_q8(c->x_norm + (size_t)t * c->codec_hidden, c->codec_hidden, xn_q8);
+        kernel_swiglu_matvec_q8(c->gate_all + (size_t)t * c->intermediate,
+                                 c->l->gate_up_q8, xn_q8, c->intermediate, n_blocks_h);
+        block_q8_0 gate_q8[n_blocks_i];
+        kernel_quantize_x_q8(c->gate_all + (size_t)t * c->intermediate, c->intermediate, gate_q8);
+        kernel_matvec_q8(c->x_norm + (size_t)t * c->codec_hidden, c->l->down_q8, gate_q8,
+                         c->codec_hidden, n_blocks_i);
+    }
+}
+
 static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
                                         int seq_len) {
     qwen_tts_config_t *cfg = &ctx->config;
@@ -348,11 +522,14 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
     float *k_all = (float *)malloc((size_t)seq_len * kv_dim * sizeof(float));
     float *v_all = (float *)malloc((size_t)seq_len * kv_dim * sizeof(float));
     float *attn_out = (float *)malloc((size_t)seq_len * heads * head_dim * sizeof(float));
-    float *attn_scores = (float *)malloc((size_t)seq_len * sizeof(float));
     float *gate_all = (float *)malloc((size_t)seq_len * intermediate * sizeof(float));
 
     for (int layer = 0; layer < layers; layer++) {
         qwen_tts_codec_transformer_layer_t *l = &ctx->codec.transformer_layers[layer];
+        codec_tf_ctx_t tf = { l, x_norm, q_all, k_all, v_all, attn_out, gate_all,
+                              codec_hidden, heads, head_dim, kv_dim,
+                              seq_len, sliding_window, groups_per_head, intermediate,
+                              1.0f / sqrtf((float)head_dim) };
 
         /* 1. Input RMSNorm */
         for (int t = 0; t < seq_len; t++)
@@ -360,33 +537,12 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
                            l->input_norm, codec_hidden, eps);
 
         /* 2. Q, K, V projections */
-        {
-            int q_dim = heads * head_dim;
-            int total_rows = q_dim + kv_dim + kv_dim;
-            float *qkv_tmp = (float *)malloc(total_rows * sizeof(float));
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-            if (l->wqkv_f16) {
-                for (int t = 0; t < seq_len; t++) {
-                    kernel_matvec_f16w(qkv_tmp, l->wqkv_f16, x_norm + t * codec_hidden, total_rows, codec_hidden);
-                    memcpy(q_all + (size_t)t * q_dim, qkv_tmp, q_dim * sizeof(float));
-                    memcpy(k_all + (size_t)t * kv_dim, qkv_tmp + q_dim, kv_dim * sizeof(float));
-                    memcpy(v_all + (size_t)t * kv_dim, qkv_tmp + q_dim + kv_dim, kv_dim * sizeof(float));
-                }
-            } else
+        if (l->wqkv_f16)
+            qwen_parallel_chunks(seq_len, 4, codec_qkv_f16_tokens, &tf);
+        else
 #endif
-            {
-                int n_blocks = codec_hidden / QK8_0;
-                for (int t = 0; t < seq_len; t++) {
-                    block_q8_0 xn_q8[n_blocks];
-                    kernel_quantize_x_q8(x_norm + t * codec_hidden, codec_hidden, xn_q8);
-                    kernel_matvec_q8(qkv_tmp, l->wqkv_q8, xn_q8, total_rows, n_blocks);
-                    memcpy(q_all + (size_t)t * q_dim, qkv_tmp, q_dim * sizeof(float));
-                    memcpy(k_all + (size_t)t * kv_dim, qkv_tmp + q_dim, kv_dim * sizeof(float));
-                    memcpy(v_all + (size_t)t * kv_dim, qkv_tmp + q_dim + kv_dim, kv_dim * sizeof(float));
-                }
-            }
-            free(qkv_tmp);
-        }
+            qwen_parallel_chunks(seq_len, 4, codec_qkv_q8_tokens, &tf);
 
         /* 3. RoPE (standard, not M-RoPE. No QK-Norm for codec decoder) */
         for (int t = 0; t < seq_len; t++) {
@@ -398,55 +554,17 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
                              kv_heads, head_dim);
         }
 
-        /* 4. Sliding-window causal attention */
-        float scale = 1.0f / sqrtf((float)head_dim);
+        /* 4. Sliding-window causal attention (one head per chunk) */
         memset(attn_out, 0, (size_t)seq_len * heads * head_dim * sizeof(float));
-
-        for (int h = 0; h < heads; h++) {
-            int kv_h = h / groups_per_head;
-            for (int qi = 0; qi < seq_len; qi++) {
-                float *qh = q_all + qi * heads * head_dim + h * head_dim;
-                int start = qi - sliding_window + 1;
-                if (start < 0) start = 0;
-
-                /* Compute attention scores within window */
-                int wlen = qi - start + 1;
-                for (int i = 0; i < wlen; i++) {
-                    int ki = start + i;
-                    float *kh = k_all + ki * kv_dim + kv_h * head_dim;
-                    attn_scores[i] = codec_dot(qh, kh, head_dim) * scale;
-                }
-                kernel_softmax(attn_scores, wlen);
-
-                float *oh = attn_out + qi * heads * head_dim + h * head_dim;
-                for (int i = 0; i < wlen; i++) {
-                    int ki = start + i;
-                    float w = attn_scores[i];
-                    float *vh = v_all + ki * kv_dim + kv_h * head_dim;
-                    codec_axpy(head_dim, w, vh, oh);
-                }
-            }
-        }
+        qwen_parallel_chunks(heads, 1, codec_attn_heads, &tf);
 
         /* 5. Output projection + LayerScale + residual */
-        {
-            int q_dim = heads * head_dim;
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
-            if (l->wo_f16) {
-                for (int t = 0; t < seq_len; t++)
-                    kernel_matvec_f16w(x_norm + t * codec_hidden, l->wo_f16,
-                                       attn_out + (size_t)t * q_dim, codec_hidden, q_dim);
-            } else
+        if (l->wo_f16)
+            qwen_parallel_chunks(seq_len, 4, codec_wo_f16_tokens, &tf);
+        else
 #endif
-            {
-                int n_blocks = q_dim / QK8_0;
-                for (int t = 0; t < seq_len; t++) {
-                    block_q8_0 attn_q8[n_blocks];
-                    kernel_quantize_x_q8(attn_out + (size_t)t * q_dim, q_dim, attn_q8);
-                    kernel_matvec_q8(x_norm + t * codec_hidden, l->wo_q8, attn_q8, codec_hidden, n_blocks);
-                }
-            }
-        }
+            qwen_parallel_chunks(seq_len, 4, codec_wo_q8_tokens, &tf);
         for (int t = 0; t < seq_len; t++) {
             if (l->attn_layer_scale)
                 kernel_mul_inplace(x_norm + t * codec_hidden, l->attn_layer_scale, codec_hidden);
@@ -461,47 +579,13 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
         /* SwiGLU MLP + down projection */
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
         if (l->gate_up_f16 && l->down_f16) {
-            float *gu_tmp = (float *)malloc(2 * intermediate * sizeof(float));
-            for (int t = 0; t < seq_len; t++) {
-                kernel_matvec_f16w(gu_tmp, l->gate_up_f16, x_norm + t * codec_hidden,
-                                   2 * intermediate, codec_hidden);
-                float *g_out = gate_all + (size_t)t * intermediate;
-                for (int i = 0; i < intermediate; i++) {
-                    float g = gu_tmp[i];
-                    g_out[i] = (g / (1.0f + expf(-g))) * gu_tmp[intermediate + i];
-                }
-                kernel_matvec_f16w(x_norm + t * codec_hidden, l->down_f16,
-                                   g_out, codec_hidden, intermediate);
-            }
-            free(gu_tmp);
+            qwen_parallel_chunks(seq_len, 4, codec_mlp_f16_tokens, &tf);
         } else
 #endif
         if (l->gate_up_f32 && l->down_f32) {
-            float *gu_tmp = (float *)malloc(2 * intermediate * sizeof(float));
-            for (int t = 0; t < seq_len; t++) {
-                kernel_matvec_f32(gu_tmp, l->gate_up_f32, x_norm + t * codec_hidden,
-                                  2 * intermediate, codec_hidden);
-                float *g_out = gate_all + (size_t)t * intermediate;
-                for (int i = 0; i < intermediate; i++) {
-                    float g = gu_tmp[i];
-                    g_out[i] = (g / (1.0f + expf(-g))) * gu_tmp[intermediate + i];
-                }
-                kernel_matvec_f32(x_norm + t * codec_hidden, l->down_f32,
-                                  g_out, codec_hidden, intermediate);
-            }
-            free(gu_tmp);
+            qwen_parallel_chunks(seq_len, 4, codec_mlp_f32_tokens, &tf);
         } else {
-            int n_blocks_h = codec_hidden / QK8_0;
-            int n_blocks_i = intermediate / QK8_0;
-            for (int t = 0; t < seq_len; t++) {
-                block_q8_0 xn_q8[n_blocks_h];
-                kernel_quantize_x_q8(x_norm + t * codec_hidden, codec_hidden, xn_q8);
-                kernel_swiglu_matvec_q8(gate_all + (size_t)t * intermediate,
-                                         l->gate_up_q8, xn_q8, intermediate, n_blocks_h);
-                block_q8_0 gate_q8[n_blocks_i];
-                kernel_quantize_x_q8(gate_all + (size_t)t * intermediate, intermediate, gate_q8);
-                kernel_matvec_q8(x_norm + t * codec_hidden, l->down_q8, gate_q8, codec_hidden, n_blocks_i);
-            }
+            qwen_parallel_chunks(seq_len, 4, codec_mlp_q8_tokens, &tf);
         }
 
         for (int t = 0; t < seq_len; t++) {
@@ -538,7 +622,7 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
     }
 
     free(x); free(x_norm); free(q_all); free(k_all); free(v_all);
-    free(attn_out); free(attn_scores); free(gate_all);
+    free(attn_out); free(gate_all);
     free(rope_cos); free(rope_sin);
 }
 
@@ -546,6 +630,33 @@ static void codec_transformer_forward(qwen_tts_ctx_t *ctx, float *hidden,
  * ConvNeXt upsampling block
  * ======================================================================== */
 
+/* Pointwise-projection workers for codec_convnext_forward. */
+typedef struct {
+    qwen_tts_convnext_block_t *block;
+    float *x_ld, *pw1;
+    int dim, dim4;
+} convnext_pw_ctx_t;
+
+static void convnext_pw1_tokens(int start, int end, void *argp) {
+    const convnext_pw_ctx_t *c = (const convnext_pw_ctx_t *)argp;
+    for (int t = start; t < end; t++) {
+        kernel_matvec_f32(c->pw1 + (size_t)t * c->dim4, c->block->pwconv1_weight,
+                          c->x_ld + (size_t)t * c->dim, c->dim4, c->dim);
+        if (c->block->pwconv1_bias)
+            kernel_add_inplace(c->pw1 + (size_t)t * c->dim4, c->block->pwconv1_bias, c->dim4);
+    }
+}
+
+static void convnext_pw2_tokens(int start, int end, void *argp) {
+    const convnext_pw_ctx_t *c = (const convnext_pw_ctx_t *)argp;
+    for (int t = start; t < end; t++) {
+        kernel_matvec_f32(c->x_ld + (size_t)t * c->dim, c->block->pwconv2_weight,
+                          c->pw1 + (size_t)t * c->dim4, c->dim, c->dim4);
+        if (c->block->pwconv2_bias)
+            kernel_add_inplace(c->x_ld + (size_t)t * c->dim, c->block->pwconv2_bias, c->dim);
+    }
+}
+
 static void codec_convnext_forward(qwen_tts_convnext_block_t *block,
                                      float *hidden, int dim, int *length) {
     int len = *length;
@@ -572,21 +683,14 @@ static void codec_convnext_forward(qwen_tts_convnext_block_t *block,
     /* pwconv1: [dim] → [4*dim] */
     int dim4 = 4 * dim;
     float *pw1 = (float *)malloc((size_t)len * dim4 * sizeof(float));
-    for (int t = 0; t < len; t++) {
-        kernel_matvec_f32(pw1 + t * dim4, block->pwconv1_weight, x_ld + t * dim, dim4, dim);
-        if (block->pwconv1_bias)
-            kernel_add_inplace(pw1 + t * dim4, block->pwconv1_bias, dim4);
-    }
+    convnext_pw_ctx_t pw = { block, x_ld, pw1, dim, dim4 };
+    qwen_parallel_chunks(len, 4, convnext_pw1_tokens, &pw);
 
     /* GELU */
     kernel_gelu_inplace(pw1, len * dim4);
 
     /* pwconv2: [4*dim] → [dim] */
-    for (int t = 0; t < len; t++) {
-        kernel_matvec_f32(x_ld + t * dim, block->pwconv2_weight, pw1 + t * dim4, dim, dim4);
-        if (block->pwconv2_bias)
-            kernel_add_inplace(x_ld + t * dim, block->pwconv2_bias, dim);
-    }
+    qwen_parallel_chunks(len, 4, convnext_pw2_tokens, &pw);
 
     /* Apply gamma (learnable residual scale) */
     for (int t = 0; t < len; t++)
@@ -902,6 +1006,84 @@ float *qwen_tts_codec_decode(qwen_tts_ctx_t *ctx, const int *codes,
  * Each token produces exactly 1920 PCM samples (80ms at 24kHz).
  * ======================================================================== */
 
+/* --------------------------------------------------------------------
+ * Per-frame scratch arena
+ *
+ * All per-frame scratch below is bump-allocated from one block sized
+ * from the config dims, so the audio thread does not hit malloc on
+ * every decode step. If a frame ever outgrows the block, the old block
+ * is kept alive (its allocations are still in use) on a retired list —
+ * chained through the reserved header bytes — and freed at the next
+ * reset, so growth never invalidates live pointers.
+ * -------------------------------------------------------------------- */
+
+#define CODEC_ARENA_HDR 64  /* reserved for the retired-list link */
+
+static size_t codec_arena_frame_bytes(const qwen_tts_config_t *cfg) {
+    /* Pessimistic per-frame bound mirroring qwen_tts_codec_decode_step:
+     * transformer single-token scratch plus the upsample/vocoder chain,
+     * where each stage needs its in/out tensors plus conv scratch. */
+    size_t floats = 8 * (size_t)cfg->codec_hidden
+                  + 4 * (size_t)cfg->codec_intermediate
+                  + (size_t)cfg->codec_sliding_window
+                  + 4 * (size_t)cfg->codec_latent;
+    size_t len = 1;
+    for (int s = 0; s < 2; s++) {
+        len *= cfg->codec_upsampling_ratios[s];
+        floats += 16 * (size_t)cfg->codec_latent * len;  /* transconv + ConvNeXt */
+    }
+    size_t dim = cfg->codec_decoder_dim;
+    floats += 4 * dim * len;                             /* vocoder pre-conv */
+    for (int b = 0; b < 4; b++) {
+        size_t out_dim = dim / 2;
+        len *= cfg->codec_upsample_rates[b];
+        floats += 16 * out_dim * len;                    /* transconv + resunits */
+        dim = out_dim;
+    }
+    return floats * sizeof(float) + CODEC_ARENA_HDR;
+}
+
+static void *codec_arena_alloc(qwen_tts_ctx_t *ctx, size_t bytes) {
+    bytes = (bytes + 63) & ~(size_t)63;
+    if (!ctx->codec_arena || ctx->codec_arena_used + bytes > ctx->codec_arena_cap) {
+        size_t cap = ctx->codec_arena_cap ? ctx->codec_arena_cap * 2
+                                          : codec_arena_frame_bytes(&ctx->config);
+        while (cap < bytes + CODEC_ARENA_HDR) cap *= 2;
+        char *blk = (char *)malloc(cap);
+        if (!blk) return NULL;
+        if (ctx->codec_arena) {
+            /* Retire the full block; its allocations stay live until reset */
+            *(void **)ctx->codec_arena = ctx->codec_arena_retired;
+            ctx->codec_arena_retired = ctx->codec_arena;
+        }
+        ctx->codec_arena = blk;
+        ctx->codec_arena_cap = cap;
+        ctx->codec_arena_used = CODEC_ARENA_HDR;
+    }
+    void *p = ctx->codec_arena + ctx->codec_arena_used;
+    ctx->codec_arena_used += bytes;
+    return p;
+}
+
+static void codec_arena_reset(qwen_tts_ctx_t *ctx) {
+    void *blk = ctx->codec_arena_retired;
+    while (blk) {
+        void *next = *(void **)blk;
+        free(blk);
+        blk = next;
+    }
+    ctx->codec_arena_retired = NULL;
+    ctx->codec_arena_used = CODEC_ARENA_HDR;
+}
+
+void qwen_tts_codec_arena_free(qwen_tts_ctx_t *ctx) {
+    codec_arena_reset(ctx);
+    free(ctx->codec_arena);
+    ctx->codec_arena = NULL;
+    ctx->codec_arena_cap = 0;
+    ctx->codec_arena_used = 0;
+}
+
 /* --------------------------------------------------------------------
  * Incremental CausalConv1d
  *
@@ -912,6 +1094,7 @@ float *qwen_tts_codec_decode(qwen_tts_ctx_t *ctx, const int *codes,
  * -------------------------------------------------------------------- */
 
 static void codec_causal_conv_incremental(
+    qwen_tts_ctx_t *ctx,
     float *out,          /* [out_ch, N_new] */
     const float *input,  /* [in_ch, N_new] */
     float *state,        /* [in_ch, state_len] - updated in-place */
@@ -922,7 +1105,7 @@ static void codec_causal_conv_incremental(
     int combined_len = state_len + N_new;
 
     /* 1. Concatenate: combined = [state, new_input] per channel */
-    float *combined = (float *)malloc((size_t)in_ch * combined_len * sizeof(float));
+    float *combined = (float *)codec_arena_alloc(ctx, (size_t)in_ch * combined_len * sizeof(float));
     for (int c = 0; c < in_ch; c++) {
         memcpy(&combined[c * combined_len],
                &state[c * state_len],
@@ -933,7 +1116,7 @@ static void codec_causal_conv_incremental(
     }
 
     /* 2. Run existing batch kernel on the combined input */
-    float *full_out = (float *)malloc((size_t)out_ch * combined_len * sizeof(float));
+    float *full_out = (float *)codec_arena_alloc(ctx, (size_t)out_ch * combined_len * sizeof(float));
     kernel_causal_conv1d(full_out, combined, weight, bias,
                          in_ch, out_ch, K, combined_len, dilation, groups);
 
@@ -948,9 +1131,6 @@ static void codec_causal_conv_incremental(
         memcpy(&state[c * state_len],
                &combined[c * combined_len + N_new],
                state_len * sizeof(float));
-
-    free(combined);
-    free(full_out);
 }
 
 /* --------------------------------------------------------------------
@@ -961,6 +1141,7 @@ static void codec_causal_conv_incremental(
  * -------------------------------------------------------------------- */
 
 static void codec_transconv_incremental(
+    qwen_tts_ctx_t *ctx,
     float *out,           /* [out_ch, N_new * stride] */
     const float *input,   /* [in_ch, N_new] */
     float *overlap,       /* [out_ch, overlap_len] - updated in-place */
@@ -975,7 +1156,8 @@ static void codec_transconv_incremental(
     if (raw_len <= 0) return;
 
     /* 1. Compute raw transposed conv output (no trim) */
-    float *raw = (float *)calloc((size_t)out_ch * raw_len, sizeof(float));
+    float *raw = (float *)codec_arena_alloc(ctx, (size_t)out_ch * raw_len * sizeof(float));
+    memset(raw, 0, (size_t)out_ch * raw_len * sizeof(float));
     for (int ic = 0; ic < in_ch; ic++) {
         for (int t = 0; t < N_new; t++) {
             float val = input[ic * N_new + t];
@@ -1023,8 +1205,6 @@ static void codec_transconv_incremental(
             }
         }
     }
-
-    free(raw);
 }
 
 /* --------------------------------------------------------------------
@@ -1055,14 +1235,14 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
     int needed = pos + 1;
     if (needed > ctx->codec_kv_max) {
         int new_max = needed + 256;
-        size_t kv_size = (size_t)layers * new_max * kv_dim * sizeof(float);
-        ctx->codec_kv_k = (float *)realloc(ctx->codec_kv_k, kv_size);
-        ctx->codec_kv_v = (float *)realloc(ctx->codec_kv_v, kv_size);
+        size_t kv_size = (size_t)layers * new_max * kv_dim * sizeof(qwen_tts_kv_t);
+        ctx->codec_kv_k = (qwen_tts_kv_t *)realloc(ctx->codec_kv_k, kv_size);
+        ctx->codec_kv_v = (qwen_tts_kv_t *)realloc(ctx->codec_kv_v, kv_size);
         ctx->codec_kv_max = new_max;
     }
 
     /* Input projection: latent → codec_hidden */
-    float *x = (float *)malloc(codec_hidden * sizeof(float));
+    float *x = (float *)codec_arena_alloc(ctx, codec_hidden * sizeof(float));
     kernel_matvec_f32(x, ctx->codec.transformer_input_proj_weight,
                        hidden_io, codec_hidden, latent);
     if (ctx->codec.transformer_input_proj_bias)
@@ -1084,15 +1264,17 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
     }
 
     /* Scratch buffers */
-    float *x_norm = (float *)malloc(codec_hidden * sizeof(float));
+    float *x_norm = (float *)codec_arena_alloc(ctx, codec_hidden * sizeof(float));
     int q_dim = heads * head_dim;
-    float *q_buf = (float *)malloc(q_dim * sizeof(float));
-    float *k_buf = (float *)malloc(kv_dim * sizeof(float));
-    float *v_buf = (float *)malloc(kv_dim * sizeof(float));
-    float *attn_out = (float *)malloc(q_dim * sizeof(float));
+    float *q_buf = (float *)codec_arena_alloc(ctx, q_dim * sizeof(float));
+    float *k_buf = (float *)codec_arena_alloc(ctx, kv_dim * sizeof(float));
+    float *v_buf = (float *)codec_arena_alloc(ctx, kv_dim * sizeof(float));
+    float *attn_out = (float *)codec_arena_alloc(ctx, q_dim * sizeof(float));
     int max_wlen = (pos + 1 < sliding_window) ? pos + 1 : sliding_window;
-    float *scores = (float *)malloc(max_wlen * sizeof(float));
-    float *gate_buf = (float *)malloc(intermediate * sizeof(float));
+    float *scores = (float *)codec_arena_alloc(ctx, max_wlen * sizeof(float));
+    float *gate_buf = (float *)codec_arena_alloc(ctx, intermediate * sizeof(float));
+    float *qkv_tmp = (float *)codec_arena_alloc(ctx, (q_dim + 2 * kv_dim) * sizeof(float));
+    float *gu_tmp = (float *)codec_arena_alloc(ctx, 2 * intermediate * sizeof(float));
 
     for (int layer = 0; layer < layers; layer++) {
         qwen_tts_codec_transformer_layer_t *l = &ctx->codec.transformer_layers[layer];
@@ -1104,7 +1286,6 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
         /* 2. QKV projections */
         {
             int total_rows = q_dim + kv_dim + kv_dim;
-            float *qkv_tmp = (float *)malloc(total_rows * sizeof(float));
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
             if (l->wqkv_f16) {
                 kernel_matvec_f16w(qkv_tmp, l->wqkv_f16, x_norm, total_rows, codec_hidden);
@@ -1119,7 +1300,6 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
             memcpy(q_buf, qkv_tmp, q_dim * sizeof(float));
             memcpy(k_buf, qkv_tmp + q_dim, kv_dim * sizeof(float));
             memcpy(v_buf, qkv_tmp + q_dim + kv_dim, kv_dim * sizeof(float));
-            free(qkv_tmp);
         }
 
         /* 3. Standard RoPE (no QK-Norm for codec) */
@@ -1127,10 +1307,10 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
         kernel_rope_apply(k_buf, NULL, rope_cos, rope_sin, kv_heads, head_dim);
 
         /* 4. Store K, V in cache */
-        memcpy(ctx->codec_kv_k + layer * kv_stride + (size_t)pos * kv_dim,
-               k_buf, kv_dim * sizeof(float));
-        memcpy(ctx->codec_kv_v + layer * kv_stride + (size_t)pos * kv_dim,
-               v_buf, kv_dim * sizeof(float));
+        codec_kv_store(ctx->codec_kv_k + layer * kv_stride + (size_t)pos * kv_dim,
+                       k_buf, kv_dim);
+        codec_kv_store(ctx->codec_kv_v + layer * kv_stride + (size_t)pos * kv_dim,
+                       v_buf, kv_dim);
 
         /* 5. Sliding-window causal attention (single query) */
         float scale = 1.0f / sqrtf((float)head_dim);
@@ -1146,15 +1326,15 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
 
             for (int i = 0; i < wlen; i++) {
                 int ki = start + i;
-                float *kh = ctx->codec_kv_k + layer * kv_stride + (size_t)ki * kv_dim + kv_h * head_dim;
-                scores[i] = codec_dot(qh, kh, head_dim) * scale;
+                qwen_tts_kv_t *kh = ctx->codec_kv_k + layer * kv_stride + (size_t)ki * kv_dim + kv_h * head_dim;
+                scores[i] = codec_kv_dot(qh, kh, head_dim) * scale;
             }
             kernel_softmax(scores, wlen);
 
             for (int i = 0; i < wlen; i++) {
                 int ki = start + i;
-                float *vh = ctx->codec_kv_v + layer * kv_stride + (size_t)ki * kv_dim + kv_h * head_dim;
-                codec_axpy(head_dim, scores[i], vh, oh);
+                qwen_tts_kv_t *vh = ctx->codec_kv_v + layer * kv_stride + (size_t)ki * kv_dim + kv_h * head_dim;
+                codec_kv_axpy(head_dim, scores[i], vh, oh);
             }
         }
 
@@ -1180,24 +1360,20 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
         /* SwiGLU MLP + down projection */
 #ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
         if (l->gate_up_f16 && l->down_f16) {
-            float *gu_tmp = (float *)malloc(2 * intermediate * sizeof(float));
             kernel_matvec_f16w(gu_tmp, l->gate_up_f16, x_norm, 2 * intermediate, codec_hidden);
             for (int i = 0; i < intermediate; i++) {
                 float g = gu_tmp[i];
                 gate_buf[i] = (g / (1.0f + expf(-g))) * gu_tmp[intermediate + i];
             }
-            free(gu_tmp);
             kernel_matvec_f16w(x_norm, l->down_f16, gate_buf, codec_hidden, intermediate);
         } else
 #endif
         if (l->gate_up_f32 && l->down_f32) {
-            float *gu_tmp = (float *)malloc(2 * intermediate * sizeof(float));
             kernel_matvec_f32(gu_tmp, l->gate_up_f32, x_norm, 2 * intermediate, codec_hidden);
             for (int i = 0; i < intermediate; i++) {
                 float g = gu_tmp[i];
                 gate_buf[i] = (g / (1.0f + expf(-g))) * gu_tmp[intermediate + i];
             }
-            free(gu_tmp);
             kernel_matvec_f32(x_norm, l->down_f32, gate_buf, codec_hidden, intermediate);
         } else {
             {
@@ -1227,9 +1403,6 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
                        x, latent, codec_hidden);
     if (ctx->codec.transformer_output_proj_bias)
         kernel_add_inplace(hidden_io, ctx->codec.transformer_output_proj_bias, latent);
-
-    free(x); free(x_norm); free(q_buf); free(k_buf); free(v_buf);
-    free(attn_out); free(scores); free(gate_buf);
 }
 
 /* --------------------------------------------------------------------
@@ -1238,24 +1411,25 @@ static void codec_transformer_step(qwen_tts_ctx_t *ctx,
  * Same as batch but uses incremental dwconv and operates on N_new positions.
  * -------------------------------------------------------------------- */
 
-static void codec_convnext_incremental(qwen_tts_convnext_block_t *block,
+static void codec_convnext_incremental(qwen_tts_ctx_t *ctx,
+                                         qwen_tts_convnext_block_t *block,
                                          float *hidden, /* [dim, N_new] in/out */
                                          float *dwconv_state, /* [dim, 6] */
                                          int dim, int N_new)
 {
     /* Residual */
     size_t n = (size_t)dim * N_new;
-    float *residual = (float *)malloc(n * sizeof(float));
+    float *residual = (float *)codec_arena_alloc(ctx, n * sizeof(float));
     memcpy(residual, hidden, n * sizeof(float));
 
     /* Depthwise causal conv (k=7, groups=dim) - incremental */
-    float *conv_out = (float *)malloc(n * sizeof(float));
-    codec_causal_conv_incremental(conv_out, hidden, dwconv_state,
+    float *conv_out = (float *)codec_arena_alloc(ctx, n * sizeof(float));
+    codec_causal_conv_incremental(ctx, conv_out, hidden, dwconv_state,
                                    block->dwconv_weight, block->dwconv_bias,
                                    dim, dim, 7, 1, dim, N_new);
 
     /* Permute to [N_new, dim] for pointwise ops */
-    float *x_ld = (float *)malloc((size_t)N_new * dim * sizeof(float));
+    float *x_ld = (float *)codec_arena_alloc(ctx, (size_t)N_new * dim * sizeof(float));
     for (int c = 0; c < dim; c++)
         for (int t = 0; t < N_new; t++)
             x_ld[t * dim + c] = conv_out[c * N_new + t];
@@ -1267,7 +1441,7 @@ static void codec_convnext_incremental(qwen_tts_convnext_block_t *block,
 
     /* pwconv1: [dim] → [4*dim] */
     int dim4 = 4 * dim;
-    float *pw1 = (float *)malloc((size_t)N_new * dim4 * sizeof(float));
+    float *pw1 = (float *)codec_arena_alloc(ctx, (size_t)N_new * dim4 * sizeof(float));
     for (int t = 0; t < N_new; t++) {
         kernel_matvec_f32(pw1 + t * dim4, block->pwconv1_weight, x_ld + t * dim, dim4, dim);
         if (block->pwconv1_bias)
@@ -1295,8 +1469,6 @@ static void codec_convnext_incremental(qwen_tts_convnext_block_t *block,
 
     /* Skip connection */
     kernel_add_inplace(hidden, residual, dim * N_new);
-
-    free(residual); free(conv_out); free(x_ld); free(pw1);
 }
 
 /* --------------------------------------------------------------------
@@ -1304,21 +1476,22 @@ static void codec_convnext_incremental(qwen_tts_convnext_block_t *block,
  * -------------------------------------------------------------------- */
 
 static void vocoder_resunit_incremental(
+    qwen_tts_ctx_t *ctx,
     qwen_tts_vocoder_resunit_t *unit,
     float *hidden,       /* [dim, N_new] in/out */
     float *conv1_state,  /* [dim, (K-1)*dilation] */
     int dim, int N_new, int dilation)
 {
     size_t n = (size_t)dim * N_new;
-    float *residual = (float *)malloc(n * sizeof(float));
+    float *residual = (float *)codec_arena_alloc(ctx, n * sizeof(float));
     memcpy(residual, hidden, n * sizeof(float));
 
     /* SnakeBeta 1 */
     kernel_snake_beta(hidden, hidden, unit->act1_alpha, unit->act1_beta, dim, N_new);
 
     /* Conv1 (k=7, dilation) - incremental */
-    float *conv1_out = (float *)malloc(n * sizeof(float));
-    codec_causal_conv_incremental(conv1_out, hidden, conv1_state,
+    float *conv1_out = (float *)codec_arena_alloc(ctx, n * sizeof(float));
+    codec_causal_conv_incremental(ctx, conv1_out, hidden, conv1_state,
                                    unit->conv1_weight, unit->conv1_bias,
                                    dim, dim, 7, dilation, 1, N_new);
 
@@ -1331,8 +1504,6 @@ static void vocoder_resunit_incremental(
 
     /* Skip connection */
     kernel_add_inplace(hidden, residual, dim * N_new);
-
-    free(residual); free(conv1_out);
 }
 
 /* --------------------------------------------------------------------
@@ -1349,8 +1520,10 @@ static void codec_rvq_dequantize_step(qwen_tts_ctx_t *ctx, const int *codes,
     int half_latent = cfg->codec_latent / 2;  /* 512 */
     int vq_dim = cfg->codec_codebook_dim / 2; /* 256 */
 
-    float *semantic_sum = (float *)calloc(vq_dim, sizeof(float));
-    float *acoustic_sum = (float *)calloc(vq_dim, sizeof(float));
+    float *semantic_sum = (float *)codec_arena_alloc(ctx, vq_dim * sizeof(float));
+    float *acoustic_sum = (float *)codec_arena_alloc(ctx, vq_dim * sizeof(float));
+    memset(semantic_sum, 0, vq_dim * sizeof(float));
+    memset(acoustic_sum, 0, vq_dim * sizeof(float));
 
     /* Semantic codebook (quantizer 0) */
     {
@@ -1404,9 +1577,6 @@ static void codec_rvq_dequantize_step(qwen_tts_ctx_t *ctx, const int *codes,
         }
         out[od] = sem + aco;
     }
-
-    free(semantic_sum);
-    free(acoustic_sum);
 }
 
 /* ========================================================================
@@ -1510,20 +1680,22 @@ float *qwen_tts_codec_decode_step(
     double ms_rvq = 0, ms_preconv = 0, ms_transformer = 0, ms_upsample = 0;
     double ms_voc_preconv = 0, ms_voc_blocks[4] = {0}, ms_final = 0;
 
+    /* All per-frame scratch comes from the arena; one reset per step */
+    codec_arena_reset(ctx);
+
     /* 1. RVQ dequantize: 1 token → [half_latent=512, 1] (channels-first) */
     t0 = now_ms();
-    float *rvq_out = (float *)malloc(half_latent * sizeof(float));
+    float *rvq_out = (float *)codec_arena_alloc(ctx, half_latent * sizeof(float));
     codec_rvq_dequantize_step(ctx, codes, num_quantizers, rvq_out);
     ms_rvq = now_ms() - t0;
 
     /* 2. Pre-conv: CausalConv1d(512→1024, k=3, N_new=1) → [1024, 1] */
     t0 = now_ms();
-    float *preconv_out = (float *)malloc(latent * sizeof(float));
-    codec_causal_conv_incremental(preconv_out, rvq_out, state->pre_conv_state,
+    float *preconv_out = (float *)codec_arena_alloc(ctx, latent * sizeof(float));
+    codec_causal_conv_incremental(ctx, preconv_out, rvq_out, state->pre_conv_state,
                                    ctx->codec.pre_conv_weight,
                                    ctx->codec.pre_conv_bias,
                                    half_latent, latent, 3, 1, 1, 1);
-    free(rvq_out);
     ms_preconv = now_ms() - t0;
 
     /* 3. Transformer: single token → [latent, 1] */
@@ -1544,17 +1716,16 @@ float *qwen_tts_codec_decode_step(
         int new_len;
 
         /* TransposedConv1d (k=stride=factor, so no overlap) */
-        float *up_out = (float *)malloc((size_t)latent * cur_len * factor * 2 * sizeof(float));
+        float *up_out = (float *)codec_arena_alloc(ctx, (size_t)latent * cur_len * factor * 2 * sizeof(float));
         kernel_transposed_conv1d(up_out, hidden,
                                   ctx->codec.upsample_transconv_weight[stage],
                                   ctx->codec.upsample_transconv_bias[stage],
                                   latent, latent, factor, factor, cur_len, &new_len);
-        free(hidden);
         hidden = up_out;
         cur_len = new_len;
 
         /* ConvNeXt (incremental dwconv) */
-        codec_convnext_incremental(&ctx->codec.upsample_convnext[stage],
+        codec_convnext_incremental(ctx, &ctx->codec.upsample_convnext[stage],
                                     hidden, state->upsample_cn_state[stage],
                                     latent, cur_len);
     }
@@ -1567,12 +1738,11 @@ float *qwen_tts_codec_decode_step(
 
     /* 6. Vocoder pre-conv */
     t0 = now_ms();
-    float *voc_pre = (float *)malloc((size_t)decoder_dim * cur_len * sizeof(float));
-    codec_causal_conv_incremental(voc_pre, hidden, state->voc_preconv_state,
+    float *voc_pre = (float *)codec_arena_alloc(ctx, (size_t)decoder_dim * cur_len * sizeof(float));
+    codec_causal_conv_incremental(ctx, voc_pre, hidden, state->voc_preconv_state,
                                    ctx->codec.vocoder_pre_conv_weight,
                                    ctx->codec.vocoder_pre_conv_bias,
                                    latent, decoder_dim, 7, 1, 1, cur_len);
-    free(hidden);
     ms_voc_preconv = now_ms() - t0;
 
     hidden = voc_pre;
@@ -1589,19 +1759,18 @@ float *qwen_tts_codec_decode_step(
         kernel_snake_beta(hidden, hidden, vb->act_alpha, vb->act_beta, in_dim, cur_len);
 
         int emit_len = cur_len * rate;
-        float *tc_out = (float *)malloc((size_t)out_dim * emit_len * sizeof(float));
-        codec_transconv_incremental(tc_out, hidden,
+        float *tc_out = (float *)codec_arena_alloc(ctx, (size_t)out_dim * emit_len * sizeof(float));
+        codec_transconv_incremental(ctx, tc_out, hidden,
                                      state->voc_blocks[block].transconv_overlap,
                                      vb->transconv_weight, vb->transconv_bias,
                                      in_dim, out_dim, K, rate, cur_len);
-        free(hidden);
         hidden = tc_out;
         cur_len = emit_len;
         current_dim = out_dim;
 
         int dilations[3] = {1, 3, 9};
         for (int ru = 0; ru < 3; ru++) {
-            vocoder_resunit_incremental(&vb->resunits[ru],
+            vocoder_resunit_incremental(ctx, &vb->resunits[ru],
                                          hidden,
                                          state->voc_blocks[block].ru_conv1_state[ru],
                                          current_dim, cur_len, dilations[ru]);
@@ -1616,12 +1785,12 @@ float *qwen_tts_codec_decode_step(
                       ctx->codec.vocoder_final_act_beta,
                       current_dim, cur_len);
 
+    /* wav is returned to the caller, so it stays on the heap */
     wav = (float *)malloc(cur_len * sizeof(float));
-    codec_causal_conv_incremental(wav, hidden, state->final_conv_state,
+    codec_causal_conv_incremental(ctx, wav, hidden, state->final_conv_state,
                                    ctx->codec.vocoder_final_conv_weight,
                                    ctx->codec.vocoder_final_conv_bias,
                                    current_dim, 1, 7, 1, 1, cur_len);
-    free(hidden);
 
     /* 9. Clamp */
     kernel_clamp(wav, cur_len, -1.0f, 1.0f);
@@ -46,6 +46,9 @@ float *qwen_tts_codec_decode(
     int *out_samples
 );
 
+/* Release the per-frame codec scratch arena (called from qwen_tts_free) */
+void qwen_tts_codec_arena_free(qwen_tts_ctx_t *ctx);
+
 /* ========================================================================
  * Incremental Codec Decode State
  * ======================================================================== */
@@ -13,10 +13,6 @@
 #include <string.h>
 #include <float.h>
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif
-
 #if defined(__ARM_NEON) || defined(__aarch64__)
 #include <arm_neon.h>
 #endif
@@ -339,7 +335,7 @@ void kernel_clamp_f16(__fp16 *x, int n, __fp16 min_val, __fp16 max_val) {
 /* ======================================================================== */
 
 void kernel_init(void) {
-#ifdef USE_OPENMP
-    omp_set_num_threads(4);
-#endif
+    /* Grow-only: if the ASR engine already configured a bigger shared
+     * pool, keep it — both engines run on the same workers now. */
+    qwen_ensure_threads(4);
 }
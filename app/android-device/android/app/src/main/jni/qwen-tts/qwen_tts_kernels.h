@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include "qwen_tts_quant.h"
+#include "qwen_pool.h"  /* shared ASR/TTS thread pool */
 
 /* ========================================================================
  * BLAS configuration
@@ -52,6 +53,16 @@ void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8
 void kernel_swiglu_matvec_q8(float *out, const block_q8_0 *gate_up_q8,
                                const block_q8_0 *x_q8, int intermediate, int n_blocks);
 
+/* Matrix-vector multiply with Q4_K weights and F32 input (the input is
+ * quantized to int8 internally, as on the ASR side).
+ * W_q4k is [rows, cols/QK_K] blocks; cols must be a multiple of QK_K. */
+void kernel_matvec_q4k(float *out, const block_q4_k *W_q4k, const float *x,
+                        int rows, int cols);
+
+/* Fused SwiGLU with Q4_K weights (layout as kernel_swiglu_matvec_q8) */
+void kernel_swiglu_matvec_q4k(float *out, const block_q4_k *gate_up_q4k,
+                                const float *x, int intermediate, int cols);
+
 /* Matrix-vector multiply: out = A @ x, A is [rows, cols] F32 */
 void kernel_matvec_f32(float *out, const float *A, const float *x, int rows, int cols);
 
@@ -93,6 +104,16 @@ int kernel_sample_top_k(const float *logits, int vocab_size, int top_k,
 void kernel_apply_repetition_penalty(float *logits, const int *token_ids,
                                      int n_tokens, int vocab_size, float penalty);
 
+/* Fused sampling: repetition penalty (in-place on logits), single-scan
+ * bounded-heap top-k selection, softmax over the k candidates, optional
+ * nucleus cutoff within them, CDF sample. Never sorts the vocab; falls
+ * back to kernel_sample_top_k when top_k is disabled or > 256.
+ * Pass recent_tokens == NULL / n_recent == 0 to skip the penalty. */
+int kernel_sample_fused(float *logits, int vocab_size,
+                        const int *recent_tokens, int n_recent, float penalty,
+                        int top_k, float top_p, float temperature,
+                        float *rng_state);
+
 /* RoPE: apply rotary position embedding to q/k vectors
  * q/k shape: [num_heads, head_dim] */
 void kernel_rope_apply(float *q, float *k, const float *cos, const float *sin,
@@ -150,6 +171,12 @@ void kernel_clamp_f16(__fp16 *x, int n, __fp16 min_val, __fp16 max_val);
  * out[r] = dot(W_f16[r,:], x_f32) for r in [0, rows) */
 void kernel_matvec_f16w(float *out, const __fp16 *W_f16, const float *x, int rows, int cols);
 
+/* Dot product: F32 vector against an FP16 row (KV cache reads), F32 accumulators */
+float kernel_dot_f32_f16(const float *a, const __fp16 *b, int n);
+
+/* y_f32 += alpha * x_f16 (attention weighted-V accumulate over an FP16 cache) */
+void kernel_axpy_f16(int n, float alpha, const __fp16 *x, float *y);
+
 /* SnakeBeta activation with FP16 data, F32 alpha/beta params */
 void kernel_snake_beta_f16(__fp16 *out, const __fp16 *x, const float *alpha,
                            const float *beta, int channels, int length);
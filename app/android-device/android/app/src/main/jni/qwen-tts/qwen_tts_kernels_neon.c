@@ -14,10 +14,6 @@
 #include <string.h>
 #include <float.h>
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif
-
 #if defined(__ARM_NEON) || defined(__aarch64__)
 #include <arm_neon.h>
 #endif
@@ -34,16 +30,21 @@ void kernel_quantize_x_q8(const float *x, int n, block_q8_0 *dst) {
 /* Q8_0 Matrix-Vector Multiply                                               */
 /* ======================================================================== */
 
-void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8,
-                       int rows, int n_blocks) {
 #if defined(__ARM_NEON) || defined(__aarch64__)
-    int o = 0;
-
-    /* Process 2 output rows at a time */
-#ifdef USE_OPENMP
-    #pragma omp parallel for schedule(static) num_threads(2) if(rows >= 512)
-    for (o = 0; o < rows; o++) {
-        const block_q8_0 *w0 = W_q8 + (size_t)o * n_blocks;
+/* Row-range worker for the threaded matvec path below. */
+typedef struct {
+    float *out;
+    const block_q8_0 *W_q8;
+    const block_q8_0 *x_q8;
+    int n_blocks;
+} matvec_q8_ctx_t;
+
+static void matvec_q8_rows(int start, int end, void *argp) {
+    const matvec_q8_ctx_t *c = (const matvec_q8_ctx_t *)argp;
+    const block_q8_0 *x_q8 = c->x_q8;
+    int n_blocks = c->n_blocks;
+    for (int o = start; o < end; o++) {
+        const block_q8_0 *w0 = c->W_q8 + (size_t)o * n_blocks;
         float s0 = 0.0f;
 
         for (int b = 0; b < n_blocks; b++) {
@@ -69,10 +70,26 @@ void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8
 #endif
             s0 += ws0 * xs * (float)vaddvq_s32(d0);
         }
-        out[o] = s0;
+        c->out[o] = s0;
     }
-#else
-    /* Non-OpenMP path: 2-rows-at-a-time */
+}
+#endif  /* __ARM_NEON */
+
+void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8,
+                       int rows, int n_blocks) {
+#if defined(__ARM_NEON) || defined(__aarch64__)
+    int o = 0;
+
+    /* Vocab-sized matvecs (LM heads, codec head) fan out to the shared
+     * pool in dynamic chunks; mid-sized projections stay serial, where
+     * the fork/join overhead would outweigh the win. */
+    if (rows >= 512 && qwen_get_n_threads() > 1) {
+        matvec_q8_ctx_t ctx = { out, W_q8, x_q8, n_blocks };
+        qwen_parallel_chunks(rows, 64, matvec_q8_rows, &ctx);
+        return;
+    }
+
+    /* Serial path: 2-rows-at-a-time */
     for (; o + 1 < rows; o += 2) {
         const block_q8_0 *w0 = W_q8 + (size_t)o * n_blocks;
         const block_q8_0 *w1 = W_q8 + (size_t)(o + 1) * n_blocks;
@@ -261,7 +278,6 @@ void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8
 
         out[o] = sum;
     }
-#endif  /* USE_OPENMP else */
 #else
     /* Scalar fallback */
     for (int r = 0; r < rows; r++) {
@@ -287,13 +303,11 @@ void kernel_matvec_q8(float *out, const block_q8_0 *W_q8, const block_q8_0 *x_q8
 
 void kernel_swiglu_matvec_q8(float *out, const block_q8_0 *gate_up_q8,
                                const block_q8_0 *x_q8, int intermediate, int n_blocks) {
-    static float *up_scratch = NULL;
-    static size_t up_scratch_cap = 0;
-    if ((size_t)intermediate > up_scratch_cap) {
-        free(up_scratch);
-        up_scratch = (float *)malloc((size_t)intermediate * sizeof(float));
-        up_scratch_cap = (size_t)intermediate;
-    }
+    /* Stack scratch (<= 12 KB at the largest intermediate): this kernel
+     * runs concurrently on pool workers (codec MLP token loop) and on the
+     * talker and decoder threads, so the up-projection must not go
+     * through shared static storage. */
+    float up_scratch[intermediate];
 
     /* Gate (first `intermediate` rows) */
     kernel_matvec_q8(out, gate_up_q8, x_q8, intermediate, n_blocks);
@@ -309,6 +323,204 @@ void kernel_swiglu_matvec_q8(float *out, const block_q8_0 *gate_up_q8,
     }
 }
 
+/* ======================================================================== */
+/* Q4_K Super-Block MatVec (NEON + SDOT, adapted from the ASR engine)        */
+/* ======================================================================== */
+
+/* Quantize x to int8 for the Q4_K matvec */
+static void q4k_quantize_x_int8(const float *x, int cols,
+                                   int8_t *x_int8, float *x_scale_out) {
+    float x_absmax = 0.0f;
+#if defined(__ARM_NEON) || defined(__aarch64__)
+    float32x4_t vabsmax = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 3 < cols; i += 4)
+        vabsmax = vmaxq_f32(vabsmax, vabsq_f32(vld1q_f32(x + i)));
+    x_absmax = vmaxvq_f32(vabsmax);
+    for (; i < cols; i++) {
+        float a = x[i] > 0 ? x[i] : -x[i];
+        if (a > x_absmax) x_absmax = a;
+    }
+
+    *x_scale_out = x_absmax / 127.0f;
+    float inv_x_scale = (x_absmax > 0.0f) ? 127.0f / x_absmax : 0.0f;
+
+    float32x4_t vscale = vdupq_n_f32(inv_x_scale);
+    int c = 0;
+    for (; c + 7 < cols; c += 8) {
+        int32x4_t i0 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(x + c), vscale));
+        int32x4_t i1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(x + c + 4), vscale));
+        int16x4_t s0 = vqmovn_s32(i0);
+        int16x4_t s1 = vqmovn_s32(i1);
+        int8x8_t b = vqmovn_s16(vcombine_s16(s0, s1));
+        vst1_s8(x_int8 + c, b);
+    }
+    for (; c < cols; c++) {
+        float v = x[c] * inv_x_scale;
+        int iv = (int)(v + (v > 0 ? 0.5f : -0.5f));
+        if (iv > 127) iv = 127;
+        if (iv < -128) iv = -128;
+        x_int8[c] = (int8_t)iv;
+    }
+#else
+    for (int i = 0; i < cols; i++) {
+        float a = fabsf(x[i]);
+        if (a > x_absmax) x_absmax = a;
+    }
+    *x_scale_out = x_absmax / 127.0f;
+    float inv_x_scale = (x_absmax > 0.0f) ? 127.0f / x_absmax : 0.0f;
+    for (int c = 0; c < cols; c++) {
+        float v = x[c] * inv_x_scale;
+        int iv = (int)(v + (v > 0 ? 0.5f : -0.5f));
+        if (iv > 127) iv = 127;
+        if (iv < -128) iv = -128;
+        x_int8[c] = (int8_t)iv;
+    }
+#endif
+}
+
+/* One row of the Q4_K matvec: integer dot against pre-quantized x, with
+ * the per-sub-group min correction folded in via bsums. */
+static inline float q4k_row_sum(const block_q4_k *row_blocks, const int8_t *x_int8,
+                                 const int32_t *bsums, int blocks_per_row) {
+    float row_sum = 0.0f;
+
+    for (int b = 0; b < blocks_per_row; b++) {
+        const block_q4_k *blk = &row_blocks[b];
+        const int8_t *xq = x_int8 + b * QK_K;
+
+#if defined(__ARM_FEATURE_DOTPROD)
+        int32x4_t acc = vdupq_n_s32(0);
+        int32_t min_acc = 0;
+
+        for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+            /* Unpack unsigned nibbles */
+            uint8x16_t packed = vld1q_u8(blk->qs + g * 16);
+            int8x16_t lo = vreinterpretq_s8_u8(vandq_u8(packed, vdupq_n_u8(0x0F)));
+            int8x16_t hi = vreinterpretq_s8_u8(vshrq_n_u8(packed, 4));
+
+            /* Interleave to get elements in order */
+            int8x16x2_t z = vzipq_s8(lo, hi);
+
+            /* SDOT: dot product of q4 weights with x_int8 */
+            int32x4_t dot = vdupq_n_s32(0);
+            dot = vdotq_s32(dot, z.val[0], vld1q_s8(xq + g * 32));
+            dot = vdotq_s32(dot, z.val[1], vld1q_s8(xq + g * 32 + 16));
+
+            /* Integer sub-scale multiply (avoids vaddvq_s32 per group) */
+            dot = vmulq_n_s32(dot, (int32_t)blk->scales[g]);
+            acc = vaddq_s32(acc, dot);
+
+            /* Min correction */
+            min_acc += (int32_t)blk->mins[g] * bsums[b * Q4K_NUM_SUBS + g];
+        }
+
+        /* Only 1 vaddvq_s32 per super-block */
+        row_sum += blk->d * (float)vaddvq_s32(acc) - blk->dmin * (float)min_acc;
+#else
+        int32_t scale_acc = 0;
+        int32_t min_acc = 0;
+
+        for (int g = 0; g < Q4K_NUM_SUBS; g++) {
+            int32_t dot = 0;
+            for (int i = 0; i < 16; i++) {
+                uint8_t packed = blk->qs[g * 16 + i];
+                int8_t lo = (int8_t)(packed & 0x0F);
+                int8_t hi = (int8_t)(packed >> 4);
+                dot += (int32_t)lo * (int32_t)xq[g * 32 + i * 2];
+                dot += (int32_t)hi * (int32_t)xq[g * 32 + i * 2 + 1];
+            }
+            scale_acc += dot * (int32_t)blk->scales[g];
+            min_acc += (int32_t)blk->mins[g] * bsums[b * Q4K_NUM_SUBS + g];
+        }
+
+        row_sum += blk->d * (float)scale_acc - blk->dmin * (float)min_acc;
+#endif
+    }
+
+    return row_sum;
+}
+
+/* Row-range worker for kernel_matvec_q4k. */
+typedef struct {
+    float *out;
+    const block_q4_k *W_q4k;
+    const int8_t *x_int8;
+    const int32_t *bsums;
+    int blocks_per_row;
+    float x_scale;
+} matvec_q4k_ctx_t;
+
+static void matvec_q4k_rows(int start, int end, void *argp) {
+    const matvec_q4k_ctx_t *c = (const matvec_q4k_ctx_t *)argp;
+    for (int r = start; r < end; r++) {
+        c->out[r] = q4k_row_sum(c->W_q4k + (size_t)r * c->blocks_per_row,
+                                c->x_int8, c->bsums, c->blocks_per_row) * c->x_scale;
+    }
+}
+
+void kernel_matvec_q4k(float *out, const block_q4_k *W_q4k, const float *x,
+                        int rows, int cols) {
+    int blocks_per_row = cols / QK_K;
+    int total_subs = cols / 32;
+
+    /* Quantize x to int8 (reusable across rows) */
+    static int8_t *x_int8 = NULL;
+    static int x_int8_cap = 0;
+    if (cols > x_int8_cap) {
+        free(x_int8);
+        x_int8 = (int8_t *)malloc(((cols + 15) & ~15) * sizeof(int8_t));
+        x_int8_cap = cols;
+    }
+    static int32_t *bsums = NULL;
+    static int bsums_cap = 0;
+    if (total_subs > bsums_cap) {
+        free(bsums);
+        bsums = (int32_t *)malloc(total_subs * sizeof(int32_t));
+        bsums_cap = total_subs;
+    }
+
+    float x_scale;
+    q4k_quantize_x_int8(x, cols, x_int8, &x_scale);
+
+    /* Precompute bsums: per-sub-group sum of x_int8 */
+    for (int s = 0; s < total_subs; s++) {
+        int32_t sum = 0;
+        const int8_t *xg = x_int8 + s * 32;
+        for (int i = 0; i < 32; i++) sum += (int32_t)xg[i];
+        bsums[s] = sum;
+    }
+
+    matvec_q4k_ctx_t ctx = { out, W_q4k, x_int8, bsums, blocks_per_row, x_scale };
+    if (rows >= 512 && qwen_get_n_threads() > 1) {
+        qwen_parallel_chunks(rows, 64, matvec_q4k_rows, &ctx);
+    } else {
+        matvec_q4k_rows(0, rows, &ctx);
+    }
+}
+
+void kernel_swiglu_matvec_q4k(float *out, const block_q4_k *gate_up_q4k,
+                                const float *x, int intermediate, int cols) {
+    /* Stack scratch, same reasoning as kernel_swiglu_matvec_q8 (batched
+     * talker workers call this concurrently). */
+    float up_scratch[intermediate];
+
+    size_t blocks_per_row = (size_t)cols / QK_K;
+
+    /* Gate (first `intermediate` rows) */
+    kernel_matvec_q4k(out, gate_up_q4k, x, intermediate, cols);
+    /* Up (next `intermediate` rows) */
+    kernel_matvec_q4k(up_scratch,
+                       gate_up_q4k + (size_t)intermediate * blocks_per_row,
+                       x, intermediate, cols);
+
+    /* SiLU(gate) * up */
+    for (int i = 0; i < intermediate; i++) {
+        float g = out[i];
+        out[i] = (g / (1.0f + expf(-g))) * up_scratch[i];
+    }
+}
+
 /* ======================================================================== */
 /* F32 Matrix-Vector Multiply (codec conv projections)                       */
 /* ======================================================================== */
@@ -434,6 +646,33 @@ void kernel_matvec_f16w(float *out, const __fp16 *W_f16, const float *x, int row
     }
 }
 
+float kernel_dot_f32_f16(const float *a, const __fp16 *b, int n) {
+    /* Widening dot against an FP16 KV cache row: FP16 loads halve the
+     * bandwidth, F32 accumulators keep full precision. */
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        float16x8_t hb = vld1q_f16(b + i);
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vcvt_f32_f16(vget_low_f16(hb)));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vcvt_f32_f16(vget_high_f16(hb)));
+    }
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; i < n; i++) sum += a[i] * (float)b[i];
+    return sum;
+}
+
+void kernel_axpy_f16(int n, float alpha, const __fp16 *x, float *y) {
+    float32x4_t va = vdupq_n_f32(alpha);
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        float16x8_t hx = vld1q_f16(x + i);
+        vst1q_f32(y + i, vfmaq_f32(vld1q_f32(y + i), va, vcvt_f32_f16(vget_low_f16(hx))));
+        vst1q_f32(y + i + 4, vfmaq_f32(vld1q_f32(y + i + 4), va, vcvt_f32_f16(vget_high_f16(hx))));
+    }
+    for (; i < n; i++) y[i] += alpha * (float)x[i];
+}
+
 #endif /* __ARM_FEATURE_FP16_VECTOR_ARITHMETIC */
 
 float kernel_sum_sq(const float *x, int n) {
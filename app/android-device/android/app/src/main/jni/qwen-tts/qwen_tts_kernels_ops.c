@@ -16,10 +16,6 @@
 #include <string.h>
 #include <float.h>
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif
-
 #if defined(__ARM_NEON) || defined(__aarch64__)
 #include <arm_neon.h>
 #endif
@@ -67,71 +63,92 @@ static float *conv1d_wpack_get(size_t n) {
 }
 #endif
 
+/* Persistent scratch for the transposed-conv per-tap weight pack + GEMM
+ * temp (the vocoder calls these every hop; avoid a malloc/free pair and
+ * page faults per call). */
+static void *_tconv_scratch = NULL;
+static size_t _tconv_scratch_cap = 0;
+
+static void *tconv_scratch_get(size_t bytes) {
+    if (bytes > _tconv_scratch_cap) {
+        void *tmp = realloc(_tconv_scratch, bytes);
+        if (!tmp) return NULL;
+        _tconv_scratch = tmp;
+        _tconv_scratch_cap = bytes;
+    }
+    return _tconv_scratch;
+}
+
+/* ======================================================================== */
+/* Parallel bias-fill helper                                                 */
+/* ======================================================================== */
+
+/* Fill out[c, 0..len) with bias[c] (zero when bias == NULL). The conv
+ * kernels use this to initialize output rows before accumulating taps. */
+typedef struct {
+    float *out;
+    const float *bias;
+    int len;
+} bias_fill_ctx_t;
+
+static void bias_fill_rows(int start, int end, void *argp) {
+    const bias_fill_ctx_t *c = (const bias_fill_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        float *out_ch = c->out + (size_t)oc * c->len;
+        float b = c->bias ? c->bias[oc] : 0.0f;
+        for (int t = 0; t < c->len; t++) out_ch[t] = b;
+    }
+}
+
+static void bias_fill_par(float *out, const float *bias, int channels, int len) {
+    bias_fill_ctx_t ctx = { out, bias, len };
+    qwen_parallel_chunks(channels, 4, bias_fill_rows, &ctx);
+}
+
 /* ======================================================================== */
 /* SnakeBeta activation                                                      */
 /* ======================================================================== */
 
-void kernel_snake_beta(float *out, const float *x, const float *alpha,
-                       const float *beta, int channels, int length) {
-    /* SnakeBeta: out = x + inv_beta * sin^2(alpha * x)
-     * alpha/beta are preprocessed at load time:
-     *   alpha = exp(alpha_log)
-     *   beta = 1 / (exp(beta_log) + eps)
-     */
+typedef struct {
+    float *out;
+    const float *x;
+    const float *alpha;
+    const float *beta;
+    int length;
+} snake_ctx_t;
+
 #if defined(ACCELERATE_NEW_LAPACK)
-    /* Vectorized path using Accelerate vvsinf + vDSP (4-8x faster than scalar sinf) */
-    int L = length;
-    vDSP_Length vL = (vDSP_Length)length;
-#ifdef USE_OPENMP
-#pragma omp parallel
-    {
-        float *tmp = (float *)malloc((size_t)length * sizeof(float));
-#pragma omp for schedule(static)
-        for (int c = 0; c < channels; c++) {
-            if (!tmp) continue;
-            float a = alpha[c];
-            float inv_b = beta[c];
-            const float *xc = x + (size_t)c * length;
-            float *oc = out + (size_t)c * length;
-            vDSP_vsmul(xc, 1, &a, tmp, 1, vL);     /* tmp = alpha * x */
-            vvsinf(tmp, tmp, &L);                    /* tmp = sin(alpha * x) */
-            vDSP_vsq(tmp, 1, tmp, 1, vL);           /* tmp = sin^2(alpha * x) */
-            vDSP_vsma(tmp, 1, &inv_b, xc, 1, oc, 1, vL); /* out = inv_b * tmp + x */
-        }
-        free(tmp);
-    }
-#else
-    float *tmp = (float *)malloc((size_t)length * sizeof(float));
-    if (tmp) {
-        for (int c = 0; c < channels; c++) {
-            float a = alpha[c];
-            float inv_b = beta[c];
-            const float *xc = x + (size_t)c * length;
-            float *oc = out + (size_t)c * length;
-            vDSP_vsmul(xc, 1, &a, tmp, 1, vL);
-            vvsinf(tmp, tmp, &L);
-            vDSP_vsq(tmp, 1, tmp, 1, vL);
-            vDSP_vsma(tmp, 1, &inv_b, xc, 1, oc, 1, vL);
+static void snake_beta_vdsp_rows(int start, int end, void *argp) {
+    const snake_ctx_t *sc = (const snake_ctx_t *)argp;
+    int L = sc->length;
+    vDSP_Length vL = (vDSP_Length)sc->length;
+    float *tmp = (float *)malloc((size_t)sc->length * sizeof(float));
+    for (int c = start; c < end; c++) {
+        float a = sc->alpha[c];
+        float inv_b = sc->beta[c];
+        const float *xc = sc->x + (size_t)c * sc->length;
+        float *oc = sc->out + (size_t)c * sc->length;
+        if (!tmp) {
+            for (int t = 0; t < sc->length; t++) {
+                float s = sinf(xc[t] * a);
+                oc[t] = xc[t] + inv_b * s * s;
+            }
+            continue;
         }
-        free(tmp);
+        vDSP_vsmul(xc, 1, &a, tmp, 1, vL);     /* tmp = alpha * x */
+        vvsinf(tmp, tmp, &L);                    /* tmp = sin(alpha * x) */
+        vDSP_vsq(tmp, 1, tmp, 1, vL);           /* tmp = sin^2(alpha * x) */
+        vDSP_vsma(tmp, 1, &inv_b, xc, 1, oc, 1, vL); /* out = inv_b * tmp + x */
     }
-#endif
-    return;
-#endif
-    /* NEON / scalar path */
-#if defined(__ARM_NEON) || defined(__aarch64__)
-    /*
-     * NEON fast sine approximation for SnakeBeta.
-     * Uses a 5th-order polynomial: sin(x) ~ x - x^3/6 + x^5/120
-     * after range reduction to [-pi, pi].
-     * Precision is sufficient for audio activation (max error ~0.00016).
-     */
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int c = 0; c < channels; c++) {
-        float a_val = alpha[c];
-        float inv_b_val = beta[c];
+    free(tmp);
+}
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+static void snake_beta_neon_rows(int start, int end, void *argp) {
+    const snake_ctx_t *sc = (const snake_ctx_t *)argp;
+    int length = sc->length;
+    for (int c = start; c < end; c++) {
+        float a_val = sc->alpha[c];
+        float inv_b_val = sc->beta[c];
         float32x4_t va = vdupq_n_f32(a_val);
         float32x4_t vb = vdupq_n_f32(inv_b_val);
         /* Constants for range reduction and polynomial */
@@ -142,8 +159,8 @@ void kernel_snake_beta(float *out, const float *x, const float *alpha,
         float32x4_t v_c3       = vdupq_n_f32(-1.0f / 6.0f);          /* -1/3! */
         float32x4_t v_c5       = vdupq_n_f32(1.0f / 120.0f);         /* 1/5! */
         float32x4_t v_half     = vdupq_n_f32(0.5f);
-        const float *xc = x + (size_t)c * length;
-        float *oc = out + (size_t)c * length;
+        const float *xc = sc->x + (size_t)c * length;
+        float *oc = sc->out + (size_t)c * length;
         int t = 0;
         for (; t + 3 < length; t += 4) {
             float32x4_t vx = vld1q_f32(xc + t);
@@ -172,24 +189,42 @@ void kernel_snake_beta(float *out, const float *x, const float *alpha,
             vst1q_f32(oc + t, result);
         }
         for (; t < length; t++) {
-            int idx = c * length + t;
-            float s = sinf(x[idx] * a_val);
-            out[idx] = x[idx] + inv_b_val * s * s;
+            float s = sinf(xc[t] * a_val);
+            oc[t] = xc[t] + inv_b_val * s * s;
         }
     }
+}
 #else
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int c = 0; c < channels; c++) {
-        float a = alpha[c];
-        float inv_b = beta[c];
-        for (int t = 0; t < length; t++) {
-            int idx = c * length + t;
-            float s = sinf(x[idx] * a);
-            out[idx] = x[idx] + inv_b * s * s;
+static void snake_beta_scalar_rows(int start, int end, void *argp) {
+    const snake_ctx_t *sc = (const snake_ctx_t *)argp;
+    for (int c = start; c < end; c++) {
+        float a = sc->alpha[c];
+        float inv_b = sc->beta[c];
+        const float *xc = sc->x + (size_t)c * sc->length;
+        float *oc = sc->out + (size_t)c * sc->length;
+        for (int t = 0; t < sc->length; t++) {
+            float s = sinf(xc[t] * a);
+            oc[t] = xc[t] + inv_b * s * s;
         }
     }
+}
+#endif
+
+void kernel_snake_beta(float *out, const float *x, const float *alpha,
+                       const float *beta, int channels, int length) {
+    /* SnakeBeta: out = x + inv_beta * sin^2(alpha * x)
+     * alpha/beta are preprocessed at load time:
+     *   alpha = exp(alpha_log)
+     *   beta = 1 / (exp(beta_log) + eps)
+     */
+    snake_ctx_t ctx = { out, x, alpha, beta, length };
+#if defined(ACCELERATE_NEW_LAPACK)
+    /* Vectorized path using Accelerate vvsinf + vDSP (4-8x faster than scalar sinf) */
+    qwen_parallel_chunks(channels, 4, snake_beta_vdsp_rows, &ctx);
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    qwen_parallel_chunks(channels, 4, snake_beta_neon_rows, &ctx);
+#else
+    qwen_parallel_chunks(channels, 4, snake_beta_scalar_rows, &ctx);
 #endif
 }
 
@@ -408,6 +443,129 @@ int kernel_sample_top_k(const float *logits, int vocab_size, int top_k,
     return sampled;
 }
 
+/*
+ * Fused sampling over a small vocab (talker 3072 / sub-talker 2048 logits,
+ * executed per code group so hundreds of times per second of audio).
+ *
+ * One scan over the logits maintains a bounded min-heap of the top_k raw
+ * logits — temperature is monotonic, so it is applied only to the k
+ * survivors. On NEON the scan skips 8-wide blocks whose max is below the
+ * heap root, which rejects almost the whole vocab once the heap warms up.
+ * Softmax, the optional top_p cutoff, and the CDF draw then run on the k
+ * candidates only; nothing ever sorts the full vocab.
+ */
+int kernel_sample_fused(float *logits, int vocab_size,
+                        const int *recent_tokens, int n_recent, float penalty,
+                        int top_k, float top_p, float temperature,
+                        float *rng_state) {
+    /* Repetition penalty: touches only the recent entries */
+    if (recent_tokens && n_recent > 0 && penalty != 1.0f)
+        kernel_apply_repetition_penalty(logits, recent_tokens, n_recent,
+                                        vocab_size, penalty);
+
+    if (top_k <= 0 || top_k > 256 || top_k >= vocab_size)
+        return kernel_sample_top_k(logits, vocab_size, top_k, top_p,
+                                   temperature, rng_state);
+    if (temperature <= 0.0f) temperature = 1e-5f;
+
+    int k = top_k;
+    int heap_idx[256];
+    float heap_val[256];   /* min-heap on raw logits; root = smallest kept */
+    int n_heap = 0;
+
+#define HEAP_PUSH(v, ix)                                                    \
+    do {                                                                    \
+        if (n_heap < k) {                                                   \
+            int c = n_heap++;                                               \
+            heap_val[c] = (v); heap_idx[c] = (ix);                          \
+            while (c > 0) {                                                 \
+                int par = (c - 1) / 2;                                      \
+                if (heap_val[par] <= heap_val[c]) break;                    \
+                float tv = heap_val[par]; heap_val[par] = heap_val[c];      \
+                heap_val[c] = tv;                                           \
+                int ti = heap_idx[par]; heap_idx[par] = heap_idx[c];        \
+                heap_idx[c] = ti;                                           \
+                c = par;                                                    \
+            }                                                               \
+        } else if ((v) > heap_val[0]) {                                     \
+            heap_val[0] = (v); heap_idx[0] = (ix);                          \
+            int c = 0;                                                      \
+            for (;;) {                                                      \
+                int l = 2 * c + 1, sm = c;                                  \
+                if (l < k && heap_val[l] < heap_val[sm]) sm = l;            \
+                if (l + 1 < k && heap_val[l + 1] < heap_val[sm]) sm = l + 1;\
+                if (sm == c) break;                                         \
+                float tv = heap_val[sm]; heap_val[sm] = heap_val[c];        \
+                heap_val[c] = tv;                                           \
+                int ti = heap_idx[sm]; heap_idx[sm] = heap_idx[c];          \
+                heap_idx[c] = ti;                                           \
+                c = sm;                                                     \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+    int i = 0;
+#if defined(__ARM_NEON) || defined(__aarch64__)
+    for (; i + 7 < vocab_size; i += 8) {
+        float32x4_t a = vld1q_f32(logits + i);
+        float32x4_t b = vld1q_f32(logits + i + 4);
+        float block_max = vmaxvq_f32(vmaxq_f32(a, b));
+        if (n_heap == k && block_max <= heap_val[0]) continue;
+        for (int j = i; j < i + 8; j++) HEAP_PUSH(logits[j], j);
+    }
+#endif
+    for (; i < vocab_size; i++) HEAP_PUSH(logits[i], i);
+#undef HEAP_PUSH
+
+    if (n_heap == 0) return 0;
+
+    /* Softmax over the candidates (max is among them by construction) */
+    float max_val = heap_val[0];
+    for (int j = 1; j < n_heap; j++)
+        if (heap_val[j] > max_val) max_val = heap_val[j];
+    float inv_temp = 1.0f / temperature;
+    float sum = 0.0f;
+    for (int j = 0; j < n_heap; j++) {
+        float p = expf((heap_val[j] - max_val) * inv_temp);
+        heap_val[j] = p;
+        sum += p;
+    }
+
+    /* Nucleus cutoff: order just the k candidates (k <= 256, not the vocab) */
+    if (top_p < 1.0f && sum > 0.0f) {
+        for (int j = 1; j < n_heap; j++) {
+            float v = heap_val[j]; int ix = heap_idx[j];
+            int q = j - 1;
+            while (q >= 0 && heap_val[q] < v) {
+                heap_val[q + 1] = heap_val[q];
+                heap_idx[q + 1] = heap_idx[q];
+                q--;
+            }
+            heap_val[q + 1] = v; heap_idx[q + 1] = ix;
+        }
+        float target = top_p * sum;
+        float cumsum = 0.0f;
+        int cutoff = n_heap;
+        for (int j = 0; j < n_heap; j++) {
+            cumsum += heap_val[j];
+            if (cumsum >= target) { cutoff = j + 1; break; }
+        }
+        n_heap = cutoff;
+        sum = cumsum;
+    }
+
+    if (sum <= 0.0f) return heap_idx[0];
+
+    /* CDF draw among the survivors */
+    float r = rand_uniform(rng_state) * sum;
+    float cumsum = 0.0f;
+    for (int j = 0; j < n_heap; j++) {
+        cumsum += heap_val[j];
+        if (cumsum >= r) return heap_idx[j];
+    }
+    return heap_idx[n_heap - 1];
+}
+
 /* ======================================================================== */
 /* RoPE (Rotary Position Embedding)                                          */
 /* ======================================================================== */
@@ -549,6 +707,118 @@ void kernel_mrope_apply(float *q, float *k, const float *cos, const float *sin,
 /* Convolution operations                                                    */
 /* ======================================================================== */
 
+/* Row workers for kernel_causal_conv1d: each handles a span of output
+ * channels so the shared pool can hand out chunks dynamically. */
+typedef struct {
+    float *out;
+    const float *input;
+    const float *weight;
+    const float *bias;
+    int length, kernel_size, dilation, pad;
+    int ch_per_group, out_per_group;
+} conv1d_ctx_t;
+
+static void conv1d_pointwise_dw_rows(int start, int end, void *argp) {
+    const conv1d_ctx_t *cc = (const conv1d_ctx_t *)argp;
+    for (int c = start; c < end; c++) {
+        float w = cc->weight[c];
+        float b = cc->bias ? cc->bias[c] : 0.0f;
+        const float *in_ch = cc->input + (size_t)c * cc->length;
+        float *out_ch = cc->out + (size_t)c * cc->length;
+        for (int t = 0; t < cc->length; t++) {
+            out_ch[t] = in_ch[t] * w + b;
+        }
+    }
+}
+
+static void conv1d_pointwise_rows(int start, int end, void *argp) {
+    const conv1d_ctx_t *cc = (const conv1d_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        float *out_ch = cc->out + (size_t)oc * cc->length;
+        float b = cc->bias ? cc->bias[oc] : 0.0f;
+        for (int t = 0; t < cc->length; t++) out_ch[t] = b;
+
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        const float *w_row = cc->weight + (size_t)oc * cc->ch_per_group;
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            float w = w_row[ic];
+            const float *in_ch = cc->input + (size_t)(ic_base + ic) * cc->length;
+            saxpy_broadcast(out_ch, w, in_ch, cc->length);
+        }
+    }
+}
+
+static void conv1d_dil1_rows(int start, int end, void *argp) {
+    const conv1d_ctx_t *cc = (const conv1d_ctx_t *)argp;
+    int length = cc->length;
+    for (int oc = start; oc < end; oc++) {
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        float *out_ch = cc->out + (size_t)oc * length;
+        float b = cc->bias ? cc->bias[oc] : 0.0f;
+        for (int t = 0; t < length; t++) out_ch[t] = b;
+
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            const float *w = cc->weight + ((size_t)oc * cc->ch_per_group + ic) * cc->kernel_size;
+            const float *in_ch = cc->input + (size_t)(ic_base + ic) * length;
+
+            for (int k = 0; k < cc->kernel_size; k++) {
+                float wk = w[k];
+                int out_start = cc->pad - k;
+                if (out_start >= length) continue;
+                const float *src = in_ch;
+                float *dst = out_ch + out_start;
+                int n = length - out_start;
+#ifdef USE_BLAS
+                cblas_saxpy(n, wk, src, 1, dst, 1);
+#else
+                saxpy_broadcast(dst, wk, src, n);
+#endif
+            }
+        }
+    }
+}
+
+static void conv1d_general_rows(int start, int end, void *argp) {
+    const conv1d_ctx_t *cc = (const conv1d_ctx_t *)argp;
+    int length = cc->length;
+    for (int oc = start; oc < end; oc++) {
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        float *out_ch = cc->out + (size_t)oc * length;
+        float b = cc->bias ? cc->bias[oc] : 0.0f;
+        for (int t = 0; t < length; t++) out_ch[t] = b;
+
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            const float *w = cc->weight + ((size_t)oc * cc->ch_per_group + ic) * cc->kernel_size;
+            const float *in_ch = cc->input + (size_t)(ic_base + ic) * length;
+
+            for (int k = 0; k < cc->kernel_size; k++) {
+                float wk = w[k];
+                int shift = cc->pad - k * cc->dilation;
+                int out_start = shift;
+                int in_start = 0;
+                if (out_start < 0) {
+                    in_start = -out_start;
+                    out_start = 0;
+                }
+                if (out_start >= length || in_start >= length) continue;
+
+                int n = length - out_start;
+                int n_in = length - in_start;
+                if (n > n_in) n = n_in;
+                if (n <= 0) continue;
+#ifdef USE_BLAS
+                cblas_saxpy(n, wk, in_ch + in_start, 1, out_ch + out_start, 1);
+#else
+                saxpy_broadcast(out_ch + out_start, wk, in_ch + in_start, n);
+#endif
+            }
+        }
+    }
+}
+
 void kernel_causal_conv1d(float *out, const float *input, const float *weight,
                           const float *bias, int in_channels, int out_channels,
                           int kernel_size, int length, int dilation, int groups) {
@@ -583,14 +853,7 @@ void kernel_causal_conv1d(float *out, const float *input, const float *weight,
                 }
             }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-            for (int oc = 0; oc < out_channels; oc++) {
-                float *out_ch = out + (size_t)oc * length;
-                float b = bias ? bias[oc] : 0.0f;
-                for (int t = 0; t < length; t++) out_ch[t] = b;
-            }
+            bias_fill_par(out, bias, out_channels, length);
 
             for (int k = 0; k < kernel_size; k++) {
                 int shift = pad - k * dilation;
@@ -625,18 +888,10 @@ void kernel_causal_conv1d(float *out, const float *input, const float *weight,
     if (kernel_size == 1 && dilation == 1) {
         if (groups == in_channels && in_channels == out_channels) {
             /* Depthwise pointwise: one scalar multiply per sample. */
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-            for (int c = 0; c < in_channels; c++) {
-                float w = weight[c];
-                float b = bias ? bias[c] : 0.0f;
-                const float *in_ch = input + c * length;
-                float *out_ch = out + c * length;
-                for (int t = 0; t < length; t++) {
-                    out_ch[t] = in_ch[t] * w + b;
-                }
-            }
+            conv1d_ctx_t ctx = { out, input, weight, bias,
+                                 length, kernel_size, dilation, pad,
+                                 ch_per_group, out_per_group };
+            qwen_parallel_chunks(in_channels, 4, conv1d_pointwise_dw_rows, &ctx);
             return;
         }
 
@@ -663,22 +918,11 @@ void kernel_causal_conv1d(float *out, const float *input, const float *weight,
         }
 #endif
 
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int oc = 0; oc < out_channels; oc++) {
-            float *out_ch = out + (size_t)oc * length;
-            float b = bias ? bias[oc] : 0.0f;
-            for (int t = 0; t < length; t++) out_ch[t] = b;
-
-            int g = oc / out_per_group;
-            int ic_base = g * ch_per_group;
-            const float *w_row = weight + (size_t)oc * ch_per_group;
-            for (int ic = 0; ic < ch_per_group; ic++) {
-                float w = w_row[ic];
-                const float *in_ch = input + (size_t)(ic_base + ic) * length;
-                saxpy_broadcast(out_ch, w, in_ch, length);
-            }
+        {
+            conv1d_ctx_t ctx = { out, input, weight, bias,
+                                 length, kernel_size, dilation, pad,
+                                 ch_per_group, out_per_group };
+            qwen_parallel_chunks(out_channels, 4, conv1d_pointwise_rows, &ctx);
         }
         return;
     }
@@ -688,72 +932,86 @@ void kernel_causal_conv1d(float *out, const float *input, const float *weight,
      * avoid inner-boundary checks for the steady-state region.
      */
     if (dilation == 1) {
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int oc = 0; oc < out_channels; oc++) {
-            int g = oc / out_per_group;
-            int ic_base = g * ch_per_group;
-            float *out_ch = out + (size_t)oc * length;
-            float b = bias ? bias[oc] : 0.0f;
-            for (int t = 0; t < length; t++) out_ch[t] = b;
-
-            for (int ic = 0; ic < ch_per_group; ic++) {
-                const float *w = weight + ((size_t)oc * ch_per_group + ic) * kernel_size;
-                const float *in_ch = input + (size_t)(ic_base + ic) * length;
-
-                for (int k = 0; k < kernel_size; k++) {
-                    float wk = w[k];
-                    int out_start = pad - k;
-                    if (out_start >= length) continue;
-                    const float *src = in_ch;
-                    float *dst = out_ch + out_start;
-                    int n = length - out_start;
-#ifdef USE_BLAS
-                    cblas_saxpy(n, wk, src, 1, dst, 1);
-#else
-                    saxpy_broadcast(dst, wk, src, n);
-#endif
-                }
-            }
-        }
+        conv1d_ctx_t ctx = { out, input, weight, bias,
+                             length, kernel_size, dilation, pad,
+                             ch_per_group, out_per_group };
+        qwen_parallel_chunks(out_channels, 4, conv1d_dil1_rows, &ctx);
         return;
     }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int oc = 0; oc < out_channels; oc++) {
-        int g = oc / out_per_group;
-        int ic_base = g * ch_per_group;
-        float *out_ch = out + (size_t)oc * length;
-        float b = bias ? bias[oc] : 0.0f;
-        for (int t = 0; t < length; t++) out_ch[t] = b;
+    {
+        conv1d_ctx_t ctx = { out, input, weight, bias,
+                             length, kernel_size, dilation, pad,
+                             ch_per_group, out_per_group };
+        qwen_parallel_chunks(out_channels, 4, conv1d_general_rows, &ctx);
+    }
+}
 
-        for (int ic = 0; ic < ch_per_group; ic++) {
-            const float *w = weight + ((size_t)oc * ch_per_group + ic) * kernel_size;
-            const float *in_ch = input + (size_t)(ic_base + ic) * length;
+/* Row workers for kernel_transposed_conv1d. */
+typedef struct {
+    float *out;
+    const float *temp;
+    int temp_stride;  /* row stride of temp: n on the BLAS path, length otherwise */
+    int final_len, k, stride, n;
+} tconv_scatter_ctx_t;
+
+static void tconv_scatter_rows(int start, int end, void *argp) {
+    const tconv_scatter_ctx_t *tc = (const tconv_scatter_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        const float *tp = tc->temp + (size_t)oc * tc->temp_stride;
+        float *op = tc->out + (size_t)oc * tc->final_len + tc->k;
+        for (int t = 0; t < tc->n; t++) {
+            op[t * tc->stride] += tp[t];
+        }
+    }
+}
 
-            for (int k = 0; k < kernel_size; k++) {
-                float wk = w[k];
-                int shift = pad - k * dilation;
-                int out_start = shift;
-                int in_start = 0;
-                if (out_start < 0) {
-                    in_start = -out_start;
-                    out_start = 0;
-                }
-                if (out_start >= length || in_start >= length) continue;
+typedef struct {
+    float *temp;
+    const float *wk_packed;
+    const float *input;
+    int length, n, in_channels;
+} tconv_gemm_ctx_t;
+
+static void tconv_gemm_rows(int start, int end, void *argp) {
+    const tconv_gemm_ctx_t *tc = (const tconv_gemm_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        float *tp = tc->temp + (size_t)oc * tc->length;
+        memset(tp, 0, (size_t)tc->n * sizeof(float));
+        const float *wk_row = tc->wk_packed + (size_t)oc * tc->in_channels;
+        for (int ic = 0; ic < tc->in_channels; ic++) {
+            const float *in_ch = tc->input + (size_t)ic * tc->length;
+            saxpy_broadcast(tp, wk_row[ic], in_ch, tc->n);
+        }
+    }
+}
 
-                int n = length - out_start;
-                int n_in = length - in_start;
-                if (n > n_in) n = n_in;
-                if (n <= 0) continue;
-#ifdef USE_BLAS
-                cblas_saxpy(n, wk, in_ch + in_start, 1, out_ch + out_start, 1);
-#else
-                saxpy_broadcast(out_ch + out_start, wk, in_ch + in_start, n);
-#endif
+typedef struct {
+    float *out;
+    const float *input;
+    const float *weight;
+    const float *bias;
+    int in_channels, out_channels, kernel_size, stride, length, final_len;
+} tconv_scalar_ctx_t;
+
+static void tconv_scalar_rows(int start, int end, void *argp) {
+    const tconv_scalar_ctx_t *tc = (const tconv_scalar_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        float *out_ch = tc->out + (size_t)oc * tc->final_len;
+        float b = tc->bias ? tc->bias[oc] : 0.0f;
+        for (int t = 0; t < tc->final_len; t++) out_ch[t] = b;
+
+        for (int ic = 0; ic < tc->in_channels; ic++) {
+            const float *in_ch = tc->input + (size_t)ic * tc->length;
+            const float *w = tc->weight + (size_t)ic * tc->out_channels * tc->kernel_size
+                             + (size_t)oc * tc->kernel_size;
+            for (int t = 0; t < tc->length; t++) {
+                float val = in_ch[t];
+                int base = t * tc->stride;
+                for (int k = 0; k < tc->kernel_size; k++) {
+                    int ot = base + k;
+                    if (ot < tc->final_len) out_ch[ot] += val * w[k];
+                }
             }
         }
     }
@@ -783,17 +1041,10 @@ void kernel_transposed_conv1d(float *out, const float *input, const float *weigh
     {
         size_t wk_size = (size_t)out_channels * in_channels;
         size_t temp_size = (size_t)out_channels * length;
-        float *wk_packed = (float *)malloc(wk_size * sizeof(float));
-        float *temp = (float *)malloc(temp_size * sizeof(float));
+        float *wk_packed = (float *)tconv_scratch_get((wk_size + temp_size) * sizeof(float));
+        float *temp = wk_packed ? wk_packed + wk_size : NULL;
         if (wk_packed && temp) {
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-            for (int oc = 0; oc < out_channels; oc++) {
-                float *out_ch = out + (size_t)oc * final_len;
-                float b = bias ? bias[oc] : 0.0f;
-                for (int t = 0; t < final_len; t++) out_ch[t] = b;
-            }
+            bias_fill_par(out, bias, out_channels, final_len);
 
             for (int k = 0; k < kernel_size; k++) {
                 for (int oc = 0; oc < out_channels; oc++) {
@@ -813,24 +1064,14 @@ void kernel_transposed_conv1d(float *out, const float *input, const float *weigh
                             input, length,
                             0.0f, temp, n);
 
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-                for (int oc = 0; oc < out_channels; oc++) {
-                    const float *tp = temp + (size_t)oc * n;
-                    float *op = out + (size_t)oc * final_len + k;
-                    for (int t = 0; t < n; t++) {
-                        op[t * stride] += tp[t];
-                    }
+                {
+                    tconv_scatter_ctx_t sctx = { out, temp, n, final_len, k, stride, n };
+                    qwen_parallel_chunks(out_channels, 4, tconv_scatter_rows, &sctx);
                 }
             }
-            free(wk_packed);
-            free(temp);
             if (out_length) *out_length = final_len;
             return;
         }
-        free(wk_packed);
-        free(temp);
     }
 #endif
 
@@ -838,17 +1079,10 @@ void kernel_transposed_conv1d(float *out, const float *input, const float *weigh
     {
         size_t wk_size = (size_t)out_channels * in_channels;
         size_t temp_size = (size_t)out_channels * length;
-        float *wk_packed = (float *)malloc(wk_size * sizeof(float));
-        float *temp = (float *)malloc(temp_size * sizeof(float));
+        float *wk_packed = (float *)tconv_scratch_get((wk_size + temp_size) * sizeof(float));
+        float *temp = wk_packed ? wk_packed + wk_size : NULL;
         if (wk_packed && temp) {
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-            for (int oc = 0; oc < out_channels; oc++) {
-                float *out_ch = out + (size_t)oc * final_len;
-                float b = bias ? bias[oc] : 0.0f;
-                for (int t = 0; t < final_len; t++) out_ch[t] = b;
-            }
+            bias_fill_par(out, bias, out_channels, final_len);
 
             for (int k = 0; k < kernel_size; k++) {
                 /* Pack weights for this tap: wk_packed[oc, ic] */
@@ -865,61 +1099,28 @@ void kernel_transposed_conv1d(float *out, const float *input, const float *weigh
                 if (n > length) n = length;
 
                 /* Manual GEMM via saxpy: temp[oc, t] = sum_ic wk[oc,ic] * input[ic,t] */
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-                for (int oc = 0; oc < out_channels; oc++) {
-                    float *tp = temp + (size_t)oc * length;
-                    memset(tp, 0, (size_t)n * sizeof(float));
-                    const float *wk_row = wk_packed + (size_t)oc * in_channels;
-                    for (int ic = 0; ic < in_channels; ic++) {
-                        const float *in_ch = input + (size_t)ic * length;
-                        saxpy_broadcast(tp, wk_row[ic], in_ch, n);
-                    }
+                {
+                    tconv_gemm_ctx_t gctx = { temp, wk_packed, input, length, n, in_channels };
+                    qwen_parallel_chunks(out_channels, 4, tconv_gemm_rows, &gctx);
                 }
 
                 /* Scatter to strided output */
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-                for (int oc = 0; oc < out_channels; oc++) {
-                    const float *tp = temp + (size_t)oc * length;
-                    float *op = out + (size_t)oc * final_len + k;
-                    for (int t = 0; t < n; t++) {
-                        op[t * stride] += tp[t];
-                    }
+                {
+                    tconv_scatter_ctx_t sctx = { out, temp, length, final_len, k, stride, n };
+                    qwen_parallel_chunks(out_channels, 4, tconv_scatter_rows, &sctx);
                 }
             }
-            free(wk_packed);
-            free(temp);
             if (out_length) *out_length = final_len;
             return;
         }
-        free(wk_packed);
-        free(temp);
     }
 
     /* Ultimate scalar fallback (malloc failed) */
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int oc = 0; oc < out_channels; oc++) {
-        float *out_ch = out + (size_t)oc * final_len;
-        float b = bias ? bias[oc] : 0.0f;
-        for (int t = 0; t < final_len; t++) out_ch[t] = b;
-
-        for (int ic = 0; ic < in_channels; ic++) {
-            const float *in_ch = input + (size_t)ic * length;
-            const float *w = weight + (size_t)ic * out_channels * kernel_size + (size_t)oc * kernel_size;
-            for (int t = 0; t < length; t++) {
-                float val = in_ch[t];
-                int base = t * stride;
-                for (int k = 0; k < kernel_size; k++) {
-                    int ot = base + k;
-                    if (ot < final_len) out_ch[ot] += val * w[k];
-                }
-            }
-        }
+    {
+        tconv_scalar_ctx_t sctx = { out, input, weight, bias,
+                                    in_channels, out_channels, kernel_size,
+                                    stride, length, final_len };
+        qwen_parallel_chunks(out_channels, 4, tconv_scalar_rows, &sctx);
     }
 
     if (out_length) *out_length = final_len;
@@ -951,16 +1152,20 @@ static inline void saxpy_broadcast_f16(
 
 /* ---- kernel_snake_beta_f16: FP16 data, F32 alpha/beta params ---- */
 
-void kernel_snake_beta_f16(__fp16 *out, const __fp16 *x, const float *alpha,
-                           const float *beta, int channels, int length) {
-    /*
-     * SnakeBeta: out = x + inv_beta * sin^2(alpha * x)
-     * FP16 polynomial sine: same 5th-order approximation as F32 path.
-     * Alpha/beta are F32 per-channel scalars, converted to FP16 per channel.
-     */
-    for (int c = 0; c < channels; c++) {
-        float16x8_t va = vdupq_n_f16((__fp16)alpha[c]);
-        float16x8_t vb = vdupq_n_f16((__fp16)beta[c]);
+typedef struct {
+    __fp16 *out;
+    const __fp16 *x;
+    const float *alpha;
+    const float *beta;
+    int length;
+} snake_f16_ctx_t;
+
+static void snake_beta_f16_rows(int start, int end, void *argp) {
+    const snake_f16_ctx_t *sc = (const snake_f16_ctx_t *)argp;
+    int length = sc->length;
+    for (int c = start; c < end; c++) {
+        float16x8_t va = vdupq_n_f16((__fp16)sc->alpha[c]);
+        float16x8_t vb = vdupq_n_f16((__fp16)sc->beta[c]);
         /* Constants for range reduction and polynomial */
         float16x8_t v_inv_twopi = vdupq_n_f16((__fp16)0.15915494f);
         float16x8_t v_twopi    = vdupq_n_f16((__fp16)6.2831853f);
@@ -971,8 +1176,8 @@ void kernel_snake_beta_f16(__fp16 *out, const __fp16 *x, const float *alpha,
         float16x8_t v_half     = vdupq_n_f16((__fp16)0.5f);
         float16x8_t v_one      = vdupq_n_f16((__fp16)1.0f);
 
-        const __fp16 *xc = x + (size_t)c * length;
-        __fp16 *oc = out + (size_t)c * length;
+        const __fp16 *xc = sc->x + (size_t)c * length;
+        __fp16 *oc = sc->out + (size_t)c * length;
         int t = 0;
         for (; t + 7 < length; t += 8) {
             float16x8_t vx = vld1q_f16(xc + t);
@@ -998,18 +1203,141 @@ void kernel_snake_beta_f16(__fp16 *out, const __fp16 *x, const float *alpha,
             vst1q_f16(oc + t, result);
         }
         /* Scalar cleanup */
-        float a_val = alpha[c];
-        float inv_b_val = beta[c];
+        float a_val = sc->alpha[c];
+        float inv_b_val = sc->beta[c];
         for (; t < length; t++) {
-            int idx = c * length + t;
-            float s = sinf((float)x[idx] * a_val);
-            out[idx] = (__fp16)((float)x[idx] + inv_b_val * s * s);
+            float s = sinf((float)xc[t] * a_val);
+            oc[t] = (__fp16)((float)xc[t] + inv_b_val * s * s);
         }
     }
 }
 
+void kernel_snake_beta_f16(__fp16 *out, const __fp16 *x, const float *alpha,
+                           const float *beta, int channels, int length) {
+    /*
+     * SnakeBeta: out = x + inv_beta * sin^2(alpha * x)
+     * FP16 polynomial sine: same 5th-order approximation as F32 path.
+     * Alpha/beta are F32 per-channel scalars, converted to FP16 per channel.
+     */
+    snake_f16_ctx_t ctx = { out, x, alpha, beta, length };
+    qwen_parallel_chunks(channels, 4, snake_beta_f16_rows, &ctx);
+}
+
 /* ---- kernel_causal_conv1d_f16 ---- */
 
+/* Row workers for the FP16 conv kernels (mirror the F32 ones above). */
+typedef struct {
+    __fp16 *out;
+    const __fp16 *input;
+    const __fp16 *weight;
+    const __fp16 *bias;
+    int length, kernel_size, dilation, pad;
+    int ch_per_group, out_per_group;
+} conv1d_f16_ctx_t;
+
+static void conv1d_f16_pointwise_dw_rows(int start, int end, void *argp) {
+    const conv1d_f16_ctx_t *cc = (const conv1d_f16_ctx_t *)argp;
+    int length = cc->length;
+    for (int c = start; c < end; c++) {
+        __fp16 w = cc->weight[c];
+        __fp16 b = cc->bias ? cc->bias[c] : (__fp16)0.0f;
+        const __fp16 *in_ch = cc->input + (size_t)c * length;
+        __fp16 *out_ch = cc->out + (size_t)c * length;
+        float16x8_t vw = vdupq_n_f16(w);
+        float16x8_t vb = vdupq_n_f16(b);
+        int t = 0;
+        for (; t + 7 < length; t += 8)
+            vst1q_f16(out_ch + t, vfmaq_f16(vb, vw, vld1q_f16(in_ch + t)));
+        for (; t < length; t++)
+            out_ch[t] = (__fp16)((float)in_ch[t] * (float)w + (float)b);
+    }
+}
+
+static void conv1d_f16_pointwise_rows(int start, int end, void *argp) {
+    const conv1d_f16_ctx_t *cc = (const conv1d_f16_ctx_t *)argp;
+    int length = cc->length;
+    for (int oc = start; oc < end; oc++) {
+        __fp16 *out_ch = cc->out + (size_t)oc * length;
+        __fp16 b = cc->bias ? cc->bias[oc] : (__fp16)0.0f;
+        float16x8_t vb = vdupq_n_f16(b);
+        int t = 0;
+        for (; t + 7 < length; t += 8) vst1q_f16(out_ch + t, vb);
+        for (; t < length; t++) out_ch[t] = b;
+
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        const __fp16 *w_row = cc->weight + (size_t)oc * cc->ch_per_group;
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            const __fp16 *in_ch = cc->input + (size_t)(ic_base + ic) * length;
+            saxpy_broadcast_f16(out_ch, w_row[ic], in_ch, length);
+        }
+    }
+}
+
+static void conv1d_f16_dil1_rows(int start, int end, void *argp) {
+    const conv1d_f16_ctx_t *cc = (const conv1d_f16_ctx_t *)argp;
+    int length = cc->length;
+    for (int oc = start; oc < end; oc++) {
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        __fp16 *out_ch = cc->out + (size_t)oc * length;
+        __fp16 b = cc->bias ? cc->bias[oc] : (__fp16)0.0f;
+        float16x8_t vb = vdupq_n_f16(b);
+        int t = 0;
+        for (; t + 7 < length; t += 8) vst1q_f16(out_ch + t, vb);
+        for (; t < length; t++) out_ch[t] = b;
+
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            const __fp16 *w = cc->weight + ((size_t)oc * cc->ch_per_group + ic) * cc->kernel_size;
+            const __fp16 *in_ch = cc->input + (size_t)(ic_base + ic) * length;
+
+            for (int k = 0; k < cc->kernel_size; k++) {
+                __fp16 wk = w[k];
+                int out_start = cc->pad - k;
+                if (out_start >= length) continue;
+                saxpy_broadcast_f16(out_ch + out_start, wk, in_ch, length - out_start);
+            }
+        }
+    }
+}
+
+static void conv1d_f16_general_rows(int start, int end, void *argp) {
+    const conv1d_f16_ctx_t *cc = (const conv1d_f16_ctx_t *)argp;
+    int length = cc->length;
+    for (int oc = start; oc < end; oc++) {
+        int g = oc / cc->out_per_group;
+        int ic_base = g * cc->ch_per_group;
+        __fp16 *out_ch = cc->out + (size_t)oc * length;
+        __fp16 b = cc->bias ? cc->bias[oc] : (__fp16)0.0f;
+        float16x8_t vb = vdupq_n_f16(b);
+        int t_init = 0;
+        for (; t_init + 7 < length; t_init += 8) vst1q_f16(out_ch + t_init, vb);
+        for (; t_init < length; t_init++) out_ch[t_init] = b;
+
+        for (int ic = 0; ic < cc->ch_per_group; ic++) {
+            const __fp16 *w = cc->weight + ((size_t)oc * cc->ch_per_group + ic) * cc->kernel_size;
+            const __fp16 *in_ch = cc->input + (size_t)(ic_base + ic) * length;
+
+            for (int k = 0; k < cc->kernel_size; k++) {
+                __fp16 wk = w[k];
+                int shift = cc->pad - k * cc->dilation;
+                int out_start = shift;
+                int in_start = 0;
+                if (out_start < 0) {
+                    in_start = -out_start;
+                    out_start = 0;
+                }
+                if (out_start >= length || in_start >= length) continue;
+                int n = length - out_start;
+                int n_in = length - in_start;
+                if (n > n_in) n = n_in;
+                if (n <= 0) continue;
+                saxpy_broadcast_f16(out_ch + out_start, wk, in_ch + in_start, n);
+            }
+        }
+    }
+}
+
 void kernel_causal_conv1d_f16(__fp16 *out, const __fp16 *input, const __fp16 *weight,
                               const __fp16 *bias, int in_channels, int out_channels,
                               int kernel_size, int length, int dilation, int groups) {
@@ -1022,106 +1350,132 @@ void kernel_causal_conv1d_f16(__fp16 *out, const __fp16 *input, const __fp16 *we
     if (kernel_size == 1 && dilation == 1) {
         if (groups == in_channels && in_channels == out_channels) {
             /* Depthwise pointwise */
-            for (int c = 0; c < in_channels; c++) {
-                __fp16 w = weight[c];
-                __fp16 b = bias ? bias[c] : (__fp16)0.0f;
-                const __fp16 *in_ch = input + (size_t)c * length;
-                __fp16 *out_ch = out + (size_t)c * length;
-                float16x8_t vw = vdupq_n_f16(w);
-                float16x8_t vb = vdupq_n_f16(b);
-                int t = 0;
-                for (; t + 7 < length; t += 8)
-                    vst1q_f16(out_ch + t, vfmaq_f16(vb, vw, vld1q_f16(in_ch + t)));
-                for (; t < length; t++)
-                    out_ch[t] = (__fp16)((float)in_ch[t] * (float)w + (float)b);
-            }
+            conv1d_f16_ctx_t ctx = { out, input, weight, bias,
+                                     length, kernel_size, dilation, pad,
+                                     ch_per_group, out_per_group };
+            qwen_parallel_chunks(in_channels, 4, conv1d_f16_pointwise_dw_rows, &ctx);
             return;
         }
 
         /* groups=1 pointwise: saxpy_broadcast_f16 */
-        for (int oc = 0; oc < out_channels; oc++) {
-            __fp16 *out_ch = out + (size_t)oc * length;
-            __fp16 b = bias ? bias[oc] : (__fp16)0.0f;
-            float16x8_t vb = vdupq_n_f16(b);
-            int t = 0;
-            for (; t + 7 < length; t += 8) vst1q_f16(out_ch + t, vb);
-            for (; t < length; t++) out_ch[t] = b;
-
-            int g = oc / out_per_group;
-            int ic_base = g * ch_per_group;
-            const __fp16 *w_row = weight + (size_t)oc * ch_per_group;
-            for (int ic = 0; ic < ch_per_group; ic++) {
-                const __fp16 *in_ch = input + (size_t)(ic_base + ic) * length;
-                saxpy_broadcast_f16(out_ch, w_row[ic], in_ch, length);
-            }
+        {
+            conv1d_f16_ctx_t ctx = { out, input, weight, bias,
+                                     length, kernel_size, dilation, pad,
+                                     ch_per_group, out_per_group };
+            qwen_parallel_chunks(out_channels, 4, conv1d_f16_pointwise_rows, &ctx);
         }
         return;
     }
 
     /* dilation=1, kernel>1 */
     if (dilation == 1) {
-        for (int oc = 0; oc < out_channels; oc++) {
-            int g = oc / out_per_group;
-            int ic_base = g * ch_per_group;
-            __fp16 *out_ch = out + (size_t)oc * length;
-            __fp16 b = bias ? bias[oc] : (__fp16)0.0f;
-            float16x8_t vb = vdupq_n_f16(b);
-            int t = 0;
-            for (; t + 7 < length; t += 8) vst1q_f16(out_ch + t, vb);
-            for (; t < length; t++) out_ch[t] = b;
-
-            for (int ic = 0; ic < ch_per_group; ic++) {
-                const __fp16 *w = weight + ((size_t)oc * ch_per_group + ic) * kernel_size;
-                const __fp16 *in_ch = input + (size_t)(ic_base + ic) * length;
-
-                for (int k = 0; k < kernel_size; k++) {
-                    __fp16 wk = w[k];
-                    int out_start = pad - k;
-                    if (out_start >= length) continue;
-                    saxpy_broadcast_f16(out_ch + out_start, wk, in_ch, length - out_start);
-                }
-            }
-        }
+        conv1d_f16_ctx_t ctx = { out, input, weight, bias,
+                                 length, kernel_size, dilation, pad,
+                                 ch_per_group, out_per_group };
+        qwen_parallel_chunks(out_channels, 4, conv1d_f16_dil1_rows, &ctx);
         return;
     }
 
     /* General dilated convolution */
-    for (int oc = 0; oc < out_channels; oc++) {
-        int g = oc / out_per_group;
-        int ic_base = g * ch_per_group;
-        __fp16 *out_ch = out + (size_t)oc * length;
-        __fp16 b = bias ? bias[oc] : (__fp16)0.0f;
+    {
+        conv1d_f16_ctx_t ctx = { out, input, weight, bias,
+                                 length, kernel_size, dilation, pad,
+                                 ch_per_group, out_per_group };
+        qwen_parallel_chunks(out_channels, 4, conv1d_f16_general_rows, &ctx);
+    }
+}
+
+/* ---- kernel_transposed_conv1d_f16 ---- */
+
+/* Row workers for kernel_transposed_conv1d_f16. */
+typedef struct {
+    __fp16 *out;
+    const __fp16 *bias;
+    int len;
+} bias_fill_f16_ctx_t;
+
+static void bias_fill_f16_rows(int start, int end, void *argp) {
+    const bias_fill_f16_ctx_t *c = (const bias_fill_f16_ctx_t *)argp;
+    int len = c->len;
+    for (int oc = start; oc < end; oc++) {
+        __fp16 *out_ch = c->out + (size_t)oc * len;
+        __fp16 b = c->bias ? c->bias[oc] : (__fp16)0.0f;
         float16x8_t vb = vdupq_n_f16(b);
-        int t_init = 0;
-        for (; t_init + 7 < length; t_init += 8) vst1q_f16(out_ch + t_init, vb);
-        for (; t_init < length; t_init++) out_ch[t_init] = b;
+        int t = 0;
+        for (; t + 7 < len; t += 8) vst1q_f16(out_ch + t, vb);
+        for (; t < len; t++) out_ch[t] = b;
+    }
+}
 
-        for (int ic = 0; ic < ch_per_group; ic++) {
-            const __fp16 *w = weight + ((size_t)oc * ch_per_group + ic) * kernel_size;
-            const __fp16 *in_ch = input + (size_t)(ic_base + ic) * length;
+typedef struct {
+    __fp16 *temp;
+    const __fp16 *wk_packed;
+    const __fp16 *input;
+    int length, n, in_channels;
+} tconv_f16_gemm_ctx_t;
+
+static void tconv_f16_gemm_rows(int start, int end, void *argp) {
+    const tconv_f16_gemm_ctx_t *tc = (const tconv_f16_gemm_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        __fp16 *tp = tc->temp + (size_t)oc * tc->length;
+        memset(tp, 0, (size_t)tc->n * sizeof(__fp16));
+        const __fp16 *wk_row = tc->wk_packed + (size_t)oc * tc->in_channels;
+        for (int ic = 0; ic < tc->in_channels; ic++) {
+            const __fp16 *in_ch = tc->input + (size_t)ic * tc->length;
+            saxpy_broadcast_f16(tp, wk_row[ic], in_ch, tc->n);
+        }
+    }
+}
 
-            for (int k = 0; k < kernel_size; k++) {
-                __fp16 wk = w[k];
-                int shift = pad - k * dilation;
-                int out_start = shift;
-                int in_start = 0;
-                if (out_start < 0) {
-                    in_start = -out_start;
-                    out_start = 0;
+typedef struct {
+    __fp16 *out;
+    const __fp16 *temp;
+    int temp_stride;
+    int final_len, k, stride, n;
+} tconv_f16_scatter_ctx_t;
+
+static void tconv_f16_scatter_rows(int start, int end, void *argp) {
+    const tconv_f16_scatter_ctx_t *tc = (const tconv_f16_scatter_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        const __fp16 *tp = tc->temp + (size_t)oc * tc->temp_stride;
+        __fp16 *op = tc->out + (size_t)oc * tc->final_len + tc->k;
+        for (int t = 0; t < tc->n; t++) {
+            op[t * tc->stride] = (__fp16)((float)op[t * tc->stride] + (float)tp[t]);
+        }
+    }
+}
+
+typedef struct {
+    __fp16 *out;
+    const __fp16 *input;
+    const __fp16 *weight;
+    const __fp16 *bias;
+    int in_channels, out_channels, kernel_size, stride, length, final_len;
+} tconv_f16_scalar_ctx_t;
+
+static void tconv_f16_scalar_rows(int start, int end, void *argp) {
+    const tconv_f16_scalar_ctx_t *tc = (const tconv_f16_scalar_ctx_t *)argp;
+    for (int oc = start; oc < end; oc++) {
+        __fp16 *out_ch = tc->out + (size_t)oc * tc->final_len;
+        __fp16 b = tc->bias ? tc->bias[oc] : (__fp16)0.0f;
+        for (int t = 0; t < tc->final_len; t++) out_ch[t] = b;
+
+        for (int ic = 0; ic < tc->in_channels; ic++) {
+            const __fp16 *in_ch = tc->input + (size_t)ic * tc->length;
+            const __fp16 *w = tc->weight + (size_t)ic * tc->out_channels * tc->kernel_size
+                              + (size_t)oc * tc->kernel_size;
+            for (int t = 0; t < tc->length; t++) {
+                float val = (float)in_ch[t];
+                int base = t * tc->stride;
+                for (int kk = 0; kk < tc->kernel_size; kk++) {
+                    int ot = base + kk;
+                    if (ot < tc->final_len) out_ch[ot] = (__fp16)((float)out_ch[ot] + val * (float)w[kk]);
                 }
-                if (out_start >= length || in_start >= length) continue;
-                int n = length - out_start;
-                int n_in = length - in_start;
-                if (n > n_in) n = n_in;
-                if (n <= 0) continue;
-                saxpy_broadcast_f16(out_ch + out_start, wk, in_ch + in_start, n);
             }
         }
     }
 }
 
-/* ---- kernel_transposed_conv1d_f16 ---- */
-
 void kernel_transposed_conv1d_f16(__fp16 *out, const __fp16 *input, const __fp16 *weight,
                                   const __fp16 *bias, int in_channels, int out_channels,
                                   int kernel_size, int stride, int length, int *out_length) {
@@ -1134,16 +1488,12 @@ void kernel_transposed_conv1d_f16(__fp16 *out, const __fp16 *input, const __fp16
     {
         size_t wk_size = (size_t)out_channels * in_channels;
         size_t temp_size = (size_t)out_channels * length;
-        __fp16 *wk_packed = (__fp16 *)malloc(wk_size * sizeof(__fp16));
-        __fp16 *temp = (__fp16 *)malloc(temp_size * sizeof(__fp16));
+        __fp16 *wk_packed = (__fp16 *)tconv_scratch_get((wk_size + temp_size) * sizeof(__fp16));
+        __fp16 *temp = wk_packed ? wk_packed + wk_size : NULL;
         if (wk_packed && temp) {
-            for (int oc = 0; oc < out_channels; oc++) {
-                __fp16 *out_ch = out + (size_t)oc * final_len;
-                __fp16 b = bias ? bias[oc] : (__fp16)0.0f;
-                float16x8_t vb = vdupq_n_f16(b);
-                int t = 0;
-                for (; t + 7 < final_len; t += 8) vst1q_f16(out_ch + t, vb);
-                for (; t < final_len; t++) out_ch[t] = b;
+            {
+                bias_fill_f16_ctx_t bctx = { out, bias, final_len };
+                qwen_parallel_chunks(out_channels, 4, bias_fill_f16_rows, &bctx);
             }
 
             for (int k = 0; k < kernel_size; k++) {
@@ -1160,52 +1510,28 @@ void kernel_transposed_conv1d_f16(__fp16 *out, const __fp16 *input, const __fp16
                 if (n > length) n = length;
 
                 /* Manual GEMM via saxpy */
-                for (int oc = 0; oc < out_channels; oc++) {
-                    __fp16 *tp = temp + (size_t)oc * length;
-                    memset(tp, 0, (size_t)n * sizeof(__fp16));
-                    const __fp16 *wk_row = wk_packed + (size_t)oc * in_channels;
-                    for (int ic = 0; ic < in_channels; ic++) {
-                        const __fp16 *in_ch = input + (size_t)ic * length;
-                        saxpy_broadcast_f16(tp, wk_row[ic], in_ch, n);
-                    }
+                {
+                    tconv_f16_gemm_ctx_t gctx = { temp, wk_packed, input, length, n, in_channels };
+                    qwen_parallel_chunks(out_channels, 4, tconv_f16_gemm_rows, &gctx);
                 }
 
                 /* Scatter to strided output */
-                for (int oc = 0; oc < out_channels; oc++) {
-                    const __fp16 *tp = temp + (size_t)oc * length;
-                    __fp16 *op = out + (size_t)oc * final_len + k;
-                    for (int t = 0; t < n; t++) {
-                        op[t * stride] = (__fp16)((float)op[t * stride] + (float)tp[t]);
-                    }
+                {
+                    tconv_f16_scatter_ctx_t sctx = { out, temp, length, final_len, k, stride, n };
+                    qwen_parallel_chunks(out_channels, 4, tconv_f16_scatter_rows, &sctx);
                 }
             }
-            free(wk_packed);
-            free(temp);
             if (out_length) *out_length = final_len;
             return;
         }
-        free(wk_packed);
-        free(temp);
     }
 
     /* Scalar fallback */
-    for (int oc = 0; oc < out_channels; oc++) {
-        __fp16 *out_ch = out + (size_t)oc * final_len;
-        __fp16 b = bias ? bias[oc] : (__fp16)0.0f;
-        for (int t = 0; t < final_len; t++) out_ch[t] = b;
-
-        for (int ic = 0; ic < in_channels; ic++) {
-            const __fp16 *in_ch = input + (size_t)ic * length;
-            const __fp16 *w = weight + (size_t)ic * out_channels * kernel_size + (size_t)oc * kernel_size;
-            for (int t = 0; t < length; t++) {
-                float val = (float)in_ch[t];
-                int base = t * stride;
-                for (int kk = 0; kk < kernel_size; kk++) {
-                    int ot = base + kk;
-                    if (ot < final_len) out_ch[ot] = (__fp16)((float)out_ch[ot] + val * (float)w[kk]);
-                }
-            }
-        }
+    {
+        tconv_f16_scalar_ctx_t sctx = { out, input, weight, bias,
+                                        in_channels, out_channels, kernel_size,
+                                        stride, length, final_len };
+        qwen_parallel_chunks(out_channels, 4, tconv_f16_scalar_rows, &sctx);
     }
 
     if (out_length) *out_length = final_len;
@@ -1,11 +1,18 @@
 /*
- * qwen_tts_quant.h - Q8_0 quantization format for Qwen3-TTS
+ * qwen_tts_quant.h - Q8_0 / Q4_K quantization formats for Qwen3-TTS
  *
  * Q8_0: 32 weights per block, symmetric quantization.
  * Each block stores a float scale and 32 int8 quantized values.
  * weight[i] = scale * qs[i]
  *
  * Memory: 36 bytes per 32 weights = 1.125 bytes/weight
+ *
+ * Q4_K: 256 weights per super-block, two-level asymmetric quantization
+ * (same block layout as the ASR engine's block_q4_k so the SDOT kernel
+ * structure carries over). Per super-block (8 sub-groups of 32):
+ * weight ≈ d * scales[g] * q - dmin * mins[g], q ∈ [0, 15]
+ *
+ * Memory: 152 bytes per 256 weights = 0.59375 bytes/weight
  */
 
 #ifndef QWEN_TTS_QUANT_H
@@ -14,12 +21,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#define QK8_0 32  /* block size */
-
-typedef struct {
-    float scale;           /* shared scale factor */
-    int8_t qs[QK8_0];     /* quantized values */
-} block_q8_0;             /* 36 bytes total */
+/* block_q8_0 / block_q4_k and the QK8_0 / QK_K / Q4K_NUM_SUBS constants are
+ * shared with the ASR engine. */
+#include "qwen_quant_formats.h"
 
 /* Quantize n float32 values to Q8_0 blocks.
  * n must be a multiple of QK8_0.
@@ -31,4 +35,9 @@ void quantize_f32_to_q8_0(const float *src, block_q8_0 *dst, int n);
  * dst must have n/QK8_0 blocks allocated. */
 void quantize_bf16_to_q8_0(const uint16_t *src, block_q8_0 *dst, int n);
 
+/* Quantize a [rows, cols] bfloat16 weight matrix to Q4_K blocks.
+ * cols must be a multiple of QK_K (256).
+ * dst must have rows * cols/QK_K blocks allocated. */
+void quantize_bf16_to_q4_k(const uint16_t *src, block_q4_k *dst, int rows, int cols);
+
 #endif /* QWEN_TTS_QUANT_H */
@@ -61,6 +61,31 @@ static inline void st_axpy(int n, float alpha, const float *x, float *y) {
 #endif
 }
 
+/* KV cache accessors: the cache element type (qwen_tts_kv_t) is FP16 on
+ * fp16-capable builds — convert on store, widen in the dot/axpy — and F32
+ * otherwise, so call sites stay #ifdef-free. */
+#ifdef __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+static inline void st_kv_store(qwen_tts_kv_t *dst, const float *src, int n) {
+    kernel_f32_to_f16(dst, src, n);
+}
+static inline float st_kv_dot(const float *a, const qwen_tts_kv_t *b, int n) {
+    return kernel_dot_f32_f16(a, b, n);
+}
+static inline void st_kv_axpy(int n, float alpha, const qwen_tts_kv_t *x, float *y) {
+    kernel_axpy_f16(n, alpha, x, y);
+}
+#else
+static inline void st_kv_store(qwen_tts_kv_t *dst, const float *src, int n) {
+    memcpy(dst, src, (size_t)n * sizeof(float));
+}
+static inline float st_kv_dot(const float *a, const qwen_tts_kv_t *b, int n) {
+    return st_dot(a, b, n);
+}
+static inline void st_kv_axpy(int n, float alpha, const qwen_tts_kv_t *x, float *y) {
+    st_axpy(n, alpha, x, y);
+}
+#endif
+
 static int ensure_talker_prefill_buffers(qwen_tts_ctx_t *ctx, int seq_len) {
     qwen_tts_config_t *cfg = &ctx->config;
     int hidden = cfg->talker_hidden;
@@ -165,7 +190,7 @@ static void talker_attention_single(
     /* 1. Input LayerNorm */
     kernel_rms_norm(x_norm, x, layer->input_norm, hidden, eps);
 
-    /* 2. Q, K, V projections (Q8_0) */
+    /* 2. Q, K, V projections (Q4_K or Q8_0) */
     {
         int q_dim = num_heads * head_dim;
         int total_rows = q_dim + kv_dim + kv_dim;
@@ -174,10 +199,14 @@ static void talker_attention_single(
             ctx->tk_qkv = (float *)malloc(total_rows * sizeof(float));
             qkv_buf = ctx->tk_qkv;
         }
-        int n_blocks = hidden / QK8_0;
-        block_q8_0 x_q8[n_blocks];
-        kernel_quantize_x_q8(x_norm, hidden, x_q8);
-        kernel_matvec_q8(qkv_buf, layer->wqkv_q8, x_q8, total_rows, n_blocks);
+        if (layer->wqkv_q4k) {
+            kernel_matvec_q4k(qkv_buf, layer->wqkv_q4k, x_norm, total_rows, hidden);
+        } else {
+            int n_blocks = hidden / QK8_0;
+            block_q8_0 x_q8[n_blocks];
+            kernel_quantize_x_q8(x_norm, hidden, x_q8);
+            kernel_matvec_q8(qkv_buf, layer->wqkv_q8, x_q8, total_rows, n_blocks);
+        }
         memcpy(q_buf, qkv_buf, q_dim * sizeof(float));
         memcpy(k_buf, qkv_buf + q_dim, kv_dim * sizeof(float));
         memcpy(v_buf, qkv_buf + q_dim + kv_dim, kv_dim * sizeof(float));
@@ -226,10 +255,10 @@ static void talker_attention_single(
 
     /* 5. Store K, V into KV cache */
     size_t kv_stride = (size_t)ctx->talker_kv_max * kv_dim;
-    float *cache_k = ctx->talker_kv_k + (size_t)layer_idx * kv_stride + (size_t)pos * kv_dim;
-    float *cache_v = ctx->talker_kv_v + (size_t)layer_idx * kv_stride + (size_t)pos * kv_dim;
-    memcpy(cache_k, k_buf, kv_dim * sizeof(float));
-    memcpy(cache_v, v_buf, kv_dim * sizeof(float));
+    qwen_tts_kv_t *cache_k = ctx->talker_kv_k + (size_t)layer_idx * kv_stride + (size_t)pos * kv_dim;
+    qwen_tts_kv_t *cache_v = ctx->talker_kv_v + (size_t)layer_idx * kv_stride + (size_t)pos * kv_dim;
+    st_kv_store(cache_k, k_buf, kv_dim);
+    st_kv_store(cache_v, v_buf, kv_dim);
 
     /* 6. Attention: Q @ K^T, scaled, causal (single query pos) */
     int seq_len = pos + 1;  /* total KV length */
@@ -243,8 +272,8 @@ static void talker_attention_single(
         float *scores = ctx->tk_scores;
 
         for (int t = 0; t < seq_len; t++) {
-            float *kt = ctx->talker_kv_k + (size_t)layer_idx * kv_stride + (size_t)t * kv_dim + kv_h * head_dim;
-            float score = st_dot(qh, kt, head_dim) * scale;
+            qwen_tts_kv_t *kt = ctx->talker_kv_k + (size_t)layer_idx * kv_stride + (size_t)t * kv_dim + kv_h * head_dim;
+            float score = st_kv_dot(qh, kt, head_dim) * scale;
             scores[t] = score;
         }
 
@@ -255,37 +284,45 @@ static void talker_attention_single(
         float *oh = attn_out + h * head_dim;
         memset(oh, 0, head_dim * sizeof(float));
         for (int t = 0; t < seq_len; t++) {
-            float *vt = ctx->talker_kv_v + (size_t)layer_idx * kv_stride + (size_t)t * kv_dim + kv_h * head_dim;
-            st_axpy(head_dim, scores[t], vt, oh);
+            qwen_tts_kv_t *vt = ctx->talker_kv_v + (size_t)layer_idx * kv_stride + (size_t)t * kv_dim + kv_h * head_dim;
+            st_kv_axpy(head_dim, scores[t], vt, oh);
         }
     }
 
-    /* 7. Output projection (Q8_0) */
+    /* 7. Output projection (Q4_K or Q8_0) */
     float *proj_out = x_norm; /* reuse buffer */
     {
         int q_dim = num_heads * head_dim;
-        int n_blocks = q_dim / QK8_0;
-        block_q8_0 attn_q8[n_blocks];
-        kernel_quantize_x_q8(attn_out, q_dim, attn_q8);
-        kernel_matvec_q8(proj_out, layer->wo_q8, attn_q8, hidden, n_blocks);
+        if (layer->wo_q4k) {
+            kernel_matvec_q4k(proj_out, layer->wo_q4k, attn_out, hidden, q_dim);
+        } else {
+            int n_blocks = q_dim / QK8_0;
+            block_q8_0 attn_q8[n_blocks];
+            kernel_quantize_x_q8(attn_out, q_dim, attn_q8);
+            kernel_matvec_q8(proj_out, layer->wo_q8, attn_q8, hidden, n_blocks);
+        }
     }
 
     /* 8. Residual add */
     kernel_add_inplace(x, proj_out, hidden);
 
-    /* 9. Post-attention norm + SwiGLU MLP (Q8_0) */
+    /* 9. Post-attention norm + SwiGLU MLP */
     kernel_rms_norm(x_norm, x, layer->post_attn_norm, hidden, eps);
 
     float *gate_buf = ctx->tk_gate;
-    {
+    if (layer->gate_up_q4k) {
+        kernel_swiglu_matvec_q4k(gate_buf, layer->gate_up_q4k, x_norm, cfg->talker_intermediate, hidden);
+    } else {
         int n_blocks = hidden / QK8_0;
         block_q8_0 xn_q8[n_blocks];
         kernel_quantize_x_q8(x_norm, hidden, xn_q8);
         kernel_swiglu_matvec_q8(gate_buf, layer->gate_up_q8, xn_q8, cfg->talker_intermediate, n_blocks);
     }
 
-    /* down projection (Q8_0) */
-    {
+    /* down projection */
+    if (layer->down_q4k) {
+        kernel_matvec_q4k(proj_out, layer->down_q4k, gate_buf, hidden, cfg->talker_intermediate);
+    } else {
         int n_blocks = cfg->talker_intermediate / QK8_0;
         block_q8_0 gate_q8[n_blocks];
         kernel_quantize_x_q8(gate_buf, cfg->talker_intermediate, gate_q8);
@@ -313,9 +350,9 @@ void qwen_tts_talker_prefill(qwen_tts_ctx_t *ctx, const float *input_embeds, int
     /* Ensure KV cache is large enough */
     if (ctx->talker_kv_max < seq_len + 4096) {
         int new_max = seq_len + 4096;
-        size_t kv_size = (size_t)cfg->talker_layers * new_max * kv_dim * sizeof(float);
-        ctx->talker_kv_k = (float *)realloc(ctx->talker_kv_k, kv_size);
-        ctx->talker_kv_v = (float *)realloc(ctx->talker_kv_v, kv_size);
+        size_t kv_size = (size_t)cfg->talker_layers * new_max * kv_dim * sizeof(qwen_tts_kv_t);
+        ctx->talker_kv_k = (qwen_tts_kv_t *)realloc(ctx->talker_kv_k, kv_size);
+        ctx->talker_kv_v = (qwen_tts_kv_t *)realloc(ctx->talker_kv_v, kv_size);
         ctx->talker_kv_max = new_max;
     }
 
@@ -375,16 +412,20 @@ void qwen_tts_talker_prefill(qwen_tts_ctx_t *ctx, const float *input_embeds, int
             kernel_rms_norm(x_norm + t * hidden, x + t * hidden, l->input_norm, hidden, eps);
         }
 
-        /* 2. Q, K, V projections (per-token Q8_0 matvec) */
+        /* 2. Q, K, V projections (per-token matvec) */
         {
             int q_dim = num_heads * head_dim;
             int total_rows = q_dim + kv_dim + kv_dim;
             int n_blocks = hidden / QK8_0;
             float *qkv_tmp = (float *)malloc(total_rows * sizeof(float));
             for (int t = 0; t < seq_len; t++) {
-                block_q8_0 xn_q8[n_blocks];
-                kernel_quantize_x_q8(x_norm + t * hidden, hidden, xn_q8);
-                kernel_matvec_q8(qkv_tmp, l->wqkv_q8, xn_q8, total_rows, n_blocks);
+                if (l->wqkv_q4k) {
+                    kernel_matvec_q4k(qkv_tmp, l->wqkv_q4k, x_norm + t * hidden, total_rows, hidden);
+                } else {
+                    block_q8_0 xn_q8[n_blocks];
+                    kernel_quantize_x_q8(x_norm + t * hidden, hidden, xn_q8);
+                    kernel_matvec_q8(qkv_tmp, l->wqkv_q8, xn_q8, total_rows, n_blocks);
+                }
                 memcpy(q_all + (size_t)t * q_dim, qkv_tmp, q_dim * sizeof(float));
                 memcpy(k_all + (size_t)t * kv_dim, qkv_tmp + q_dim, kv_dim * sizeof(float));
                 memcpy(v_all + (size_t)t * kv_dim, qkv_tmp + q_dim + kv_dim, kv_dim * sizeof(float));
@@ -445,10 +486,10 @@ void qwen_tts_talker_prefill(qwen_tts_ctx_t *ctx, const float *input_embeds, int
 
         /* 5. Store K, V in cache */
         for (int t = 0; t < seq_len; t++) {
-            memcpy(ctx->talker_kv_k + layer * kv_stride + t * kv_dim,
-                   k_all + t * kv_dim, kv_dim * sizeof(float));
-            memcpy(ctx->talker_kv_v + layer * kv_stride + t * kv_dim,
-                   v_all + t * kv_dim, kv_dim * sizeof(float));
+            st_kv_store(ctx->talker_kv_k + layer * kv_stride + t * kv_dim,
+                        k_all + t * kv_dim, kv_dim);
+            st_kv_store(ctx->talker_kv_v + layer * kv_stride + t * kv_dim,
+                        v_all + t * kv_dim, kv_dim);
         }
 
         /* 6. Attention: [seq, heads, head_dim] @ [seq, kv_heads, head_dim]^T
@@ -482,14 +523,19 @@ void qwen_tts_talker_prefill(qwen_tts_ctx_t *ctx, const float *input_embeds, int
             }
         }
 
-        /* 7. Output projection (per-token Q8_0 matvec) */
+        /* 7. Output projection (per-token matvec) */
         {
             int q_dim = num_heads * head_dim;
             int n_blocks = q_dim / QK8_0;
             for (int t = 0; t < seq_len; t++) {
-                block_q8_0 attn_q8[n_blocks];
-                kernel_quantize_x_q8(attn_out + (size_t)t * q_dim, q_dim, attn_q8);
-                kernel_matvec_q8(x_norm + (size_t)t * hidden, l->wo_q8, attn_q8, hidden, n_blocks);
+                if (l->wo_q4k) {
+                    kernel_matvec_q4k(x_norm + (size_t)t * hidden, l->wo_q4k,
+                                      attn_out + (size_t)t * q_dim, hidden, q_dim);
+                } else {
+                    block_q8_0 attn_q8[n_blocks];
+                    kernel_quantize_x_q8(attn_out + (size_t)t * q_dim, q_dim, attn_q8);
+                    kernel_matvec_q8(x_norm + (size_t)t * hidden, l->wo_q8, attn_q8, hidden, n_blocks);
+                }
             }
         }
 
@@ -501,18 +547,30 @@ void qwen_tts_talker_prefill(qwen_tts_ctx_t *ctx, const float *input_embeds, int
         for (int t = 0; t < seq_len; t++)
             kernel_rms_norm(x_norm + t * hidden, x + t * hidden, l->post_attn_norm, hidden, eps);
 
-        /* SwiGLU MLP + down projection (per-token Q8_0) */
+        /* SwiGLU MLP + down projection (per-token) */
         {
             int n_blocks_h = hidden / QK8_0;
             int n_blocks_i = cfg->talker_intermediate / QK8_0;
             for (int t = 0; t < seq_len; t++) {
-                block_q8_0 xn_q8[n_blocks_h];
-                kernel_quantize_x_q8(x_norm + (size_t)t * hidden, hidden, xn_q8);
-                kernel_swiglu_matvec_q8(gate_all + (size_t)t * cfg->talker_intermediate,
-                                         l->gate_up_q8, xn_q8, cfg->talker_intermediate, n_blocks_h);
-                block_q8_0 gate_q8[n_blocks_i];
-                kernel_quantize_x_q8(gate_all + (size_t)t * cfg->talker_intermediate, cfg->talker_intermediate, gate_q8);
-                kernel_matvec_q8(x_norm + (size_t)t * hidden, l->down_q8, gate_q8, hidden, n_blocks_i);
+                if (l->gate_up_q4k) {
+                    kernel_swiglu_matvec_q4k(gate_all + (size_t)t * cfg->talker_intermediate,
+                                             l->gate_up_q4k, x_norm + (size_t)t * hidden,
+                                             cfg->talker_intermediate, hidden);
+                } else {
+                    block_q8_0 xn_q8[n_blocks_h];
+                    kernel_quantize_x_q8(x_norm + (size_t)t * hidden, hidden, xn_q8);
+                    kernel_swiglu_matvec_q8(gate_all + (size_t)t * cfg->talker_intermediate,
+                                             l->gate_up_q8, xn_q8, cfg->talker_intermediate, n_blocks_h);
+                }
+                if (l->down_q4k) {
+                    kernel_matvec_q4k(x_norm + (size_t)t * hidden, l->down_q4k,
+                                      gate_all + (size_t)t * cfg->talker_intermediate,
+                                      hidden, cfg->talker_intermediate);
+                } else {
+                    block_q8_0 gate_q8[n_blocks_i];
+                    kernel_quantize_x_q8(gate_all + (size_t)t * cfg->talker_intermediate, cfg->talker_intermediate, gate_q8);
+                    kernel_matvec_q8(x_norm + (size_t)t * hidden, l->down_q8, gate_q8, hidden, n_blocks_i);
+                }
             }
         }
 
@@ -557,9 +615,9 @@ void qwen_tts_talker_forward(qwen_tts_ctx_t *ctx, const float *input_embed, floa
     /* Ensure KV cache space */
     if (pos >= ctx->talker_kv_max) {
         int new_max = ctx->talker_kv_max + 2048;
-        size_t kv_size = (size_t)cfg->talker_layers * new_max * kv_dim * sizeof(float);
-        ctx->talker_kv_k = (float *)realloc(ctx->talker_kv_k, kv_size);
-        ctx->talker_kv_v = (float *)realloc(ctx->talker_kv_v, kv_size);
+        size_t kv_size = (size_t)cfg->talker_layers * new_max * kv_dim * sizeof(qwen_tts_kv_t);
+        ctx->talker_kv_k = (qwen_tts_kv_t *)realloc(ctx->talker_kv_k, kv_size);
+        ctx->talker_kv_v = (qwen_tts_kv_t *)realloc(ctx->talker_kv_v, kv_size);
         ctx->tk_scores = (float *)realloc(ctx->tk_scores, new_max * sizeof(float));
         ctx->talker_kv_max = new_max;
     }
@@ -636,9 +694,9 @@ void qwen_tts_subtalker_generate(
     /* Allocate KV cache for sub-talker (small, num_groups+1 positions) */
     int max_seq = num_groups + 2;
     if (!ctx->subtalker_kv_k || ctx->subtalker_kv_max < max_seq) {
-        size_t kv_size = (size_t)st_layers * max_seq * st_kv_dim * sizeof(float);
-        ctx->subtalker_kv_k = (float *)realloc(ctx->subtalker_kv_k, kv_size);
-        ctx->subtalker_kv_v = (float *)realloc(ctx->subtalker_kv_v, kv_size);
+        size_t kv_size = (size_t)st_layers * max_seq * st_kv_dim * sizeof(qwen_tts_kv_t);
+        ctx->subtalker_kv_k = (qwen_tts_kv_t *)realloc(ctx->subtalker_kv_k, kv_size);
+        ctx->subtalker_kv_v = (qwen_tts_kv_t *)realloc(ctx->subtalker_kv_v, kv_size);
         ctx->subtalker_kv_max = max_seq;
     }
     ctx->subtalker_kv_len = 0;
@@ -722,7 +780,9 @@ void qwen_tts_subtalker_generate(
         for (int sl = 0; sl < st_layers; sl++) { \
             qwen_tts_subtalker_layer_t *l = &ctx->subtalker.layers[sl]; \
             kernel_rms_norm(x_norm, x, l->input_norm, st_hidden, eps); \
-            { \
+            if (l->wqkv_q4k) { \
+                kernel_matvec_q4k(st_qkv_buf, l->wqkv_q4k, x_norm, st_qkv_total, st_hidden); \
+            } else { \
                 int _nb = st_hidden / QK8_0; \
                 block_q8_0 _xq[_nb]; \
                 kernel_quantize_x_q8(x_norm, st_hidden, _xq); \
@@ -739,8 +799,8 @@ void qwen_tts_subtalker_generate(
                               ctx->st_rope_sin + (pos_idx) * st_head_dim, st_heads, st_head_dim); \
             kernel_rope_apply(k_buf, NULL, ctx->st_rope_cos + (pos_idx) * st_head_dim, \
                               ctx->st_rope_sin + (pos_idx) * st_head_dim, st_kv_heads, st_head_dim); \
-            memcpy(ctx->subtalker_kv_k + sl * kv_stride + (pos_idx) * st_kv_dim, k_buf, st_kv_dim * sizeof(float)); \
-            memcpy(ctx->subtalker_kv_v + sl * kv_stride + (pos_idx) * st_kv_dim, v_buf, st_kv_dim * sizeof(float)); \
+            st_kv_store(ctx->subtalker_kv_k + sl * kv_stride + (pos_idx) * st_kv_dim, k_buf, st_kv_dim); \
+            st_kv_store(ctx->subtalker_kv_v + sl * kv_stride + (pos_idx) * st_kv_dim, v_buf, st_kv_dim); \
             for (int h = 0; h < st_heads; h++) { \
                 int kvh = h / groups_per_head; \
                 float *_q = q_buf + h * st_head_dim; \
@@ -748,17 +808,19 @@ void qwen_tts_subtalker_generate(
                 float *_scores = ctx->st_scores; \
                 memset(_o, 0, st_head_dim * sizeof(float)); \
                 for (int t = 0; t <= (pos_idx); t++) { \
-                    float *_k = ctx->subtalker_kv_k + sl * kv_stride + t * st_kv_dim + kvh * st_head_dim; \
-                    _scores[t] = st_dot(_q, _k, st_head_dim) * attn_scale; \
+                    qwen_tts_kv_t *_k = ctx->subtalker_kv_k + sl * kv_stride + t * st_kv_dim + kvh * st_head_dim; \
+                    _scores[t] = st_kv_dot(_q, _k, st_head_dim) * attn_scale; \
                 } \
                 kernel_softmax(_scores, (pos_idx) + 1); \
                 for (int t = 0; t <= (pos_idx); t++) { \
                     float w = _scores[t]; \
-                    float *_v = ctx->subtalker_kv_v + sl * kv_stride + t * st_kv_dim + kvh * st_head_dim; \
-                    st_axpy(st_head_dim, w, _v, _o); \
+                    qwen_tts_kv_t *_v = ctx->subtalker_kv_v + sl * kv_stride + t * st_kv_dim + kvh * st_head_dim; \
+                    st_kv_axpy(st_head_dim, w, _v, _o); \
                 } \
             } \
-            { \
+            if (l->wo_q4k) { \
+                kernel_matvec_q4k(x_norm, l->wo_q4k, attn_out, st_hidden, st_q_dim); \
+            } else { \
                 int _nb = st_q_dim / QK8_0; \
                 block_q8_0 _aq[_nb]; \
                 kernel_quantize_x_q8(attn_out, st_q_dim, _aq); \
@@ -766,13 +828,17 @@ void qwen_tts_subtalker_generate(
             } \
             kernel_add_inplace(x, x_norm, st_hidden); \
             kernel_rms_norm(x_norm, x, l->post_attn_norm, st_hidden, eps); \
-            { \
+            if (l->gate_up_q4k) { \
+                kernel_swiglu_matvec_q4k(st_gate_buf, l->gate_up_q4k, x_norm, st_intermediate, st_hidden); \
+            } else { \
                 int _nb = st_hidden / QK8_0; \
                 block_q8_0 _xq[_nb]; \
                 kernel_quantize_x_q8(x_norm, st_hidden, _xq); \
                 kernel_swiglu_matvec_q8(st_gate_buf, l->gate_up_q8, _xq, st_intermediate, _nb); \
             } \
-            { \
+            if (l->down_q4k) { \
+                kernel_matvec_q4k(x_norm, l->down_q4k, st_gate_buf, st_hidden, st_intermediate); \
+            } else { \
                 int _nb = st_intermediate / QK8_0; \
                 block_q8_0 _gq[_nb]; \
                 kernel_quantize_x_q8(st_gate_buf, st_intermediate, _gq); \
@@ -818,8 +884,9 @@ void qwen_tts_subtalker_generate(
         kernel_matvec_q8(logits_buf, ctx->subtalker.lm_heads_q8[0], x_q8, st_vocab, n_blocks);
     }
     float rng = (float)ctx->sample_seed;
-    out_codes[1] = kernel_sample_top_k(logits_buf, st_vocab, ctx->subtalker_top_k,
-                                        ctx->subtalker_top_p, ctx->subtalker_temperature, &rng);
+    out_codes[1] = kernel_sample_fused(logits_buf, st_vocab, NULL, 0, 1.0f,
+                                        ctx->subtalker_top_k, ctx->subtalker_top_p,
+                                        ctx->subtalker_temperature, &rng);
 
     /* Steps 2..30: generate groups 2..31 */
     for (int g = 2; g < num_groups; g++) {
@@ -834,8 +901,9 @@ void qwen_tts_subtalker_generate(
             kernel_quantize_x_q8(x, st_hidden, x_q8);
             kernel_matvec_q8(logits_buf, ctx->subtalker.lm_heads_q8[g - 1], x_q8, st_vocab, n_blocks);
         }
-        out_codes[g] = kernel_sample_top_k(logits_buf, st_vocab, ctx->subtalker_top_k,
-                                            ctx->subtalker_top_p, ctx->subtalker_temperature, &rng);
+        out_codes[g] = kernel_sample_fused(logits_buf, st_vocab, NULL, 0, 1.0f,
+                                            ctx->subtalker_top_k, ctx->subtalker_top_p,
+                                            ctx->subtalker_temperature, &rng);
     }
 
     #undef ST_PROJECT_INPUT
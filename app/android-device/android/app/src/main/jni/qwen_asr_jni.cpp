@@ -8,6 +8,7 @@
 #include <jni.h>
 #include <android/log.h>
 #include <pthread.h>
+#include <atomic>
 #include <cstring>
 #include <cstdlib>
 #include <unistd.h>
@@ -16,6 +17,8 @@ extern "C" {
 #include "qwen_asr.h"
 #include "qwen_asr_audio.h"
 #include "qwen_asr_kernels.h"
+#include "qwen_asr_perf.h"
+#include "qwen_asr_trace.h"
 }
 
 #define TAG "QwenASR_JNI"
@@ -58,11 +61,75 @@ static qwen_ctx_t *g_ctx = nullptr;
 static qwen_live_audio_t *g_live = nullptr;
 static pthread_t g_asr_thread;
 static bool g_asr_running = false;
+static int g_input_rate = 0;  // native mic rate; 0/16000 = no resampling
 
 // Cached JNI references for token callback
 static jclass g_voice_service_class = nullptr;
 static jmethodID g_on_native_token = nullptr;
 
+// ---------------------------------------------------------------------------
+// Shared audio ring (lock-free producer path)
+// ---------------------------------------------------------------------------
+//
+// Java's AudioRecord reads PCM straight into a native-allocated direct
+// ByteBuffer (the staging chunk), then nativeCommitAudio publishes it into
+// this SPSC ring with one release store — no jshortArray, no Get/Release
+// pinning, no mutex on the audio thread. A pump thread drains the ring and
+// runs the short→float conversion, resampler and VAD (and the contended
+// qwen_live_audio_t mutex) off the capture thread, so the mic cadence can't
+// be stalled by the decode loop holding that lock.
+
+static uint8_t *g_ring = nullptr;
+static size_t g_ring_cap = 0;            // bytes, power of two
+static uint8_t *g_staging = nullptr;
+static size_t g_staging_cap = 0;
+static std::atomic<uint64_t> g_ring_wr{0};  // bytes produced (monotonic)
+static std::atomic<uint64_t> g_ring_rd{0};  // bytes consumed (monotonic)
+static std::atomic<bool> g_pump_running{false};
+static pthread_t g_pump_thread;
+static uint64_t g_ring_overruns = 0;     // audio-thread only
+
+static void *audio_pump_thread(void * /*arg*/) {
+    while (g_pump_running.load(std::memory_order_acquire)) {
+        uint64_t wr = g_ring_wr.load(std::memory_order_acquire);
+        uint64_t rd = g_ring_rd.load(std::memory_order_relaxed);
+        if (wr == rd) {
+            // Chunks arrive every ~100ms; a short poll keeps the producer
+            // free of any signalling primitive.
+            usleep(5000);
+            continue;
+        }
+        size_t avail = (size_t)(wr - rd);
+        size_t off = (size_t)(rd & (g_ring_cap - 1));
+        size_t run = g_ring_cap - off;
+        if (run > avail) run = avail;
+        if (g_live) {
+            qwen_live_audio_push_s16(g_live, (const int16_t *)(g_ring + off),
+                                     (int)(run / 2));
+        }
+        g_ring_rd.store(rd + run, std::memory_order_release);
+    }
+    return nullptr;
+}
+
+static void start_audio_pump(void) {
+    if (!g_ring || g_pump_running.load(std::memory_order_acquire)) return;
+    // Discard anything staged while ASR was down
+    g_ring_rd.store(g_ring_wr.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    g_pump_running.store(true, std::memory_order_release);
+    if (pthread_create(&g_pump_thread, nullptr, audio_pump_thread, nullptr) != 0) {
+        LOGE("start_audio_pump: pthread_create failed");
+        g_pump_running.store(false, std::memory_order_relaxed);
+    }
+}
+
+static void stop_audio_pump(void) {
+    if (!g_pump_running.load(std::memory_order_acquire)) return;
+    g_pump_running.store(false, std::memory_order_release);
+    pthread_join(g_pump_thread, nullptr);
+}
+
 // ---------------------------------------------------------------------------
 // JNI_OnLoad
 // ---------------------------------------------------------------------------
@@ -164,6 +231,10 @@ Java_ai_connct_1screen_rn_VoiceService_nativeLoadModel(
     // Set thread count (default to 4 if not specified)
     int threads = nThreads > 0 ? nThreads : 4;
     qwen_set_threads(threads);
+    // Let the pool re-tune its width between utterances: sustained
+    // transcription thermal-throttles after a few minutes and the fixed
+    // width then oversubscribes the shrunken cores.
+    qwen_pool_governor_enable(1);
     LOGI("Set thread count to %d", threads);
 
     // Configure for live streaming
@@ -192,12 +263,17 @@ Java_ai_connct_1screen_rn_VoiceService_nativeStartAsr(JNIEnv *env, jclass /*claz
 
     // Reset KV cache for fresh start
     g_ctx->kv_cache_len = 0;
+    g_ctx->kv_pos_offset = 0;
 
     g_live = qwen_live_audio_create();
     if (!g_live) {
         LOGE("nativeStartAsr: failed to create live audio");
         return JNI_FALSE;
     }
+    if (qwen_live_audio_set_input_rate(g_live, g_input_rate) != 0) {
+        LOGE("nativeStartAsr: unsupported input rate %d, expecting 16kHz pushes",
+             g_input_rate);
+    }
 
     g_asr_running = true;
     if (pthread_create(&g_asr_thread, nullptr, asr_thread_func, nullptr) != 0) {
@@ -207,11 +283,78 @@ Java_ai_connct_1screen_rn_VoiceService_nativeStartAsr(JNIEnv *env, jclass /*claz
         g_asr_running = false;
         return JNI_FALSE;
     }
+    start_audio_pump();
 
     LOGI("ASR started");
     return JNI_TRUE;
 }
 
+JNIEXPORT jobject JNICALL
+Java_ai_connct_1screen_rn_VoiceService_nativeCreateAudioRing(
+        JNIEnv *env, jclass /*clazz*/, jint chunkBytes) {
+    if (chunkBytes <= 0) return nullptr;
+
+    // Re-init with a bigger chunk (e.g. record-rate change): replace both
+    // buffers. Callers only do this while the pump is stopped.
+    if (g_staging && g_staging_cap < (size_t)chunkBytes) {
+        stop_audio_pump();
+        free(g_staging); g_staging = nullptr;
+        free(g_ring); g_ring = nullptr;
+    }
+    if (!g_staging) {
+        g_staging_cap = (size_t)chunkBytes;
+        g_staging = (uint8_t *)malloc(g_staging_cap);
+        // ~16 chunks (1.6s of 100ms buffers) of slack before overrun
+        g_ring_cap = 1;
+        while (g_ring_cap < (size_t)chunkBytes * 16) g_ring_cap <<= 1;
+        g_ring = (uint8_t *)malloc(g_ring_cap);
+        if (!g_staging || !g_ring) {
+            LOGE("nativeCreateAudioRing: allocation failed");
+            free(g_staging); g_staging = nullptr;
+            free(g_ring); g_ring = nullptr;
+            return nullptr;
+        }
+        g_ring_wr.store(0, std::memory_order_relaxed);
+        g_ring_rd.store(0, std::memory_order_relaxed);
+    }
+    return env->NewDirectByteBuffer(g_staging, (jlong)g_staging_cap);
+}
+
+JNIEXPORT void JNICALL
+Java_ai_connct_1screen_rn_VoiceService_nativeCommitAudio(
+        JNIEnv * /*env*/, jclass /*clazz*/, jint bytes) {
+    if (!g_ring || !g_staging || bytes <= 0) return;
+    size_t n = (size_t)bytes;
+    if (n > g_staging_cap) n = g_staging_cap;
+    n &= ~(size_t)1;  // whole int16 frames
+
+    uint64_t wr = g_ring_wr.load(std::memory_order_relaxed);
+    uint64_t rd = g_ring_rd.load(std::memory_order_acquire);
+    if (g_ring_cap - (size_t)(wr - rd) < n) {
+        // Pump stalled (decode loop holding the audio mutex for too long);
+        // drop the chunk rather than block the capture thread.
+        if ((++g_ring_overruns & 0x3f) == 1)
+            LOGE("audio ring overrun (%llu total), dropping chunk",
+                 (unsigned long long)g_ring_overruns);
+        return;
+    }
+    size_t off = (size_t)(wr & (g_ring_cap - 1));
+    size_t run = g_ring_cap - off;
+    if (run > n) run = n;
+    memcpy(g_ring + off, g_staging, run);
+    memcpy(g_ring, g_staging + run, n - run);
+    g_ring_wr.store(wr + n, std::memory_order_release);
+}
+
+JNIEXPORT void JNICALL
+Java_ai_connct_1screen_rn_VoiceService_nativeSetAudioInputRate(
+        JNIEnv * /*env*/, jclass /*clazz*/, jint sampleRate) {
+    g_input_rate = sampleRate;
+    if (g_live && qwen_live_audio_set_input_rate(g_live, sampleRate) != 0) {
+        LOGE("nativeSetAudioInputRate: unsupported rate %d", sampleRate);
+    }
+}
+
 JNIEXPORT void JNICALL
 Java_ai_connct_1screen_rn_VoiceService_nativePushAudio(
         JNIEnv *env, jclass /*clazz*/, jshortArray samples, jint length) {
@@ -229,6 +372,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeStopAsr(JNIEnv *env, jclass /*clazz
     if (!g_asr_running || !g_live) return;
 
     LOGI("Stopping ASR...");
+    stop_audio_pump();
     qwen_live_audio_signal_eof(g_live);
     pthread_join(g_asr_thread, nullptr);
 
@@ -244,6 +388,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeResetAsr(JNIEnv *env, jclass /*claz
 
     // Stop current ASR if running
     if (g_asr_running && g_live) {
+        stop_audio_pump();
         qwen_live_audio_signal_eof(g_live);
         pthread_join(g_asr_thread, nullptr);
         qwen_live_audio_free(g_live);
@@ -253,6 +398,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeResetAsr(JNIEnv *env, jclass /*claz
 
     // Reset KV cache
     g_ctx->kv_cache_len = 0;
+    g_ctx->kv_pos_offset = 0;
 
     // Create fresh live audio and restart ASR thread
     g_live = qwen_live_audio_create();
@@ -260,6 +406,10 @@ Java_ai_connct_1screen_rn_VoiceService_nativeResetAsr(JNIEnv *env, jclass /*claz
         LOGE("nativeResetAsr: failed to create live audio");
         return;
     }
+    if (qwen_live_audio_set_input_rate(g_live, g_input_rate) != 0) {
+        LOGE("nativeResetAsr: unsupported input rate %d, expecting 16kHz pushes",
+             g_input_rate);
+    }
 
     g_asr_running = true;
     if (pthread_create(&g_asr_thread, nullptr, asr_thread_func, nullptr) != 0) {
@@ -268,6 +418,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeResetAsr(JNIEnv *env, jclass /*claz
         g_live = nullptr;
         g_asr_running = false;
     }
+    if (g_asr_running) start_audio_pump();
 
     LOGI("ASR reset and restarted");
 }
@@ -276,6 +427,7 @@ JNIEXPORT void JNICALL
 Java_ai_connct_1screen_rn_VoiceService_nativeFreeModel(JNIEnv *env, jclass /*clazz*/) {
     // Stop ASR first
     if (g_asr_running && g_live) {
+        stop_audio_pump();
         qwen_live_audio_signal_eof(g_live);
         pthread_join(g_asr_thread, nullptr);
         qwen_live_audio_free(g_live);
@@ -283,6 +435,11 @@ Java_ai_connct_1screen_rn_VoiceService_nativeFreeModel(JNIEnv *env, jclass /*cla
         g_asr_running = false;
     }
 
+    // Release the shared audio ring (Java drops its ByteBuffer alongside)
+    stop_audio_pump();
+    free(g_staging); g_staging = nullptr; g_staging_cap = 0;
+    free(g_ring); g_ring = nullptr; g_ring_cap = 0;
+
     if (g_ctx) {
         qwen_free(g_ctx);
         g_ctx = nullptr;
@@ -336,6 +493,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeTestWav(
 
     // Reset KV cache for clean inference
     g_ctx->kv_cache_len = 0;
+    g_ctx->kv_pos_offset = 0;
 
     // Use batch mode for WAV files — single encoder + prefill + decode pass,
     // much faster than streaming which re-prefills O(N²) per chunk.
@@ -401,6 +559,7 @@ Java_ai_connct_1screen_rn_VoiceService_nativeTestWavStream(
 
     // Reset KV cache for clean inference
     g_ctx->kv_cache_len = 0;
+    g_ctx->kv_pos_offset = 0;
 
     // Use streaming path: create live audio, push all samples, signal EOF, transcribe
     qwen_live_audio_t *live = qwen_live_audio_create();
@@ -438,4 +597,26 @@ Java_ai_connct_1screen_rn_VoiceService_nativeTestWavStream(
     free(samples);
 }
 
+// Read-and-clear: returns the per-kernel/per-layer counter report and resets
+// the counters, so fleet telemetry gets per-pull deltas.
+JNIEXPORT jstring JNICALL
+Java_ai_connct_1screen_rn_VoiceService_nativeGetPerfReport(
+        JNIEnv *env, jclass /*clazz*/) {
+
+    char buf[8192];
+    qwen_perf_report(buf, sizeof(buf));
+    qwen_perf_reset();
+    return env->NewStringUTF(buf);
+}
+
+// Structured pipeline trace: bit 1 = JSONL events on stderr (forwarded to
+// logcat by the redirect above), bit 2 = ATrace sections for perfetto.
+// 0 turns it off. Safe to flip while a stream is running.
+JNIEXPORT void JNICALL
+Java_ai_connct_1screen_rn_VoiceService_nativeSetTraceMode(
+        JNIEnv * /*env*/, jclass /*clazz*/, jint mode) {
+    qwen_trace_set((int)mode);
+    LOGI("Trace mode set to %d", (int)mode);
+}
+
 } // extern "C"
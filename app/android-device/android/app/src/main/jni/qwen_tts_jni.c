@@ -5,13 +5,16 @@
  *   - nativeTtsLoadModel(String modelDir) -> boolean
  *   - nativeTtsGenerate(String tokenIds, String speaker, String language) -> short[]
  *   - nativeTtsGenerateStream(String tokenIds, String speaker, String language,
- *                             int chunkSize, TtsStreamCallback callback) -> void
+ *                             int chunkSize, boolean directSink,
+ *                             TtsStreamCallback callback) -> void
  *   - nativeTtsIsLoaded() -> boolean
  *   - nativeTtsFree() -> void
  */
 
 #include <jni.h>
 #include <android/log.h>
+#include <aaudio/AAudio.h>
+#include <dlfcn.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -20,6 +23,7 @@
 #include <time.h>
 
 #include "qwen_tts.h"
+#include "qwen_pool.h"
 
 #define TAG "QwenTTS_JNI"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, TAG, __VA_ARGS__)
@@ -114,6 +118,10 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeTtsGenerate(JNIEnv *env, jclass cl
     LOGI("TTS generate: tokens=%s speaker=%s language=%s",
          token_ids, speaker ? speaker : "(null)", language ? language : "(null)");
 
+    /* Synthesis is background class on the shared pool: live ASR decode
+     * (barge-in) keeps the workers whenever both want them. */
+    qwen_set_thread_background(1);
+
     int out_samples = 0;
     float *pcm_float = qwen_tts_generate(g_tts_ctx, token_ids, speaker, language, &out_samples);
 
@@ -151,6 +159,107 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeTtsGenerate(JNIEnv *env, jclass cl
     return result;
 }
 
+/* ========================================================================
+ * Direct AAudio sink (optional low-latency playback path)
+ *
+ * minSdk is 24 but AAudio only exists from API 26, so the library is
+ * dlopen'd at runtime; on older devices (or if the stream fails to open)
+ * playback falls back to the jshortArray → Java AudioTrack bridge below.
+ * ======================================================================== */
+
+static struct {
+    int tried;
+    void *lib;
+    aaudio_result_t (*createStreamBuilder)(AAudioStreamBuilder **);
+    void (*builderSetSampleRate)(AAudioStreamBuilder *, int32_t);
+    void (*builderSetChannelCount)(AAudioStreamBuilder *, int32_t);
+    void (*builderSetFormat)(AAudioStreamBuilder *, aaudio_format_t);
+    void (*builderSetPerformanceMode)(AAudioStreamBuilder *, aaudio_performance_mode_t);
+    aaudio_result_t (*builderOpenStream)(AAudioStreamBuilder *, AAudioStream **);
+    aaudio_result_t (*builderDelete)(AAudioStreamBuilder *);
+    aaudio_result_t (*streamRequestStart)(AAudioStream *);
+    aaudio_result_t (*streamWrite)(AAudioStream *, const void *, int32_t, int64_t);
+    int64_t (*streamGetFramesWritten)(AAudioStream *);
+    int64_t (*streamGetFramesRead)(AAudioStream *);
+    aaudio_result_t (*streamRequestStop)(AAudioStream *);
+    aaudio_result_t (*streamClose)(AAudioStream *);
+} s_aaudio;
+
+static int aaudio_available(void) {
+    if (s_aaudio.tried) return s_aaudio.lib != NULL;
+    s_aaudio.tried = 1;
+    void *lib = dlopen("libaaudio.so", RTLD_NOW);
+    if (!lib) {
+        LOGI("AAudio not available, using Java AudioTrack playback");
+        return 0;
+    }
+    s_aaudio.createStreamBuilder      = dlsym(lib, "AAudio_createStreamBuilder");
+    s_aaudio.builderSetSampleRate     = dlsym(lib, "AAudioStreamBuilder_setSampleRate");
+    s_aaudio.builderSetChannelCount   = dlsym(lib, "AAudioStreamBuilder_setChannelCount");
+    s_aaudio.builderSetFormat         = dlsym(lib, "AAudioStreamBuilder_setFormat");
+    s_aaudio.builderSetPerformanceMode = dlsym(lib, "AAudioStreamBuilder_setPerformanceMode");
+    s_aaudio.builderOpenStream        = dlsym(lib, "AAudioStreamBuilder_openStream");
+    s_aaudio.builderDelete            = dlsym(lib, "AAudioStreamBuilder_delete");
+    s_aaudio.streamRequestStart       = dlsym(lib, "AAudioStream_requestStart");
+    s_aaudio.streamWrite              = dlsym(lib, "AAudioStream_write");
+    s_aaudio.streamGetFramesWritten   = dlsym(lib, "AAudioStream_getFramesWritten");
+    s_aaudio.streamGetFramesRead      = dlsym(lib, "AAudioStream_getFramesRead");
+    s_aaudio.streamRequestStop        = dlsym(lib, "AAudioStream_requestStop");
+    s_aaudio.streamClose              = dlsym(lib, "AAudioStream_close");
+    if (!s_aaudio.createStreamBuilder || !s_aaudio.builderSetSampleRate ||
+        !s_aaudio.builderSetChannelCount || !s_aaudio.builderSetFormat ||
+        !s_aaudio.builderSetPerformanceMode || !s_aaudio.builderOpenStream ||
+        !s_aaudio.builderDelete || !s_aaudio.streamRequestStart ||
+        !s_aaudio.streamWrite || !s_aaudio.streamGetFramesWritten ||
+        !s_aaudio.streamGetFramesRead || !s_aaudio.streamRequestStop ||
+        !s_aaudio.streamClose) {
+        LOGE("libaaudio.so missing symbols, using Java AudioTrack playback");
+        dlclose(lib);
+        return 0;
+    }
+    s_aaudio.lib = lib;
+    return 1;
+}
+
+/* Open + start a low-latency float output stream for one utterance. */
+static AAudioStream *tts_aaudio_open(void) {
+    if (!aaudio_available()) return NULL;
+    AAudioStreamBuilder *builder = NULL;
+    if (s_aaudio.createStreamBuilder(&builder) != AAUDIO_OK) return NULL;
+    s_aaudio.builderSetSampleRate(builder, QWEN_TTS_SAMPLE_RATE);
+    s_aaudio.builderSetChannelCount(builder, 1);
+    s_aaudio.builderSetFormat(builder, AAUDIO_FORMAT_PCM_FLOAT);
+    s_aaudio.builderSetPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    AAudioStream *stream = NULL;
+    aaudio_result_t r = s_aaudio.builderOpenStream(builder, &stream);
+    s_aaudio.builderDelete(builder);
+    if (r != AAUDIO_OK) {
+        LOGE("AAudio openStream failed (%d)", (int)r);
+        return NULL;
+    }
+    if (s_aaudio.streamRequestStart(stream) != AAUDIO_OK) {
+        LOGE("AAudio requestStart failed");
+        s_aaudio.streamClose(stream);
+        return NULL;
+    }
+    return stream;
+}
+
+/* Block until the device has consumed everything we wrote, then close. */
+static void tts_aaudio_drain_close(AAudioStream *stream) {
+    int64_t written = s_aaudio.streamGetFramesWritten(stream);
+    for (;;) {
+        int64_t played = s_aaudio.streamGetFramesRead(stream);
+        if (played >= written) break;
+        int64_t remain_us = (written - played) * 1000000LL / QWEN_TTS_SAMPLE_RATE;
+        if (remain_us > 100000LL) remain_us = 100000LL;
+        if (remain_us < 1000LL) remain_us = 1000LL;
+        usleep((useconds_t)remain_us);
+    }
+    s_aaudio.streamRequestStop(stream);
+    s_aaudio.streamClose(stream);
+}
+
 /* ========================================================================
  * Streaming TTS: C audio callback → Java TtsStreamCallback bridge
  * ======================================================================== */
@@ -161,6 +270,7 @@ typedef struct {
     jmethodID onAudioChunk;
     jmethodID onComplete;
     jmethodID onError;
+    AAudioStream *sink;     /* direct playback; NULL = Java AudioTrack path */
     int total_samples;
     long start_ms;
 } stream_cb_data_t;
@@ -209,11 +319,30 @@ static int jni_audio_cb(const float *samples, int n_samples, void *userdata) {
     return 0;
 }
 
+/* C audio callback, direct sink mode: float PCM goes straight into the
+ * AAudio stream — no int16 conversion, no array, no JNI transition. */
+static int jni_audio_cb_direct(const float *samples, int n_samples, void *userdata) {
+    stream_cb_data_t *data = (stream_cb_data_t *)userdata;
+    int written = 0;
+    while (written < n_samples) {
+        aaudio_result_t r = s_aaudio.streamWrite(data->sink, samples + written,
+                                                 n_samples - written,
+                                                 500000000LL /* 500ms */);
+        if (r < 0) {
+            LOGE("AAudio write failed (%d), aborting generation", (int)r);
+            return -1;
+        }
+        written += (int)r;
+    }
+    data->total_samples += n_samples;
+    return 0;
+}
+
 JNIEXPORT void JNICALL
 Java_ai_connct_1screen_rn_HermesRuntime_nativeTtsGenerateStream(
     JNIEnv *env, jclass cls,
     jstring jTokenIds, jstring jSpeaker, jstring jLanguage,
-    jint chunkSize, jobject jCallback)
+    jint chunkSize, jboolean directSink, jobject jCallback)
 {
     if (!g_tts_ctx) {
         LOGE("TTS model not loaded");
@@ -242,11 +371,37 @@ Java_ai_connct_1screen_rn_HermesRuntime_nativeTtsGenerateStream(
     cb_data.onAudioChunk = (*env)->GetMethodID(env, cbClass, "onAudioChunk", "([SI)V");
     cb_data.onComplete = (*env)->GetMethodID(env, cbClass, "onComplete", "(IJ)V");
     cb_data.onError = (*env)->GetMethodID(env, cbClass, "onError", "(Ljava/lang/String;)V");
+    cb_data.sink = NULL;
     cb_data.total_samples = 0;
     cb_data.start_ms = now_ms_jni();
 
-    int ret = qwen_tts_generate_stream(g_tts_ctx, token_ids, speaker, language,
-                                        (int)chunkSize, jni_audio_cb, &cb_data);
+    /* Direct playback: open the AAudio stream once for the utterance and
+     * let the C callback write float PCM into it. Java then only sees
+     * lifecycle events (onComplete/onError), never the audio itself. */
+    if (directSink) {
+        cb_data.sink = tts_aaudio_open();
+        if (!cb_data.sink)
+            LOGI("Direct sink unavailable, falling back to onAudioChunk");
+    }
+
+    /* Synthesis is background class on the shared pool (see
+     * nativeTtsGenerate). */
+    qwen_set_thread_background(1);
+
+    /* Segmented variant: tokenIds may carry '|'-separated per-sentence
+     * segments for low first-audio latency; a single segment behaves
+     * exactly like qwen_tts_generate_stream. */
+    int ret = qwen_tts_generate_stream_segmented(g_tts_ctx, token_ids, speaker, language,
+                                                 (int)chunkSize,
+                                                 cb_data.sink ? jni_audio_cb_direct : jni_audio_cb,
+                                                 &cb_data);
+
+    /* In sink mode onComplete doubles as "playback finished": drain the
+     * device before reporting, so callers can keep their blocking wait. */
+    if (cb_data.sink) {
+        tts_aaudio_drain_close(cb_data.sink);
+        cb_data.sink = NULL;
+    }
 
     (*env)->ReleaseStringUTFChars(env, jTokenIds, token_ids);
     if (speaker) (*env)->ReleaseStringUTFChars(env, jSpeaker, speaker);
@@ -11,6 +11,9 @@
 #include "tools_app.h"
 #include "hermes_runtime.h"
 
+#include <string_view>
+#include <vector>
+
 using namespace facebook::jsi;
 
 // ---------------------------------------------------------------------------
@@ -24,6 +27,8 @@ void resolveAppJniCache(JNIEnv* env) {
     g_app_cache.clazz            = (jclass)env->NewGlobalRef(cls);
     g_app_cache.getScreen        = env->GetStaticMethodID(cls, "nativeGetScreen",        "()Ljava/lang/String;");
     g_app_cache.takeScreenshot   = env->GetStaticMethodID(cls, "nativeTakeScreenshot",   "()Ljava/lang/String;");
+    g_app_cache.takeScreenshotJpeg = env->GetStaticMethodID(cls, "nativeTakeScreenshotJpeg", "()[B");
+    g_app_cache.screenshotError  = env->GetStaticMethodID(cls, "nativeScreenshotError",  "()Ljava/lang/String;");
     g_app_cache.clickByText      = env->GetStaticMethodID(cls, "nativeClickByText",      "(Ljava/lang/String;)Z");
     g_app_cache.clickByDesc      = env->GetStaticMethodID(cls, "nativeClickByDesc",      "(Ljava/lang/String;)Z");
     g_app_cache.clickByCoords    = env->GetStaticMethodID(cls, "nativeClickByCoords",    "(II)Z");
@@ -39,6 +44,7 @@ void resolveAppJniCache(JNIEnv* env) {
     g_app_cache.showNotifications= env->GetStaticMethodID(cls, "nativeShowNotifications","()Z");
     g_app_cache.launchApp        = env->GetStaticMethodID(cls, "nativeLaunchApp",        "(Ljava/lang/String;)Ljava/lang/String;");
     g_app_cache.listApps         = env->GetStaticMethodID(cls, "nativeListApps",         "()Ljava/lang/String;");
+    g_app_cache.batchActions     = env->GetStaticMethodID(cls, "nativeBatchActions",     "(Ljava/lang/String;)Ljava/lang/String;");
     env->DeleteLocalRef(cls);
 }
 
@@ -52,9 +58,9 @@ void resolveAppJniCache(JNIEnv* env) {
             [](Runtime& rt, const Value&, const Value*, size_t) -> Value { \
                 JNIEnv* env = getEnv(); \
                 jstring result = (jstring)env->CallStaticObjectMethod(g_app_cache.clazz, g_app_cache.jniMethod); \
-                std::string str = jstringToStd(env, result); \
+                String str = jstringToJsi(env, rt, result); \
                 if (result) env->DeleteLocalRef(result); \
-                return String::createFromUtf8(rt, str); \
+                return str; \
             }))
 
 #define REGISTER_APP_BOOL_FN(rt, name, jniMethod) \
@@ -66,21 +72,158 @@ void resolveAppJniCache(JNIEnv* env) {
                 return Value((bool)result); \
             }))
 
+// ---------------------------------------------------------------------------
+// Screenshot byte transfer
+// ---------------------------------------------------------------------------
+
+// MutableBuffer holding the JPEG bytes of one capture. The byte[] from Java
+// is copied into it exactly once (GetByteArrayRegion); the ArrayBuffer built
+// on top shares the storage with JS, so no Base64 inflation or further
+// copies happen until the LLM payload is assembled.
+class JpegBuffer : public MutableBuffer {
+public:
+    explicit JpegBuffer(size_t size) : bytes_(size) {}
+    size_t size() const override { return bytes_.size(); }
+    uint8_t* data() override { return bytes_.data(); }
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+// ---------------------------------------------------------------------------
+// Accessibility tree cache + diff
+// ---------------------------------------------------------------------------
+
+// Last serialized tree, cached native-side (one slot — the app agent runs a
+// single runtime). get_screen_diff() compares the fresh dump against it one
+// line per node and returns only the changed region, so a content-heavy
+// screen doesn't push 50-100KB into JS and the LLM context when one widget
+// changed.
+static std::string g_last_tree;
+
+static std::vector<std::string_view> treeLines(const std::string& s) {
+    std::vector<std::string_view> lines;
+    size_t start = 0;
+    while (start < s.size()) {
+        size_t end = s.find('\n', start);
+        if (end == std::string::npos) end = s.size();
+        lines.push_back(std::string_view(s).substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+// Compact delta: trim the common prefix/suffix lines and emit the region in
+// between. One node per line and stable serialization order make this catch
+// single-subtree changes precisely. Falls back to the full tree when there
+// is no previous dump or most of the screen changed.
+static std::string diffTree(const std::string& prev, const std::string& cur) {
+    if (prev.empty()) return cur;
+    if (prev == cur) return "[no screen changes since the previous call]\n";
+
+    auto a = treeLines(prev);
+    auto b = treeLines(cur);
+    size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && a[prefix] == b[prefix])
+        prefix++;
+    size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+           a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix])
+        suffix++;
+    size_t added = b.size() - prefix - suffix;
+    size_t removed = a.size() - prefix - suffix;
+
+    // Mostly-new screen: the delta would not be meaningfully smaller
+    if (added * 2 > b.size()) return cur;
+
+    char header[192];
+    snprintf(header, sizeof(header),
+             "[screen diff vs previous call: %zu unchanged lines above and %zu below "
+             "this region; %zu old lines replaced by %zu new. Use get_screen() for "
+             "the full tree.]\n",
+             prefix, suffix, removed, added);
+    std::string out = header;
+    for (size_t i = prefix; i < b.size() - suffix; i++) {
+        out.append(b[i]);
+        out += '\n';
+    }
+    if (added == 0) out += "(nodes removed, nothing added)\n";
+    return out;
+}
+
 // ---------------------------------------------------------------------------
 // Registration
 // ---------------------------------------------------------------------------
 
+// Property names probed on every click/long_click target object. Interned
+// once at registration; the host lambdas capture the shared_ptr, and since
+// the runtime owns those lambdas the PropNameIDs are released during runtime
+// teardown, never after.
+struct TargetProps {
+    PropNameID desc, x, y;
+    explicit TargetProps(Runtime& rt)
+        : desc(PropNameID::forAscii(rt, "desc")),
+          x(PropNameID::forAscii(rt, "x")),
+          y(PropNameID::forAscii(rt, "y")) {}
+};
+
 void registerAppTools(Runtime& rt) {
-    // get_screen() -> string
-    REGISTER_APP_STRING_FN(rt, "get_screen", getScreen);
+    auto props = std::make_shared<TargetProps>(rt);
+
+    // get_screen() -> string (full tree; refreshes the native diff cache)
+    rt.global().setProperty(rt, "get_screen",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "get_screen"), 0,
+            [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
+                JNIEnv* env = getEnv();
+                jstring result = (jstring)env->CallStaticObjectMethod(g_app_cache.clazz, g_app_cache.getScreen);
+                const std::string& str = jstringToScratch(env, result);
+                if (result) env->DeleteLocalRef(result);
+                String js = String::createFromUtf8(rt, str);
+                g_last_tree = str;
+                return js;
+            }));
+
+    // get_screen_diff() -> string (changed region since the previous call)
+    rt.global().setProperty(rt, "get_screen_diff",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "get_screen_diff"), 0,
+            [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
+                JNIEnv* env = getEnv();
+                jstring result = (jstring)env->CallStaticObjectMethod(g_app_cache.clazz, g_app_cache.getScreen);
+                const std::string& str = jstringToScratch(env, result);
+                if (result) env->DeleteLocalRef(result);
+                std::string delta = diffTree(g_last_tree, str);
+                g_last_tree = str;
+                return String::createFromUtf8(rt, delta);
+            }));
 
     // take_screenshot() -> string (base64 JPEG or error)
     REGISTER_APP_STRING_FN(rt, "take_screenshot", takeScreenshot);
 
+    // take_screenshot_jpeg() -> ArrayBuffer (JPEG bytes) or error string
+    rt.global().setProperty(rt, "take_screenshot_jpeg",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "take_screenshot_jpeg"), 0,
+            [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
+                JNIEnv* env = getEnv();
+                jbyteArray jpeg = (jbyteArray)env->CallStaticObjectMethod(
+                    g_app_cache.clazz, g_app_cache.takeScreenshotJpeg);
+                if (!jpeg) {
+                    jstring err = (jstring)env->CallStaticObjectMethod(
+                        g_app_cache.clazz, g_app_cache.screenshotError);
+                    String str = jstringToJsi(env, rt, err);
+                    if (err) env->DeleteLocalRef(err);
+                    return str;
+                }
+                jsize len = env->GetArrayLength(jpeg);
+                auto buffer = std::make_shared<JpegBuffer>((size_t)len);
+                env->GetByteArrayRegion(jpeg, 0, len,
+                                        reinterpret_cast<jbyte*>(buffer->data()));
+                env->DeleteLocalRef(jpeg);
+                return Value(rt, ArrayBuffer(rt, std::move(buffer)));
+            }));
+
     // click(target) -> bool
     rt.global().setProperty(rt, "click",
         Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "click"), 1,
-            [](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
+            [props](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
                 if (count < 1) return Value(false);
                 JNIEnv* env = getEnv();
                 if (args[0].isString()) {
@@ -92,16 +235,16 @@ void registerAppTools(Runtime& rt) {
                 }
                 if (args[0].isObject()) {
                     Object obj = args[0].asObject(rt);
-                    if (obj.hasProperty(rt, "desc")) {
-                        std::string desc = obj.getProperty(rt, "desc").asString(rt).utf8(rt);
+                    if (obj.hasProperty(rt, props->desc)) {
+                        std::string desc = obj.getProperty(rt, props->desc).asString(rt).utf8(rt);
                         jstring jdesc = env->NewStringUTF(desc.c_str());
                         jboolean res = env->CallStaticBooleanMethod(g_app_cache.clazz, g_app_cache.clickByDesc, jdesc);
                         env->DeleteLocalRef(jdesc);
                         return Value((bool)res);
                     }
-                    if (obj.hasProperty(rt, "x") && obj.hasProperty(rt, "y")) {
-                        int x = (int)obj.getProperty(rt, "x").asNumber();
-                        int y = (int)obj.getProperty(rt, "y").asNumber();
+                    if (obj.hasProperty(rt, props->x) && obj.hasProperty(rt, props->y)) {
+                        int x = (int)obj.getProperty(rt, props->x).asNumber();
+                        int y = (int)obj.getProperty(rt, props->y).asNumber();
                         jboolean res = env->CallStaticBooleanMethod(g_app_cache.clazz, g_app_cache.clickByCoords, x, y);
                         return Value((bool)res);
                     }
@@ -112,7 +255,7 @@ void registerAppTools(Runtime& rt) {
     // long_click(target) -> bool
     rt.global().setProperty(rt, "long_click",
         Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "long_click"), 1,
-            [](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
+            [props](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
                 if (count < 1) return Value(false);
                 JNIEnv* env = getEnv();
                 if (args[0].isString()) {
@@ -124,16 +267,16 @@ void registerAppTools(Runtime& rt) {
                 }
                 if (args[0].isObject()) {
                     Object obj = args[0].asObject(rt);
-                    if (obj.hasProperty(rt, "desc")) {
-                        std::string desc = obj.getProperty(rt, "desc").asString(rt).utf8(rt);
+                    if (obj.hasProperty(rt, props->desc)) {
+                        std::string desc = obj.getProperty(rt, props->desc).asString(rt).utf8(rt);
                         jstring jdesc = env->NewStringUTF(desc.c_str());
                         jboolean res = env->CallStaticBooleanMethod(g_app_cache.clazz, g_app_cache.longClickByDesc, jdesc);
                         env->DeleteLocalRef(jdesc);
                         return Value((bool)res);
                     }
-                    if (obj.hasProperty(rt, "x") && obj.hasProperty(rt, "y")) {
-                        int x = (int)obj.getProperty(rt, "x").asNumber();
-                        int y = (int)obj.getProperty(rt, "y").asNumber();
+                    if (obj.hasProperty(rt, props->x) && obj.hasProperty(rt, props->y)) {
+                        int x = (int)obj.getProperty(rt, props->x).asNumber();
+                        int y = (int)obj.getProperty(rt, props->y).asNumber();
                         jboolean res = env->CallStaticBooleanMethod(g_app_cache.clazz, g_app_cache.longClickByCoords, x, y);
                         return Value((bool)res);
                     }
@@ -165,11 +308,11 @@ void registerAppTools(Runtime& rt) {
                 jstring jtext = env->NewStringUTF(text.c_str());
                 jstring jdir = env->NewStringUTF(dir.c_str());
                 jstring result = (jstring)env->CallStaticObjectMethod(g_app_cache.clazz, g_app_cache.scrollElement, jtext, jdir);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 env->DeleteLocalRef(jtext);
                 env->DeleteLocalRef(jdir);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // type_text(text) -> bool
@@ -206,12 +349,33 @@ void registerAppTools(Runtime& rt) {
                 std::string name = args[0].asString(rt).utf8(rt);
                 jstring jname = env->NewStringUTF(name.c_str());
                 jstring result = (jstring)env->CallStaticObjectMethod(g_app_cache.clazz, g_app_cache.launchApp, jname);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 env->DeleteLocalRef(jname);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // list_apps() -> string
     REGISTER_APP_STRING_FN(rt, "list_apps", listApps);
+
+    // batch_actions(actionsJson) -> Array of per-action result objects
+    // One JNI crossing for a whole action sequence — each single-call tool
+    // costs a JNI transition plus the accessibility-service handoff, so a
+    // typical click -> sleep -> scroll script pays that once instead of per
+    // action. The sequence itself runs Java-side in AppToolsHost; the result
+    // JSON is built into JSI objects natively so JS never JSON.parses it.
+    rt.global().setProperty(rt, "batch_actions",
+        Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "batch_actions"), 1,
+            [](Runtime& rt, const Value&, const Value* args, size_t count) -> Value {
+                if (count < 1) return String::createFromUtf8(rt, "[{\"error\":\"need an action array\"}]");
+                JNIEnv* env = getEnv();
+                std::string json = args[0].asString(rt).utf8(rt);
+                jstring jjson = env->NewStringUTF(json.c_str());
+                jstring result = (jstring)env->CallStaticObjectMethod(
+                    g_app_cache.clazz, g_app_cache.batchActions, jjson);
+                Value out = jstringJsonToJsi(env, rt, result);
+                env->DeleteLocalRef(jjson);
+                if (result) env->DeleteLocalRef(result);
+                return out;
+            }));
 }
@@ -15,6 +15,8 @@ struct AppJniCache {
     jclass clazz;              // AppToolsHost.java
     jmethodID getScreen;
     jmethodID takeScreenshot;
+    jmethodID takeScreenshotJpeg;
+    jmethodID screenshotError;
     jmethodID clickByText;
     jmethodID clickByDesc;
     jmethodID clickByCoords;
@@ -30,6 +32,7 @@ struct AppJniCache {
     jmethodID showNotifications;
     jmethodID launchApp;
     jmethodID listApps;
+    jmethodID batchActions;
 };
 
 // Resolve JNI method IDs for AppToolsHost. Call once from the main thread.
@@ -45,9 +45,9 @@ void registerBrowserTools(Runtime& rt) {
             [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
                 JNIEnv* env = getEnv();
                 jstring result = (jstring)env->CallStaticObjectMethod(g_browser_cache.clazz, g_browser_cache.getPage);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // click_element(id) -> bool
@@ -116,9 +116,9 @@ void registerBrowserTools(Runtime& rt) {
             [](Runtime& rt, const Value&, const Value*, size_t) -> Value {
                 JNIEnv* env = getEnv();
                 jstring result = (jstring)env->CallStaticObjectMethod(g_browser_cache.clazz, g_browser_cache.takeScreenshot);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // switch_ua(mode) -> string
@@ -130,10 +130,10 @@ void registerBrowserTools(Runtime& rt) {
                 std::string mode = args[0].asString(rt).utf8(rt);
                 jstring jmode = env->NewStringUTF(mode.c_str());
                 jstring result = (jstring)env->CallStaticObjectMethod(g_browser_cache.clazz, g_browser_cache.switchUa, jmode);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 env->DeleteLocalRef(jmode);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 
     // set_viewport(width, height) -> string
@@ -145,8 +145,8 @@ void registerBrowserTools(Runtime& rt) {
                 int w = (int)args[0].asNumber();
                 int h = (int)args[1].asNumber();
                 jstring result = (jstring)env->CallStaticObjectMethod(g_browser_cache.clazz, g_browser_cache.setViewport, w, h);
-                std::string str = jstringToStd(env, result);
+                String str = jstringToJsi(env, rt, result);
                 if (result) env->DeleteLocalRef(result);
-                return String::createFromUtf8(rt, str);
+                return str;
             }));
 }
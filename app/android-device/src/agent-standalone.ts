@@ -15,7 +15,12 @@ import "./app-prompt"; // side-effect: sets globalThis.__DEVICE_PROMPT__
 // Declare globals provided by C++ host functions (for TypeScript only)
 declare global {
   var get_screen: () => string;
+  // Changed lines since the previous call; full tree on first use
+  var get_screen_diff: () => string;
   var take_screenshot: () => string;
+  // Zero-copy capture: JPEG bytes as an ArrayBuffer, or an "ERROR: ..." string
+  var take_screenshot_jpeg: () => ArrayBuffer | string;
+  var base64_encode: (buf: ArrayBuffer) => string;
   var click: (
     target: string | { desc?: string; x?: number; y?: number }
   ) => boolean;
@@ -23,6 +28,12 @@ declare global {
     target: string | { desc?: string; x?: number; y?: number }
   ) => boolean;
   var scroll: (direction: string) => boolean;
+  // One JNI crossing for a fixed action sequence; the wrapper accepts an
+  // array and stringifies it for the native side. Results come back as a
+  // ready array of per-action objects (built native-side, no JSON.parse)
+  var batch_actions: (
+    actions: string | Array<Record<string, unknown>>
+  ) => Array<Record<string, unknown>>;
   var scroll_element: (text: string, direction: string) => string;
   var type_text: (text: string) => boolean;
   var press_home: () => boolean;
@@ -35,6 +46,11 @@ declare global {
   var sleep: (ms: number) => void;
   var log: (msg: string) => void;
   var update_status: (text: string) => void;
+  // Hermes heap counters (bytes allocated, GC counts) as a plain object
+  var get_heap_info: () => Record<string, number>;
+  // Parallel fan-out of {url, headers, body} requests; returns a JSON
+  // array of response bodies in request order
+  var http_post_batch: (requestsJson: string) => string;
   var ask_user: (question: string) => string;
   var hide_overlay: () => void;
   var executeCodeForServer: (code: string) => {
@@ -56,12 +72,13 @@ function wrapHostFunctions(opts: {
   deadline: number;
   maxGetScreen: number;
   onGetScreen?: (tree: string) => void;
-  onScreenshot: (b64: string) => void;
+  onScreenshot: (jpeg: ArrayBuffer) => void;
   onAction?: (entry: { fn: string; args: string; result: string }) => void;
 }): { getScreenCount: () => number; restore: () => void } {
   let getScreenCount = 0;
 
   const origGetScreen = get_screen;
+  const origGetScreenDiff = get_screen_diff;
   const origTakeScreenshot = take_screenshot;
   const origClick = click;
   const origLongClick = long_click;
@@ -69,6 +86,7 @@ function wrapHostFunctions(opts: {
   const origLaunchApp = launch_app;
   const origScroll = scroll;
   const origScrollElement = scroll_element;
+  const origBatchActions = batch_actions;
   const origPressHome = press_home;
   const origPressBack = press_back;
   const origPressRecents = press_recents;
@@ -97,14 +115,38 @@ function wrapHostFunctions(opts: {
     return tree;
   };
 
+  // Counts against the same per-exec limit as get_screen
+  globalThis.get_screen_diff = function (): string {
+    if (Date.now() > opts.deadline) throw new Error("Script execution timeout");
+    getScreenCount++;
+    if (getScreenCount > opts.maxGetScreen) {
+      throw new Error(
+        "get_screen_diff() called after " +
+          getScreenCount +
+          " screen reads. Max is " +
+          opts.maxGetScreen +
+          ". Return and plan next actions in a new execute_js call."
+      );
+    }
+    const delta = origGetScreenDiff();
+    opts.onAction?.({
+      fn: "get_screen_diff",
+      args: "",
+      result: delta.length + " chars"
+    });
+    if (opts.onGetScreen) opts.onGetScreen(delta);
+    return delta;
+  };
+
   globalThis.take_screenshot = function (): string {
     if (Date.now() > opts.deadline) throw new Error("Script execution timeout");
-    const b64 = origTakeScreenshot();
-    if (b64.startsWith("ERROR:")) {
-      opts.onAction?.({ fn: "take_screenshot", args: "", result: b64 });
-      return b64;
+    // Raw JPEG bytes — Base64 is deferred until the payload is built
+    const jpeg = take_screenshot_jpeg();
+    if (typeof jpeg === "string") {
+      opts.onAction?.({ fn: "take_screenshot", args: "", result: jpeg });
+      return jpeg;
     }
-    opts.onScreenshot(b64);
+    opts.onScreenshot(jpeg);
     opts.onAction?.({ fn: "take_screenshot", args: "", result: "captured" });
     return "screenshot captured - image will be sent to you";
   };
@@ -164,6 +206,16 @@ function wrapHostFunctions(opts: {
     return r;
   };
 
+  globalThis.batch_actions = function (
+    actions: string | Array<Record<string, unknown>>
+  ): Array<Record<string, unknown>> {
+    if (Date.now() > opts.deadline) throw new Error("Script execution timeout");
+    const json = typeof actions === "string" ? actions : JSON.stringify(actions);
+    const r = origBatchActions(json);
+    opts.onAction?.({ fn: "batch_actions", args: json, result: JSON.stringify(r) });
+    return r;
+  };
+
   globalThis.press_home = function (): boolean {
     const r = origPressHome();
     opts.onAction?.({ fn: "press_home", args: "", result: String(r) });
@@ -199,6 +251,7 @@ function wrapHostFunctions(opts: {
     getScreenCount: () => getScreenCount,
     restore() {
       globalThis.get_screen = origGetScreen;
+      globalThis.get_screen_diff = origGetScreenDiff;
       globalThis.take_screenshot = origTakeScreenshot;
       globalThis.click = origClick;
       globalThis.long_click = origLongClick;
@@ -206,6 +259,7 @@ function wrapHostFunctions(opts: {
       globalThis.launch_app = origLaunchApp;
       globalThis.scroll = origScroll;
       globalThis.scroll_element = origScrollElement;
+      globalThis.batch_actions = origBatchActions;
       globalThis.press_home = origPressHome;
       globalThis.press_back = origPressBack;
       globalThis.press_recents = origPressRecents;
@@ -224,18 +278,22 @@ function executeCodeForServer(code: string): {
   screenshots: string[];
   executionLog: Array<{ fn: string; args: string; result: string }>;
 } {
-  const capturedScreenshots: string[] = [];
+  const capturedScreenshots: ArrayBuffer[] = [];
   const logEntries: Array<{ fn: string; args: string; result: string }> = [];
   let lastGetScreenResult: string | null = null;
 
+  // Held as raw bytes during execution; encoded only here, once, when the
+  // result payload (which carries screenshots to the LLM) is assembled.
+  const encodeScreenshots = () => capturedScreenshots.map((b) => base64_encode(b));
+
   const wrapped = wrapHostFunctions({
     deadline: Date.now() + EXEC_TIMEOUT_MS,
     maxGetScreen: MAX_GET_SCREEN_PER_EXEC,
     onGetScreen(tree) {
       lastGetScreenResult = tree;
     },
-    onScreenshot(b64) {
-      capturedScreenshots.push(b64);
+    onScreenshot(jpeg) {
+      capturedScreenshots.push(jpeg);
     },
     onAction(entry) {
       logEntries.push(entry);
@@ -250,7 +308,7 @@ function executeCodeForServer(code: string): {
     }
     return {
       result: result === undefined ? "undefined" : String(result),
-      screenshots: capturedScreenshots,
+      screenshots: encodeScreenshots(),
       executionLog: logEntries
     };
   } catch (e: unknown) {
@@ -259,13 +317,13 @@ function executeCodeForServer(code: string): {
       return {
         result:
           "[JS Error] Top-level 'return' is not allowed. The code runs in global scope — use the last expression as the result instead of 'return'.",
-        screenshots: capturedScreenshots,
+        screenshots: encodeScreenshots(),
         executionLog: logEntries
       };
     }
     return {
       result: "[JS Error] " + msg,
-      screenshots: capturedScreenshots,
+      screenshots: encodeScreenshots(),
       executionLog: logEntries
     };
   } finally {
@@ -16,6 +16,8 @@ export const SYSTEM_PROMPT =
   '- click("text") matches BOTH text and desc attributes. Use click({desc:"X"}) for desc-only match\n' +
   "- Bounds format: [left,top][right,bottom]. Center: x=(left+right)/2, y=(top+bottom)/2\n" +
   "- After actions, call sleep(500) then get_screen() to verify results\n" +
+  "- When re-checking a screen you already read, prefer get_screen_diff() — it returns only what changed since the last read\n" +
+  "- For a fixed sequence of actions (click, sleep, scroll, ...), prefer one batch_actions([...]) call over separate calls — it is faster and stops at the first failure\n" +
   "- If elements (especially ImageView) have no text or desc, call take_screenshot() to see actual pixels\n" +
   "- take_screenshot() returns a placeholder; the actual image is automatically sent to you as a vision input\n" +
   "- If click by text fails, calculate coordinates from bounds and use click({x, y})\n" +
@@ -15,6 +15,14 @@ export const HOST_FUNCTIONS: HostFunctionDef[] = [
     description: "returns accessibility tree as string",
     agentVisible: true
   },
+  {
+    name: "get_screen_diff",
+    params: [],
+    returns: "string",
+    description:
+      "like get_screen() but returns only the lines changed since the previous call (much smaller; falls back to the full tree)",
+    agentVisible: true
+  },
   {
     name: "take_screenshot",
     params: [],
@@ -65,6 +73,19 @@ export const HOST_FUNCTIONS: HostFunctionDef[] = [
     description: "scroll a specific scrollable element found by text",
     agentVisible: true
   },
+  {
+    name: "batch_actions",
+    params: [
+      {
+        name: "actions",
+        type: "Array<{ action: string; text?: string; desc?: string; x?: number; y?: number; direction?: string; ms?: number }>"
+      }
+    ],
+    returns: "Array<{ action: string; ok?: boolean; error?: string }>",
+    description:
+      'run a fixed action sequence in one native call, e.g. batch_actions([{action:"click",text:"OK"},{action:"sleep",ms:500},{action:"scroll",direction:"down"}]). Supports click/long_click/scroll/type_text/sleep/press_home/press_back/press_recents/show_notifications; stops at the first failure and returns an array of per-action results',
+    agentVisible: true
+  },
   {
     name: "type_text",
     params: [{ name: "text", type: "string" }],
@@ -163,6 +184,13 @@ export const HOST_FUNCTIONS: HostFunctionDef[] = [
     description: "hide the overlay",
     agentVisible: false
   },
+  {
+    name: "get_heap_info",
+    params: [],
+    returns: "Record<string, number>",
+    description: "Hermes heap counters as a plain object (for perf logging)",
+    agentVisible: false
+  },
   {
     name: "http_post",
     params: [
@@ -173,6 +201,14 @@ export const HOST_FUNCTIONS: HostFunctionDef[] = [
     returns: "string",
     description: "synchronous HTTP POST",
     agentVisible: false
+  },
+  {
+    name: "http_post_batch",
+    params: [{ name: "requestsJson", type: "string" }],
+    returns: "string",
+    description:
+      "parallel HTTP POSTs: JSON array of {url, headers, body}, returns JSON array of response bodies in order",
+    agentVisible: false
   }
 ];
 